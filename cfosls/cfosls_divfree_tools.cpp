@@ -1164,13 +1164,17 @@ LocalProblemSolver::~LocalProblemSolver()
     delete temprhs_func;
 
     delete AE_edofs_L2;
-    for (int blk = 0; blk < AE_eintdofs_blocks->NumRowBlocks(); ++blk)
-        delete &(AE_eintdofs_blocks->GetBlock(blk,blk));
     delete AE_eintdofs_blocks;
 
     delete xblock;
     delete yblock;
 
+    for (int blk = 0; blk < numblocks; ++blk)
+        delete Local_inds[blk];
+    for (int blk1 = 0; blk1 < numblocks; ++blk1)
+        for (int blk2 = 0; blk2 < numblocks; ++blk2)
+            delete LocalAE_Matrices(blk1,blk2);
+
     if (optimized_localsolve)
         for (unsigned int i = 0; i < LUfactors.size(); ++i)
             for (unsigned int j = 0; j < LUfactors[i].size(); ++j)
@@ -1188,6 +1192,48 @@ LocalProblemSolver::~LocalProblemSolver()
 
 }
 
+// memory used by the data of the (owned) vectors
+static long VectorsMemoryUsage(const Array<BlockVector*>& vecs)
+{
+    long mem = 0;
+    for (int i = 0; i < vecs.Size(); ++i)
+        if (vecs[i])
+            mem += vecs[i]->MemoryUsage();
+    return mem;
+}
+
+long LocalProblemSolver::MemoryUsage() const
+{
+    long mem = 0;
+
+    if (AE_edofs_L2)
+        mem += AE_edofs_L2->MemoryUsage();
+    if (AE_eintdofs_blocks)
+        mem += AE_eintdofs_blocks->MemoryUsage();
+
+    if (optimized_localsolve)
+        for (unsigned int i = 0; i < LUfactors.size(); ++i)
+            for (unsigned int j = 0; j < LUfactors[i].size(); ++j)
+                if (LUfactors[i][j])
+                    mem += LUfactors[i][j]->MemoryUsage();
+
+    if (temprhs_func)
+        mem += temprhs_func->MemoryUsage();
+    if (tempsol)
+        mem += tempsol->MemoryUsage();
+    mem += arena.MemoryUsage();
+
+    if (own_essbdr)
+    {
+        for (unsigned int i = 0; i < bdrdofs_blocks_copy.size(); ++i)
+            mem += bdrdofs_blocks_copy[i]->MemoryUsage();
+        for (unsigned int i = 0; i < essbdrdofs_blocks_copy.size(); ++i)
+            mem += essbdrdofs_blocks_copy[i]->MemoryUsage();
+    }
+
+    return mem;
+}
+
 void LocalProblemSolver::Mult(const Vector &x, Vector &y, Vector * rhs_constr) const
 {
     // x will be accessed through xblock as its view
@@ -1214,6 +1260,16 @@ void LocalProblemSolver::Setup()
     tempsol = new BlockVector(Op_blkspmat.RowOffsets());
     //std:cout << "sol size = " << sol->Size() << "\n";
 
+    sub_Func_offsets.SetSize(numblocks + 1);
+    Local_inds.resize(numblocks);
+    LocalAE_Matrices.SetSize(numblocks, numblocks);
+    for (int blk1 = 0; blk1 < numblocks; ++blk1)
+    {
+        Local_inds[blk1] = new Array<int>();
+        for (int blk2 = 0; blk2 < numblocks; ++blk2)
+            LocalAE_Matrices(blk1,blk2) = new DenseMatrix();
+    }
+
     // (optionally) saves LU factors related to the local problems to be solved
     // for each agglomerate element
     if (optimized_localsolve)
@@ -1233,21 +1289,9 @@ void LocalProblemSolver::SolveTrueLocalProblems(BlockVector& truerhs_func, Block
 
     DenseMatrix sub_Constr;
     Vector sub_rhsconstr;
-    Array<int> sub_Func_offsets(numblocks + 1);
-
-    Array2D<const SparseMatrix *> Op_blks(numblocks, numblocks);
-    Array2D<DenseMatrix*> LocalAE_Matrices(numblocks, numblocks);
-    std::vector<SparseMatrix*> AE_eintdofs_blks(numblocks);
-    std::vector<Array<int>*> Local_inds(numblocks);
-
-    for ( int blk = 0; blk < numblocks; ++blk )
-    {
-        AE_eintdofs_blks[blk] = &(AE_eintdofs_blocks->GetBlock(blk,blk));
-        Local_inds[blk] = new Array<int>();
-    }
 
     // loop over all AE, solving a local problem in each AE
-    int nAE = AE_edofs_L2->Height();
+    int nAE = AE_edofs_L2->Size();
 
     for( int AE = 0; AE < nAE; ++AE)
     {
@@ -1260,15 +1304,18 @@ void LocalProblemSolver::SolveTrueLocalProblems(BlockVector& truerhs_func, Block
         {
             //std::cout << "main case AE > e \n" << std::flush;
             //std::cout << "AE = " << AE << "\n";
+
+            // all local matrices and vectors for the AE are taken from the arena
+            ArenaScope scope(arena);
+
             bool is_degenerate = true;
             sub_Func_offsets[0] = 0;
             for ( int blk = 0; blk < numblocks; ++blk )
             {
-                // no memory allocation here, it's just a viewer which is created. no valgrind suggests allocation here
-                //Local_inds[blk] = new Array<int>(AE_eintdofs_blks[blk]->GetRowColumns(AE),
-                                                 //AE_eintdofs_blks[blk]->RowSize(AE));
-                Local_inds[blk]->MakeRef(AE_eintdofs_blks[blk]->GetRowColumns(AE),
-                                                 AE_eintdofs_blks[blk]->RowSize(AE));
+                // no memory allocation here, Local_inds[blk] is just a viewer
+                Table& AE_eintdofs_blk = AE_eintdofs_blocks->GetBlock(blk,blk);
+                Local_inds[blk]->MakeRef(AE_eintdofs_blk.GetRow(AE),
+                                         AE_eintdofs_blk.RowSize(AE));
 
                 if (blk == 0) // degeneracy comes from Constraint matrix which involves only sigma = the first block
                 {
@@ -1303,46 +1350,44 @@ void LocalProblemSolver::SolveTrueLocalProblems(BlockVector& truerhs_func, Block
                 {
                     if (blk1 == 0 && blk2 == 0) // handling L2 block (constraint)
                     {
-                        Array<int> Wtmp_j(AE_edofs_L2->GetRowColumns(AE), AE_edofs_L2->RowSize(AE));
+                        Array<int> Wtmp_j(AE_edofs_L2->GetRow(AE), AE_edofs_L2->RowSize(AE));
                         if (compute_AEproblem_matrices(numblocks, numblocks))
                         {
-                            sub_Constr.SetSize(Wtmp_j.Size(), Local_inds[blk1]->Size());
+                            sub_Constr.UseExternalData(scope.Alloc<double>(Wtmp_j.Size() * Local_inds[blk1]->Size()),
+                                                       Wtmp_j.Size(), Local_inds[blk1]->Size());
                             Constr_spmat.GetSubMatrix(Wtmp_j, *Local_inds[blk1], sub_Constr);
                         }
 
+                        sub_rhsconstr.SetDataAndSize(scope.Alloc<double>(Wtmp_j.Size()), Wtmp_j.Size());
                         if (localrhs_constr)
-                        {
                             localrhs_constr->GetSubVector(Wtmp_j, sub_rhsconstr);
-                        }
                         else
-                        {
-                            sub_rhsconstr.SetSize(Wtmp_j.Size());
                             sub_rhsconstr = 0.0;
-                        }
 
                     } // end of special treatment of the first block involved into constraint
 
                     sub_Func_offsets[blk1 + 1] = sub_Func_offsets[blk1] + Local_inds[blk1]->Size();
 
-                    if (compute_AEproblem_matrices(blk1,blk2))
-                        Op_blks(blk1,blk2) = &(Op_blkspmat.GetBlock(blk1,blk2));
-
                     if (compute_AEproblem_matrices(blk1,blk2))
                     {
                         // Extracting local problem matrices:
-                        LocalAE_Matrices(blk1,blk2) = new DenseMatrix(Local_inds[blk1]->Size(), Local_inds[blk2]->Size());
-                        Op_blks(blk1,blk2)->GetSubMatrix(*Local_inds[blk1], *Local_inds[blk2], *LocalAE_Matrices(blk1,blk2));
+                        int height = Local_inds[blk1]->Size();
+                        int width = Local_inds[blk2]->Size();
+                        LocalAE_Matrices(blk1,blk2)->UseExternalData(scope.Alloc<double>(height * width),
+                                                                     height, width);
+                        Op_blkspmat.GetBlock(blk1,blk2).GetSubMatrix(*Local_inds[blk1], *Local_inds[blk2],
+                                                                     *LocalAE_Matrices(blk1,blk2));
 
                     } // end of the block for non-optimized version
                 }
             } // end of loop over all blocks in the functional
 
-            BlockVector sub_Func(sub_Func_offsets);
+            sub_Func.Update(scope.Alloc<double>(sub_Func_offsets[numblocks]), sub_Func_offsets);
 
             for ( int blk = 0; blk < numblocks; ++blk )
                 temprhs_func->GetBlock(blk).GetSubVector(*Local_inds[blk], sub_Func.GetBlock(blk));
 
-            BlockVector sol_loc(sub_Func_offsets);
+            sol_loc.Update(scope.Alloc<double>(sub_Func_offsets[numblocks]), sub_Func_offsets);
             sol_loc = 0.0;
 
             // solving local problem at the agglomerate element AE
@@ -1355,10 +1400,13 @@ void LocalProblemSolver::SolveTrueLocalProblems(BlockVector& truerhs_func, Block
                         (*Local_inds[blk], sol_loc.GetBlock(blk));
             }
 
+            // the arena memory is returned at the end of the scope, so the
+            // matrices kept for the next AE must not point into it
+            sub_Constr.ClearExternalData();
             for ( int blk1 = 0; blk1 < numblocks; ++blk1 )
                 for ( int blk2 = 0; blk2 < numblocks; ++blk2 )
                     if (compute_AEproblem_matrices(blk1,blk2))
-                        delete LocalAE_Matrices(blk1,blk2);
+                        LocalAE_Matrices(blk1,blk2)->ClearExternalData();
         } // end of if AE is bigger than single fine grid element
         //else
             //std::cout << "side case AE == e \n" << std::flush;
@@ -1368,9 +1416,6 @@ void LocalProblemSolver::SolveTrueLocalProblems(BlockVector& truerhs_func, Block
     for (int blk = 0; blk < numblocks; ++blk)
         d_td_blocks[blk]->MultTranspose(tempsol->GetBlock(blk), truesol.GetBlock(blk));
 
-    for ( int blk = 0; blk < numblocks; ++blk )
-        delete Local_inds[blk];
-
     return;
 
 }
@@ -1446,12 +1491,14 @@ void LocalProblemSolver::SolveLocalProblemOpt(DenseMatrixInverse * inv_A, DenseM
                                            DenseMatrix& B, BlockVector &G,
                                            Vector& F, BlockVector &sol, bool is_degenerate) const
 {
+    ArenaScope scope(arena);
+
     // invAG = invA * G
-    Vector invAG;
+    Vector invAG(scope.Alloc<double>(G.Size()), G.Size());
     inv_A->Mult(G, invAG);
 
     // temp = ( B * invA * G - F )
-    Vector temp(B.Height());
+    Vector temp(scope.Alloc<double>(B.Height()), B.Height());
     B.Mult(invAG, temp);
     temp -= F;
 
@@ -1459,11 +1506,11 @@ void LocalProblemSolver::SolveLocalProblemOpt(DenseMatrixInverse * inv_A, DenseM
         temp(0) = 0;
 
     // lambda = inv(BinvABT) * ( B * invA * G - F )
-    Vector lambda(B.Height());
+    Vector lambda(scope.Alloc<double>(B.Height()), B.Height());
     inv_Schur->Mult(temp, lambda);
 
     // temp2 = (G - BT * lambda)
-    Vector temp2(B.Width());
+    Vector temp2(scope.Alloc<double>(B.Width()), B.Width());
     B.MultTranspose(lambda,temp2);
     temp2 *= -1;
     temp2 += G;
@@ -1478,13 +1525,13 @@ void LocalProblemSolver::SaveLocalLUFactors() const
                 "Error: Unnecessary saving of the LU factors for the local problems"
                 " with optimized_localsolve deactivated \n");
 
-    int nAE = AE_edofs_L2->Height();
+    int nAE = AE_edofs_L2->Size();
     LUfactors.resize(nAE);
 
     DenseMatrix sub_Constr;
     DenseMatrix sub_Func;
 
-    SparseMatrix * AE_eintdofs = &(AE_eintdofs_blocks->GetBlock(0,0));
+    Table * AE_eintdofs = &(AE_eintdofs_blocks->GetBlock(0,0));
     const SparseMatrix * Op_blk = &(Op_blkspmat.GetBlock(0,0));
 
     Array<int> * Local_inds = new Array<int>();
@@ -1504,9 +1551,9 @@ void LocalProblemSolver::SaveLocalLUFactors() const
             bool is_degenerate = true;
 
             //Array<int> Local_inds(AE_eintdofs->GetRowColumns(AE), AE_eintdofs->RowSize(AE));
-            Local_inds->MakeRef(AE_eintdofs->GetRowColumns(AE), AE_eintdofs->RowSize(AE));
+            Local_inds->MakeRef(AE_eintdofs->GetRow(AE), AE_eintdofs->RowSize(AE));
 
-            Array<int> Wtmp_j(AE_edofs_L2->GetRowColumns(AE), AE_edofs_L2->RowSize(AE));
+            Array<int> Wtmp_j(AE_edofs_L2->GetRow(AE), AE_edofs_L2->RowSize(AE));
             sub_Constr.SetSize(Wtmp_j.Size(), Local_inds->Size());
             Constr_spmat.GetSubMatrix(Wtmp_j, *Local_inds, sub_Constr);
 
@@ -1571,7 +1618,7 @@ void LocalProblemSolver::SaveLocalLUFactors() const
     //compute_AEproblem_matrices(numblocks, numblocks) = true;
 }
 
-// Returns a pointer to a BlockMatrix which stores
+// Returns a pointer to a BlockTable which stores
 // the relation between agglomerated elements (AEs)
 // and fine-grid internal (w.r.t. to AEs) dofs for each block.
 // For lowest-order elements all the fine-grid dofs will be
@@ -1579,9 +1626,9 @@ void LocalProblemSolver::SaveLocalLUFactors() const
 // for higher order elements there will be two parts,
 // one for dofs at fine-grid element faces which belong to the global boundary
 // and a different treatment for internal (w.r.t. to fine elements) dofs
-BlockMatrix* LocalProblemSolver::Get_AE_eintdofs(const BlockMatrix &el_to_dofs,
-                                        const std::vector<Array<int>* > &dof_is_essbdr,
-                                        const std::vector<Array<int>* > &dof_is_bdr) const
+BlockTable* LocalProblemSolver::Get_AE_eintdofs(const BlockTable &el_to_dofs,
+                                                const std::vector<Array<int>* > &dof_is_essbdr,
+                                                const std::vector<Array<int>* > &dof_is_bdr) const
 {
     MPI_Comm comm = d_td_blocks[0]->GetComm();
     int num_procs;
@@ -1590,18 +1637,15 @@ BlockMatrix* LocalProblemSolver::Get_AE_eintdofs(const BlockMatrix &el_to_dofs,
     Array<int> res_rowoffsets(numblocks+1);
     res_rowoffsets[0] = 0;
     for (int blk = 0; blk < numblocks; ++blk)
-        res_rowoffsets[blk + 1] = res_rowoffsets[blk] + AE_e.Height();
-    Array<int> res_coloffsets(numblocks+1);
-    res_coloffsets[0] = 0;
-    for (int blk = 0; blk < numblocks; ++blk)
-        res_coloffsets[blk + 1] = res_coloffsets[blk] + el_to_dofs.GetBlock(blk,blk).Width();
+        res_rowoffsets[blk + 1] = res_rowoffsets[blk] + AE_e.Size();
 
-    BlockMatrix * res = new BlockMatrix(res_rowoffsets, res_coloffsets);
+    BlockTable * res = new BlockTable(res_rowoffsets, el_to_dofs.ColOffsets());
+    res->owns_blocks = 1;
 
     for (int blk = 0; blk < numblocks; ++blk)
     {
         // a shortcut
-        const SparseMatrix * el_dofs_blk = &(el_to_dofs.GetBlock(blk,blk));
+        const Table * el_dofs_blk = &(el_to_dofs.GetBlock(blk,blk));
 
         SparseMatrix d_td_diag;
         SparseMatrix td_d_diag;
@@ -1618,51 +1662,32 @@ BlockMatrix* LocalProblemSolver::Get_AE_eintdofs(const BlockMatrix &el_to_dofs,
             td_d->GetOffd(td_d_offd, cmap_td_d);
         }
 
-        // creating dofs_to_AE relation table
-        SparseMatrix * tempprod = mfem::Mult(AE_e, *el_dofs_blk);
-        SparseMatrix * dofs_AE = Transpose(*tempprod);
-        delete tempprod;
-
-        int ndofs = dofs_AE->Height();
-
-        int * innerdofs_AE_i = new int [ndofs + 1];
-
-        // computing the number of internal degrees of freedom in all AEs
-        int nnz = 0;
-        for (int dof = 0; dof < ndofs; ++dof)
-        {
-            innerdofs_AE_i[dof]= nnz;
-
-            bool dof_is_shared = false;
-
-            if (num_procs > 1)
+        // for each dof, the number of AEs containing it and the first of them
+        // (the AE_dofs relation is read column by column instead of being
+        // transposed)
+        const int nAE = AE_e.Size();
+        const int ndofs = el_to_dofs.ColOffsets()[blk + 1] - el_to_dofs.ColOffsets()[blk];
+        Table * AE_dofs = mfem::Mult(AE_e, *el_dofs_blk);
+        const int * AE_dofs_i = AE_dofs->GetI();
+        const int * AE_dofs_j = AE_dofs->GetJ();
+
+        Array<int> dof_nAEs(ndofs);
+        Array<int> dof_AE(ndofs);
+        dof_nAEs = 0;
+        dof_AE = -1;
+        for (int AE = 0; AE < nAE; ++AE)
+            for (int j = AE_dofs_i[AE]; j < AE_dofs_i[AE + 1]; ++j)
             {
-                bool own_tdof = (d_td_diag.RowSize(dof) > 0);
-                if (own_tdof) // then it is either a local tdof or a boundary tdof (~ shared dof)
-                {
-                    int tdof = d_td_diag.GetRowColumns(dof)[0];
-                    dof_is_shared = (td_d_offd.RowSize(tdof) > 0);
-                }
-                else
-                    dof_is_shared = true;
+                const int dof = AE_dofs_j[j];
+                if (dof_nAEs[dof]++ == 0)
+                    dof_AE[dof] = AE;
             }
+        delete AE_dofs;
 
-            bool dof_on_bdr = ((*dof_is_bdr[blk])[dof]!= 0 );
-            bool dof_on_nonessbdr = ( (*dof_is_essbdr[blk])[dof] == 0 && dof_on_bdr);
-
-            if (( (dofs_AE->RowSize(dof) == 1 && !dof_on_bdr) || dof_on_nonessbdr) && (!dof_is_shared) )
-            {
-                nnz++;
-            }
-
-        }
-        innerdofs_AE_i[ndofs] = nnz;
-
-        // allocating j and data arrays for the created relation table
-        int * innerdofs_AE_j = new int[nnz];
-        double * innerdofs_AE_data = new double[nnz];
-
-        int nnz_count = 0;
+        // finding the AE for each internal fine-grid dof (w.r.t to AE),
+        // -1 for non-internal dofs
+        Array<int> innerdof_AE(ndofs);
+        innerdof_AE = -1;
         for (int dof = 0; dof < ndofs; ++dof)
         {
             bool dof_is_shared = false;
@@ -1682,25 +1707,27 @@ BlockMatrix* LocalProblemSolver::Get_AE_eintdofs(const BlockMatrix &el_to_dofs,
             bool dof_on_bdr = ((*dof_is_bdr[blk])[dof]!= 0 );
             bool dof_on_nonessbdr = ( (*dof_is_essbdr[blk])[dof] == 0 && dof_on_bdr);
 
-            if (( (dofs_AE->RowSize(dof) == 1 && !dof_on_bdr) || dof_on_nonessbdr) && (!dof_is_shared) )
-                innerdofs_AE_j[nnz_count++] = dofs_AE->GetRowColumns(dof)[0];
+            if (( (dof_nAEs[dof] == 1 && !dof_on_bdr) || dof_on_nonessbdr) && (!dof_is_shared) )
+                innerdof_AE[dof] = dof_AE[dof];
         }
 
-        std::fill_n(innerdofs_AE_data, nnz, 1);
-
-        // creating a relation between internal fine-grid dofs (w.r.t to AE) and AEs,
-        // keeeping zero rows for non-internal dofs
-        SparseMatrix * innerdofs_AE = new SparseMatrix(innerdofs_AE_i, innerdofs_AE_j, innerdofs_AE_data,
-                                                       dofs_AE->Height(), dofs_AE->Width());
-        delete dofs_AE;
+        // creating the relation between AEs and internal fine-grid dofs
+        Table * AE_innerdofs = new Table;
+        AE_innerdofs->MakeI(nAE);
+        for (int dof = 0; dof < ndofs; ++dof)
+            if (innerdof_AE[dof] >= 0)
+                AE_innerdofs->AddAColumnInRow(innerdof_AE[dof]);
+        AE_innerdofs->MakeJ();
+        for (int dof = 0; dof < ndofs; ++dof)
+            if (innerdof_AE[dof] >= 0)
+                AE_innerdofs->AddConnection(innerdof_AE[dof], dof);
+        AE_innerdofs->ShiftUpI();
 
-        res->SetBlock(blk, blk, Transpose(*innerdofs_AE));
+        res->SetBlock(blk, blk, AE_innerdofs);
 
         if (num_procs > 1)
             delete td_d;
 
-        delete innerdofs_AE;
-
     } // end of the loop over blocks
 
     return res;
@@ -1717,7 +1744,7 @@ void LocalProblemSolverWithS::SaveLocalLUFactors() const
 
     Array2D<const SparseMatrix *> Op_blks(numblocks, numblocks);
     Array2D<DenseMatrix*> LocalAE_Matrices(numblocks, numblocks);
-    std::vector<SparseMatrix*> AE_eintdofs_blks(numblocks);
+    std::vector<Table*> AE_eintdofs_blks(numblocks);
     std::vector<Array<int>*> Local_inds(numblocks);
 
     for ( int blk = 0; blk < numblocks; ++blk )
@@ -1728,7 +1755,7 @@ void LocalProblemSolverWithS::SaveLocalLUFactors() const
     }
 
     // loop over all AE, solving a local problem in each AE
-    int nAE = AE_edofs_L2->Height();
+    int nAE = AE_edofs_L2->Size();
     LUfactors.resize(nAE);
 
     for( int AE = 0; AE < nAE; ++AE)
@@ -1751,7 +1778,7 @@ void LocalProblemSolverWithS::SaveLocalLUFactors() const
                 // no memory allocation here, it's just a viewer which is created. no valgrind suggests allocation here
                 //Local_inds[blk] = new Array<int>(AE_eintdofs_blks[blk]->GetRowColumns(AE),
                                                  //AE_eintdofs_blks[blk]->RowSize(AE));
-                Local_inds[blk]->MakeRef(AE_eintdofs_blks[blk]->GetRowColumns(AE),
+                Local_inds[blk]->MakeRef(AE_eintdofs_blks[blk]->GetRow(AE),
                                                  AE_eintdofs_blks[blk]->RowSize(AE));
 
                 if (blk == 0) // degeneracy comes from Constraint matrix which involves only sigma = the first block
@@ -1787,7 +1814,7 @@ void LocalProblemSolverWithS::SaveLocalLUFactors() const
                 {
                     if (blk1 == 0 && blk2 == 0) // handling L2 block (constraint)
                     {
-                        Array<int> Wtmp_j(AE_edofs_L2->GetRowColumns(AE), AE_edofs_L2->RowSize(AE));
+                        Array<int> Wtmp_j(AE_edofs_L2->GetRow(AE), AE_edofs_L2->RowSize(AE));
                         if (compute_AEproblem_matrices(numblocks, numblocks))
                         {
                             //Wtmp_j.Print();
@@ -2143,22 +2170,18 @@ void LocalProblemSolverWithS::SolveLocalProblemOpt(DenseMatrixInverse * inv_AorA
                                                    DenseMatrix& B, DenseMatrix& D, BlockVector &G,
                                                    Vector& F, BlockVector &sol, bool is_degenerate) const
 {
-    Vector lambda(B.Height());
+    ArenaScope scope(arena);
+
+    Vector lambda(scope.Alloc<double>(B.Height()), B.Height());
 
     if (G.GetBlock(1).Size() == 0) // this means no internal dofs for S in the current AE
     {
         // invAG = invA * G
-        Vector invAG;
+        Vector invAG(scope.Alloc<double>(G.Size()), G.Size());
         inv_AorAtilda->Mult(G, invAG);
 
-        DenseMatrix BT(B.Width(), B.Height());
-        BT.Transpose(B);
-
-        DenseMatrix invABT;
-        inv_AorAtilda->Mult(BT, invABT);
-
         // temp = ( B * invA * G - F )
-        Vector temp(B.Height());
+        Vector temp(scope.Alloc<double>(B.Height()), B.Height());
         B.Mult(invAG, temp);
         temp -= F;
 
@@ -2169,7 +2192,7 @@ void LocalProblemSolverWithS::SolveLocalProblemOpt(DenseMatrixInverse * inv_AorA
         inv_Schur->Mult(temp, lambda);
 
         // temp2 = (G - BT * lambda)
-        Vector temp2(B.Width());
+        Vector temp2(scope.Alloc<double>(B.Width()), B.Width());
         B.MultTranspose(lambda,temp2);
         temp2 *= -1;
         temp2 += G;
@@ -2197,23 +2220,23 @@ void LocalProblemSolverWithS::SolveLocalProblemOpt(DenseMatrixInverse * inv_AorA
 
 
         // creating DT * invC * F_S
-        Vector invCF2;
+        Vector invCF2(scope.Alloc<double>(G.GetBlock(1).Size()), G.GetBlock(1).Size());
         inv_C->Mult(G.GetBlock(1), invCF2);
 
-        Vector DTinvCF2(D.Width());
+        Vector DTinvCF2(scope.Alloc<double>(D.Width()), D.Width());
         D.MultTranspose(invCF2, DTinvCF2);
 
         // creating F1tilda = F_sigma - DT * invC * F_S
-        Vector F1tilda(D.Width());
+        Vector F1tilda(scope.Alloc<double>(D.Width()), D.Width());
         F1tilda = G.GetBlock(0);
         F1tilda -= DTinvCF2;
 
         // creating invAtildaFtilda = inv(Atilda) * Ftilda =
         // = inv(A - D * inv_C * DT) * (F_sigma - DT * invC * F_S)
-        Vector invAtildaFtilda(G.GetBlock(0).Size());
+        Vector invAtildaFtilda(scope.Alloc<double>(G.GetBlock(0).Size()), G.GetBlock(0).Size());
         inv_AorAtilda->Mult(F1tilda, invAtildaFtilda);
 
-        Vector FinalFlam(B.Height());
+        Vector FinalFlam(scope.Alloc<double>(B.Height()), B.Height());
         B.Mult(invAtildaFtilda, FinalFlam);
         FinalFlam -= F;
 
@@ -2225,7 +2248,7 @@ void LocalProblemSolverWithS::SolveLocalProblemOpt(DenseMatrixInverse * inv_AorA
 
         // changing Ftilda so that Ftilda_new = Ftilda_old - BT * lambda
         // = F_sigma - DT * invC * F_S - BT * lambda
-        Vector temp(B.Width());
+        Vector temp(scope.Alloc<double>(B.Width()), B.Width());
         B.MultTranspose(lambda, temp);
         F1tilda -= temp;
 
@@ -2234,7 +2257,7 @@ void LocalProblemSolverWithS::SolveLocalProblemOpt(DenseMatrixInverse * inv_AorA
         inv_AorAtilda->Mult(F1tilda, sol.GetBlock(0));
 
         // temp2 = F_S - D * sigma
-        Vector temp2(D.Height());
+        Vector temp2(scope.Alloc<double>(D.Height()), D.Height());
         D.Mult(sol.GetBlock(0), temp2);
         temp2 *= -1.0;
         temp2 += G.GetBlock(1);
@@ -2258,6 +2281,9 @@ DivConstraintSolver::~DivConstraintSolver()
         for (int i = 0; i < AE_e.Size(); ++i)
             delete AE_e[i];
 
+    for (int i = 0; i < PtWP_diag_lvls.Size(); ++i)
+        delete PtWP_diag_lvls[i];
+
     if (own_data)
     {
         for (unsigned int i = 0; i < el2dofs_row_offsets.size(); ++i)
@@ -2303,6 +2329,50 @@ DivConstraintSolver::~DivConstraintSolver()
     }
 }
 
+long DivConstraintSolver::MemoryUsage() const
+{
+    long mem = VectorsMemoryUsage(truetempvec_lvls) + VectorsMemoryUsage(truetempvec2_lvls) +
+            VectorsMemoryUsage(trueresfunc_lvls) + VectorsMemoryUsage(truesolupdate_lvls);
+
+    if (own_data || built_on_mgtools)
+        for (int i = 0; i < AE_e.Size(); ++i)
+            if (AE_e[i])
+                mem += AE_e[i]->MemoryUsage();
+
+    for (int i = 0; i < PtWP_diag_lvls.Size(); ++i)
+        if (PtWP_diag_lvls[i])
+            mem += PtWP_diag_lvls[i]->MemoryUsage();
+    mem += arena.MemoryUsage();
+
+    if (own_data)
+    {
+        for (int i = 0; i < BlockOps_lvls.Size(); ++i)
+            if (BlockOps_lvls[i])
+                mem += BlockOperatorMemoryUsage(*BlockOps_lvls[i]);
+        for (int i = 0; i < Funct_mat_lvls.Size(); ++i)
+            if (Funct_mat_lvls[i])
+                mem += Funct_mat_lvls[i]->MemoryUsage();
+        for (int i = 0; i < Mass_mat_lvls.Size(); ++i)
+            if (Mass_mat_lvls[i])
+                mem += Mass_mat_lvls[i]->MemoryUsage();
+        for (int i = 0; i < Constraint_mat_lvls.Size(); ++i)
+            if (Constraint_mat_lvls[i])
+                mem += Constraint_mat_lvls[i]->MemoryUsage();
+        for (int i = 0; i < el2dofs_funct_lvls.Size(); ++i)
+            if (el2dofs_funct_lvls[i])
+                mem += el2dofs_funct_lvls[i]->MemoryUsage();
+
+        for (int i = 0; i < Smoothers_lvls.Size(); ++i)
+            if (HcurlGSSSmoother * hcurl_smoother = dynamic_cast<HcurlGSSSmoother*>(Smoothers_lvls[i]))
+                mem += hcurl_smoother->MemoryUsage();
+        for (int i = 0; i < LocalSolvers_lvls.Size(); ++i)
+            if (LocalSolvers_lvls[i])
+                mem += LocalSolvers_lvls[i]->MemoryUsage();
+    }
+
+    return mem;
+}
+
 DivConstraintSolver::DivConstraintSolver(MultigridToolsHierarchy& mgtools_hierarchy_,
                     bool optimized_localsolvers_, bool with_hcurl_smoothers_, bool verbose_)
     : problem(mgtools_hierarchy_.GetProblem()),
@@ -2323,6 +2393,8 @@ DivConstraintSolver::DivConstraintSolver(MultigridToolsHierarchy& mgtools_hierar
                 mgtools_hierarchy->With_Schwarz() && mgtools_hierarchy->With_Hcurl(),
                 "MultigridToolsHierarchy instance must have these components in order to be"
                 " used for constructing DivConstraintSolver");
+    MFEM_VERIFY(mgtools_hierarchy->With_Nested_AE(),
+                "DivConstraintSolver requires agglomerates which are unions of coarse elements");
 
     P_L2.SetSize(num_levels - 1);
     AE_e.SetSize(num_levels - 1);
@@ -2390,7 +2462,7 @@ DivConstraintSolver::DivConstraintSolver(MultigridToolsHierarchy& mgtools_hierar
     for (int l = 0; l < num_levels - 1; ++l)
     {
         P_L2[l] = hierarchy->GetPspace(SpaceName::L2, l);
-        AE_e[l] = Transpose(*P_L2[l]);
+        AE_e[l] = TransposedPattern(*P_L2[l]);
 
         LocalSolvers_lvls[l] = mgtools_hierarchy->GetSchwarzSmoothers()[l];
 
@@ -2518,7 +2590,7 @@ DivConstraintSolver::DivConstraintSolver(FOSLSProblem& problem_, GeneralHierarch
                 hierarchy->GetEssBdrTdofsOrDofs("tdof", SpaceName::HCURL, essbdr_attribs_Hcurl, l);
 
         P_L2[l] = hierarchy->GetPspace(SpaceName::L2, l);
-        AE_e[l] = Transpose(*P_L2[l]);
+        AE_e[l] = TransposedPattern(*P_L2[l]);
 
         offsets_funct[l + 1] = hierarchy->ConstructTrueOffsetsforFormul(l + 1, *space_names_funct);
         TrueP_Func[l] = hierarchy->ConstructTruePforFormul(l, *space_names_funct,
@@ -2675,7 +2747,7 @@ DivConstraintSolver::DivConstraintSolver(FOSLSProblem& problem_, GeneralHierarch
 
 
 DivConstraintSolver::DivConstraintSolver(MPI_Comm Comm, int NumLevels,
-                       Array< SparseMatrix*> &AE_to_e,
+                       Array< Table*> &AE_to_e,
                        Array< BlockOperator*>& TrueProj_Func,
                        Array< SparseMatrix*> &Proj_L2,
                        Array<SparseMatrix *> &Mass_mat_lvls_,
@@ -2786,6 +2858,11 @@ void DivConstraintSolver::Update(bool recoarsen)
         MFEM_ASSERT(update_counter == hierarchy_upd_cnt - 1,
                     "Current implementation allows the update counters to differ no more than by one");
 
+        // levels are shifted and the mass matrices may change
+        for (int i = 0; i < PtWP_diag_lvls.Size(); ++i)
+            delete PtWP_diag_lvls[i];
+        PtWP_diag_lvls.SetSize(0);
+
         const Array<SpaceName>* space_names_funct =
                 problem->GetFEformulation().GetFormulation()->GetFunctSpacesDescriptor();
         int numblocks_funct = space_names_funct->Size();
@@ -2800,7 +2877,7 @@ void DivConstraintSolver::Update(bool recoarsen)
         SparseMatrix * P_L2_new = hierarchy->GetPspace(SpaceName::L2, 0);
         P_L2.Prepend(P_L2_new);
 
-        SparseMatrix * AE_e_new = Transpose(*P_L2[0]);
+        Table * AE_e_new = TransposedPattern(*P_L2[0]);
         AE_e.Prepend(AE_e_new);
 
         const Array<int> * offsets_funct_new =
@@ -2889,7 +2966,7 @@ void DivConstraintSolver::Update(bool recoarsen)
         Array<int>* el2dofs_row_offsets_new = new Array<int>();
         Array<int>* el2dofs_col_offsets_new = new Array<int>();
 
-        BlockMatrix * el2dofs_funct_lvls_new = hierarchy->GetElementToDofs
+        BlockTable * el2dofs_funct_lvls_new = hierarchy->GetElementToDofs
                 (*space_names_funct, 0, el2dofs_row_offsets_new, el2dofs_col_offsets_new);
 
         el2dofs_row_offsets.push_front(el2dofs_row_offsets_new);
@@ -3135,11 +3212,14 @@ void DivConstraintSolver::UpdateParticularSolution(int level, HypreParMatrix& Co
                                     " was more than 1 in the constructor");
         offsets = &TrueP_Func[level]->RowOffsets();
     }
-    const BlockVector start_guess_viewer(start_guess.GetData(), *offsets);
-    BlockVector partsol_viewer(partsol.GetData(), *offsets);
+    start_guess_viewer.Update(start_guess.GetData(), *offsets);
+    partsol_viewer.Update(partsol.GetData(), *offsets);
+
+    // temporary vectors are taken from the arena
+    ArenaScope scope(arena);
 
     // checking if the given initial vector satisfies the divergence constraint
-    Vector rhs_constr(Constr_lvl.Height());
+    Vector rhs_constr(scope.Alloc<double>(Constr_lvl.Height()), Constr_lvl.Height());
     Constr_lvl.Mult(start_guess_viewer.GetBlock(0), rhs_constr);
     rhs_constr -= constrRhs;
     rhs_constr *= -1.0;
@@ -3161,9 +3241,9 @@ void DivConstraintSolver::UpdateParticularSolution(int level, HypreParMatrix& Co
     }
 
     // variable-size vectors (initialized with the finest level sizes) on dofs
-    Vector Qlminus1_f(rhs_constr.Size());     // stores P_l^T rhs_constr_l
-    Vector PtQlminus1_f(rhs_constr.Size());
-    Vector finer_buff(rhs_constr.Size());
+    Vector Qlminus1_f(scope.Alloc<double>(rhs_constr.Size()), rhs_constr.Size()); // stores P_l^T rhs_constr_l
+    Vector PtQlminus1_f(scope.Alloc<double>(rhs_constr.Size()), rhs_constr.Size());
+    Vector finer_buff(scope.Alloc<double>(rhs_constr.Size()), rhs_constr.Size());
 
     // 0. Compute rhs in the functional for the finest level
     UpdateTrueResidual(level, NULL, start_guess_viewer, *trueresfunc_lvls[level] );
@@ -3253,11 +3333,14 @@ void DivConstraintSolver::FindParticularSolution(int start_level, HypreParMatrix
                                     " was more than 1 in the constructor");
         offsets = &TrueP_Func[start_level]->RowOffsets();
     }
-    const BlockVector start_guess_viewer(start_guess.GetData(), *offsets);
-    BlockVector partsol_viewer(partsol.GetData(), *offsets);
+    start_guess_viewer.Update(start_guess.GetData(), *offsets);
+    partsol_viewer.Update(partsol.GetData(), *offsets);
+
+    // temporary vectors are taken from the arena
+    ArenaScope scope(arena);
 
     // checking if the given initial vector satisfies the divergence constraint
-    Vector rhs_constr(Constr_start_lvl.Height());
+    Vector rhs_constr(scope.Alloc<double>(Constr_start_lvl.Height()), Constr_start_lvl.Height());
     Constr_start_lvl.Mult(start_guess_viewer.GetBlock(0), rhs_constr);
     rhs_constr -= constrRhs;
     rhs_constr *= -1.0;
@@ -3279,9 +3362,9 @@ void DivConstraintSolver::FindParticularSolution(int start_level, HypreParMatrix
     }
 
     // variable-size vectors (initialized with the finest level sizes) on dofs
-    Vector Qlminus1_f(rhs_constr.Size());     // stores P_l^T rhs_constr_l
-    Vector PtQlminus1_f(rhs_constr.Size());
-    Vector finer_buff(rhs_constr.Size());
+    Vector Qlminus1_f(scope.Alloc<double>(rhs_constr.Size()), rhs_constr.Size()); // stores P_l^T rhs_constr_l
+    Vector PtQlminus1_f(scope.Alloc<double>(rhs_constr.Size()), rhs_constr.Size());
+    Vector finer_buff(scope.Alloc<double>(rhs_constr.Size()), rhs_constr.Size());
 
     // 0. Compute rhs in the functional for the finest level
     UpdateTrueResidual(start_level, Functrhs_global, start_guess_viewer, *trueresfunc_lvls[start_level] );
@@ -3429,10 +3512,22 @@ void DivConstraintSolver::NewProjectFinerL2ToCoarser(int l, const Vector& in,
         std::cout << "Mass matrix is absent \n";
     MFEM_ASSERT(Mass_mat_lvls[l], "The modified projector requires mass matrix to be defined at this level");
 
-    SparseMatrix * temp = mfem::RAP(*P_L2[l], *Mass_mat_lvls[l], *P_L2[l]);
-    Vector diag;
-    temp->GetDiag(diag);
-    delete temp;
+    // the diagonal of P_l^T W P_l depends only on the level, so it is computed once
+    if (l >= PtWP_diag_lvls.Size())
+    {
+        int old_size = PtWP_diag_lvls.Size();
+        PtWP_diag_lvls.SetSize(l + 1);
+        for (int i = old_size; i <= l; ++i)
+            PtWP_diag_lvls[i] = NULL;
+    }
+    if (!PtWP_diag_lvls[l])
+    {
+        SparseMatrix * temp = mfem::RAP(*P_L2[l], *Mass_mat_lvls[l], *P_L2[l]);
+        PtWP_diag_lvls[l] = new Vector;
+        temp->GetDiag(*PtWP_diag_lvls[l]);
+        delete temp;
+    }
+    const Vector& diag = *PtWP_diag_lvls[l];
 
     // temporarily using out as a coarse level buffer
     // although in the end it will be a fine level vector
@@ -3503,16 +3598,29 @@ void DivConstraintSolver::ComputeLocalRhsConstr(int l, Vector& finer_proj,
     return;
 }
 
-#ifdef TIMING
-void HcurlGSSSmoother::ResetInternalTimings() const
+long HcurlGSSSmoother::MemoryUsage() const
 {
-    time_beforeintmult = 0.0;
-    time_intmult = 0.0;
-    time_afterintmult = 0.0;
-    time_globalmult = 0.0;
-}
+    long mem = 0;
+    for (int blk1 = 0; blk1 < numblocks; ++blk1)
+        for (int blk2 = 0; blk2 < numblocks; ++blk2)
+            if (HcurlFunct_global(blk1,blk2))
+                mem += HcurlFunct_global(blk1,blk2)->MemoryUsage();
+
+    if (truerhs)
+        mem += truerhs->MemoryUsage();
+    if (truex)
+        mem += truex->MemoryUsage();
+
+#ifndef BLKDIAG_SMOOTHER
+    if (tmp1)
+        mem += tmp1->MemoryUsage();
+    if (numblocks > 1)
+        mem += tmp2->MemoryUsage();
 #endif
 
+    return mem;
+}
+
 HcurlGSSSmoother::~HcurlGSSSmoother()
 {
     delete xblock;
@@ -3756,11 +3864,7 @@ HcurlGSSSmoother::HcurlGSSSmoother (Array2D<HypreParMatrix*> & Funct_HpMat,
 #ifndef BLKDIAG_SMOOTHER
 void HcurlGSSSmoother::MultTranspose(const Vector & x, Vector & y) const
 {
-#ifdef TIMING
-    MPI_Barrier(comm);
-    chrono2.Clear();
-    chrono2.Start();
-#endif
+    ProfileScope scope("HcurlGSSSmoother");
 
     if (print_level)
         std::cout << "Smoothing with HcurlGSS smoother \n";
@@ -3768,12 +3872,7 @@ void HcurlGSSSmoother::MultTranspose(const Vector & x, Vector & y) const
     xblock->Update(x.GetData(), block_offsets);
     yblock->Update(y.GetData(), block_offsets);
 
-#ifdef TIMING
-    MPI_Barrier(comm);
-    chrono.Clear();
-    chrono.Start();
-#endif
-
+    profiler.Start("transfer to Hcurl");
     for ( int blk = 0; blk < numblocks; ++blk)
     {
         const Array<int> *temp;
@@ -3830,16 +3929,9 @@ void HcurlGSSSmoother::MultTranspose(const Vector & x, Vector & y) const
     }
 
     *truex = 0.0;
+    profiler.Stop();
 
-#ifdef TIMING
-    MPI_Barrier(comm);
-    chrono.Stop();
-    time_beforeintmult += chrono.RealTime();
-    MPI_Barrier(comm);
-    chrono.Clear();
-    chrono.Start();
-#endif
-
+    profiler.Start("Hcurl smoothing");
     if (numblocks == 1)
     {
         Smoothers[0]->Mult(truerhs->GetBlock(0), truex->GetBlock(0));
@@ -3851,16 +3943,9 @@ void HcurlGSSSmoother::MultTranspose(const Vector & x, Vector & y) const
         HcurlFunct_global(0,1)->Mult(-1.0, truex->GetBlock(1), 1.0, *tmp1);
         Smoothers[0]->Mult(*tmp1, truex->GetBlock(0));
     }
+    profiler.Stop();
 
-#ifdef TIMING
-    MPI_Barrier(comm);
-    chrono.Stop();
-    time_intmult += chrono.RealTime();
-    MPI_Barrier(comm);
-    chrono.Clear();
-    chrono.Start();
-#endif
-
+    profiler.Start("transfer to Hdiv");
     for (int blk = 0; blk < numblocks; ++blk)
     {
         if (blk == 0) // in Hcurl
@@ -3903,27 +3988,13 @@ void HcurlGSSSmoother::MultTranspose(const Vector & x, Vector & y) const
             yblock->GetBlock(blk)[(*temp)[tdofind]] = 0.0;
         }
     }
-
-#ifdef TIMING
-    MPI_Barrier(comm);
-    chrono.Stop();
-    time_afterintmult += chrono.RealTime();
-
-    MPI_Barrier(comm);
-    chrono2.Stop();
-    time_globalmult += chrono2.RealTime();
-#endif
-
+    profiler.Stop();
 }
 #endif
 
 void HcurlGSSSmoother::Mult(const Vector & x, Vector & y) const
 {
-#ifdef TIMING
-    MPI_Barrier(comm);
-    chrono2.Clear();
-    chrono2.Start();
-#endif
+    ProfileScope scope("HcurlGSSSmoother");
 
     if (print_level)
         std::cout << "Smoothing with HcurlGSS smoother \n";
@@ -3939,12 +4010,6 @@ void HcurlGSSSmoother::Mult(const Vector & x, Vector & y) const
     //xblock = new BlockVector(x.GetData(), block_offsets);
     //yblock = new BlockVector(y.GetData(), block_offsets);
 
-#ifdef TIMING
-    MPI_Barrier(comm);
-    chrono.Clear();
-    chrono.Start();
-#endif
-
     /*
 #ifdef COMPARE_MG
     for ( int blk = 0; blk < numblocks; ++blk)
@@ -3987,6 +4052,7 @@ void HcurlGSSSmoother::Mult(const Vector & x, Vector & y) const
 #endif
     */
 
+    profiler.Start("transfer to Hcurl");
     for ( int blk = 0; blk < numblocks; ++blk)
     {
         const Array<int> *temp;
@@ -4070,20 +4136,13 @@ void HcurlGSSSmoother::Mult(const Vector & x, Vector & y) const
     }
 
     *truex = 0.0;
-
-#ifdef TIMING
-    MPI_Barrier(comm);
-    chrono.Stop();
-    time_beforeintmult += chrono.RealTime();
-    MPI_Barrier(comm);
-    chrono.Clear();
-    chrono.Start();
-#endif
+    profiler.Stop();
 
     //truerhs->GetBlock(0).Print();
     //std::cout << "input to Smoothers mult \n";
     //truerhs->Print();
 
+    profiler.Start("Hcurl smoothing");
 #ifdef BLKDIAG_SMOOTHER
     for ( int blk = 0; blk < numblocks; ++blk)
         Smoothers[blk]->Mult(truerhs->GetBlock(blk), truex->GetBlock(blk));
@@ -4100,19 +4159,12 @@ void HcurlGSSSmoother::Mult(const Vector & x, Vector & y) const
         Smoothers[1]->Mult(*tmp2, truex->GetBlock(1));
     }
 #endif // for #else to #ifdef BLKDIAG
+    profiler.Stop();
 
     //std::cout << "output to Smoothers mult \n";
     //truex->Print();
 
-#ifdef TIMING
-    MPI_Barrier(comm);
-    chrono.Stop();
-    time_intmult += chrono.RealTime();
-    MPI_Barrier(comm);
-    chrono.Clear();
-    chrono.Start();
-#endif
-
+    profiler.Start("transfer to Hdiv");
     for (int blk = 0; blk < numblocks; ++blk)
     {
         if (blk == 0) // in Hcurl
@@ -4189,18 +4241,9 @@ void HcurlGSSSmoother::Mult(const Vector & x, Vector & y) const
         }
     }
 
-    //yblock->GetBlock(0).Print();
-
-#ifdef TIMING
-    MPI_Barrier(comm);
-    chrono.Stop();
-    time_afterintmult += chrono.RealTime();
-
-    MPI_Barrier(comm);
-    chrono2.Stop();
-    time_globalmult += chrono2.RealTime();
-#endif
+    profiler.Stop();
 
+    //yblock->GetBlock(0).Print();
 }
 
 void HcurlGSSSmoother::Setup() const
@@ -4360,10 +4403,22 @@ void HcurlGSSSmoother::Setup() const
 
     truex = new BlockVector(trueblock_offsets);
     truerhs = new BlockVector(trueblock_offsets);
+}
 
-#ifdef TIMING
-    ResetInternalTimings();
-#endif
+long GeneralMinConstrSolver::MemoryUsage() const
+{
+    long mem = init_guess ? init_guess->MemoryUsage() : 0;
+
+    mem += VectorsMemoryUsage(truesolupdate_lvls) + VectorsMemoryUsage(truetempvec_lvls) +
+            VectorsMemoryUsage(truetempvec2_lvls) + VectorsMemoryUsage(trueresfunc_lvls) +
+            VectorsMemoryUsage(truetempblock_lvls);
+
+    if (built_on_mgtools)
+        for (unsigned int i = 0; i < essbdrtruedofs_Func.size(); ++i)
+            for (unsigned int j = 0; j < essbdrtruedofs_Func[i].size(); ++j)
+                mem += essbdrtruedofs_Func[i][j]->MemoryUsage();
+
+    return mem;
 }
 
 GeneralMinConstrSolver::~GeneralMinConstrSolver()
@@ -4382,11 +4437,6 @@ GeneralMinConstrSolver::~GeneralMinConstrSolver()
     for (int i = 0; i < truetempblock_lvls.Size(); ++i)
         delete truetempblock_lvls[i];
 
-#ifdef TIMING
-    delete time_localsolve_lvls;
-    delete time_smoother_lvls;
-#endif
-
     if (built_on_mgtools)
     {
         for (unsigned int i = 0; i < essbdrtruedofs_Func.size(); ++i)
@@ -4755,18 +4805,6 @@ GeneralMinConstrSolver::GeneralMinConstrSolver(
                        std::vector<Operator*> & Func_Global_lvls,
                        HypreParMatrix * Constr_Global,
                        Vector * Constr_Rhs_global,
-#ifdef TIMING
-                        std::list<double>* Times_mult,
-                        std::list<double>* Times_solve,
-                        std::list<double>* Times_localsolve,
-                        std::list<double>* Times_localsolve_lvls,
-                        std::list<double>* Times_smoother,
-                        std::list<double>* Times_smoother_lvls,
-                        std::list<double>* Times_coarsestproblem,
-                        std::list<double>* Times_resupdate,
-                        std::list<double>* Times_fw,
-                        std::list<double>* Times_up,
-#endif
                        Array<Operator*>* LocalSolvers,
                        Operator *CoarsestSolver,
                        int StopCriteria_Type)
@@ -4781,18 +4819,6 @@ GeneralMinConstrSolver::GeneralMinConstrSolver(
        numblocks(TrueProj_Func[0]->NumRowBlocks()),
        Constr_global(Constr_Global),
        Constr_rhs_global(Constr_Rhs_global)
-#ifdef TIMING
-       , times_mult(Times_mult),
-       times_solve(Times_solve),
-       times_localsolve(Times_localsolve),
-       times_localsolve_lvls(Times_localsolve_lvls),
-       times_smoother(Times_smoother),
-       times_smoother_lvls(Times_smoother_lvls),
-       times_coarsestproblem(Times_coarsestproblem),
-       times_resupdate(Times_resupdate),
-       times_fw(Times_fw),
-       times_up(Times_up)
-#endif
 {
 
     TrueP_Func.SetSize(TrueProj_Func.Size());
@@ -4865,23 +4891,6 @@ GeneralMinConstrSolver::GeneralMinConstrSolver(
         else
             LocalSolvers_lvls[l] = NULL;
 
-#ifdef TIMING
-    time_mult = 0.0;
-    time_solve = 0.0;
-    time_localsolve = 0.0;
-    time_localsolve_lvls = new double[num_levels - 1];
-    for (int l = 0; l < num_levels - 1; ++l)
-        time_localsolve_lvls[l] = 0.0;
-    time_smoother = 0.0;
-    time_smoother_lvls = new double[num_levels - 1];
-    for (int l = 0; l < num_levels - 1; ++l)
-        time_smoother_lvls[l] = 0.0;
-    time_coarsestproblem = 0.0;
-    time_resupdate = 0.0;
-    time_fw = 0.0;
-    time_up = 0.0;
-#endif
-
     Setup();
 }
 
@@ -4927,24 +4936,7 @@ void GeneralMinConstrSolver::Mult(int start_level, const HypreParMatrix* Constr_
 {
     MFEM_ASSERT(setup_finished, "Solver setup must have been called before Mult() \n");
 
-#ifdef TIMING
-    time_mult = 0.0;
-    time_solve = 0.0;
-    time_localsolve = 0.0;
-    for (int l = 0; l < num_levels - 1; ++l)
-        time_localsolve_lvls[l] = 0.0;
-    time_smoother = 0.0;
-    for (int l = 0; l < num_levels - 1; ++l)
-        time_smoother_lvls[l] = 0.0;
-    time_coarsestproblem = 0.0;
-    time_resupdate = 0.0;
-    time_fw = 0.0;
-    time_up = 0.0;
-
-    MPI_Barrier(comm);
-    chrono4.Clear();
-    chrono4.Start();
-#endif
+    ProfileScope scope("GeneralMinConstrSolver");
 
     // start iteration
     current_iteration = 0;
@@ -4962,8 +4954,8 @@ void GeneralMinConstrSolver::Mult(int start_level, const HypreParMatrix* Constr_
 
 
     // x and y will be accessed through these viewers as BlockVectors
-    const BlockVector x_viewer(x.GetData(), *offsets);
-    BlockVector y_viewer(y.GetData(), *offsets);
+    xblock.Update(x.GetData(), *offsets);
+    yblock.Update(y.GetData(), *offsets);
 
     if (preconditioner_mode)
         *init_guess = 0.0;
@@ -5029,33 +5021,22 @@ void GeneralMinConstrSolver::Mult(int start_level, const HypreParMatrix* Constr_
                 MFEM_ASSERT(CheckConstrRes(tempblock_truedofs->GetBlock(0), *Constr_start_lvl, NULL,
                                        "before the iteration"),"");
 
-#ifdef TIMING
-        MPI_Barrier(comm);
-        chrono3.Clear();
-        chrono3.Start();
-#endif
-
         //std::cout << "righthand side on the entrance to Solve() \n";
         //xblock_truedofs->Print();
 
-        Solve(start_level, Constr_start_lvl, x_viewer, *tempblock_truedofs, y_viewer);
-
-#ifdef TIMING
-        MPI_Barrier(comm);
-        chrono3.Stop();
-        time_solve  += chrono3.RealTime();
-#endif
+        Solve(start_level, Constr_start_lvl, xblock, *tempblock_truedofs, yblock);
+        profiler.Count("iterations");
 
         if (!preconditioner_mode)
         {
             if (Constr_start_lvl)
-                MFEM_ASSERT(CheckConstrRes(y_viewer.GetBlock(0), *Constr_start_lvl, Constr_rhs_global,
+                MFEM_ASSERT(CheckConstrRes(yblock.GetBlock(0), *Constr_start_lvl, Constr_rhs_global,
                                       "after the iteration"),"");
         }
         else
         {
             if (Constr_start_lvl)
-                MFEM_ASSERT(CheckConstrRes(y_viewer.GetBlock(0), *Constr_start_lvl, NULL,
+                MFEM_ASSERT(CheckConstrRes(yblock.GetBlock(0), *Constr_start_lvl, NULL,
                                        "after the iteration"),"");
         }
 
@@ -5131,7 +5112,7 @@ void GeneralMinConstrSolver::Mult(int start_level, const HypreParMatrix* Constr_
 
             // resetting the input and output vectors for the next iteration
 
-            *tempblock_truedofs = y_viewer;
+            *tempblock_truedofs = yblock;
         }
 
     } // end of main iterative loop
@@ -5144,28 +5125,6 @@ void GeneralMinConstrSolver::Mult(int start_level, const HypreParMatrix* Constr_
         else // -1
             std::cout << "Solver didn't converge in " << itnum << " iterations. \n" << std::flush;
     }
-
-#ifdef TIMING
-    MPI_Barrier(comm);
-    chrono4.Stop();
-    time_mult += chrono4.RealTime();
-#endif
-
-#ifdef TIMING
-    times_mult->push_back(time_mult);
-    times_solve->push_back(time_solve);
-    times_localsolve->push_back(time_localsolve);
-    for (int l = 0; l < num_levels - 1; ++l)
-        times_localsolve_lvls[l].push_back(time_localsolve_lvls[l]);
-    times_smoother->push_back(time_smoother);
-    for (int l = 0; l < num_levels - 1; ++l)
-        times_smoother_lvls[l].push_back(time_smoother_lvls[l]);
-    times_coarsestproblem->push_back(time_coarsestproblem);
-    times_resupdate->push_back(time_resupdate);
-    times_fw->push_back(time_fw);
-    times_up->push_back(time_up);
-#endif
-
 }
 
 void GeneralMinConstrSolver::MultTrueFunc(int l, const Operator *Funct_l, double coeff,
@@ -5197,11 +5156,7 @@ void GeneralMinConstrSolver::Solve(int start_level, const HypreParMatrix *Constr
                                    const BlockVector& righthand_side,
                                    const BlockVector& previous_sol, BlockVector& next_sol) const
 {
-#ifdef TIMING
-    MPI_Barrier(comm);
-    chrono2.Clear();
-    chrono2.Start();
-#endif
+    ProfileScope scope("V-cycle");
 
     if (print_level)
         std::cout << "Starting iteration " << current_iteration << " ... \n";
@@ -5245,12 +5200,9 @@ void GeneralMinConstrSolver::Solve(int start_level, const HypreParMatrix *Constr
                              "at the beginning of Solve: ", print_level);
         */
 
-#ifdef TIMING
-    MPI_Barrier(comm);
-    chrono.Clear();
-    chrono.Start();
-#endif
+    profiler.Start("residual update");
     UpdateTrueResidual(start_level, &righthand_side, previous_sol, *trueresfunc_lvls[start_level] );
+    profiler.Stop();
 
     /*
     if (verbose)
@@ -5261,25 +5213,11 @@ void GeneralMinConstrSolver::Solve(int start_level, const HypreParMatrix *Constr
     }
     */
 
-#ifdef TIMING
-    MPI_Barrier(comm);
-    chrono.Stop();
-    time_resupdate += chrono.RealTime();
-    MPI_Barrier(comm);
-    chrono.Clear();
-    chrono.Start();
-#endif
-
     // DOWNWARD loop: from finest to coarsest
     // 1. loop over levels finer than the coarsest
     for (int l = start_level; l < num_levels - 1; ++l)
     {
-
-#ifdef TIMING
-        MPI_Barrier(comm);
-        chrono.Clear();
-        chrono.Start();
-#endif
+        profiler.Start("level", l);
 
         //std::cout << "residual before smoothing, old GenMinConstr, "
                      //"norm = " << trueresfunc_lvls[l]->Norml2() / sqrt (trueresfunc_lvls[l]->Size()) << "\n";
@@ -5289,7 +5227,9 @@ void GeneralMinConstrSolver::Solve(int start_level, const HypreParMatrix *Constr
 
         if (LocalSolvers_lvls[l])
         {
+            profiler.Start("local solves");
             LocalSolvers_lvls[l]->Mult(*trueresfunc_lvls[l], *truetempvec_lvls[l]);
+            profiler.Stop();
 
             //std::cout << "LocalSmoother * r, x, norm = " <<
                             // truetempvec_lvls[l]->Norml2() / sqrt(truetempvec_lvls[l]->Size()) << "\n";
@@ -5297,30 +5237,13 @@ void GeneralMinConstrSolver::Solve(int start_level, const HypreParMatrix *Constr
             *truesolupdate_lvls[l] += *truetempvec_lvls[l];
         }
 
-#ifdef TIMING
-        MPI_Barrier(comm);
-        chrono.Stop();
-        time_localsolve_lvls[l] += chrono.RealTime();
-        time_localsolve += chrono.RealTime();
-        MPI_Barrier(comm);
-        chrono.Clear();
-        chrono.Start();
-#endif
-
+        profiler.Start("residual update");
         UpdateTrueResidual(l, trueresfunc_lvls[l], *truesolupdate_lvls[l], *truetempvec_lvls[l] );
+        profiler.Stop();
 
         //std::cout << "residual after LocalSmoother, r - A Smoo1 * r, norm = "
                          //<< truetempvec_lvls[l]->Norml2() / sqrt(truetempvec_lvls[l]->Size()) << "\n";
 
-#ifdef TIMING
-        MPI_Barrier(comm);
-        chrono.Stop();
-        time_resupdate += chrono.RealTime();
-        MPI_Barrier(comm);
-        chrono.Clear();
-        chrono.Start();
-#endif
-
         // smooth
         if (Smoothers_lvls[l])
         {
@@ -5333,7 +5256,9 @@ void GeneralMinConstrSolver::Solve(int start_level, const HypreParMatrix *Constr
             //std::cout << "input to smoother inside new mg \n";
             //truetempvec_lvls[l]->Print();
 
+            profiler.Start("smoother");
             Smoothers_lvls[l]->Mult(*truetempvec_lvls[l], *truetempvec2_lvls[l] );
+            profiler.Stop();
 
             //std::cout << "HcurlSmoother * updated residual, Smoo2 * (r - A Smoo1 * r), norm = "
                             //<< truetempvec2_lvls[l]->Norml2() / sqrt(truetempvec2_lvls[l]->Size()) << "\n";
@@ -5348,37 +5273,18 @@ void GeneralMinConstrSolver::Solve(int start_level, const HypreParMatrix *Constr
 
 #endif
 
-#ifdef TIMING
-            MPI_Barrier(comm);
-            chrono.Stop();
-            time_smoother_lvls[l] += chrono.RealTime();
-            time_smoother += chrono.RealTime();
-#endif
             *truesolupdate_lvls[l] += *truetempvec2_lvls[l];
-#ifdef TIMING
-            MPI_Barrier(comm);
-            chrono.Clear();
-            chrono.Start();
-#endif
 
             //std::cout << "residual again before smoothing, old GenMinConstr, "
                          //"norm = " << trueresfunc_lvls[l]->Norml2() /
                          // sqrt (trueresfunc_lvls[l]->Size()) << "\n";
 
+            profiler.Start("residual update");
             UpdateTrueResidual(l, trueresfunc_lvls[l], *truesolupdate_lvls[l], *truetempvec_lvls[l] );
+            profiler.Stop();
 
             //std::cout << "new residual inside new mg \n";
             //truetempvec_lvls[l]->Print();
-
-#ifdef TIMING
-            MPI_Barrier(comm);
-            chrono.Stop();
-            time_resupdate += chrono.RealTime();
-            MPI_Barrier(comm);
-            chrono.Clear();
-            chrono.Start();
-#endif
-
         }
 
         //std::cout << "correction after smoothing, old GenMinConstr, "
@@ -5391,6 +5297,7 @@ void GeneralMinConstrSolver::Solve(int start_level, const HypreParMatrix *Constr
                      //"norm = " << trueresfunc_lvls[l]->Norml2() / sqrt (trueresfunc_lvls[l]->Size()) << "\n";
 
 
+        profiler.Start("restriction");
         TrueP_Func[l]->MultTranspose(*trueresfunc_lvls[l], *trueresfunc_lvls[l + 1]);
 
         // manually setting the boundary conditions (required for S from H1 at least) at the coarser level
@@ -5410,26 +5317,14 @@ void GeneralMinConstrSolver::Solve(int start_level, const HypreParMatrix *Constr
 
             //shift += trueresfunc_lvls[l + 1]->GetBlock(blk).Size();
         }
+        profiler.Stop();
 
         //std::cout << "residual after coarsening, old GenMinConstr, "
                      //"norm = " << trueresfunc_lvls[l + 1]->Norml2() / sqrt (trueresfunc_lvls[l + 1]->Size()) << "\n";
 
-
-
+        profiler.Stop();
     } // end of loop over finer levels
 
-#ifdef TIMING
-    MPI_Barrier(comm);
-    chrono2.Stop();
-    time_fw  += chrono2.RealTime();
-#endif
-
-#ifdef TIMING
-    MPI_Barrier(comm);
-    chrono.Clear();
-    chrono.Start();
-#endif
-
     //std::cout << "residual at the coarsest level, old GenMinConstr, "
                  //"norm = " << trueresfunc_lvls[num_levels - 1]->Norml2() /
                  //sqrt (trueresfunc_lvls[num_levels - 1]->Size()) << "\n";
@@ -5438,59 +5333,37 @@ void GeneralMinConstrSolver::Solve(int start_level, const HypreParMatrix *Constr
     *truesolupdate_lvls[num_levels - 1] = 0.0;
 #else
     // BOTTOM: solve the global problem at the coarsest level
+    profiler.Start("coarse solve");
     CoarseSolver->Mult(*trueresfunc_lvls[num_levels - 1], *truesolupdate_lvls[num_levels - 1]);
+    profiler.Stop();
 #endif
 
     //std::cout << "coarsest grid correction, old GenMinConstr, "
                  //"norm = " << truesolupdate_lvls[num_levels - 1]->Norml2() /
                     //sqrt (truesolupdate_lvls[num_levels - 1]->Size()) << "\n";
 
-#ifdef TIMING
-    MPI_Barrier(comm);
-    chrono.Stop();
-    //std::cout << "before: " << time_coarsestproblem << "\n";
-    time_coarsestproblem += chrono.RealTime();
-    //std::cout << "after: " << time_coarsestproblem << "\n";
-#endif
-
-#ifdef TIMING
-    MPI_Barrier(comm);
-    chrono2.Clear();
-    chrono2.Start();
-#endif
-
     // UPWARD loop: from coarsest to finest
     if (symmetric) // then also smoothing and solving local problems on the way up
     {
         for (int l = num_levels - 1; l > start_level; --l)
         {
+            profiler.Start("level", l - 1);
+
             // interpolate back to the finer level
+            profiler.Start("interpolation");
             TrueP_Func[l - 1]->Mult(*truesolupdate_lvls[l], *truetempvec_lvls[l - 1]);
+            profiler.Stop();
 
             *truesolupdate_lvls[l - 1] += *truetempvec_lvls[l - 1];
 
-#ifdef TIMING
-            MPI_Barrier(comm);
-            chrono.Clear();
-            chrono.Start();
-#endif
+            profiler.Start("residual update");
             UpdateTrueResidual(l - 1, trueresfunc_lvls[l - 1], *truetempvec_lvls[l - 1], *truetempvec2_lvls[l - 1] );
-#ifdef TIMING
-            MPI_Barrier(comm);
-            chrono.Stop();
-            time_resupdate += chrono.RealTime();
-#endif
+            profiler.Stop();
             *trueresfunc_lvls[l - 1] = *truetempvec2_lvls[l - 1];
 
             //std::cout << "residual before post-smoothing, old GenMinConstr, "
                          //"norm = " << trueresfunc_lvls[l - 1]->Norml2() / sqrt (trueresfunc_lvls[l - 1]->Size()) << "\n";
 
-#ifdef TIMING
-            MPI_Barrier(comm);
-            chrono.Clear();
-            chrono.Start();
-#endif
-
             // smooth at the finer level
             if (Smoothers_lvls[l - 1])
             {
@@ -5500,51 +5373,27 @@ void GeneralMinConstrSolver::Solve(int start_level, const HypreParMatrix *Constr
                 //std::cout << "input to smoother inside new mg at the upward loop \n";
                 //truetempvec2_lvls[l - 1]->Print();
 
+                profiler.Start("smoother");
                 Smoothers_lvls[l - 1]->MultTranspose(*truetempvec2_lvls[l - 1], *truetempvec_lvls[l - 1] );
-#endif
-
-#ifdef TIMING
-                MPI_Barrier(comm);
-                chrono.Stop();
-                time_smoother_lvls[l - 1] += chrono.RealTime();
-                time_smoother += chrono.RealTime();
+                profiler.Stop();
 #endif
 
                 *truesolupdate_lvls[l - 1] += *truetempvec_lvls[l - 1];
 
-#ifdef TIMING
-                MPI_Barrier(comm);
-                chrono.Clear();
-                chrono.Start();
-#endif
+                profiler.Start("residual update");
                 UpdateTrueResidual(l - 1, trueresfunc_lvls[l - 1], *truetempvec_lvls[l - 1], *truetempvec2_lvls[l - 1] );
-
-#ifdef TIMING
-                MPI_Barrier(comm);
-                chrono.Stop();
-                time_resupdate += chrono.RealTime();
-#endif
+                profiler.Stop();
             }
 
-
-#ifdef TIMING
-            MPI_Barrier(comm);
-            chrono.Clear();
-            chrono.Start();
-#endif
-
             if (LocalSolvers_lvls[l - 1])
             {
+                profiler.Start("local solves");
                 LocalSolvers_lvls[l - 1]->Mult(*truetempvec2_lvls[l - 1], *truetempvec_lvls[l - 1]);
+                profiler.Stop();
                 *truesolupdate_lvls[l - 1] += *truetempvec_lvls[l - 1];
             }
 
-#ifdef TIMING
-            MPI_Barrier(comm);
-            chrono.Stop();
-            time_localsolve_lvls[l - 1] += chrono.RealTime();
-            time_localsolve += chrono.RealTime();
-#endif
+            profiler.Stop();
         }
 
     }
@@ -5556,18 +5405,16 @@ void GeneralMinConstrSolver::Solve(int start_level, const HypreParMatrix *Constr
         for (int level = num_levels - 1; level > start_level; --level)
         {
             // solupdate[level-1] = solupdate[level-1] + P[level-1] * solupdate[level]
+            profiler.Start("level", level - 1);
+            profiler.Start("interpolation");
             TrueP_Func[level - 1]->Mult(*truesolupdate_lvls[level], *truetempvec_lvls[level - 1] );
+            profiler.Stop();
+            profiler.Stop();
             *truesolupdate_lvls[level - 1] += *truetempvec_lvls[level - 1];
         }
 
     }
 
-#ifdef TIMING
-    MPI_Barrier(comm);
-    chrono2.Stop();
-    time_up  += chrono2.RealTime();
-#endif
-
     if (Constr_start_lvl)
         MFEM_ASSERT(CheckConstrRes(truesolupdate_lvls[start_level]->GetBlock(0), *Constr_start_lvl, NULL,
                 "for update after full V-cycle"),"");
@@ -5771,6 +5618,39 @@ void BlockSmoother::MultTranspose(const Vector & x, Vector & y) const
 #endif
 }
 
+ChebyshevBlockSmoother::ChebyshevBlockSmoother(BlockOperator &Op, int order, bool l1)
+    : ChebyshevSmoother(((HypreParMatrix&)Op.GetBlock(0,0)).GetComm(), Op,
+                        GetScaling(Op, l1), order)
+{}
+
+Vector ChebyshevBlockSmoother::GetScaling(BlockOperator &Op, bool l1)
+{
+    const Array<int>& offsets = Op.RowOffsets();
+    Vector scaling(offsets.Last());
+    scaling = 0.0;
+
+    Vector block_scaling;
+    for (int i = 0; i < Op.NumRowBlocks(); ++i)
+        for (int j = 0; j < Op.NumColBlocks(); ++j)
+        {
+            if (Op.IsZeroBlock(i,j) || (!l1 && i != j))
+                continue;
+
+            HypreParMatrix * block = dynamic_cast<HypreParMatrix*>(&Op.GetBlock(i,j));
+            MFEM_VERIFY(block, "Blocks must be HypreParMatrices \n");
+
+            if (l1)
+                block->GetRowL1Norms(block_scaling);
+            else
+                block->GetDiag(block_scaling);
+
+            for (int k = 0; k < block_scaling.Size(); ++k)
+                scaling[offsets[i] + k] += block_scaling[k];
+        }
+
+    return scaling;
+}
+
 // Computes prerequisites required for solving local problems at level l
 // such as relation tables between AEs and internal fine-grid dofs
 // and maybe smth else ... ?
@@ -5800,7 +5680,8 @@ MonolithicMultigrid::MonolithicMultigrid(BlockOperator &Op, const Array<BlockOpe
       correction(Operators_.Size()),
       residual(Operators_.Size()),
       CoarsePrec_(Coarse_Prec),
-      built_prec(false)
+      built_prec(false),
+      ConsolidatedSolver(NULL)
 {
     Operators_.Last() = &Op;
 
@@ -6015,6 +5896,29 @@ MonolithicMultigrid::MonolithicMultigrid(BlockOperator &Op, const Array<BlockOpe
     CoarseSolver->SetPreconditioner(*CoarsePrec_);
 }
 
+void MonolithicMultigrid::SetChebyshevSmoothers(int order, bool l1)
+{
+    for (int l = 0; l < Operators_.Size(); l++)
+    {
+        delete Smoothers_[l];
+        Smoothers_[l] = new ChebyshevBlockSmoother(*Operators_[l], order, l1);
+    }
+}
+
+bool MonolithicMultigrid::SetConsolidatedCoarseSolver(bool replicate)
+{
+    delete ConsolidatedSolver;
+    ConsolidatedSolver = new ConsolidatedCoarseSolver(*Operators_[0], replicate);
+    if (ConsolidatedSolver->IsSingular())
+    {
+        // keeping the iterative coarse solver
+        delete ConsolidatedSolver;
+        ConsolidatedSolver = NULL;
+        return false;
+    }
+    return true;
+}
+
 void MonolithicMultigrid::Mult(const Vector & x, Vector & y) const
 {
     *residual.Last() = x;
@@ -6042,7 +5946,7 @@ void MonolithicMultigrid::MG_Cycle() const
 {
     // PreSmoothing
     const BlockOperator& Operator_l = *Operators_[current_level];
-    const BlockSmoother& Smoother_l = *Smoothers_[current_level];
+    const Operator& Smoother_l = *Smoothers_[current_level];
 
     Vector& residual_l = *residual[current_level];
     Vector& correction_l = *correction[current_level];
@@ -6115,7 +6019,10 @@ void MonolithicMultigrid::MG_Cycle() const
 #ifdef NO_COARSESOLVE
         correction_l = 0.0;
 #else
-        CoarseSolver->Mult(residual_l, correction_l);
+        if (ConsolidatedSolver)
+            ConsolidatedSolver->Mult(residual_l, correction_l);
+        else
+            CoarseSolver->Mult(residual_l, correction_l);
 #endif
         /*
         cor_cor.SetSize(residual_l.Size());
@@ -6138,6 +6045,36 @@ void MonolithicMultigrid::MG_Cycle() const
 
 }
 
+void Multigrid::SetChebyshevSmoothers(int order, bool l1)
+{
+    Vector scaling;
+    for (int l = 0; l < Operators_.Size(); l++)
+    {
+        if (l1)
+            Operators_[l]->GetRowL1Norms(scaling);
+        else
+            Operators_[l]->GetDiag(scaling);
+
+        delete Smoothers_[l];
+        Smoothers_[l] = new ChebyshevSmoother(Operators_[l]->GetComm(), *Operators_[l],
+                                              scaling, order);
+    }
+}
+
+bool Multigrid::SetConsolidatedCoarseSolver(bool replicate)
+{
+    delete ConsolidatedSolver;
+    ConsolidatedSolver = new ConsolidatedCoarseSolver(*Operators_[0], replicate);
+    if (ConsolidatedSolver->IsSingular())
+    {
+        // keeping the iterative coarse solver
+        delete ConsolidatedSolver;
+        ConsolidatedSolver = NULL;
+        return false;
+    }
+    return true;
+}
+
 void Multigrid::Mult(const Vector & x, Vector & y) const
 {
     *residual.Last() = x;
@@ -6162,7 +6099,7 @@ void Multigrid::Mult(const Vector & x, Vector & y) const
 void Multigrid::MG_Cycle() const
 {
     const HypreParMatrix& Operator_l = *Operators_[current_level];
-    const HypreSmoother& Smoother_l = *Smoothers_[current_level];
+    const Solver& Smoother_l = *Smoothers_[current_level];
 
     Vector& residual_l = *residual[current_level];
     Vector& correction_l = *correction[current_level];
@@ -6215,7 +6152,10 @@ void Multigrid::MG_Cycle() const
 #ifdef NO_COARSESOLVE
         correction_l = 0.0;
 #else
-        CoarseSolver->Mult(residual_l, correction_l);
+        if (ConsolidatedSolver)
+            ConsolidatedSolver->Mult(residual_l, correction_l);
+        else
+            CoarseSolver->Mult(residual_l, correction_l);
 #endif
 
 #ifdef BND_FOR_MULTIGRID
@@ -18,11 +18,6 @@ namespace mfem
 // activates a check for the correctness of local problem solve for the blocked case (with S)
 //#define CHECK_LOCALSOLVE
 
-#ifdef TIMING
-#undef CHECK_LOCALSOLVE
-#undef CHECK_BNDCND
-#endif
-
 #ifndef MFEM_DEBUG
 #undef CHECK_LOCALSOLVE
 #undef CHECK_BNDCND
@@ -313,13 +308,13 @@ protected:
     const std::vector<HypreParMatrix*>& d_td_blocks;
 
     // Relation tables which represent agglomerated elements-to-elements relation
-    const SparseMatrix& AE_e;
+    const Table& AE_e;
 
-    const BlockMatrix& el_to_dofs_Op;
-    const SparseMatrix& el_to_dofs_L2;
+    const BlockTable& el_to_dofs_Op;
+    const Table& el_to_dofs_L2;
 
-    mutable SparseMatrix* AE_edofs_L2;
-    mutable BlockMatrix* AE_eintdofs_blocks; // relation between AEs and internal (w.r.t to AEs) fine-grid dofs
+    mutable Table* AE_edofs_L2;
+    mutable BlockTable* AE_eintdofs_blocks; // relation between AEs and internal (w.r.t to AEs) fine-grid dofs
 
     const std::vector<Array<int>* >& bdrdofs_blocks;
     const std::vector<Array<int>* >& essbdrdofs_blocks;
@@ -343,6 +338,18 @@ protected:
     mutable BlockVector* temprhs_func;
     mutable BlockVector* tempsol;
 
+    // work objects for the local problems, created in Setup() and reused from
+    // one AE to another; their data is taken from the arena
+    mutable Array<int> sub_Func_offsets;
+    mutable std::vector<Array<int>* > Local_inds;
+    mutable Array2D<DenseMatrix*> LocalAE_Matrices;
+    mutable BlockVector sub_Func;
+    mutable BlockVector sol_loc;
+
+    // storage for the per-AE temporaries, so that Mult() does no heap allocations
+    // after the first call
+    mutable MemoryArena arena;
+
     bool own_essbdr;
 
 protected:
@@ -361,21 +368,25 @@ protected:
     // classes in order to speed up iterations
     virtual void SaveLocalLUFactors() const;
 
-    BlockMatrix* Get_AE_eintdofs(const BlockMatrix& el_to_dofs,
-                                            const std::vector<Array<int>* > &dof_is_essbdr,
-                                            const std::vector<Array<int>* > &dof_is_bdr) const;
+    BlockTable* Get_AE_eintdofs(const BlockTable& el_to_dofs,
+                                const std::vector<Array<int>* > &dof_is_essbdr,
+                                const std::vector<Array<int>* > &dof_is_bdr) const;
 
     void Setup();
 
 public:
     virtual ~LocalProblemSolver();
+
+    /// Returns the memory (in bytes) owned by the solver: local relation
+    /// matrices, saved local LU factors and work vectors
+    virtual long MemoryUsage() const;
     // main constructor
     LocalProblemSolver(int size, const BlockMatrix& Op_Blksmat,
                        const SparseMatrix& Constr_Spmat,
                        const std::vector<HypreParMatrix*>& D_tD_blks,
-                       const SparseMatrix& AE_el,
-                       const BlockMatrix& El_to_Dofs_Op,
-                       const SparseMatrix& El_to_Dofs_L2,
+                       const Table& AE_el,
+                       const BlockTable& El_to_Dofs_Op,
+                       const Table& El_to_Dofs_L2,
                        const std::vector<Array<int>* >& BdrDofs_blks,
                        const std::vector<Array<int>* >& EssBdrDofs_blks,
                        bool Optimized_LocalSolve)
@@ -387,9 +398,9 @@ public:
     LocalProblemSolver(int size, const BlockMatrix& Op_Blksmat,
                        const SparseMatrix& Constr_Spmat,
                        const std::vector<HypreParMatrix*>& D_tD_blks,
-                       const SparseMatrix& AE_el,
-                       const BlockMatrix& El_to_Dofs_Op,
-                       const SparseMatrix& El_to_Dofs_L2,
+                       const Table& AE_el,
+                       const BlockTable& El_to_Dofs_Op,
+                       const Table& El_to_Dofs_L2,
                        const std::vector<Array<int>* >& BdrDofs_blks,
                        const std::vector<Array<int>* >& EssBdrDofs_blks,
                        bool Optimized_LocalSolve, bool copy_essbdr)
@@ -480,9 +491,9 @@ public:
     LocalProblemSolverWithS(int size, const BlockMatrix& Op_Blksmat,
                        const SparseMatrix& Constr_Spmat,
                        const std::vector<HypreParMatrix*>& D_tD_blks,
-                       const SparseMatrix& AE_el,
-                       const BlockMatrix& El_to_Dofs_Op,
-                       const SparseMatrix& El_to_Dofs_L2,
+                       const Table& AE_el,
+                       const BlockTable& El_to_Dofs_Op,
+                       const Table& El_to_Dofs_L2,
                        const std::vector<Array<int>* >& BdrDofs_blks,
                        const std::vector<Array<int>* >& EssBdrDofs_blks,
                        bool Optimized_LocalSolve)
@@ -498,9 +509,9 @@ public:
     LocalProblemSolverWithS(int size, const BlockMatrix& Op_Blksmat,
                        const SparseMatrix& Constr_Spmat,
                        const std::vector<HypreParMatrix*>& D_tD_blks,
-                       const SparseMatrix& AE_el,
-                       const BlockMatrix& El_to_Dofs_Op,
-                       const SparseMatrix& El_to_Dofs_L2,
+                       const Table& AE_el,
+                       const BlockTable& El_to_Dofs_Op,
+                       const Table& El_to_Dofs_L2,
                        const std::vector<Array<int>* >& BdrDofs_blks,
                        const std::vector<Array<int>* >& EssBdrDofs_blks,
                        bool Optimized_LocalSolve, bool copy_essbdr)
@@ -560,7 +571,7 @@ protected:
     Array<int> d_td_coarsest_row_offsets;
     Array<int> d_td_coarsest_col_offsets;
 
-    Array<BlockMatrix*> el2dofs_funct_lvls;
+    Array<BlockTable*> el2dofs_funct_lvls;
 
     const bool own_data;
 
@@ -572,7 +583,7 @@ protected:
     // Relation tables which represent agglomerated elements-to-elements relation at each level
     // used in ProjectFinerL2ToCoarser (and further in ComputeLocalRhsConstr)
     // not owned by the object if not built on mgtools
-    Array<SparseMatrix*> AE_e;
+    Array<Table*> AE_e;
 
     const MPI_Comm comm;
 
@@ -605,6 +616,17 @@ protected:
     mutable Array<LocalProblemSolver*> LocalSolvers_lvls;
     mutable CoarsestProblemSolver* CoarseSolver;
 
+    // diagonals of P_L2^T * Mass * P_L2 at each level, computed at the first use
+    // in NewProjectFinerL2ToCoarser
+    mutable Array<Vector*> PtWP_diag_lvls;
+
+    // viewers for the arguments of Find(Update)ParticularSolution as BlockVectors
+    mutable BlockVector start_guess_viewer;
+    mutable BlockVector partsol_viewer;
+
+    // storage for the temporary vectors of Find(Update)ParticularSolution
+    mutable MemoryArena arena;
+
     mutable bool verbose;
 
 protected:
@@ -625,6 +647,9 @@ protected:
 public:
     virtual ~DivConstraintSolver();
 
+    /// Returns the memory (in bytes) owned by the solver on this rank
+    long MemoryUsage() const;
+
     DivConstraintSolver(FOSLSProblem& problem_, GeneralHierarchy& hierarchy_,
                         bool optimized_localsolvers_, bool with_hcurl_smoothers_, bool verbose_);
 
@@ -632,7 +657,7 @@ public:
                         bool optimized_localsolvers_, bool with_hcurl_smoothers_, bool verbose_);
 
     DivConstraintSolver(MPI_Comm Comm, int NumLevels,
-                           Array< SparseMatrix*> &AE_to_e,
+                           Array< Table*> &AE_to_e,
                            Array< BlockOperator*>& TrueProj_Func,
                            Array< SparseMatrix*> &Proj_L2,
                            Array< SparseMatrix*> &Mass_mat_lvls_,
@@ -727,15 +752,6 @@ protected:
     mutable HypreParMatrix* Divfree_hpmat;
 #endif
 
-#ifdef TIMING
-    mutable StopWatch chrono;
-    mutable StopWatch chrono2;
-    mutable double time_beforeintmult;
-    mutable double time_intmult;
-    mutable double time_afterintmult;
-    mutable double time_globalmult;
-#endif
-
     // Projection of the system matrix M onto discrete Hcurl space
     // stores Curl_hT * M * Curlh
     //mutable SparseMatrix* CTMC;
@@ -787,6 +803,10 @@ protected:
 
 public:
     virtual ~HcurlGSSSmoother();
+
+    /// Returns the memory (in bytes) owned by the smoother: H(curl) x other blocks
+    /// matrices and work vectors
+    long MemoryUsage() const;
     HcurlGSSSmoother (Array2D<HypreParMatrix*> & Funct_HpMat,
                                         const HypreParMatrix& Divfree_HpMat_nobnd,
                                         const Array<int>& EssBdrtruedofs_Hcurl,
@@ -849,27 +869,9 @@ public:
 
     // service routines
     int GetSweepsNumber(int block) const {return sweeps_num[block];}
-#ifdef TIMING
-    void ResetInternalTimings() const;
-
-    double GetGlobalMultTime() {return time_globalmult;}
-    double GetInternalMultTime() {return time_intmult;}
-    double GetBeforeIntMultTime() {return time_beforeintmult;}
-    double GetAfterIntMultTime() {return time_afterintmult;}
-#endif
 
 };
 
-#ifdef TIMING
-void HcurlGSSSmoother::ResetInternalTimings() const
-{
-    time_beforeintmult = 0.0;
-    time_intmult = 0.0;
-    time_afterintmult = 0.0;
-    time_globalmult = 0.0;
-}
-#endif
-
 // TODO: Fix the block case - boundary conditions for the vectors and matrices in the geometric multigrid
 // TODO: Implement the Gauss-Seidel smoother for the block case for the new multigrid (i.e. add off-diagonal blocks)
 // TODO: so that finally for the block case geometric MG and new MG w/o Schwarz smoother give the same result
@@ -967,34 +969,6 @@ protected:
     mutable HypreParMatrix * Constr_global;
     mutable Vector * Constr_rhs_global;
 
-#ifdef TIMING
-private:
-    mutable StopWatch chrono;
-    mutable StopWatch chrono2;
-    mutable StopWatch chrono3;
-    mutable StopWatch chrono4;
-    mutable double time_solve;
-    mutable double time_mult;
-    mutable double time_localsolve;
-    mutable double* time_localsolve_lvls;
-    mutable double time_smoother;
-    mutable double* time_smoother_lvls;
-    mutable double time_coarsestproblem;
-    mutable double time_resupdate;
-    mutable double time_fw;
-    mutable double time_up;
-    mutable std::list<double>* times_mult;
-    mutable std::list<double>* times_solve;
-    mutable std::list<double>* times_localsolve;
-    mutable std::list<double>* times_localsolve_lvls;
-    mutable std::list<double>* times_smoother;
-    mutable std::list<double>* times_smoother_lvls;
-    mutable std::list<double>* times_coarsestproblem;
-    mutable std::list<double>* times_resupdate;
-    mutable std::list<double>* times_fw;
-    mutable std::list<double>* times_up;
-#endif
-
 protected:
     BlockVector* Functrhs_global; // used only for FunctCheck (hence, it is not used in the preconditioner mode at all)
     BlockVector* Funct_addvec; // used only for FunctCheck (hence, it is not used in the preconditioner mode at all)
@@ -1015,6 +989,11 @@ protected:
     mutable Array<BlockVector*> truesolupdate_lvls;
     mutable Array<BlockVector*> truetempblock_lvls;
 
+    // viewers for the input and output of Mult() as BlockVectors, kept as members
+    // to avoid allocating their blocks at every call
+    mutable BlockVector xblock;
+    mutable BlockVector yblock;
+
     mutable Array<Operator*> LocalSolvers_lvls;
     mutable Operator* CoarseSolver;
 
@@ -1059,6 +1038,9 @@ protected:
 public:
     virtual ~GeneralMinConstrSolver();
 
+    /// Returns the memory (in bytes) owned by the solver on this rank
+    long MemoryUsage() const;
+
     GeneralMinConstrSolver(int size, MultigridToolsHierarchy& mgtools_hierarchy_, bool with_local_smoothers_,
                            bool optimized_localsolvers_, bool with_hcurl_smoothers_,
                            int stopcriteria_type_, bool verbose_);
@@ -1071,36 +1053,12 @@ public:
                            BlockVector& Functrhs_Global,
                            Array<Operator*>& Smoothers_Lvls,
                            std::vector<Operator*> & Func_Global_lvls,
-#ifdef TIMING
-                            std::list<double>* Times_mult,
-                            std::list<double>* Times_solve,
-                            std::list<double>* Times_localsolve,
-                            std::list<double>* Times_localsolve_lvls,
-                            std::list<double>* Times_smoother,
-                            std::list<double>* Times_smoother_lvls,
-                            std::list<double>* Times_coarsestproblem,
-                            std::list<double>* Times_resupdate,
-                            std::list<double>* Times_fw,
-                            std::list<double>* Times_up,
-#endif
                            Array<Operator*>* LocalSolvers = NULL,
                            Operator* CoarseSolver = NULL,
                            int StopCriteria_Type = 1)
         : GeneralMinConstrSolver(Comm, NumLevels, TrueProj_Func, EssBdrTrueDofs_Func,
                                  Functrhs_Global, Smoothers_Lvls, Func_Global_lvls,
                                  NULL, NULL,
-#ifdef TIMING
-                                 Times_mult,
-                                 Times_solve,
-                                 Times_localsolve,
-                                 Times_localsolve_lvls,
-                                 Times_smoother,
-                                 Times_smoother_lvls,
-                                 Times_coarsestproblem,
-                                 Times_resupdate,
-                                 Times_fw,
-                                 Times_up,
-#endif
                                  LocalSolvers, CoarseSolver, StopCriteria_Type)
     {}
 
@@ -1113,18 +1071,6 @@ public:
                            std::vector<Operator*> & Func_Global_lvls,
                            HypreParMatrix * Constr_Global,
                            Vector * Constr_Rhs_global,
-#ifdef TIMING
-                            std::list<double>* Times_mult,
-                            std::list<double>* Times_solve,
-                            std::list<double>* Times_localsolve,
-                            std::list<double>* Times_localsolve_lvls,
-                            std::list<double>* Times_smoother,
-                            std::list<double>* Times_smoother_lvls,
-                            std::list<double>* Times_coarsestproblem,
-                            std::list<double>* Times_resupdate,
-                            std::list<double>* Times_fw,
-                            std::list<double>* Times_up,
-#endif
                            Array<Operator*>* LocalSolvers = NULL,
                            Operator* CoarseSolver = NULL,
                            int StopCriteria_Type = 1);
@@ -1204,6 +1150,9 @@ public:
 
 class DivPart
 {
+private:
+    // storage for the local matrices and vectors at the agglomerates
+    MemoryArena arena;
 
 public:
 
@@ -1215,9 +1164,9 @@ public:
                    Vector &F_fine,
                    Array< SparseMatrix*> &P_W,
                    Array< SparseMatrix*> &P_R,
-                   Array< SparseMatrix*> &Element_Elementc,
-                   Array< SparseMatrix*> &Element_dofs_R,
-                   Array< SparseMatrix*> &Element_dofs_W,
+                   Array< Table*> &AE_Element,
+                   Array< Table*> &Element_dofs_R,
+                   Array< Table*> &Element_dofs_W,
                    HypreParMatrix * d_td_coarse_R,
                    HypreParMatrix * d_td_coarse_W,
                    int* R_offsets,
@@ -1227,7 +1176,7 @@ public:
                    )
     {
         const MPI_Comm comm = d_td_coarse_R->GetComm();
-//        StopWatch chrono;
+        ProfileScope scope("DivPart");
 
 //        Vector sol_p_c2f;
         Vector vec1;
@@ -1245,36 +1194,28 @@ public:
         SparseMatrix * M_finer = M_fine;
         SparseMatrix * M_lvl;
 
-//        chrono.Clear();
-//        chrono.Start();
-
         for (int l=0; l < ref_levels; l++)
         {
-            // 1. Obtaining the relation Dofs_Coarse_Element
-            SparseMatrix *R_t = Transpose(*Element_dofs_R[l]);
-            SparseMatrix *W_t = Transpose(*Element_dofs_W[l]);
+            ProfileScope level_scope("level", l);
 
-            MFEM_ASSERT(R_t->Width() == Element_Elementc[l]->Height() ,
-                        "Element_Elementc matrix and R_t does not match");
+            // 1. Obtaining the relations between the coarse elements (AEs)
+            // and the dofs. The multiplicities of AE_el * el_dofs count the
+            // fine elements of the AE which share the dof, so the product is
+            // taken in this order and no dof-to-AE relation is transposed.
+            MFEM_ASSERT(Element_dofs_R[l]->Size() == AE_Element[l]->Width() ,
+                        "AE_Element relation and R_t does not match");
 
-            SparseMatrix *W_AE = Mult(*W_t,*Element_Elementc[l]);
-            SparseMatrix *R_AE = Mult(*R_t,*Element_Elementc[l]);
-
-            delete R_t;
-            delete W_t;
+            Table *AE_W = Mult(*AE_Element[l], *Element_dofs_W[l]);
+            Table AE_R_all;
+            Array<int> AE_R_counts;
+            Mult(*AE_Element[l], *Element_dofs_R[l], AE_R_all, AE_R_counts);
 
             // 2. For RT elements, we impose boundary condition equal zero,
-            //   see the function: GetInternalDofs2AE to obtained them
-
-            SparseMatrix intDofs_R_AE;
-            GetInternalDofs2AE(*R_AE,intDofs_R_AE);
+            //   see the function: GetAEInternalDofs to obtained them
 
             //  AE elements x localDofs stored in AE_R & AE_W
-            SparseMatrix *AE_R =  Transpose(intDofs_R_AE);
-            SparseMatrix *AE_W = Transpose(*W_AE);
-
-            delete W_AE;
-            delete R_AE;
+            Table *AE_R = new Table;
+            GetAEInternalDofs(AE_R_all, AE_R_counts, *AE_R);
 
 
             // 3. Right hand size at each level is of the form:
@@ -1361,37 +1302,39 @@ public:
             //5. Setting for the coarse problem
             DenseMatrix sub_M;
             DenseMatrix sub_B;
-            DenseMatrix sub_BT;
 //            DenseMatrix invBB;
 
             Vector sub_F;
             Vector sub_G;
 
             //Vector to Assamble the solution at level l
-            Vector u_loc_vec(AE_W->Width());
-            Vector p_loc_vec(AE_R->Width());
+            Vector u_loc_vec(P_W[l]->Height());
+            Vector p_loc_vec(P_R[l]->Height());
 
             u_loc_vec =0.0;
             p_loc_vec =0.0;
 
-            for( int e = 0; e < AE_R->Height(); e++){
+            for( int e = 0; e < AE_R->Size(); e++){
+
+                // local matrices and vectors are taken from the arena
+                ArenaScope ae_scope(arena);
 
-                Array<int> Rtmp_j(AE_R->GetRowColumns(e), AE_R->RowSize(e));
-                Array<int> Wtmp_j(AE_W->GetRowColumns(e), AE_W->RowSize(e));
+                Array<int> Rtmp_j(AE_R->GetRow(e), AE_R->RowSize(e));
+                Array<int> Wtmp_j(AE_W->GetRow(e), AE_W->RowSize(e));
+                const int nR = Rtmp_j.Size();
+                const int nW = Wtmp_j.Size();
 
                 // Setting size of Dense Matrices
                 if (M_lvl)
-                    sub_M.SetSize(Rtmp_j.Size());
-                sub_B.SetSize(Wtmp_j.Size(),Rtmp_j.Size());
-                sub_BT.SetSize(Rtmp_j.Size(),Wtmp_j.Size());
+                    sub_M.UseExternalData(ae_scope.Alloc<double>(nR * nR), nR, nR);
+                sub_B.UseExternalData(ae_scope.Alloc<double>(nW * nR), nW, nR);
 //                sub_G.SetSize(Rtmp_j.Size());
-//                sub_F.SetSize(Wtmp_j.Size());
+                sub_F.SetDataAndSize(ae_scope.Alloc<double>(nW), nW);
 
                 // Obtaining submatrices:
                 if (M_lvl)
                     M_lvl->GetSubMatrix(Rtmp_j,Rtmp_j, sub_M);
                 B_lvl->GetSubMatrix(Wtmp_j,Rtmp_j, sub_B);
-                sub_BT.Transpose(sub_B);
 
 //                sub_G  = .0;
 //                sub_F  = .0;
@@ -1399,7 +1342,7 @@ public:
                 rhs_l.GetSubVector(Wtmp_j, sub_F);
 
 
-                Vector sig(Rtmp_j.Size());
+                Vector sig(ae_scope.Alloc<double>(nR), nR);
 
                 MFEM_ASSERT(sub_F.Sum()<= 9e-11,
                             "checking local average at each level " << sub_F.Sum());
@@ -1581,11 +1524,11 @@ public:
             solver.SetPreconditioner(*darcyPr);
             solver.SetPrintLevel(0);
             trueX = 0.0;
+            profiler.Start("coarse solve");
             solver.Mult(trueRhs, trueX);
-//            chrono.Stop();
+            profiler.Count("MINRES iterations", solver.GetNumIterations());
+            profiler.Stop();
 
-//            cout << "MINRES converged in " << solver.GetNumIterations() << " iterations" <<endl;
-//            cout << "MINRES solver took " << chrono.RealTime() << "s. \n";
             Truesig_c = trueX.GetBlock(0);
 
             for ( int blk = 0; blk < darcyPr->NumBlocks(); ++blk)
@@ -1625,11 +1568,11 @@ public:
             solver.SetOperator(*S);
             solver.SetPreconditioner(*invS);
             solver.SetPrintLevel(0);
+            profiler.Start("coarse solve");
             solver.Mult(FF_coarse, tmp_c);
-//            chrono.Stop();
+            profiler.Count("CG iterations", solver.GetNumIterations());
+            profiler.Stop();
 
-//            cout << "CG converged in " << solver.GetNumIterations() << " iterations" <<endl;
-//            cout << "CG solver took " << chrono.RealTime() << "s. \n";
             MinvBt->Mult(tmp_c, Truesig_c);
 
             delete MinvBt;
@@ -1661,110 +1604,76 @@ public:
         sigma = total_sig;
     }
 
-    void Dofs_AE(SparseMatrix &Element_Dofs, const SparseMatrix &Element_Element_coarse, SparseMatrix &Dofs_Ae)
+    void Dofs_AE(const Table &Element_Dofs, const Table &AE_Element, Table &Dofs_Ae)
     {
-        // Returns a SparseMatrix with the relation dofs to Element coarse.
-        SparseMatrix *R_T = Transpose(Element_Dofs);
-        SparseMatrix *Dofs_AE = Mult(*R_T,Element_Element_coarse);
-        SparseMatrix *AeDofs = Transpose(*Dofs_AE);
-        Dofs_Ae = *AeDofs;
-
-        delete R_T;
-        delete Dofs_AE;
+        // Returns a Table with the relation AE to dofs.
+        Mult(AE_Element, Element_Dofs, Dofs_Ae);
     }
 
 
-    void Elem2Dofs(const FiniteElementSpace &fes, SparseMatrix &Element_to_dofs)
+    void Elem2Dofs(const FiniteElementSpace &fes, Table &Element_to_dofs)
     {
-        // Returns a SparseMatrix with the relation Element to Dofs
-        int * I = new int[fes.GetNE()+1];
-        Array<int> vdofs_R;
-        Array<int> dofs_R;
-
-        I[0] = 0;
-        for (int i = 0; i < fes.GetNE(); i++)
-        {
-            fes.GetElementVDofs(i, vdofs_R);
-            I[i+1] = I[i] + vdofs_R.Size();
-        }
-        int * J = new int[I[fes.GetNE()]];
-        double * data = new double[I[fes.GetNE()]];
-
-        for (int i = 0; i<fes.GetNE(); i++)
-        {
-            // Returns indexes of dofs in array for ith' elements'
-            fes.GetElementVDofs(i,vdofs_R);
-            fes.AdjustVDofs(vdofs_R);
-            for (int j = I[i];j<I[i+1];j++)
-            {
-                J[j] = vdofs_R[j-I[i]];
-                data[j] =1;
-            }
-
-        }
-        SparseMatrix A(I,J,data,fes.GetNE(), fes.GetVSize());
-        Element_to_dofs.Swap(A);
+        // Returns a Table with the relation Element to Dofs
+        Table *A = ElementToDofs(fes);
+        Element_to_dofs.Swap(*A);
+        delete A;
     }
 
-    void GetInternalDofs2AE(const SparseMatrix &R_AE, SparseMatrix &B)
+    void GetAEInternalDofs(const Table &AE_R, const Array<int> &AE_R_counts, Table &B)
     {
-        /* Returns a SparseMatrix with the relation InteriorDofs to Coarse Element.
+        /* Returns a Table with the relation Coarse Element to InteriorDofs.
    * This is use for the Raviart-Thomas dofs, which vanish at the
    * boundary of the coarse elements.
    *
-   * row.Size() ==2, means, it share by 2 AE
+   * AE_R_counts are the multiplicities of the connections of
+   * AE_R = AE_el * el_dofs, i.e. the number of fine elements of the AE
+   * sharing the dof.
    *
    * For the lowest order case:
-   * row.Size()==1, and data=1, means bdry
-   * row.Size()==1, and data=2, means interior
+   * count=1 means bdry
+   * count=2 means interior
    */
 
-        int nnz=0;
-        int * R_AE_i = R_AE.GetI();
-        int * R_AE_j = R_AE.GetJ();
-        double * R_AE_data = R_AE.GetData();
-
-        int * out_i = new int [R_AE.Height()+1];
+        const int * AE_R_i = AE_R.GetI();
+        const int * AE_R_j = AE_R.GetJ();
 
         // Find Hdivdofs_interior_AE
-        for (int i=0; i<R_AE.Height(); i++)
-        {
-            out_i[i]= nnz;
-            for (int j= R_AE_i[i]; j< R_AE_i[i+1]; j++)
-                if (R_AE_data[j]==2)
-                    nnz++; // If the degree is share by two elements
-        }
-        out_i[R_AE.Height()] = nnz;
-
-        int * out_j = new int[nnz];
-        double * out_data = new double[nnz];
-        nnz = 0;
-
-        for (int i=0; i< R_AE.Height(); i++)
-            for (int j=R_AE_i[i]; j<R_AE_i[i+1]; j++)
-                if (R_AE_data[j] == 2)
-                    out_j[nnz++] = R_AE_j[j];
-
-        // Forming the data array:
-        std::fill_n(out_data, nnz, 1);
-
-        SparseMatrix out(out_i, out_j, out_data, R_AE.Height(),
-                         R_AE.Width());
-        B.Swap(out);
+        B.MakeI(AE_R.Size());
+        for (int i=0; i<AE_R.Size(); i++)
+            for (int j= AE_R_i[i]; j< AE_R_i[i+1]; j++)
+                if (AE_R_counts[j]==2)
+                    B.AddAColumnInRow(i); // If the degree is share by two elements
+        B.MakeJ();
+
+        for (int i=0; i< AE_R.Size(); i++)
+            for (int j=AE_R_i[i]; j<AE_R_i[i+1]; j++)
+                if (AE_R_counts[j] == 2)
+                    B.AddConnection(i, AE_R_j[j]);
+        B.ShiftUpI();
     }
 
     void Local_problem(const DenseMatrix &sub_M,  DenseMatrix &sub_B, Vector &Sub_G, Vector &sub_F, Vector &sigma){
         // Returns sigma local
 
+        // local matrices and their LU factors are taken from the arena
+        ArenaScope scope(arena);
+        const int nR = sub_B.Width();
+        const int nW = sub_B.Height();
 
-        DenseMatrix sub_BT(sub_B.Width(), sub_B.Height());
+        DenseMatrix sub_BT(scope.Alloc<double>(nR * nW), nR, nW);
         sub_BT.Transpose(sub_B);
 
         DenseMatrix invM_BT;
         if (sub_M.Size() > 0)
         {
-            DenseMatrixInverse invM_loc(sub_M);
-            invM_loc.Mult(sub_BT,invM_BT);
+            DenseMatrix M_lu(scope.Alloc<double>(nR * nR), nR, nR);
+            M_lu = sub_M;
+            LUFactors invM_loc(M_lu.Data(), scope.Alloc<int>(nR));
+            invM_loc.Factor(nR);
+
+            invM_BT.UseExternalData(scope.Alloc<double>(nR * nW), nR, nW);
+            invM_BT = sub_BT;
+            invM_loc.Solve(nR, nW, invM_BT.Data());
         }
 
         /* Solving the local problem:
@@ -1777,7 +1686,7 @@ public:
               * B M^{-1} B^t (-u) = F
               */
 
-        DenseMatrix B_invM_BT(sub_B.Height());
+        DenseMatrix B_invM_BT(scope.Alloc<double>(nW * nW), nW, nW);
 
         if (sub_M.Size() > 0)
             Mult(sub_B, invM_BT, B_invM_BT);
@@ -1793,14 +1702,17 @@ public:
         B_invM_BT(0,0)=1.;
 
 
-        DenseMatrixInverse inv_BinvMBT(B_invM_BT);
+        // B_invM_BT is not needed anymore and is overwritten by its LU factors
+        LUFactors inv_BinvMBT(B_invM_BT.Data(), scope.Alloc<int>(nW));
+        inv_BinvMBT.Factor(nW);
 
 //        Vector invMG(sub_M.Size());
 //        invM_loc.Mult(Sub_G,invMG);
 
         sub_F[0] = 0;
-        Vector uu(sub_B.Height());
-        inv_BinvMBT.Mult(sub_F, uu);
+        Vector uu(scope.Alloc<double>(nW), nW);
+        uu = sub_F;
+        inv_BinvMBT.Solve(nW, 1, uu.GetData());
         if (sub_M.Size() > 0)
             invM_BT.Mult(uu,sigma);
         else
@@ -1875,6 +1787,19 @@ private:
     mutable Vector tmp1;
 };
 
+// Chebyshev smoother for a block operator with HypreParMatrix blocks,
+// scaled either by the diagonal (l1 = false) or by the l1 norms of the rows
+// of the whole block operator (l1-Chebyshev). Unlike the GS-type block
+// smoothers above it only needs matvecs with the blocks
+class ChebyshevBlockSmoother : public ChebyshevSmoother
+{
+public:
+    ChebyshevBlockSmoother(BlockOperator &Op, int order = 2, bool l1 = true);
+
+    // the diagonal or the l1 row norms of Op
+    static Vector GetScaling(BlockOperator &Op, bool l1);
+};
+
 class MonolithicMultigrid : public Solver
 {
 public:
@@ -1888,6 +1813,16 @@ public:
 
     virtual void SetOperator(const Operator &op) { }
 
+    // replaces the default block GS smoothers by (l1-)Chebyshev smoothers
+    // of the given polynomial order
+    void SetChebyshevSmoothers(int order, bool l1 = true);
+
+    // replaces the CG coarsest solver by a direct solver for the coarsest
+    // operator, gathered onto the root rank or replicated on all ranks
+    // (see ConsolidatedCoarseSolver); if the coarsest operator is singular,
+    // the CG solver is kept and false is returned
+    bool SetConsolidatedCoarseSolver(bool replicate = false);
+
     ~MonolithicMultigrid()
     {
         for (int l = 0; l < Operators_.Size(); l++)
@@ -1902,6 +1837,7 @@ public:
         delete CoarseSolver;
         if (built_prec)
             delete CoarsePrec_;
+        delete ConsolidatedSolver;
     }
 
 private:
@@ -1916,7 +1852,7 @@ private:
 #endif
 
     Array<BlockOperator*> Operators_;
-    Array<BlockSmoother*> Smoothers_;
+    Array<Operator*> Smoothers_;
 
     mutable int current_level;
 
@@ -1932,6 +1868,8 @@ private:
 
     mutable bool built_prec;
 
+    ConsolidatedCoarseSolver *ConsolidatedSolver;
+
 public:
     Operator* GetCoarsestSolver() {return CoarseSolver;}
     BlockOperator* GetInterpolation(int l) { return P_[l];}
@@ -1966,7 +1904,8 @@ public:
           curl_space_coarsest(C_space_coarsest),
 #endif
           CoarsePrec_(CoarsePrec),
-          built_prec(false)
+          built_prec(false),
+          ConsolidatedSolver(NULL)
     {
         Operators_.Last() = &Op;
         for (int l = Operators_.Size()-1; l > 0; l--)
@@ -2110,6 +2049,16 @@ public:
 
     virtual void SetOperator(const Operator &op) { }
 
+    // replaces the default l1-GS smoothers by (l1-)Chebyshev smoothers
+    // of the given polynomial order
+    void SetChebyshevSmoothers(int order, bool l1 = true);
+
+    // replaces the CG coarsest solver by a direct solver for the coarsest
+    // operator, gathered onto the root rank or replicated on all ranks
+    // (see ConsolidatedCoarseSolver); if the coarsest operator is singular,
+    // the CG solver is kept and false is returned
+    bool SetConsolidatedCoarseSolver(bool replicate = false);
+
     virtual ~Multigrid()
     {
         for (int l = 0; l < Operators_.Size(); l++)
@@ -2124,6 +2073,7 @@ public:
         delete CoarseSolver;
         if (built_prec)
             delete CoarsePrec_;
+        delete ConsolidatedSolver;
     }
 #ifdef COMPARE_MG
     CGSolver * GetCoarseSolver() const {return CoarseSolver;}
@@ -2140,7 +2090,7 @@ private:
 #endif
 
     Array<HypreParMatrix*> Operators_;
-    Array<HypreSmoother*> Smoothers_;
+    Array<Solver*> Smoothers_;
 
     mutable int current_level;
 
@@ -2160,6 +2110,8 @@ private:
 
 
     mutable bool built_prec;
+
+    ConsolidatedCoarseSolver * ConsolidatedSolver;
 };
 
 
@@ -54,7 +54,7 @@ void H1NormIntegrator::AssembleElementMatrix(const FiniteElement &el, ElementTra
       const IntegrationPoint &ip = ir_diff->IntPoint(i);
       el.CalcDShape(ip, dshape);
 
-      Trans.SetIntPoint(&ip);
+      Trans.SetIntPoint(*ir_diff, i);
       w = Trans.Weight();
       w = ip.weight / (square ? w : w*w*w);
       // AdjugateJacobian = / adj(J),         if J is square
@@ -98,7 +98,7 @@ void H1NormIntegrator::AssembleElementMatrix(const FiniteElement &el, ElementTra
       const IntegrationPoint &ip = ir_mass->IntPoint(i);
       el.CalcShape(ip, shape);
 
-      Trans.SetIntPoint (&ip);
+      Trans.SetIntPoint(*ir_mass, i);
       w = Trans.Weight() * ip.weight;
       if (Qmass)
       {
@@ -148,7 +148,7 @@ void MixedVectorVectorFEMassIntegrator::AssembleElementMatrix2(const FiniteEleme
     {
        const IntegrationPoint &ip = ir->IntPoint(i);
 
-       Trans.SetIntPoint (&ip);
+       Trans.SetIntPoint(*ir, i);
 
        trial_fe.CalcVShape(Trans, trial_vshape);
 
@@ -236,7 +236,7 @@ void PAUVectorFEMassIntegrator::AssembleElementMatrix2(const FiniteElement &tria
         const IntegrationPoint &ip = ir->IntPoint(i);
         test_fe.CalcShape(ip, test_shape);
 
-        Trans.SetIntPoint (&ip);
+        Trans.SetIntPoint(*ir, i);
         trial_fe.CalcVShape(Trans, trial_vshape);
 
         w = ip.weight * Trans.Weight();
@@ -248,6 +248,68 @@ void PAUVectorFEMassIntegrator::AssembleElementMatrix2(const FiniteElement &tria
                     elmat(k, j) += w*trial_vshape(j,d)*b(d)*test_shape(k);
     }
 }
+
+void PAUVectorFEMassIntegrator::AssembleElementMatrices2(FiniteElementSpace &trial_fes,
+                                                         FiniteElementSpace &test_fes,
+                                                         const Array<int> &elems,
+                                                         DenseTensor &elmats)
+{
+    const int ne = elems.Size();
+    if (ne == 0 || !RefElementShapes::IsVShapeSupported(*trial_fes.GetFE(elems[0])))
+    {
+        BilinearFormIntegrator::AssembleElementMatrices2(trial_fes, test_fes, elems, elmats);
+        return;
+    }
+    const FiniteElement &trial_fe = *trial_fes.GetFE(elems[0]);
+    const FiniteElement &test_fe = *test_fes.GetFE(elems[0]);
+    int dim  = test_fe.GetDim();
+    int trial_dof = trial_fe.GetDof();
+    int test_dof = test_fe.GetDof();
+
+    if (VQ == NULL)
+        mfem_error("PAUVectorFEMassIntegrator::AssembleElementMatrices2(...)\n"
+                "   is not implemented for non-vector coefficients");
+
+    IsoparametricTransformation Trans;
+    test_fes.GetElementTransformation(elems[0], &Trans);
+    const IntegrationRule *ir = IntRule;
+    if (ir == NULL)
+    {
+        int order = (Trans.OrderW() + test_fe.GetOrder() + trial_fe.GetOrder());
+        ir = &IntRules.Get(test_fe.GetGeomType(), order);
+    }
+    // the reference shapes are shared by all elements of the batch
+    const RefElementShapes trial_ref(trial_fe, *ir, RefElementShapes::VSHAPE);
+    const RefElementShapes test_ref(test_fe, *ir, RefElementShapes::SHAPE);
+
+    SetTensorSize(elmats, test_dof, trial_dof, ne);
+    DenseMatrix elmat, trial_vshape;
+    Vector test_shape, b;
+    for (int e = 0; e < ne; e++)
+    {
+        if (e > 0)
+            test_fes.GetElementTransformation(elems[e], &Trans);
+        elmat.UseExternalData(elmats.GetData(e), test_dof, trial_dof);
+        elmat = 0.0;
+        for (int i = 0; i < ir->GetNPoints(); i++)
+        {
+            const IntegrationPoint &ip = ir->IntPoint(i);
+            test_ref.GetShape(i, test_shape);
+
+            Trans.SetIntPoint(*ir, i);
+            trial_ref.CalcPhysVShape(i, Trans, trial_vshape);
+
+            double w = ip.weight * Trans.Weight();
+            VQ->Eval (b, Trans, ip);
+
+            for (int j = 0; j < trial_dof; j++)
+                for (int k = 0; k < test_dof; k++)
+                    for (int d = 0; d < dim; d++ )
+                        elmat(k, j) += w*trial_vshape(j,d)*b(d)*test_shape(k);
+        }
+    }
+    elmat.ClearExternalData();
+}
 ///////////////////////////
 
 void PAUVectorFEMassIntegrator2::AssembleElementMatrix(const FiniteElement &el,
@@ -293,7 +355,7 @@ void PAUVectorFEMassIntegrator2::AssembleElementMatrix(const FiniteElement &el,
         el.CalcShape(ip, shape);
         el.CalcDShape(ip, dshape);
 
-        Trans.SetIntPoint (&ip);
+        Trans.SetIntPoint(*ir, i);
         CalcInverse(Trans.Jacobian(), invdfdx);
         w = ip.weight * Trans.Weight();
         Mult(dshape, invdfdx, dshapedxt);
@@ -376,7 +438,7 @@ void VectorFECurlVQIntegrator::AssembleElementMatrix2(const FiniteElement &trial
     {
         const IntegrationPoint &ip = ir->IntPoint(i);
 
-        Trans.SetIntPoint(&ip);
+        Trans.SetIntPoint(*ir, i);
 
         double w = ip.weight;
         VQ->Eval(D, Trans, ip);
@@ -446,7 +508,7 @@ void VectorcurlDomainLFIntegrator::AssembleRHSElementVect(const FiniteElement &e
         const IntegrationPoint &ip = ir->IntPoint(i);
         el.CalcCurlShape(ip, curlshape);
 
-        Tr.SetIntPoint (&ip);
+        Tr.SetIntPoint(*ir, i);
 
         VQ.Eval(vecval,Tr,ip);                  // plain evaluation
 
@@ -480,7 +542,7 @@ void VectordivDomainLFIntegrator::AssembleRHSElementVect(const FiniteElement &el
       const IntegrationPoint &ip = ir->IntPoint(i);
       el.CalcDivShape(ip, divshape);
 
-      Tr.SetIntPoint (&ip);
+      Tr.SetIntPoint(*ir, i);
       double val = Q.Eval(Tr, ip);
 
       add(elvect, ip.weight * val, divshape, elvect);
@@ -531,7 +593,7 @@ void MixedVectorScalarIntegrator::AssembleElementMatrix2(const FiniteElement &tr
         const IntegrationPoint &ip = ir->IntPoint(i);
         test_fe.CalcShape(ip, test_shape);
 
-        Trans.SetIntPoint (&ip);
+        Trans.SetIntPoint(*ir, i);
         trial_fe.CalcShape(ip, trial_shape);
 
         for (int d = 0; d < dim; ++d )
@@ -592,7 +654,7 @@ void GradDomainLFIntegrator::AssembleRHSElementVect( const FiniteElement &el,
       const IntegrationPoint &ip = ir->IntPoint(i);
       el.CalcDShape(ip, dshape);
 
-      Tr.SetIntPoint (&ip);
+      Tr.SetIntPoint(*ir, i);
       w = ip.weight;
       CalcAdjugate(Tr.Jacobian(), invdfdx);
       Mult(dshape, invdfdx, dshapedxt);
@@ -638,7 +700,7 @@ void ImproperVectorMassIntegrator::AssembleElementMatrix( const FiniteElement &e
     {
        const IntegrationPoint &ip = ir->IntPoint(i);
 
-       Trans.SetIntPoint (&ip);
+       Trans.SetIntPoint(*ir, i);
 
        el.CalcShape(ip, scalar_shape);
        for (int d = 0; d < dim; ++d )
@@ -704,7 +766,7 @@ void CFOSLS_MixedHeatIntegrator::AssembleElementMatrix2( const FiniteElement &tr
         trial_fe.CalcShape(ip, trial_shape);
         trial_fe.CalcDShape(ip, trial_dshape);
 
-        Trans.SetIntPoint (&ip);
+        Trans.SetIntPoint(*ir, i);
         test_fe.CalcVShape(Trans, test_vshape);
 
         w = ip.weight * Trans.Weight();
@@ -727,6 +789,84 @@ void CFOSLS_MixedHeatIntegrator::AssembleElementMatrix2( const FiniteElement &tr
     }
 }
 
+void CFOSLS_MixedHeatIntegrator::AssembleElementMatrices2(FiniteElementSpace &trial_fes,
+                                                          FiniteElementSpace &test_fes,
+                                                          const Array<int> &elems,
+                                                          DenseTensor &elmats)
+{
+    const int ne = elems.Size();
+    if (ne == 0 || !RefElementShapes::IsVShapeSupported(*test_fes.GetFE(elems[0])))
+    {
+        BilinearFormIntegrator::AssembleElementMatrices2(trial_fes, test_fes, elems, elmats);
+        return;
+    }
+    const FiniteElement &trial_fe = *trial_fes.GetFE(elems[0]);
+    const FiniteElement &test_fe = *test_fes.GetFE(elems[0]);
+    int dim  = test_fe.GetDim();
+    int trial_dof = trial_fe.GetDof();
+    int test_dof = test_fe.GetDof();
+
+    if (VQ || MQ)
+        mfem_error("CFOSLS_MixedHeatIntegrator::AssembleElementMatrices2(...)\n"
+                   "  is not implemented for vector/tensor coefficients");
+
+    IsoparametricTransformation Trans;
+    test_fes.GetElementTransformation(elems[0], &Trans);
+    const IntegrationRule *ir = IntRule;
+    if (ir == NULL)
+    {
+        int order = (Trans.OrderW() + test_fe.GetOrder() + trial_fe.GetOrder());
+        ir = &IntRules.Get(test_fe.GetGeomType(), order);
+    }
+    // the reference shapes are shared by all elements of the batch
+    const RefElementShapes trial_ref(trial_fe, *ir, RefElementShapes::SHAPE |
+                                     RefElementShapes::DSHAPE);
+    const RefElementShapes test_ref(test_fe, *ir, RefElementShapes::VSHAPE);
+
+    SetTensorSize(elmats, test_dof, trial_dof, ne);
+    DenseMatrix elmat, trial_dshape, test_vshape;
+    DenseMatrix trial_dshapedxt(trial_dof,dim);
+    DenseMatrix invdfdx(dim,dim);
+    Vector trial_shape;
+    for (int e = 0; e < ne; e++)
+    {
+        if (e > 0)
+            test_fes.GetElementTransformation(elems[e], &Trans);
+        elmat.UseExternalData(elmats.GetData(e), test_dof, trial_dof);
+        elmat = 0.0;
+        for (int i = 0; i < ir->GetNPoints(); i++)
+        {
+            const IntegrationPoint &ip = ir->IntPoint(i);
+
+            trial_ref.GetShape(i, trial_shape);
+            trial_ref.GetDShape(i, trial_dshape);
+
+            Trans.SetIntPoint(*ir, i);
+            test_ref.CalcPhysVShape(i, Trans, test_vshape);
+
+            double w = ip.weight * Trans.Weight();
+            CalcInverse(Trans.Jacobian(), invdfdx);
+            Mult(trial_dshape, invdfdx, trial_dshapedxt);
+            if (Q)
+            {
+                w *= Q -> Eval (Trans, ip);
+            }
+
+            for (int j = 0; j < test_dof; j++)
+            {
+                for (int k = 0; k < trial_dof; k++)
+                {
+                    for (int d = 0; d < dim - 1; d++ )
+                        elmat(j, k) += 1.0 * w * test_vshape(j, d) * trial_dshapedxt(k, d);
+                    elmat(j, k) -= w * test_vshape(j, dim - 1) * trial_shape(k);
+                }
+            }
+        }
+    }
+    elmat.ClearExternalData();
+    trial_dshape.ClearExternalData();
+}
+
 void CFOSLS_HeatIntegrator::AssembleElementMatrix(const FiniteElement &el, ElementTransformation &Trans,
                                                   DenseMatrix &elmat)
 {
@@ -767,7 +907,7 @@ void CFOSLS_HeatIntegrator::AssembleElementMatrix(const FiniteElement &el, Eleme
         el.CalcShape(ip, shape);
         el.CalcDShape(ip, dshape);
 
-        Trans.SetIntPoint (&ip);
+        Trans.SetIntPoint(*ir, i);
         CalcInverse(Trans.Jacobian(), invdfdx);
         w = ip.weight * Trans.Weight();
         Mult(dshape, invdfdx, dshapedxt);
@@ -788,6 +928,74 @@ void CFOSLS_HeatIntegrator::AssembleElementMatrix(const FiniteElement &el, Eleme
     }
 }
 
+void CFOSLS_HeatIntegrator::AssembleElementMatrices(FiniteElementSpace &fes,
+                                                    const Array<int> &elems,
+                                                    DenseTensor &elmats)
+{
+    const int ne = elems.Size();
+    if (ne == 0)
+        return;
+    const FiniteElement &el = *fes.GetFE(elems[0]);
+    int dof = el.GetDof();
+    int dim  = el.GetDim();
+
+    if (VQ || MQ)
+        mfem_error("CFOSLS_HeatIntegrator::AssembleElementMatrices(...)\n"
+                   "   is not implemented for vector/tensor coefficients");
+
+    IsoparametricTransformation Trans;
+    fes.GetElementTransformation(elems[0], &Trans);
+    const IntegrationRule *ir = IntRule;
+    if (ir == NULL)
+    {
+        int order = (Trans.OrderW() + el.GetOrder() + el.GetOrder());
+        ir = &IntRules.Get(el.GetGeomType(), order);
+    }
+    // the reference shapes are shared by all elements of the batch
+    const RefElementShapes ref(el, *ir, RefElementShapes::SHAPE |
+                               RefElementShapes::DSHAPE);
+
+    SetTensorSize(elmats, dof, dof, ne);
+    DenseMatrix elmat, dshape;
+    DenseMatrix dshapedxt(dof,dim);
+    DenseMatrix invdfdx(dim,dim);
+    Vector shape;
+    for (int e = 0; e < ne; e++)
+    {
+        if (e > 0)
+            fes.GetElementTransformation(elems[e], &Trans);
+        elmat.UseExternalData(elmats.GetData(e), dof, dof);
+        elmat = 0.0;
+        for (int i = 0; i < ir->GetNPoints(); i++)
+        {
+            const IntegrationPoint &ip = ir->IntPoint(i);
+
+            ref.GetShape(i, shape);
+            ref.GetDShape(i, dshape);
+
+            Trans.SetIntPoint(*ir, i);
+            CalcInverse(Trans.Jacobian(), invdfdx);
+            double w = ip.weight * Trans.Weight();
+            Mult(dshape, invdfdx, dshapedxt);
+
+            if (Q)
+            {
+                w *= Q -> Eval (Trans, ip);
+            }
+
+            for (int j = 0; j < dof; j++)
+                for (int k = 0; k < dof; k++)
+                {
+                    for (int d = 0; d < dim - 1; d++ )
+                        elmat(j, k) +=  w * dshapedxt(j, d) * dshapedxt(k, d);
+                    elmat(j, k) +=  w * shape(j) * shape(k);
+                }
+        }
+    }
+    elmat.ClearExternalData();
+    dshape.ClearExternalData();
+}
+
 void CFOSLS_MixedWaveIntegrator::AssembleElementMatrix2( const FiniteElement &trial_fe, const FiniteElement &test_fe,
                                                          ElementTransformation &Trans, DenseMatrix &elmat)
 {
@@ -830,7 +1038,7 @@ void CFOSLS_MixedWaveIntegrator::AssembleElementMatrix2( const FiniteElement &tr
         trial_fe.CalcShape(ip, trial_shape);
         trial_fe.CalcDShape(ip, trial_dshape);
 
-        Trans.SetIntPoint (&ip);
+        Trans.SetIntPoint(*ir, i);
         test_fe.CalcVShape(Trans, test_vshape);
 
         w = ip.weight * Trans.Weight();
@@ -893,7 +1101,7 @@ void CFOSLS_WaveIntegrator::AssembleElementMatrix( const FiniteElement &el,
         el.CalcShape(ip, shape);
         el.CalcDShape(ip, dshape);
 
-        Trans.SetIntPoint (&ip);
+        Trans.SetIntPoint(*ir, i);
         CalcInverse(Trans.Jacobian(), invdfdx);
         w = ip.weight * Trans.Weight();
         Mult(dshape, invdfdx, dshapedxt);
@@ -99,6 +99,10 @@ public:
                                        const FiniteElement &test_fe,
                                        ElementTransformation &Trans,
                                        DenseMatrix &elmat);
+   virtual void AssembleElementMatrices2(FiniteElementSpace &trial_fes,
+                                         FiniteElementSpace &test_fes,
+                                         const Array<int> &elems,
+                                         DenseTensor &elmats);
 };
 
 /// Integrator for (q * (- grad_x u, grad_t u)^T, (- grad_x v, grad_t v)^T)
@@ -336,6 +340,10 @@ public:
                                         const FiniteElement &test_fe,
                                         ElementTransformation &Trans,
                                         DenseMatrix &elmat);
+    virtual void AssembleElementMatrices2(FiniteElementSpace &trial_fes,
+                                          FiniteElementSpace &test_fes,
+                                          const Array<int> &elems,
+                                          DenseTensor &elmats);
 };
 
 /// Integrator for (Q * (-grad_x u, u)^T, (-grad_x v, v)^T)
@@ -369,6 +377,9 @@ public:
     virtual void AssembleElementMatrix(const FiniteElement &el,
                                        ElementTransformation &Trans,
                                        DenseMatrix &elmat);
+    virtual void AssembleElementMatrices(FiniteElementSpace &fes,
+                                         const Array<int> &elems,
+                                         DenseTensor &elmats);
 };
 
 /// Integrator for (sigma, (- grad_x u, grad_t u)^T)
@@ -493,8 +493,11 @@ void TimeStepping<Problem>::SequentialSolve(const Vector& init_vector, bool comp
     MFEM_ASSERT(problems_initialized, "Cannot solve if the problems are not set");
     MFEM_ASSERT(init_vector.Size() == base_inputs[0]->Size(), "Input vector length mismatch the length of the base_input");
 
+    ProfileScope scope("TimeStepping sequential solve");
+
     for (int tslab = 0; tslab < nslabs; ++tslab )
     {
+        ProfileScope slab_scope("time slab", tslab);
         Problem * tslab_problem = timeslabs_problems[tslab];
         FOSLSFEFormulation& fe_formul = tslab_problem->GetFEformulation();
         int index = fe_formul.GetFormulation()->GetUnknownWithInitCnd();
@@ -525,6 +528,8 @@ void TimeStepping<Problem>::SequentialSolve(const Vector& rhs, const Vector& ini
     MFEM_ASSERT(problems_initialized, "Cannot solve if the problems are not set");
     MFEM_ASSERT(init_vector.Size() == base_inputs[0]->Size(), "Input vector length mismatch the length of the base_input");
 
+    ProfileScope scope("TimeStepping sequential solve");
+
     Problem * tslab_startproblem = timeslabs_problems[0];
     FOSLSFEFormulation& fe_formul = tslab_startproblem->GetFEformulation();
     int index = fe_formul.GetFormulation()->GetUnknownWithInitCnd();
@@ -534,6 +539,7 @@ void TimeStepping<Problem>::SequentialSolve(const Vector& rhs, const Vector& ini
 
     for (int tslab = 0; tslab < nslabs; ++tslab )
     {
+        ProfileScope slab_scope("time slab", tslab);
         Problem * tslab_problem = timeslabs_problems[tslab];
 
         if (tslab == 0)
@@ -573,12 +579,15 @@ void TimeStepping<Problem>::ParallelSolve(const Array<Vector*> &init_vectors, bo
 
     MFEM_ASSERT(init_vectors.Size() == nslabs, "Number of input vectors must equal number of time slabs");
 
+    ProfileScope scope("TimeStepping parallel solve");
+
     // renaming init_vectors into internal base_inputs
     for (int tslab = 0; tslab < nslabs; ++tslab )
         *base_inputs[tslab] = *init_vectors[tslab];
 
     for (int tslab = 0; tslab < nslabs; ++tslab )
     {
+        ProfileScope slab_scope("time slab", tslab);
         Problem * tslab_problem = timeslabs_problems[tslab];
 
         tslab_problem->Solve(*init_vectors[tslab], *base_outputs[tslab]);
@@ -596,10 +605,13 @@ void TimeStepping<Problem>::ParallelSolve(const Vector& rhs, const Array<Vector*
     MFEM_ASSERT(init_vectors.Size() == nslabs, "Number of input vectors (for initial "
                                                "conditions) must equal the number of time slabs");
 
+    ProfileScope scope("TimeStepping parallel solve");
+
     const BlockVector rhs_viewer(rhs.GetData(), GetGlobalOffsets());
 
     for (int tslab = 0; tslab < nslabs; ++tslab )
     {
+        ProfileScope slab_scope("time slab", tslab);
         MFEM_ASSERT(init_vectors[tslab]->Size() == GetInitCondSize(),
                     "For the given timeslab initcond vector size mismatch the problem");
         Problem * tslab_problem = timeslabs_problems[tslab];
@@ -1,4 +1,5 @@
 #include <iostream>
+#include <algorithm>
 #include "testhead.hpp"
 
 using namespace std;
@@ -6,6 +7,13 @@ using namespace std;
 namespace mfem
 {
 
+// local memory used by the object at level l of a hierarchy array, 0 if absent
+template <class T>
+static long LvlMemoryUsage(const Array<T*>& objs, int l)
+{
+    return (l < objs.Size() && objs[l]) ? objs[l]->MemoryUsage() : 0;
+}
+
 bool CGSolver_mod::IndicesAreCorrect(const Vector& vec) const
 {
     bool res = true;
@@ -380,32 +388,307 @@ void CGSolver_mod2::Mult(const Vector &b, Vector &x) const
    final_norm = sqrt(new_betanom);
 }
 
+BlkHypreOperator::BlkHypreOperator(Array2D<HypreParMatrix*> & Hpmats)
+    : numblocks(Hpmats.NumRows())
+{
+    hpmats.SetSize(numblocks, numblocks);
+    for (int i = 0; i < numblocks; ++i )
+        for (int j = 0; j < numblocks; ++j )
+            if (Hpmats(i,j))
+                hpmats(i,j) = Hpmats(i,j);
+            else
+                hpmats(i,j) = NULL;
+
+    plan = new BlockParMatVecPlan(hpmats);
+
+    plan->RowOffsets().Copy(block_offsets);
+    for (int i = 0; i < numblocks + 1; ++i)
+        MFEM_VERIFY(block_offsets[i] == plan->ColOffsets()[i],
+                    "BlkHypreOperator: the block operator must be square");
+    height = width = block_offsets[numblocks];
+
+    multi_op = new BlockOperator(block_offsets);
+    for (int i = 0; i < numblocks; ++i )
+        for (int j = 0; j < numblocks; ++j )
+            if (hpmats(i,j))
+                multi_op->SetBlock(i,j, hpmats(i,j));
+}
+
 void BlkHypreOperator::Mult(const Vector &x, Vector &y) const
 {
-    BlockVector x_viewer(x.GetData(), block_offsets);
-    BlockVector y_viewer(y.GetData(), block_offsets);
+    plan->Mult(x, y);
+}
 
-    for (int i = 0; i < numblocks; ++i)
+void BlkHypreOperator::MultTranspose(const Vector &x, Vector &y) const
+{
+    plan->MultTranspose(x, y);
+}
+
+BlkHypreOperator::~BlkHypreOperator()
+{
+    delete multi_op;
+    delete plan;
+}
+
+const double ConsolidatedCoarseSolver::SingularTol = 1e-12;
+
+ConsolidatedCoarseSolver::ConsolidatedCoarseSolver(HypreParMatrix & A, bool Replicate)
+    : Solver(), replicate(Replicate)
+{
+    Array2D<HypreParMatrix*> blocks(1, 1);
+    blocks(0,0) = &A;
+    Setup(blocks);
+}
+
+ConsolidatedCoarseSolver::ConsolidatedCoarseSolver(const Array2D<HypreParMatrix*> & blocks,
+                                                   bool Replicate)
+    : Solver(), replicate(Replicate)
+{
+    Setup(blocks);
+}
+
+ConsolidatedCoarseSolver::ConsolidatedCoarseSolver(BlockOperator & Op, bool Replicate)
+    : Solver(), replicate(Replicate)
+{
+    Array2D<HypreParMatrix*> blocks(Op.NumRowBlocks(), Op.NumColBlocks());
+    for (int i = 0; i < Op.NumRowBlocks(); ++i)
+        for (int j = 0; j < Op.NumColBlocks(); ++j)
+        {
+            if (Op.IsZeroBlock(i,j))
+                blocks(i,j) = NULL;
+            else
+            {
+                blocks(i,j) = dynamic_cast<HypreParMatrix*>(&Op.GetBlock(i,j));
+                MFEM_VERIFY(blocks(i,j), "Blocks must be HypreParMatrices \n");
+            }
+        }
+    Setup(blocks);
+}
+
+void ConsolidatedCoarseSolver::Setup(const Array2D<HypreParMatrix*> & blocks)
+{
+    const int nblocks = blocks.NumRows();
+    MFEM_VERIFY(blocks.NumCols() == nblocks, "The block structure must be square \n");
+    for (int b = 0; b < nblocks; ++b)
+        MFEM_VERIFY(blocks(b,b), "Diagonal blocks must be present \n");
+
+    mat = NULL;
+#ifdef MFEM_USE_SUITESPARSE
+    direct = NULL;
+#else
+    dense = NULL;
+#endif
+    singular = false;
+
+    comm = blocks(0,0)->GetComm();
+    MPI_Comm_size(comm, &num_procs);
+    MPI_Comm_rank(comm, &myid);
+
+    // local size and first global row of each block, on every rank
+    const int part_index = HYPRE_AssumedPartitionCheck() ? 0 : myid;
+    Array<int> my_info(2 * nblocks);
+    for (int b = 0; b < nblocks; ++b)
+    {
+        my_info[b] = blocks(b,b)->Height();
+        my_info[nblocks + b] = blocks(b,b)->RowPart()[part_index];
+    }
+    Array<int> info(2 * nblocks * num_procs);
+    MPI_Allgather(my_info.GetData(), 2 * nblocks, MPI_INT,
+                  info.GetData(), 2 * nblocks, MPI_INT, comm);
+
+    // rank-major consolidated numbering: block_offsets(p,b) is the position
+    // of the first row of block b owned by rank p
+    Array2D<int> block_offsets(num_procs, nblocks);
+    std::vector<std::vector<int> > block_starts(nblocks, std::vector<int>(num_procs));
+    sizes.SetSize(num_procs);
+    displs.SetSize(num_procs + 1);
+    displs[0] = 0;
+    for (int p = 0; p < num_procs; ++p)
+    {
+        sizes[p] = 0;
+        for (int b = 0; b < nblocks; ++b)
+        {
+            block_offsets(p,b) = displs[p] + sizes[p];
+            block_starts[b][p] = info[2 * nblocks * p + nblocks + b];
+            sizes[p] += info[2 * nblocks * p + b];
+        }
+        displs[p + 1] = displs[p] + sizes[p];
+    }
+    const int glob_size = displs[num_procs];
+
+    height = width = sizes[myid];
+
+    // local rows with the columns in the consolidated numbering
+    SparseMatrix local(height, glob_size);
+    SparseMatrix diag, offd;
+    HYPRE_Int * cmap;
+    for (int i = 0; i < nblocks; ++i)
+        for (int j = 0; j < nblocks; ++j)
+        {
+            if (!blocks(i,j))
+                continue;
+
+            MFEM_VERIFY(blocks(i,j)->Height() == my_info[i] && blocks(i,j)->Width() == my_info[j],
+                        "Block (" << i << "," << j << ") does not match the diagonal blocks \n");
+
+            const int row_shift = block_offsets(myid,i) - displs[myid];
+
+            blocks(i,j)->GetDiag(diag);
+            for (int r = 0; r < diag.Height(); ++r)
+                for (int k = diag.GetI()[r]; k < diag.GetI()[r + 1]; ++k)
+                    local.Add(row_shift + r, block_offsets(myid,j) + diag.GetJ()[k],
+                              diag.GetData()[k]);
+
+            blocks(i,j)->GetOffd(offd, cmap);
+            if (offd.Width() == 0)
+                continue;
+            for (int r = 0; r < offd.Height(); ++r)
+                for (int k = offd.GetI()[r]; k < offd.GetI()[r + 1]; ++k)
+                {
+                    const int gcol = cmap[offd.GetJ()[k]];
+                    const int owner = std::upper_bound(block_starts[j].begin(), block_starts[j].end(),
+                                                       gcol) - block_starts[j].begin() - 1;
+                    local.Add(row_shift + r, block_offsets(owner,j) + gcol - block_starts[j][owner],
+                              offd.GetData()[k]);
+                }
+        }
+    local.Finalize();
+
+    // gathering the rows (as row lengths, columns and values) onto the root or all ranks
+    int my_nnz = local.NumNonZeroElems();
+    Array<int> nnz(num_procs), nnz_displs(num_procs + 1);
+    MPI_Allgather(&my_nnz, 1, MPI_INT, nnz.GetData(), 1, MPI_INT, comm);
+    nnz_displs[0] = 0;
+    for (int p = 0; p < num_procs; ++p)
+        nnz_displs[p + 1] = nnz_displs[p] + nnz[p];
+
+    Array<int> row_lengths(height);
+    for (int r = 0; r < height; ++r)
+        row_lengths[r] = local.RowSize(r);
+
+    const bool holds_matrix = replicate || myid == 0;
+    int * I = NULL;
+    int * J = NULL;
+    double * V = NULL;
+    if (holds_matrix)
     {
-        for (int j = 0; j < numblocks; ++j)
-            if (hpmats(i,j))
-                hpmats(i,j)->Mult(x_viewer.GetBlock(j), y_viewer.GetBlock(i));
+        I = new int[glob_size + 1];
+        J = new int[nnz_displs[num_procs]];
+        V = new double[nnz_displs[num_procs]];
+    }
+
+    if (replicate)
+    {
+        MPI_Allgatherv(row_lengths.GetData(), height, MPI_INT,
+                       I + 1, sizes.GetData(), displs.GetData(), MPI_INT, comm);
+        MPI_Allgatherv(local.GetJ(), my_nnz, MPI_INT,
+                       J, nnz.GetData(), nnz_displs.GetData(), MPI_INT, comm);
+        MPI_Allgatherv(local.GetData(), my_nnz, MPI_DOUBLE,
+                       V, nnz.GetData(), nnz_displs.GetData(), MPI_DOUBLE, comm);
     }
+    else
+    {
+        MPI_Gatherv(row_lengths.GetData(), height, MPI_INT,
+                    I ? I + 1 : NULL, sizes.GetData(), displs.GetData(), MPI_INT, 0, comm);
+        MPI_Gatherv(local.GetJ(), my_nnz, MPI_INT,
+                    J, nnz.GetData(), nnz_displs.GetData(), MPI_INT, 0, comm);
+        MPI_Gatherv(local.GetData(), my_nnz, MPI_DOUBLE,
+                    V, nnz.GetData(), nnz_displs.GetData(), MPI_DOUBLE, 0, comm);
+    }
+
+    if (holds_matrix)
+    {
+        I[0] = 0;
+        for (int r = 0; r < glob_size; ++r)
+            I[r + 1] += I[r];
+
+        mat = new SparseMatrix(I, J, V, glob_size, glob_size);
+        mat->SortColumnIndices();
+
+#ifdef MFEM_USE_SUITESPARSE
+        direct = new UMFPackSolver(*mat);
+        singular = direct->Info[UMFPACK_STATUS] == UMFPACK_WARNING_singular_matrix ||
+                direct->Info[UMFPACK_RCOND] < SingularTol;
+#else
+        dense = new DenseMatrix(glob_size);
+        *dense = 0.0;
+        for (int r = 0; r < glob_size; ++r)
+            for (int k = I[r]; k < I[r + 1]; ++k)
+                (*dense)(r, J[k]) = V[k];
+        ipiv.SetSize(glob_size);
+        LUFactors lu(dense->Data(), ipiv.GetData());
+        singular = !lu.TryFactor(glob_size, SingularTol * dense->MaxMaxNorm());
+#endif
+
+        glob_x.SetSize(glob_size);
+        glob_y.SetSize(glob_size);
+    }
+
+    // the outcome of the factorization on the root decides on all ranks
+    int flag = singular;
+    MPI_Bcast(&flag, 1, MPI_INT, 0, comm);
+    singular = flag;
 }
 
-void BlkHypreOperator::MultTranspose(const Vector &x, Vector &y) const
+void ConsolidatedCoarseSolver::Solve() const
 {
-    BlockVector x_viewer(x.GetData(), block_offsets);
-    BlockVector y_viewer(y.GetData(), block_offsets);
+#ifdef MFEM_USE_SUITESPARSE
+    direct->Mult(glob_x, glob_y);
+#else
+    glob_y = glob_x;
+    LUFactors lu(dense->Data(), const_cast<int*>(ipiv.GetData()));
+    lu.Solve(glob_y.Size(), 1, glob_y.GetData());
+#endif
+}
 
-    for (int i = 0; i < numblocks; ++i)
+void ConsolidatedCoarseSolver::Mult(const Vector &x, Vector &y) const
+{
+    MFEM_VERIFY(!singular, "The consolidated coarse matrix is singular, "
+                "an iterative coarse solver must be used instead \n");
+
+    if (replicate)
     {
-        for (int j = 0; j < numblocks; ++j)
-            if (hpmats(i,j))
-                hpmats(i,j)->MultTranspose(x_viewer.GetBlock(j), y_viewer.GetBlock(i));
+        MPI_Allgatherv(x.GetData(), height, MPI_DOUBLE, glob_x.GetData(),
+                       sizes.GetData(), displs.GetData(), MPI_DOUBLE, comm);
+        Solve();
+        for (int i = 0; i < height; ++i)
+            y[i] = glob_y[displs[myid] + i];
+    }
+    else
+    {
+        MPI_Gatherv(x.GetData(), height, MPI_DOUBLE, glob_x.GetData(),
+                    sizes.GetData(), displs.GetData(), MPI_DOUBLE, 0, comm);
+        if (myid == 0)
+            Solve();
+        MPI_Scatterv(glob_y.GetData(), sizes.GetData(), displs.GetData(), MPI_DOUBLE,
+                     y.GetData(), height, MPI_DOUBLE, 0, comm);
     }
 }
 
+ConsolidatedCoarseSolver::~ConsolidatedCoarseSolver()
+{
+#ifdef MFEM_USE_SUITESPARSE
+    delete direct;
+#else
+    delete dense;
+#endif
+    delete mat;
+}
+
+long ConsolidatedCoarseSolver::MemoryUsage() const
+{
+    long mem = sizes.MemoryUsage() + displs.MemoryUsage() +
+            glob_x.MemoryUsage() + glob_y.MemoryUsage();
+    if (mat)
+        mem += mat->MemoryUsage();
+#ifndef MFEM_USE_SUITESPARSE
+    if (dense)
+        mem += dense->MemoryUsage();
+    mem += ipiv.MemoryUsage();
+#endif
+    return mem;
+}
+
 void BdrConditions::Set(const std::vector<Array<int>* >& bdr_attribs_)
 {
     for (unsigned int i = 0; i < bdr_attribs.size(); ++i)
@@ -1154,7 +1437,7 @@ MultigridToolsHierarchy::MultigridToolsHierarchy(GeneralHierarchy& hierarchy_, F
             el2dofs_funct_lvls[l] = hierarchy.GetElementToDofs(*space_names_funct, l, el2dofs_row_offsets[l],
                                                                el2dofs_col_offsets[l]);
 
-            AE_e_lvls[l] = Transpose(*hierarchy.GetPspace(SpaceName::L2, l));
+            AE_e_lvls[l] = ConstructAE_e(l);
             if (numblocks_funct > 1) // S is present
             {
                 SchwarzSmoothers_lvls[l] = new LocalProblemSolverWithS
@@ -1288,6 +1571,97 @@ MultigridToolsHierarchy::MultigridToolsHierarchy(GeneralHierarchy& hierarchy_, F
         delete fullbdr_attribs[i];
 }
 
+void MultigridToolsHierarchy::GetMemoryUsage(int l, long& ops_mem, long& smoothers_mem,
+                                             long& mats_mem) const
+{
+    ops_mem = 0;
+    if (l < FunctOps_lvls.Size() && FunctOps_lvls[l])
+        ops_mem += BlockOperatorMemoryUsage(*FunctOps_lvls[l]);
+    if (descr.with_nobnd_op && l < FunctOps_nobnd_lvls.Size() && FunctOps_nobnd_lvls[l])
+        ops_mem += BlockOperatorMemoryUsage(*FunctOps_nobnd_lvls[l]);
+
+    smoothers_mem = 0;
+    if (descr.with_Schwarz && l < SchwarzSmoothers_lvls.Size() && SchwarzSmoothers_lvls[l])
+        smoothers_mem += SchwarzSmoothers_lvls[l]->MemoryUsage();
+    if (descr.with_Hcurl && l < HcurlSmoothers_lvls.Size() && HcurlSmoothers_lvls[l])
+        smoothers_mem += HcurlSmoothers_lvls[l]->MemoryUsage();
+
+    mats_mem = 0;
+    if (descr.with_Schwarz || descr.with_coarsest_partfinder)
+        mats_mem += LvlMemoryUsage(Funct_mat_lvls, l) + LvlMemoryUsage(Constraint_mat_lvls, l);
+    if (descr.with_Schwarz)
+        mats_mem += LvlMemoryUsage(Mass_mat_lvls, l) + LvlMemoryUsage(AE_e_lvls, l);
+    mats_mem += LvlMemoryUsage(el2dofs_funct_lvls, l);
+}
+
+long MultigridToolsHierarchy::MemoryUsage(int level) const
+{
+    long ops_mem, smoothers_mem, mats_mem;
+    GetMemoryUsage(level, ops_mem, smoothers_mem, mats_mem);
+    return ops_mem + smoothers_mem + mats_mem;
+}
+
+long MultigridToolsHierarchy::MemoryUsage() const
+{
+    long mem = 0;
+    for (int l = 0; l < nlevels; ++l)
+        mem += MemoryUsage(l);
+    return mem;
+}
+
+void MultigridToolsHierarchy::PrintMemoryUsage(std::ostream& out) const
+{
+    MPI_Comm comm = hierarchy.GetFinestParMesh()->GetComm();
+    int myid;
+    MPI_Comm_rank(comm, &myid);
+
+    if (myid == 0)
+        out << "MultigridToolsHierarchy memory usage: \n";
+
+    for (int l = 0; l < nlevels; ++l)
+    {
+        long ops_mem, smoothers_mem, mats_mem;
+        GetMemoryUsage(l, ops_mem, smoothers_mem, mats_mem);
+
+        std::string lvl = "level " + std::to_string(l) + ": ";
+        mfem::PrintMemoryUsage(comm, (lvl + "operators").c_str(), ops_mem, out);
+        mfem::PrintMemoryUsage(comm, (lvl + "smoothers").c_str(), smoothers_mem, out);
+        mfem::PrintMemoryUsage(comm, (lvl + "local matrices").c_str(), mats_mem, out);
+    }
+
+    mfem::PrintMemoryUsage(comm, "total", MemoryUsage(), out);
+}
+
+Table * MultigridToolsHierarchy::ConstructAE_e(int l)
+{
+    // coarse elements at level l + 1 as agglomerates of elements at level l
+    Table * AEc_e = TransposedPattern(*hierarchy.GetPspace(SpaceName::L2, l));
+
+    if (descr.Schwarz_AE_size <= 0)
+        return AEc_e;
+
+    ParMesh * pmesh_l = hierarchy.GetPmesh(l);
+
+    if (!descr.Schwarz_AE_nested)
+    {
+        delete AEc_e;
+        return PartitionedAE_e(*pmesh_l, descr.Schwarz_AE_size);
+    }
+
+    // partitioning coarse elements so that the resulting agglomerates,
+    // unions of coarse elements, have approximately the target size
+    ParMesh * pmesh_coarse = hierarchy.GetPmesh(l + 1);
+    int ratio = std::max(1, pmesh_l->GetNE() / std::max(1, pmesh_coarse->GetNE()));
+
+    Table * AE_ec = PartitionedAE_e(*pmesh_coarse, std::max(1, descr.Schwarz_AE_size / ratio));
+    Table * AE_e = mfem::Mult(*AE_ec, *AEc_e);
+
+    delete AE_ec;
+    delete AEc_e;
+
+    return AE_e;
+}
+
 int MultigridToolsHierarchy::Update(bool recoarsen)
 {
     int hierarchy_upd_cnt = hierarchy.GetUpdateCounter();
@@ -1448,7 +1822,7 @@ int MultigridToolsHierarchy::Update(bool recoarsen)
             el2dofs_funct_lvls.Prepend(hierarchy.GetElementToDofs(*space_names_funct, 0, el2dofs_row_offsets_new,
                                                                   el2dofs_col_offsets_new));
 
-            SparseMatrix * AE_e_new = Transpose(*hierarchy.GetPspace(SpaceName::L2, 0));
+            Table * AE_e_new = ConstructAE_e(0);
             AE_e_lvls.Prepend(AE_e_new);
 
             std::vector<Array<int>* > essbdr_dofs_funct_0 =
@@ -1775,7 +2149,7 @@ FOSLSProblem::FOSLSProblem(GeneralHierarchy& Hierarchy, BdrConditions& bdr_condi
       pbforms(fe_formul.Nblocks()),
       CFOSLSop(NULL), own_cfoslsop(false), CFOSLSop_nobnd(NULL), own_cfoslsop_nobnd(false),
       trueRhs(NULL), trueX(NULL), trueBnd(NULL), x(NULL),
-      prec_option(0), prec(NULL), solver(NULL), verbose(verbose_)
+      prec_option(0), prec(NULL), solver(NULL), solver_op(NULL), amg_reuse(0), solver_option(0), verbose(verbose_)
 {
     estimators.SetSize(0);
 
@@ -1815,7 +2189,7 @@ FOSLSProblem::FOSLSProblem(GeneralHierarchy& Hierarchy, int level, BdrConditions
       pbforms(fe_formul.Nblocks()),
       CFOSLSop(NULL), own_cfoslsop(false), CFOSLSop_nobnd(NULL), own_cfoslsop_nobnd(false),
       trueRhs(NULL), trueX(NULL), trueBnd(NULL), x(NULL),
-      prec_option(0), prec(NULL), solver(NULL), verbose(verbose_)
+      prec_option(0), prec(NULL), solver(NULL), solver_op(NULL), amg_reuse(0), solver_option(0), verbose(verbose_)
 {
     estimators.SetSize(0);
 
@@ -1853,7 +2227,7 @@ FOSLSProblem::FOSLSProblem(ParMesh& pmesh_, BdrConditions& bdr_conditions,
       pbforms(fe_formul.Nblocks()),
       CFOSLSop(NULL), own_cfoslsop(false), CFOSLSop_nobnd(NULL), own_cfoslsop_nobnd(false),
       trueRhs(NULL), trueX(NULL), trueBnd(NULL), x(NULL),
-      prec_option(0), prec(NULL), solver(NULL), verbose(verbose_)
+      prec_option(0), prec(NULL), solver(NULL), solver_op(NULL), amg_reuse(0), solver_option(0), verbose(verbose_)
 {
     estimators.SetSize(0);
 
@@ -1912,6 +2286,8 @@ FOSLSProblem::~FOSLSProblem()
     if (solver)
         delete solver;
 
+    delete solver_op;
+
     if (prec)
         delete prec;
 
@@ -1935,6 +2311,64 @@ FOSLSProblem::~FOSLSProblem()
 }
 
 
+long FOSLSProblem::MemoryUsage() const
+{
+    long mem = 0;
+
+    for (int i = 0; i < grfuns.Size(); ++i)
+        if (grfuns[i])
+            mem += grfuns[i]->MemoryUsage();
+
+    for (int i = 0; i < plforms.Size(); ++i)
+        if (plforms[i])
+            mem += plforms[i]->MemoryUsage();
+
+    // spaces taken from the hierarchy are accounted there
+    if (!hierarchy)
+        for (int i = 0; i < pfes.Size(); ++i)
+            if (pfes[i])
+                mem += pfes[i]->MemoryUsage();
+
+    if (forms_initialized)
+        mem += pbforms.MemoryUsage();
+
+    if (hpmats_initialized)
+    {
+        for (int i = 0; i < hpmats.NumRows(); ++i)
+            for (int j = 0; j < hpmats.NumCols(); ++j)
+                if (hpmats(i,j))
+                    mem += hpmats(i,j)->MemoryUsage();
+
+        for (int i = 0; i < hpmats_nobnd.NumRows(); ++i)
+            for (int j = 0; j < hpmats_nobnd.NumCols(); ++j)
+                if (hpmats_nobnd(i,j))
+                    mem += hpmats_nobnd(i,j)->MemoryUsage();
+    }
+
+    if (trueRhs)
+        mem += trueRhs->MemoryUsage();
+    if (trueX)
+        mem += trueX->MemoryUsage();
+    if (trueBnd)
+        mem += trueBnd->MemoryUsage();
+    if (x)
+        mem += x->MemoryUsage();
+
+    if (solver_op)
+        mem += solver_op->MemoryUsage();
+
+    for (int i = 0; i < prec_amgs.Size(); ++i)
+        if (prec_amgs[i])
+            mem += prec_amgs[i]->MemoryUsage();
+
+    return mem;
+}
+
+void FOSLSProblem::PrintMemoryUsage(std::ostream& out) const
+{
+    mfem::PrintMemoryUsage(pmesh.GetComm(), "FOSLSProblem", MemoryUsage(), out);
+}
+
 void FOSLSProblem::Update()
 {
     if (!is_dynamic && verbose)
@@ -1979,9 +2413,13 @@ void FOSLSProblem::Update()
         delete solver;
     solver = NULL;
 
+    delete solver_op;
+    solver_op = NULL;
+
     if (prec)
         delete prec;
     prec = NULL;
+    prec_amgs.SetSize(0);
 
     if (hpmats_initialized)
         for (int i = 0; i < hpmats.NumRows(); ++i)
@@ -2085,11 +2523,33 @@ void FOSLSProblem::InitSolver(bool verbose)
     double rtol = 1e-12;//1e-7;//1e-9;
     double atol = 1e-14;//1e-9;//1e-12;
 
-    solver = new MINRESSolver(comm);
+    switch (solver_option)
+    {
+    case MINRES_SOLVER:
+        solver = new MINRESSolver(comm);
+        break;
+    case PIPELINED_MINRES_SOLVER:
+        solver = new PipelinedMINRESSolver(comm);
+        break;
+    case CG_SOLVER:
+        solver = new CGSolver(comm);
+        break;
+    case PIPELINED_CG_SOLVER:
+        solver = new PipelinedCGSolver(comm);
+        break;
+    case SSTEP_CG_SOLVER:
+        solver = new SStepCGSolver(comm);
+        break;
+    default:
+        MFEM_ABORT("Unknown solver_option = " << solver_option);
+    }
     solver->SetAbsTol(atol);
     solver->SetRelTol(rtol);
     solver->SetMaxIter(max_iter);
-    solver->SetOperator(*CFOSLSop);
+    if (solver_op)
+        solver->SetOperator(*solver_op);
+    else
+        solver->SetOperator(*CFOSLSop);
     if (prec)
          solver->SetPreconditioner(*prec);
     solver->SetPrintLevel(0);
@@ -2099,6 +2559,60 @@ void FOSLSProblem::InitSolver(bool verbose)
     solver_initialized = true;
 }
 
+void FOSLSProblem::ResetOp(BlockOperator& op, bool capture)
+{
+    MFEM_ASSERT(op.Height() == blkoffsets_true[blkoffsets_true.Size() - 1]
+                && op.Width() == op.Height(), "Replacing operator sizes mismatch"
+                                              " the existing's");
+    if (CFOSLSop)
+        delete CFOSLSop;
+
+    CFOSLSop = &op;
+
+    own_cfoslsop = capture;
+
+    // solver_op refers to the blocks of the old operator, so it must not be
+    // restored by InitSolver() after the replacement
+    delete solver_op;
+    solver_op = NULL;
+
+    int nblocks = op.NumRowBlocks();
+    Array2D<HypreParMatrix*> op_hpmats(nblocks, nblocks);
+    bool all_hypre = true;
+    for (int i = 0; i < nblocks; ++i)
+        for (int j = 0; j < nblocks; ++j)
+        {
+            op_hpmats(i,j) = NULL;
+            if (!op.IsZeroBlock(i,j))
+            {
+                op_hpmats(i,j) = dynamic_cast<HypreParMatrix*>(&op.GetBlock(i,j));
+                if (!op_hpmats(i,j))
+                    all_hypre = false;
+            }
+        }
+
+    if (all_hypre)
+        solver_op = new BlkHypreOperator(op_hpmats);
+}
+
+void FOSLSProblem::SetSolverOption(int option, bool verbose)
+{
+    solver_option = option;
+    if (!solver_initialized)
+        return;
+
+    IterativeSolver * old_solver = solver;
+    InitSolver(verbose);
+
+    solver->SetRelTol(old_solver->GetRelTol());
+    solver->SetAbsTol(old_solver->GetAbsTol());
+    solver->SetMaxIter(old_solver->GetMaxIter());
+    solver->SetPrintLevel(old_solver->GetPrintLevel());
+    solver->iterative_mode = old_solver->iterative_mode;
+
+    delete old_solver;
+}
+
 // actually, constructs a vector with exact solution
 // f.e. projections and 0's for Lagrange multiplier
 BlockVector * FOSLSProblem::GetExactSolProj()
@@ -2354,16 +2868,46 @@ void FOSLSProblem::BuildSystem(bool verbose)
     MFEM_ASSERT(spaces_initialized && forms_initialized,
                 "Cannot build system if spaces or forms were not initialized");
 
+    ProfileScope scope("FOSLSProblem setup");
+
     CreateOffsetsRhsSol();
 
+    profiler.Start("assembly");
     AssembleSystem(verbose);
+    profiler.Stop();
 
+    profiler.Start("solver setup");
     InitSolver(verbose);
 
     ResetPrec(prec_option);
     //CreatePrec(*CFOSLSop, prec_option, verbose);
 
     UpdateSolverPrec();
+    profiler.Stop();
+}
+
+HypreBoomerAMG * FOSLSProblem::CreateAMG(HypreParMatrix & A, int blk)
+{
+    HypreBoomerAMG * amg = new HypreBoomerAMG(A);
+    amg->SetPrintLevel(0);
+    amg->iterative_mode = false;
+
+    if (amg_reuse > 0)
+    {
+        amg->SetReuseSetup(amg_reuse);
+        // the solvers are matched by the block they precondition, not by the
+        // order in which CreatePrec() creates them
+        if (blk < old_prec_amgs.Size() && old_prec_amgs[blk])
+            amg->TakeSetup(*old_prec_amgs[blk]);
+
+        for (int i = prec_amgs.Size(); i <= blk; ++i)
+            prec_amgs.Append(NULL);
+        MFEM_ASSERT(!prec_amgs[blk], "BoomerAMG for block " << blk
+                    << " was already created");
+        prec_amgs[blk] = amg;
+    }
+
+    return amg;
 }
 
 // works correctly only for problems with homogeneous initial conditions?
@@ -2556,6 +3100,9 @@ void FOSLSProblem::AssembleSystem(bool verbose)
                CFOSLSop->SetBlock(i,j, hpmats(i,j));
    own_cfoslsop = true;
 
+   delete solver_op;
+   solver_op = new BlkHypreOperator(hpmats);
+
    CFOSLSop_nobnd = new BlockOperator(blkoffsets_true);
    for (int i = 0; i < numblocks; ++i)
        for (int j = 0; j < numblocks; ++j)
@@ -3105,6 +3652,8 @@ void FOSLSProblem::SolveProblem(const Vector& rhs, Vector& sol, bool verbose, bo
 {
     MFEM_ASSERT(solver_initialized, "Solver is not initialized \n");
 
+    ProfileScope scope("FOSLSProblem solve");
+
     chrono.Clear();
     chrono.Start();
 
@@ -3112,6 +3661,8 @@ void FOSLSProblem::SolveProblem(const Vector& rhs, Vector& sol, bool verbose, bo
 
     chrono.Stop();
 
+    profiler.Count("iterations", solver->GetNumIterations());
+
     if (verbose)
     {
        if (solver->GetConverged())
@@ -3124,6 +3675,35 @@ void FOSLSProblem::SolveProblem(const Vector& rhs, Vector& sol, bool verbose, bo
     }
 }
 
+void FOSLSProblem::SolveProblem(const MultiVector& rhs, MultiVector& sol, bool verbose) const
+{
+    MFEM_ASSERT(solver_initialized, "Solver is not initialized \n");
+
+    ProfileScope scope("FOSLSProblem solve");
+
+    chrono.Clear();
+    chrono.Start();
+
+    solver->Mult(rhs, sol);
+
+    chrono.Stop();
+
+    profiler.Count("iterations", solver->GetNumIterations());
+
+    if (verbose)
+    {
+       if (solver->GetConverged())
+          std::cout << "Iterative solver converged for all " << rhs.NumVectors()
+                    << " righthand sides in " << solver->GetNumIterations()
+                    << " iterations with a max residual norm of " << solver->GetFinalNorm() << ".\n";
+       else
+          std::cout << "Iterative solver did not converge for all " << rhs.NumVectors()
+                    << " righthand sides in " << solver->GetNumIterations()
+                    << " iterations. Max residual norm is " << solver->GetFinalNorm() << ".\n";
+       std::cout << "Iterative solver took " << chrono.RealTime() << "s. \n";
+    }
+}
+
 void FOSLSProblem::SolveProblem(const Vector& rhs, bool verbose, bool compute_error) const
 {
     *trueX = 0.0;
@@ -3353,9 +3933,7 @@ void FOSLSProblem_HdivL2hyp::CreatePrec(BlockOperator& op, int prec_option, bool
 
         invA->iterative_mode = false;
 
-        invS = new HypreBoomerAMG(*Schur);
-        ((HypreBoomerAMG *)invS)->SetPrintLevel(0);
-        ((HypreBoomerAMG *)invS)->iterative_mode = false;
+        invS = CreateAMG(*Schur, 1);
     }
 
     prec = new BlockDiagonalPreconditioner(blkoffsets_true);
@@ -3560,9 +4138,7 @@ void FOSLSProblem_HdivL2L2hyp::CreatePrec(BlockOperator& op, int prec_option, bo
 
         invC = new HypreSmoother(C, HypreSmoother::Type::l1GS, 1);
 
-        invS = new HypreBoomerAMG(*Schur);
-        ((HypreBoomerAMG *)invS)->SetPrintLevel(0);
-        ((HypreBoomerAMG *)invS)->iterative_mode = false;
+        invS = CreateAMG(*Schur, 2);
     }
 
     prec = new BlockDiagonalPreconditioner(blkoffsets_true);
@@ -3859,13 +4435,9 @@ void FOSLSProblem_HdivH1L2hyp::CreatePrec(BlockOperator& op, int prec_option, bo
         invA = new HypreDiagScale(A);
         invA->iterative_mode = false;
 
-        invC = new HypreBoomerAMG(C);
-        ((HypreBoomerAMG*)invC)->SetPrintLevel(0);
-        ((HypreBoomerAMG*)invC)->iterative_mode = false;
+        invC = CreateAMG(C, 1);
 
-        invS = new HypreBoomerAMG(*Schur);
-        ((HypreBoomerAMG *)invS)->SetPrintLevel(0);
-        ((HypreBoomerAMG *)invS)->iterative_mode = false;
+        invS = CreateAMG(*Schur, 2);
     }
 
 
@@ -3935,13 +4507,9 @@ void FOSLSProblem_HdivH1parab::CreatePrec(BlockOperator& op, int prec_option, bo
         invA = new HypreDiagScale(A);
         invA->iterative_mode = false;
 
-        invC = new HypreBoomerAMG(C);
-        ((HypreBoomerAMG*)invC)->SetPrintLevel(0);
-        ((HypreBoomerAMG*)invC)->iterative_mode = false;
+        invC = CreateAMG(C, 1);
 
-        invS = new HypreBoomerAMG(*Schur);
-        ((HypreBoomerAMG *)invS)->SetPrintLevel(0);
-        ((HypreBoomerAMG *)invS)->iterative_mode = false;
+        invS = CreateAMG(*Schur, 2);
     }
 
 
@@ -4113,13 +4681,9 @@ void FOSLSProblem_HdivH1wave::CreatePrec(BlockOperator& op, int prec_option, boo
         invA = new HypreDiagScale(A);
         invA->iterative_mode = false;
 
-        invC = new HypreBoomerAMG(C);
-        ((HypreBoomerAMG*)invC)->SetPrintLevel(0);
-        ((HypreBoomerAMG*)invC)->iterative_mode = false;
+        invC = CreateAMG(C, 1);
 
-        invS = new HypreBoomerAMG(*Schur);
-        ((HypreBoomerAMG *)invS)->SetPrintLevel(0);
-        ((HypreBoomerAMG *)invS)->iterative_mode = false;
+        invS = CreateAMG(*Schur, 2);
     }
 
 
@@ -4290,13 +4854,9 @@ void FOSLSProblem_HdivH1lapl::CreatePrec(BlockOperator& op, int prec_option, boo
         invA = new HypreDiagScale(A);
         invA->iterative_mode = false;
 
-        invC = new HypreBoomerAMG(C);
-        ((HypreBoomerAMG*)invC)->SetPrintLevel(0);
-        ((HypreBoomerAMG*)invC)->iterative_mode = false;
+        invC = CreateAMG(C, 1);
 
-        invS = new HypreBoomerAMG(*Schur);
-        ((HypreBoomerAMG *)invS)->SetPrintLevel(0);
-        ((HypreBoomerAMG *)invS)->iterative_mode = false;
+        invS = CreateAMG(*Schur, 2);
     }
 
 
@@ -4471,9 +5031,7 @@ void FOSLSProblem_MixedLaplace::CreatePrec(BlockOperator& op, int prec_option, b
 
         invA->iterative_mode = false;
 
-        invS = new HypreBoomerAMG(*Schur);
-        ((HypreBoomerAMG *)invS)->SetPrintLevel(0);
-        ((HypreBoomerAMG *)invS)->iterative_mode = false;
+        invS = CreateAMG(*Schur, 1);
     }
 
     prec = new BlockDiagonalPreconditioner(blkoffsets_true);
@@ -4489,6 +5047,88 @@ void FOSLSProblem_MixedLaplace::CreatePrec(BlockOperator& op, int prec_option, b
 
 }
 
+void FOSLSProblem_MixedLaplace::SolveHybridized(bool verbose, bool compute_error) const
+{
+    MFEM_ASSERT(solver_initialized, "Solver is not initialized \n");
+
+    ProfileScope scope("FOSLSProblem hybridized solve");
+
+    chrono.Clear();
+    chrono.Start();
+
+    const int dim = pmesh.Dimension();
+    FiniteElementCollection * trace_coll;
+    if (dim == 4)
+        trace_coll = new DG0_Interface_4DFECollection(0, dim);
+    else
+        trace_coll = new DG_Interface_FECollection(fe_formul.Feorder(), dim);
+    ParFiniteElementSpace * trace_space = new ParFiniteElementSpace(&pmesh, trace_coll);
+
+    Array<int> ess_tdofs;
+    pfes[0]->GetEssentialTrueDofs(bdr_conds.GetBdrAttribs(0), ess_tdofs);
+
+    // the forms only borrow the integrators of the formulation
+    ParBilinearForm * a = new ParBilinearForm(pfes[0]);
+    a->BorrowDomainIntegrator(fe_formul.GetBlfi(0,0));
+    ParMixedBilinearForm * b = new ParMixedBilinearForm(pfes[0], pfes[1]);
+    b->BorrowDomainIntegrator(fe_formul.GetBlfi(1,0));
+    a->EnableHybridization(trace_space, new NormalTraceJumpIntegrator(), ess_tdofs, b);
+    a->Assemble();
+
+    // boundary conditions and righthand side on the dofs of both spaces
+    BlockVector x_hyb(*x);
+    BlockVector rhs_hyb(blkoffsets);
+    for (int i = 0; i < fe_formul.Nblocks(); ++i)
+        rhs_hyb.GetBlock(i) = *grfuns[i + fe_formul.Nblocks()];
+
+    OperatorHandle H(Operator::HYPRE_PARCSR);
+    Vector X, B;
+    a->FormLinearSystem(ess_tdofs, x_hyb, rhs_hyb, H, X, B);
+
+    HypreBoomerAMG amg(*H.As<HypreParMatrix>());
+    amg.SetPrintLevel(0);
+    amg.iterative_mode = false;
+
+    CGSolver pcg(pmesh.GetComm());
+    pcg.SetAbsTol(solver->GetAbsTol());
+    pcg.SetRelTol(solver->GetRelTol());
+    pcg.SetMaxIter(solver->GetMaxIter());
+    pcg.SetPrintLevel(0);
+    pcg.SetOperator(*H.Ptr());
+    pcg.SetPreconditioner(amg);
+    pcg.Mult(B, X);
+
+    a->RecoverFEMSolution(X, rhs_hyb, x_hyb);
+    for (int i = 0; i < fe_formul.Nblocks(); ++i)
+        pfes[i]->GetRestrictionMatrix()->Mult(x_hyb.GetBlock(i), trueX->GetBlock(i));
+
+    chrono.Stop();
+
+    profiler.Count("iterations", pcg.GetNumIterations());
+
+    if (verbose)
+    {
+       if (pcg.GetConverged())
+          std::cout << "PCG for the hybridized system converged in " << pcg.GetNumIterations()
+                    << " iterations with a residual norm of " << pcg.GetFinalNorm() << ".\n";
+       else
+          std::cout << "PCG for the hybridized system did not converge in " << pcg.GetNumIterations()
+                    << " iterations. Residual norm is " << pcg.GetFinalNorm() << ".\n";
+       std::cout << "Hybridized solve took " << chrono.RealTime() << "s. \n";
+    }
+
+    delete a;
+    delete b;
+    delete trace_space;
+    delete trace_coll;
+
+    DistributeSolution();
+
+    bool checkbnd = false;
+    if (compute_error)
+        ComputeError(verbose, checkbnd);
+}
+
 void FOSLSProblem_MixedLaplace::ComputeExtraError(const Vector& vec) const
 {
     BlockVector vec_viewer(vec.GetData(), blkoffsets_true);
@@ -4652,9 +5292,7 @@ void FOSLSProblem_Laplace::CreatePrec(BlockOperator& op, int prec_option, bool v
     }
     else // standard case
     {
-        invA = new HypreBoomerAMG(A);
-        ((HypreBoomerAMG *)invA)->SetPrintLevel(0);
-        ((HypreBoomerAMG *)invA)->iterative_mode = false;
+        invA = CreateAMG(A, 0);
     }
 
     if (prec_option > 0)
@@ -4913,15 +5551,11 @@ void FOSLSDivfreeProblem::CreatePrec(BlockOperator & op, int prec_option, bool v
     }
     else // standard case
     {
-        invA = new HypreBoomerAMG(A);
-        ((HypreBoomerAMG*)invA)->SetPrintLevel(0);
-        ((HypreBoomerAMG*)invA)->iterative_mode = false;
+        invA = CreateAMG(A, 0);
 
         if (op.NumRowBlocks() > 1) // case when S is present
         {
-            invC = new HypreBoomerAMG(*C);
-            ((HypreBoomerAMG*)invC)->SetPrintLevel(0);
-            ((HypreBoomerAMG*)invC)->iterative_mode = false;
+            invC = CreateAMG(*C, 1);
         }
     }
 
@@ -5195,7 +5829,7 @@ GeneralHierarchy::GeneralHierarchy(int num_levels, ParMesh& pmesh_)
     : num_lvls(num_levels), pmesh(pmesh_), with_hcurl(false),
       divfreedops_constructed (false), doftruedofs_constructed (true),
       el2dofs_constructed(false),
-      pmesh_ne(0), update_counter(0),
+      pmesh_ne(0), update_counter(0), geom_factors_flags(0),
       fully_initialized(false)
 {}
 
@@ -5398,12 +6032,83 @@ GeneralHierarchy::GeneralHierarchy(int num_levels, ParMesh& pmesh_, int feorder_
     : num_lvls(num_levels), pmesh(pmesh_), feorder(feorder_), with_hcurl(with_hcurl_),
       divfreedops_constructed (false), doftruedofs_constructed (true),
       el2dofs_constructed(false),
-      pmesh_ne(0), update_counter(0),
+      pmesh_ne(0), update_counter(0), geom_factors_flags(0),
       fully_initialized(true)
 {
     Init(feorder_, verbose, with_hcurl_);
 }
 
+void GeneralHierarchy::GetMemoryUsage(int l, long& mesh_mem, long& spaces_mem,
+                                      long& interp_mem, long& other_mem) const
+{
+    mesh_mem = LvlMemoryUsage(pmesh_lvls, l);
+
+    // dof_truedof matrices are owned and thus accounted by the spaces
+    spaces_mem = LvlMemoryUsage(Hdiv_space_lvls, l) + LvlMemoryUsage(Hcurl_space_lvls, l) +
+            LvlMemoryUsage(H1_space_lvls, l) + LvlMemoryUsage(L2_space_lvls, l) +
+            LvlMemoryUsage(Hdivskew_space_lvls, l);
+
+    // interpolation from level l + 1 to level l
+    interp_mem = LvlMemoryUsage(P_H1_lvls, l) + LvlMemoryUsage(P_Hdiv_lvls, l) +
+            LvlMemoryUsage(P_L2_lvls, l) + LvlMemoryUsage(P_Hcurl_lvls, l) +
+            LvlMemoryUsage(P_Hdivskew_lvls, l) +
+            LvlMemoryUsage(TrueP_H1_lvls, l) + LvlMemoryUsage(TrueP_Hdiv_lvls, l) +
+            LvlMemoryUsage(TrueP_L2_lvls, l) + LvlMemoryUsage(TrueP_Hcurl_lvls, l) +
+            LvlMemoryUsage(TrueP_Hdivskew_lvls, l);
+
+    other_mem = LvlMemoryUsage(DivfreeDops_lvls, l) +
+            LvlMemoryUsage(el2dofs_L2_lvls, l) + LvlMemoryUsage(el2dofs_H1_lvls, l) +
+            LvlMemoryUsage(el2dofs_Hdiv_lvls, l) + LvlMemoryUsage(el2dofs_Hcurl_lvls, l) +
+            LvlMemoryUsage(el2dofs_Hdivskew_lvls, l);
+}
+
+long GeneralHierarchy::MemoryUsage(int level) const
+{
+    long mesh_mem, spaces_mem, interp_mem, other_mem;
+    GetMemoryUsage(level, mesh_mem, spaces_mem, interp_mem, other_mem);
+    return mesh_mem + spaces_mem + interp_mem + other_mem;
+}
+
+long GeneralHierarchy::MemoryUsage() const
+{
+    // the finest ("dynamic") mesh and spaces are separate from the level 0 copies
+    long mem = pmesh.MemoryUsage() + Hdiv_space->MemoryUsage() +
+            H1_space->MemoryUsage() + L2_space->MemoryUsage();
+    if (with_hcurl)
+        mem += Hcurl_space->MemoryUsage();
+    if (pmesh.Dimension() == 4)
+        mem += Hdivskew_space->MemoryUsage();
+
+    for (int l = 0; l < num_lvls; ++l)
+        mem += MemoryUsage(l);
+
+    return mem;
+}
+
+void GeneralHierarchy::PrintMemoryUsage(std::ostream& out) const
+{
+    MPI_Comm comm = pmesh.GetComm();
+    int myid;
+    MPI_Comm_rank(comm, &myid);
+
+    if (myid == 0)
+        out << "GeneralHierarchy memory usage: \n";
+
+    for (int l = 0; l < num_lvls; ++l)
+    {
+        long mesh_mem, spaces_mem, interp_mem, other_mem;
+        GetMemoryUsage(l, mesh_mem, spaces_mem, interp_mem, other_mem);
+
+        std::string lvl = "level " + std::to_string(l) + ": ";
+        mfem::PrintMemoryUsage(comm, (lvl + "mesh").c_str(), mesh_mem, out);
+        mfem::PrintMemoryUsage(comm, (lvl + "f.e. spaces").c_str(), spaces_mem, out);
+        mfem::PrintMemoryUsage(comm, (lvl + "interpolation").c_str(), interp_mem, out);
+        mfem::PrintMemoryUsage(comm, (lvl + "other").c_str(), other_mem, out);
+    }
+
+    mfem::PrintMemoryUsage(comm, "total", MemoryUsage(), out);
+}
+
 GeneralHierarchy::~GeneralHierarchy()
 {
     int dim = pmesh.Dimension();
@@ -5510,6 +6215,14 @@ GeneralHierarchy::~GeneralHierarchy()
 
 }
 
+void GeneralHierarchy::EnableGeometricFactors(int flags)
+{
+    geom_factors_flags = flags;
+    pmesh.EnableGeometricFactors(flags);
+    for (int l = 0; l < pmesh_lvls.Size(); ++l)
+        pmesh_lvls[l]->EnableGeometricFactors(flags);
+}
+
 int GeneralHierarchy::Update()
 {
     // TODO: Instead of checking the mesh number of elements to define
@@ -5527,6 +6240,7 @@ int GeneralHierarchy::Update()
 
         // updating mesh
         ParMesh * pmesh_new = new ParMesh(pmesh);
+        pmesh_new->EnableGeometricFactors(geom_factors_flags);
         pmesh_lvls.Prepend(pmesh_new);
 
         int dim = pmesh.Dimension();
@@ -5710,21 +6424,21 @@ int GeneralHierarchy::Update()
             ParFiniteElementSpace * pfes;
 
             pfes = L2_space_lvls[0];
-            SparseMatrix * el2dofs_L2_new = ElementToDofs(*pfes);
+            Table * el2dofs_L2_new = ElementToDofs(*pfes);
             el2dofs_L2_lvls.Prepend(el2dofs_L2_new);
 
             pfes = H1_space_lvls[0];
-            SparseMatrix * el2dofs_H1_new = ElementToDofs(*pfes);
+            Table * el2dofs_H1_new = ElementToDofs(*pfes);
             el2dofs_H1_lvls.Prepend(el2dofs_H1_new);
 
             pfes = Hdiv_space_lvls[0];
-            SparseMatrix * el2dofs_Hdiv_new = ElementToDofs(*pfes);
+            Table * el2dofs_Hdiv_new = ElementToDofs(*pfes);
             el2dofs_Hdiv_lvls.Prepend(el2dofs_Hdiv_new);
 
             if (with_hcurl)
             {
                 pfes = Hcurl_space_lvls[0];
-                SparseMatrix * el2dofs_Hcurl_new = ElementToDofs(*pfes);
+                Table * el2dofs_Hcurl_new = ElementToDofs(*pfes);
                 el2dofs_Hcurl_lvls.Prepend(el2dofs_Hcurl_new);
             }
 
@@ -5732,7 +6446,7 @@ int GeneralHierarchy::Update()
             if (dim == 4)
             {
                 pfes = Hdivskew_space_lvls[0];
-                SparseMatrix * el2dofs_Hdivskew_new = ElementToDofs(*pfes);
+                Table * el2dofs_Hdivskew_new = ElementToDofs(*pfes);
                 el2dofs_Hdivskew_lvls.Prepend(el2dofs_Hdivskew_new);
             }
         }
@@ -6176,7 +6890,7 @@ void GeneralHierarchy::ConstructEl2Dofs()
     el2dofs_constructed = true;
 }
 
-SparseMatrix* GeneralHierarchy::GetElementToDofs(SpaceName space_name, int level) const
+Table* GeneralHierarchy::GetElementToDofs(SpaceName space_name, int level) const
 {
     if (!el2dofs_constructed)
     {
@@ -6216,8 +6930,8 @@ SparseMatrix* GeneralHierarchy::GetElementToDofs(SpaceName space_name, int level
     return NULL;
 }
 
-BlockMatrix* GeneralHierarchy::GetElementToDofs(const Array<SpaceName>& space_names, int level,
-                                                Array<int>& row_offsets, Array<int>& col_offsets) const
+BlockTable* GeneralHierarchy::GetElementToDofs(const Array<SpaceName>& space_names, int level,
+                                               Array<int>& row_offsets, Array<int>& col_offsets) const
 {
     Array<ParFiniteElementSpace*> pfess(space_names.Size());
 
@@ -6253,11 +6967,11 @@ BlockMatrix* GeneralHierarchy::GetElementToDofs(const Array<SpaceName>& space_na
         }
     }
 
-    BlockMatrix * res = new BlockMatrix(row_offsets, col_offsets);
+    BlockTable * res = new BlockTable(row_offsets, col_offsets);
 
     for (int i = 0; i < res->NumRowBlocks(); ++i)
     {
-        SparseMatrix * el2dofs_blk = ElementToDofs(*pfess[i]);
+        Table * el2dofs_blk = ElementToDofs(*pfess[i]);
         res->SetBlock(i,i, el2dofs_blk);
     }
 
@@ -6266,8 +6980,8 @@ BlockMatrix* GeneralHierarchy::GetElementToDofs(const Array<SpaceName>& space_na
     return res;
 }
 
-BlockMatrix* GeneralHierarchy::GetElementToDofs(const Array<SpaceName>& space_names, int level,
-                                                Array<int>* row_offsets, Array<int>* col_offsets) const
+BlockTable* GeneralHierarchy::GetElementToDofs(const Array<SpaceName>& space_names, int level,
+                                               Array<int>* row_offsets, Array<int>* col_offsets) const
 {
     Array<ParFiniteElementSpace*> pfess(space_names.Size());
 
@@ -6314,11 +7028,11 @@ BlockMatrix* GeneralHierarchy::GetElementToDofs(const Array<SpaceName>& space_na
     row_offsets->PartialSum();
     col_offsets->PartialSum();
 
-    BlockMatrix * res = new BlockMatrix(*row_offsets, *col_offsets);
+    BlockTable * res = new BlockTable(*row_offsets, *col_offsets);
 
     for (int i = 0; i < res->NumRowBlocks(); ++i)
     {
-        SparseMatrix * el2dofs_blk = ElementToDofs(*pfess[i]);
+        Table * el2dofs_blk = ElementToDofs(*pfess[i]);
         res->SetBlock(i,i, el2dofs_blk);
     }
 
@@ -7470,9 +8184,9 @@ void EliminateBoundaryBlocks(BlockOperator& BlockOp, const std::vector<Array<int
         }
 }
 
-SparseMatrix* ElementToDofs(const FiniteElementSpace &fes)
+Table* ElementToDofs(const FiniteElementSpace &fes)
 {
-    // Returns a SparseMatrix with the relation Element to Dofs
+    // Returns a Table with the relation Element to Dofs
     int * I = new int[fes.GetNE() + 1];
     Array<int> vdofs_R;
 
@@ -7483,7 +8197,6 @@ SparseMatrix* ElementToDofs(const FiniteElementSpace &fes)
         I[i + 1] = I[i] + vdofs_R.Size();
     }
     int * J = new int[I[fes.GetNE()]];
-    double * data = new double[I[fes.GetNE()]];
 
     for (int i = 0; i < fes.GetNE(); ++i)
     {
@@ -7491,16 +8204,72 @@ SparseMatrix* ElementToDofs(const FiniteElementSpace &fes)
         fes.GetElementVDofs(i,vdofs_R);
         fes.AdjustVDofs(vdofs_R);
         for (int j = I[i]; j < I[i + 1]; ++j)
-        {
             J[j] = vdofs_R[j - I[i]];
-            data[j] =1;
-        }
-
     }
-    SparseMatrix * res = new SparseMatrix(I, J, data, fes.GetNE(), fes.GetVSize());
+    Table * res = new Table;
+    res->SetIJ(I, J, fes.GetNE());
     return res;
 }
 
+Table* TransposedPattern(const SparseMatrix &A)
+{
+    const int * A_i = A.GetI();
+    const int * A_j = A.GetJ();
+
+    Table * At = new Table;
+    At->MakeI(A.Width());
+    for (int k = 0; k < A_i[A.Height()]; ++k)
+        At->AddAColumnInRow(A_j[k]);
+    At->MakeJ();
+    for (int i = 0; i < A.Height(); ++i)
+        for (int k = A_i[i]; k < A_i[i + 1]; ++k)
+            At->AddConnection(A_j[k], i);
+    At->ShiftUpI();
+    return At;
+}
+
+long BlockOperatorMemoryUsage(const BlockOperator &op)
+{
+    if (!op.owns_blocks)
+        return 0;
+
+    BlockOperator & op_nc = const_cast<BlockOperator&>(op);
+
+    long mem = 0;
+    for (int i = 0; i < op.NumRowBlocks(); ++i)
+        for (int j = 0; j < op.NumColBlocks(); ++j)
+            if (!op.IsZeroBlock(i,j))
+            {
+                Operator * blk = &op_nc.GetBlock(i,j);
+                if (HypreParMatrix * hpmat = dynamic_cast<HypreParMatrix*>(blk))
+                    mem += hpmat->MemoryUsage();
+                else if (SparseMatrix * spmat = dynamic_cast<SparseMatrix*>(blk))
+                    mem += spmat->MemoryUsage();
+            }
+    return mem;
+}
+
+Table* PartitionedAE_e(Mesh &mesh, int target_AE_size)
+{
+    MFEM_VERIFY(target_AE_size > 0, "Target AE size must be positive");
+
+    int ne = mesh.GetNE();
+    int nAE = std::max(1, (ne + target_AE_size - 1) / target_AE_size);
+
+    // partitioning the local element-to-element graph,
+    // recursive bisection is used for a small number of parts and k-way otherwise
+    int * partitioning = mesh.GeneratePartitioning(nAE, nAE > 8 ? 1 : 0);
+
+    // AE_e relation as the transpose of the element-to-AE map,
+    // the elements of each AE are in increasing order
+    Table * AE_e = new Table;
+    Transpose(Array<int>(partitioning, ne), *AE_e, nAE);
+
+    delete [] partitioning;
+
+    return AE_e;
+}
+
 BlockMatrix * RAP(const BlockMatrix &Rt, const BlockMatrix &A, const BlockMatrix &P)
 {
    BlockMatrix * R = Transpose(Rt);
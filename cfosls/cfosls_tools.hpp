@@ -96,6 +96,8 @@ public:
 
 // a class for square block operators where each block is given as a HypreParMatrix
 // used as an interface to handle coarsened operators for multigrid
+// the products are computed with a BlockParMatVecPlan, which exchanges one message
+// per neighbor for all the blocks, instead of one set of messages per block
 // TODO: Who should delete the matrices?
 class BlkHypreOperator : public Operator
 {
@@ -103,28 +105,98 @@ protected:
     int numblocks;
     Array2D<HypreParMatrix*> hpmats;
     Array<int> block_offsets;
+    BlockParMatVecPlan * plan;
+    // used for the products with several vectors at once
+    BlockOperator * multi_op;
 public:
-    BlkHypreOperator(Array2D<HypreParMatrix*> & Hpmats)
-        : numblocks(Hpmats.NumRows())
-    {
-        hpmats.SetSize(numblocks, numblocks);
-        for (int i = 0; i < numblocks; ++i )
-            for (int j = 0; j < numblocks; ++j )
-                if (Hpmats(i,j))
-                    hpmats(i,j) = Hpmats(i,j);
-                else
-                    hpmats(i,j) = NULL;
+    BlkHypreOperator(Array2D<HypreParMatrix*> & Hpmats);
 
+    virtual void Mult(const Vector &x, Vector &y) const;
+    virtual void Mult(const MultiVector &x, MultiVector &y) const
+    { multi_op->Mult(x, y); }
+    virtual void MultTranspose(const Vector &x, Vector &y) const;
 
-        block_offsets.SetSize(numblocks + 1);
-        block_offsets[0] = 0;
-        for (int i = 0; i < numblocks; ++i )
-            block_offsets[i + 1] = hpmats(i,i)->Height();
-        block_offsets.PartialSum();
-    }
+    /// split versions of Mult(), see BlockParMatVecPlan::MultBegin()
+    void MultBegin(const Vector &x) const { plan->MultBegin(x); }
+    void MultEnd(const Vector &x, Vector &y) const { plan->MultEnd(x, y); }
+
+    const Array<int> & BlockOffsets() const { return block_offsets; }
+
+    // memory (in bytes) used by the communication plan; the blocks are not owned
+    long MemoryUsage() const { return plan->MemoryUsage(); }
+
+    virtual ~BlkHypreOperator();
+};
+
+// A direct solver for a coarse (block) operator with HypreParMatrix blocks
+// which gathers the whole matrix onto the root rank (replicate = false) or
+// onto every rank (replicate = true) and factorizes it there.
+// A solve then costs one gather and one scatter of the vectors (or a single
+// allgather if the matrix is replicated) instead of a Krylov iteration with
+// global reductions on the full communicator, where the coarsest level has
+// only a handful of rows per rank.
+// The consolidated matrix uses the rank-major ordering of the local true dofs,
+// so that the local parts of the vectors are contiguous; it is factorized
+// with UMFPack if MFEM is built with SuiteSparse and with dense LU otherwise,
+// so the coarse problem must be rather small.
+// A singular coarse operator (e.g. the H(curl) one, whose kernel contains the
+// gradients) cannot be factorized: this is detected during the setup, by a
+// pivot below SingularTol times the largest entry (dense LU) or by a
+// reciprocal condition number estimate below SingularTol (UMFPack), and is
+// reported by IsSingular() on all ranks. Mult() refuses to run in this case,
+// so the caller has to keep an iterative coarse solver which can handle the
+// kernel (see Multigrid::SetConsolidatedCoarseSolver()).
+class ConsolidatedCoarseSolver : public Solver
+{
+protected:
+    MPI_Comm comm;
+    int num_procs;
+    int myid;
+    bool replicate;
+
+    // local sizes and offsets of all ranks in the consolidated numbering
+    Array<int> sizes;
+    Array<int> displs;
+
+    // the consolidated matrix and its factorization (on the root or on all ranks)
+    SparseMatrix * mat;
+#ifdef MFEM_USE_SUITESPARSE
+    UMFPackSolver * direct;
+#else
+    // LU factors and pivots of the dense consolidated matrix
+    DenseMatrix * dense;
+    Array<int> ipiv;
+#endif
+    // same value on all ranks
+    bool singular;
+
+    mutable Vector glob_x;
+    mutable Vector glob_y;
+
+    void Setup(const Array2D<HypreParMatrix*> & blocks);
+    // glob_y = A^{-1} glob_x, on the ranks holding the matrix
+    void Solve() const;
+
+public:
+    ConsolidatedCoarseSolver(HypreParMatrix & A, bool Replicate = false);
+    ConsolidatedCoarseSolver(const Array2D<HypreParMatrix*> & blocks, bool Replicate = false);
+    // all nonzero blocks of Op must be HypreParMatrices
+    ConsolidatedCoarseSolver(BlockOperator & Op, bool Replicate = false);
+
+    // relative threshold of the singularity detection
+    static const double SingularTol;
+
+    // true if the consolidated matrix could not be factorized
+    bool IsSingular() const { return singular; }
 
     virtual void Mult(const Vector &x, Vector &y) const;
-    virtual void MultTranspose(const Vector &x, Vector &y) const;
+    virtual void SetOperator(const Operator &op) { }
+
+    // memory (in bytes) used by the consolidated matrix, its factorization
+    // (only the dense one is accounted) and the work vectors
+    long MemoryUsage() const;
+
+    virtual ~ConsolidatedCoarseSolver();
 };
 
 /// simple structure for storing boundary attributes for different unknowns
@@ -422,11 +494,11 @@ protected:
     Array< HypreParMatrix* > DofTrueDof_Hdivskew_lvls;
 
     // element-to-dofs relations for various f.e. spaces
-    Array<SparseMatrix*> el2dofs_L2_lvls;
-    Array<SparseMatrix*> el2dofs_H1_lvls;
-    Array<SparseMatrix*> el2dofs_Hdiv_lvls;
-    Array<SparseMatrix*> el2dofs_Hcurl_lvls;
-    Array<SparseMatrix*> el2dofs_Hdivskew_lvls;
+    Array<Table*> el2dofs_L2_lvls;
+    Array<Table*> el2dofs_H1_lvls;
+    Array<Table*> el2dofs_Hdiv_lvls;
+    Array<Table*> el2dofs_Hcurl_lvls;
+    Array<Table*> el2dofs_Hdivskew_lvls;
 
     int feorder;
 
@@ -446,6 +518,9 @@ protected:
 
     int update_counter;
 
+    // geometric factors cached by the meshes of the hierarchy, see EnableGeometricFactors()
+    int geom_factors_flags;
+
     // array of attached problems
     // they don't belong to the hierarchy but they will be updated when the hierarchy is.
     Array<FOSLSProblem*> problems;
@@ -469,6 +544,11 @@ public:
     // returns the update counter
     virtual int Update();
 
+    // enables caching of the geometric factors at quadrature points (see
+    // Mesh::EnableGeometricFactors()) on the meshes of all levels, including the
+    // levels added by later updates; flags = 0 disables it
+    void EnableGeometricFactors(int flags = GeometricFactors::ALL);
+
     // tells the hierarchy to construct divfree discrete operators
     void ConstructDivfreeDops();
 
@@ -548,13 +628,13 @@ public:
     */
 
     // more getters
-    SparseMatrix* GetElementToDofs(SpaceName space_name, int level) const;
+    Table* GetElementToDofs(SpaceName space_name, int level) const;
 
-    BlockMatrix* GetElementToDofs(const Array<SpaceName>& space_names, int level,
-                                  Array<int>& row_offsets, Array<int>& col_offsets) const;
+    BlockTable* GetElementToDofs(const Array<SpaceName>& space_names, int level,
+                                 Array<int>& row_offsets, Array<int>& col_offsets) const;
 
-    BlockMatrix* GetElementToDofs(const Array<SpaceName>& space_names, int level,
-                                  Array<int>* row_offsets, Array<int>* col_offsets) const;
+    BlockTable* GetElementToDofs(const Array<SpaceName>& space_names, int level,
+                                 Array<int>* row_offsets, Array<int>* col_offsets) const;
 
     HypreParMatrix *GetDofTrueDof(SpaceName space_name, int level) const;
     std::vector<HypreParMatrix*> GetDofTrueDof(const Array<SpaceName>& space_names, int level) const;
@@ -563,6 +643,16 @@ public:
 
     int GetUpdateCounter() const {return update_counter;}
 
+    // local memory (in bytes) used at level l by the mesh, f.e. spaces (including
+    // their dof_truedof matrices), interpolation matrices, divfree operators and
+    // element-to-dofs relations stored in the hierarchy
+    long MemoryUsage(int level) const;
+    // local memory (in bytes) over all levels plus the finest level ("dynamic") spaces
+    long MemoryUsage() const;
+    // prints the memory usage per level and per kind of object, aggregated over the
+    // ranks (collective call)
+    void PrintMemoryUsage(std::ostream& out = std::cout) const;
+
     // constructs a FOSLSProblem of given (by template parameter) subtype
     // using the spaces at level l (defined on pmesh_lvls[l], thus, "static")
     template <class Problem> Problem* BuildStaticProblem(int l, BdrConditions& bdr_conditions,
@@ -591,6 +681,11 @@ protected:
     // used in constructing the hierarchy of meshes
     virtual void RefineAndCopy(int lvl, ParMesh* pmesh);
 
+    // memory (in bytes) used at level l by the mesh, the f.e. spaces, the
+    // interpolation matrices and the rest, reported separately by PrintMemoryUsage()
+    void GetMemoryUsage(int l, long& mesh_mem, long& spaces_mem,
+                        long& interp_mem, long& other_mem) const;
+
     // These are used for delayed initialization in GeneralAnisoHierarchy
     // The reason to use these are because we want in GeneralAnisoHierarchy to replace a part
     // of the constructor (related to the mesh hierarchy construction) via an overriden RefineAndCopy()
@@ -1480,6 +1575,20 @@ public:
 
     // updates the underlying diagonal and off-diagonal forms
     void Update();
+
+    // memory (in bytes) used by the assembled matrices of the forms
+    long MemoryUsage() const
+    {
+        long mem = 0;
+        for (int i = 0; i < diag_forms.Size(); ++i)
+            if (diag_forms[i])
+                mem += diag_forms[i]->MemoryUsage();
+        for (int i = 0; i < offd_forms.NumRows(); ++i)
+            for (int j = 0; j < offd_forms.NumCols(); ++j)
+                if (offd_forms(i,j))
+                    mem += offd_forms(i,j)->MemoryUsage();
+        return mem;
+    }
 };
 
 /// Base class for general CFOSLS problem
@@ -1489,6 +1598,13 @@ public:
 /// TODO: boundary conditions, as in the time stepping code
 class FOSLSProblem
 {
+public:
+    /// Krylov methods which can be selected with SetSolverOption();
+    /// the pipelined and s-step variants need fewer blocking global
+    /// reductions per iteration, CG options require an SPD system
+    enum SolverOption {MINRES_SOLVER = 0, PIPELINED_MINRES_SOLVER, CG_SOLVER,
+                       PIPELINED_CG_SOLVER, SSTEP_CG_SOLVER};
+
 protected:
     ParMesh& pmesh;
 
@@ -1574,6 +1690,21 @@ protected:
     // preconditioner for the problem
     Solver *prec;
     IterativeSolver * solver;
+    // operator given to the solver: the blocks of CFOSLSop applied with one
+    // aggregated halo exchange per product (NULL if CFOSLSop was not assembled here)
+    BlkHypreOperator * solver_op;
+
+    // maximal number of reuses of the BoomerAMG setups when the preconditioner
+    // is recreated, see SetAMGReuse(); 0 by default (no reuse)
+    int amg_reuse;
+    // BoomerAMG solvers created by CreateAMG() for the current preconditioner
+    // and, while a new one is created, for the previous one, indexed by the
+    // preconditioner block (NULL for the blocks without a BoomerAMG; not
+    // owned, they are blocks of the preconditioners)
+    Array<HypreBoomerAMG*> prec_amgs;
+    Array<HypreBoomerAMG*> old_prec_amgs;
+    // Krylov method used by InitSolver(), one of SolverOption
+    int solver_option;
 
     // currently used only to measure the solution time
     mutable StopWatch chrono;
@@ -1589,6 +1720,10 @@ protected:
     void InitForms();
     void AssembleSystem(bool verbose);
     virtual void CreatePrec(BlockOperator & op, int prec_option, bool verbose) {}
+    /// BoomerAMG for the diagonal block blk of the preconditioner, to be used
+    /// by CreatePrec(); with SetAMGReuse() it takes over the setup of the
+    /// BoomerAMG created for the same block by the previous preconditioner
+    HypreBoomerAMG * CreateAMG(HypreParMatrix & A, int blk);
     void SetPrecOption(int option) { prec_option = option; }
 
     void InitGrFuns();
@@ -1632,6 +1767,10 @@ public:
     { SolveProblem(*trueRhs, verbose, compute_error); }
     void SolveProblem(const Vector& rhs, bool verbose, bool compute_error) const;
     void SolveProblem(const Vector& rhs, Vector& sol, bool verbose, bool compute_error) const;
+    /// solves for several righthand sides at once (on true dofs), sharing
+    /// the operator and preconditioner applications and the reductions
+    /// between them if the solver supports it (CG and MINRES do)
+    void SolveProblem(const MultiVector& rhs, MultiVector& sol, bool verbose) const;
 
     void BuildSystem(bool verbose);
 
@@ -1640,6 +1779,35 @@ public:
 
     void InitSolver(bool verbose);
 
+    /// Selects the Krylov method (see SolverOption), MINRES by default;
+    /// an already initialized solver is recreated with the same tolerances,
+    /// maximal number of iterations and print level
+    void SetSolverOption(int option, bool verbose = false);
+    int GetSolverOption() const { return solver_option; }
+    /// Enables caching of the geometric factors at quadrature points on the problem mesh,
+    /// see Mesh::EnableGeometricFactors(); it is used by the next assembly, e.g., by
+    /// BuildSystem() or Update(). Since the mesh may be shared with a hierarchy or
+    /// other problems, the cache is enabled for them as well
+    void EnableGeometricFactors(int flags = GeometricFactors::ALL)
+    { pmesh.EnableGeometricFactors(flags); }
+
+    /// number of iterations of the last solve
+    int GetNumIterations() const { return solver->GetNumIterations(); }
+
+    /// Allows the BoomerAMG setups of the preconditioner to be reused up to max_reuse
+    /// times by the next preconditioners created by ResetPrec() (and BuildSystem()),
+    /// as long as the spaces do not change. Then the preconditioner is recreated
+    /// for the current operator by every ResetPrec(), even with the same prec_option.
+    /// See HypreBoomerAMG::SetReuseSetup()
+    void SetAMGReuse(int max_reuse) { amg_reuse = max_reuse; }
+
+    /// Local memory (in bytes) used by the problem: grid functions, f.e. spaces
+    /// (only if owned, i.e., not taken from the hierarchy), forms, assembled blocks,
+    /// block vectors and the BoomerAMG hierarchies of the preconditioner
+    long MemoryUsage() const;
+    /// Prints MemoryUsage() aggregated over the ranks (collective call)
+    void PrintMemoryUsage(std::ostream& out = std::cout) const;
+
     void UpdateSolverPrec() { solver->SetPreconditioner(*prec); }
 
     void SetPrec(Solver & Prec)
@@ -1745,18 +1913,9 @@ public:
 
     void UpdateSolverMat(Operator& op) { solver->SetOperator(op); }
 
-    void ResetOp(BlockOperator& op, bool capture)
-    {
-        MFEM_ASSERT(op.Height() == blkoffsets_true[blkoffsets_true.Size() - 1]
-                    && op.Width() == op.Height(), "Replacing operator sizes mismatch"
-                                                  " the existing's");
-        if (CFOSLSop)
-            delete CFOSLSop;
-
-        CFOSLSop = &op;
-
-        own_cfoslsop = capture;
-    }
+    // replaces the system operator; the operator given to the solver is
+    // rebuilt from the blocks of op (or dropped if they are not all hypre matrices)
+    void ResetOp(BlockOperator& op, bool capture);
     void ResetOp_nobnd(BlockOperator& op_nobnd, bool capture)
     {
         MFEM_ASSERT(op_nobnd.Height() == blkoffsets_true[blkoffsets_true.Size() - 1]
@@ -1803,19 +1962,24 @@ public:
     // related to the preconditioner, like Schur
     virtual void ResetPrec (int new_prec_option)
     {
-        if (new_prec_option != prec_option)
+        if (new_prec_option != prec_option || !prec || amg_reuse > 0)
         {
-            if (prec)
-                delete prec;
+            // the old preconditioner is deleted only after the new one is created,
+            // so that CreateAMG() can take over its BoomerAMG setups
+            Solver * old_prec = prec;
+            Swap(prec_amgs, old_prec_amgs);
+            prec_amgs.SetSize(0);
+            // the blocks of a different preconditioner have other operators
+            if (new_prec_option != prec_option)
+                old_prec_amgs.SetSize(0);
+
             CreatePrec(*CFOSLSop, new_prec_option, verbose);
             UpdateSolverPrec();
+
+            if (old_prec)
+                delete old_prec;
+            old_prec_amgs.SetSize(0);
         }
-        else
-            if (!prec)
-            {
-                CreatePrec(*CFOSLSop, new_prec_option, verbose);
-                UpdateSolverPrec();
-            }
     }
 
     friend void GeneralHierarchy::AttachProblem(FOSLSProblem* problem);
@@ -1836,8 +2000,12 @@ protected:
     virtual void CreatePrec(BlockOperator &op, int prec_option, bool verbose) override;
     virtual void ResetPrec (int new_prec_option)
     {
-        delete Schur;
+        // the old Schur complement is deleted only after the new preconditioner
+        // is created, since its BoomerAMG setup may be taken over, see CreateAMG()
+        HypreParMatrix * old_Schur = Schur;
         FOSLSProblem::ResetPrec(new_prec_option);
+        if (Schur != old_Schur)
+            delete old_Schur;
     }
 
 public:
@@ -1893,8 +2061,11 @@ protected:
     virtual void CreatePrec(BlockOperator &op, int prec_option, bool verbose) override;
     virtual void ResetPrec (int new_prec_option)
     {
-        delete Schur;
+        // see FOSLSProblem_HdivL2hyp::ResetPrec()
+        HypreParMatrix * old_Schur = Schur;
         FOSLSProblem::ResetPrec(new_prec_option);
+        if (Schur != old_Schur)
+            delete old_Schur;
     }
 
 public:
@@ -1945,8 +2116,11 @@ protected:
     virtual void CreatePrec(BlockOperator &op, int prec_option, bool verbose) override;
     virtual void ResetPrec (int new_prec_option)
     {
-        delete Schur;
+        // see FOSLSProblem_HdivL2hyp::ResetPrec()
+        HypreParMatrix * old_Schur = Schur;
         FOSLSProblem::ResetPrec(new_prec_option);
+        if (Schur != old_Schur)
+            delete old_Schur;
     }
 
 public:
@@ -1996,8 +2170,11 @@ protected:
     virtual void CreatePrec(BlockOperator &op, int prec_option, bool verbose) override;
     virtual void ResetPrec (int new_prec_option)
     {
-        delete Schur;
+        // see FOSLSProblem_HdivL2hyp::ResetPrec()
+        HypreParMatrix * old_Schur = Schur;
         FOSLSProblem::ResetPrec(new_prec_option);
+        if (Schur != old_Schur)
+            delete old_Schur;
     }
 
 public:
@@ -2048,8 +2225,11 @@ protected:
     virtual void CreatePrec(BlockOperator &op, int prec_option, bool verbose) override;
     virtual void ResetPrec (int new_prec_option)
     {
-        delete Schur;
+        // see FOSLSProblem_HdivL2hyp::ResetPrec()
+        HypreParMatrix * old_Schur = Schur;
         FOSLSProblem::ResetPrec(new_prec_option);
+        if (Schur != old_Schur)
+            delete old_Schur;
     }
 
 public:
@@ -2100,8 +2280,11 @@ protected:
     virtual void CreatePrec(BlockOperator &op, int prec_option, bool verbose) override;
     virtual void ResetPrec (int new_prec_option)
     {
-        delete Schur;
+        // see FOSLSProblem_HdivL2hyp::ResetPrec()
+        HypreParMatrix * old_Schur = Schur;
         FOSLSProblem::ResetPrec(new_prec_option);
+        if (Schur != old_Schur)
+            delete old_Schur;
     }
 
 public:
@@ -2186,10 +2369,20 @@ public:
 
     virtual void ResetPrec (int new_prec_option)
     {
-        delete Schur;
+        // see FOSLSProblem_HdivL2hyp::ResetPrec()
+        HypreParMatrix * old_Schur = Schur;
         FOSLSProblem::ResetPrec(new_prec_option);
+        if (Schur != old_Schur)
+            delete old_Schur;
     }
 
+    /// Solves the problem like Solve(), but through the hybridization of the
+    /// Hdiv-L2 system (see BilinearForm::EnableHybridization()): instead of
+    /// MINRES on the saddle-point system, PCG with BoomerAMG is applied to the
+    /// SPD system for the Lagrange multipliers on the faces, with the relative
+    /// and absolute tolerances and the max number of iterations of the solver
+    void SolveHybridized(bool verbose, bool compute_error) const;
+
     void ComputeExtraError(const Vector& vec) const override;
 
     void ComputeFuncError(const Vector& vec) const override;
@@ -3223,6 +3416,15 @@ struct ComponentsDescriptor
     bool with_coarsest_hcurl;
     bool with_monolithic_GS;
     bool with_nobnd_op;
+    // target number of elements in the agglomerates used by the Schwarz smoothers;
+    // if <= 0, the agglomerates are the coarse elements from the refinement hierarchy,
+    // else they are obtained by partitioning the element-to-element graph with METIS
+    int Schwarz_AE_size;
+    // if true, partitioned agglomerates are built as unions of coarse elements
+    // (required by DivConstraintSolver, since its local problems have nonzero rhs
+    // which is only compatible over the coarse elements), else the fine level
+    // elements are partitioned directly
+    bool Schwarz_AE_nested;
 public:
     virtual ~ComponentsDescriptor() {}
     ComponentsDescriptor() : ComponentsDescriptor(false, false, false,
@@ -3236,7 +3438,9 @@ public:
           with_coarsest_partfinder(with_coarsest_partfinder_),
           with_coarsest_hcurl(with_coarsest_hcurl_),
           with_monolithic_GS(with_monolithic_GS_),
-          with_nobnd_op(with_nobnd_op_)
+          with_nobnd_op(with_nobnd_op_),
+          Schwarz_AE_size(0),
+          Schwarz_AE_nested(true)
     {}
 };
 
@@ -3253,7 +3457,7 @@ protected:
     FOSLSProblem* problem;
     ComponentsDescriptor descr;
 protected:
-    Array<SparseMatrix*> AE_e_lvls;
+    Array<Table*> AE_e_lvls;
     Array<BlockOperator*> BlockP_nobnd_lvls;
     Array<Operator*> P_bnd_lvls;
     Array<BlockOperator*> FunctOps_lvls;
@@ -3279,7 +3483,7 @@ protected:
     Array<int> d_td_coarsest_row_offsets;
     Array<int> d_td_coarsest_col_offsets;
 
-    Array<BlockMatrix*> el2dofs_funct_lvls;
+    Array<BlockTable*> el2dofs_funct_lvls;
 
     std::deque<Array<int>* > el2dofs_row_offsets;
     std::deque<Array<int>* > el2dofs_col_offsets;
@@ -3288,6 +3492,15 @@ protected:
     // hierarchy was updated
     int update_counter;
 
+protected:
+    // constructs AE_e relation for the Schwarz smoother at level l, as prescribed
+    // by descr.Schwarz_AE_size and descr.Schwarz_AE_nested
+    Table * ConstructAE_e(int l);
+
+    // memory (in bytes) used at level l by the operators, the smoothers and the
+    // matrices needed for them, reported separately by PrintMemoryUsage()
+    void GetMemoryUsage(int l, long& ops_mem, long& smoothers_mem, long& mats_mem) const;
+
 public:
     virtual ~MultigridToolsHierarchy();
 
@@ -3335,6 +3548,15 @@ public:
     bool With_Coarsest_partfinder() {return descr.with_coarsest_partfinder;}
     bool With_Schwarz() {return descr.with_Schwarz;}
     bool With_Coarsest_hcurl() {return descr.with_coarsest_hcurl;}
+    // true if each Schwarz agglomerate is a union of coarse elements
+    bool With_Nested_AE() {return descr.Schwarz_AE_size <= 0 || descr.Schwarz_AE_nested;}
+
+    /// Local memory (in bytes) used by the components at level l and over all levels
+    /// (the coarsest level solvers are not accounted)
+    long MemoryUsage(int level) const;
+    long MemoryUsage() const;
+    /// Prints the memory usage per level, aggregated over the ranks (collective call)
+    void PrintMemoryUsage(std::ostream& out = std::cout) const;
 };
 
 /// simple copy by using Transpose (and temporarily allocating
@@ -3349,8 +3571,22 @@ HypreParMatrix * CopyHypreParMatrix(const HypreParMatrix& hpmat);
 /// By tdofs here we actually simply mean indices
 void EliminateBoundaryBlocks(BlockOperator& BlockOp, const std::vector<Array<int>* > esstdofs_blks);
 
-/// Construct el_to_dofs relation table as a SparseMatrix for a given finite element space
-SparseMatrix *ElementToDofs(const FiniteElementSpace &fes);
+/// Construct el_to_dofs relation table for a given finite element space
+Table *ElementToDofs(const FiniteElementSpace &fes);
+
+/// Constructs the relation given by the transposed sparsity pattern of a SparseMatrix,
+/// e.g., the AE_e relation from the prolongator of the lowest-order L2 space
+Table *TransposedPattern(const SparseMatrix &A);
+
+/// Memory (in bytes) used by the blocks of a BlockOperator which are HypreParMatrix
+/// or SparseMatrix objects, accounted only if the blocks are owned by the operator
+long BlockOperatorMemoryUsage(const BlockOperator &op);
+
+/// Constructs AE_e relation table for the agglomerates
+/// obtained by partitioning the local element-to-element graph of the mesh with METIS
+/// into parts of approximately target_AE_size elements. Works for meshes without
+/// any refinement history. Requires MFEM to be built with METIS
+Table *PartitionedAE_e(Mesh &mesh, int target_AE_size);
 
 /// RAP for BlockMatrices (somehow non-present in MFEM)
 BlockMatrix *RAP(const BlockMatrix &Rt, const BlockMatrix &A, const BlockMatrix &P);
@@ -126,6 +126,13 @@ int main(int argc, char *argv[])
 
     int feorder         = 0;
 
+    // target size of the agglomerates for the Schwarz smoothers, if > 0 they are
+    // constructed by METIS (as unions of coarse elements), else taken from the refinement
+    int Schwarz_AE_size = 0;
+
+    // whether to report the memory used by the hierarchies and solvers
+    bool report_memory = false;
+
     if (verbose)
         cout << "Solving CFOSLS Transport equation, multigrid for the div-free approach, minimization solver \n";
 
@@ -153,6 +160,11 @@ int main(int argc, char *argv[])
                    "Whether to use M to compute a particular solution");
     args.AddOption(&space_for_S, "-spaceS", "--spaceS",
                    "Space for S: L2 or H1.");
+    args.AddOption(&Schwarz_AE_size, "-aesize", "--AE-size",
+                   "Target number of elements in METIS agglomerates for Schwarz smoothers"
+                   " (<= 0: use coarse elements).");
+    args.AddOption(&report_memory, "-mem", "--memory", "-no-mem", "--no-memory",
+                   "Report memory usage of the hierarchies and solvers.");
     args.Parse();
     if (!args.Good())
     {
@@ -365,11 +377,21 @@ int main(int argc, char *argv[])
                                               with_Hcurl, with_coarsest_partfinder,
                                               with_coarsest_hcurl, with_monolithic_GS,
                                               with_nobnd_op);
+        descriptor->Schwarz_AE_size = Schwarz_AE_size;
     }
     MultigridToolsHierarchy * mgtools_hierarchy =
             new MultigridToolsHierarchy(*hierarchy, 0, *descriptor);
 #endif
 
+    if (report_memory)
+    {
+        hierarchy->PrintMemoryUsage();
+        problem->PrintMemoryUsage();
+#ifdef USE_MULTIGRID_TOOLS
+        mgtools_hierarchy->PrintMemoryUsage();
+#endif
+    }
+
     std::vector<Array<int>*>& essbdr_attribs = problem->GetBdrConditions().GetAllBdrAttribs();
 
     if (verbose)
@@ -427,11 +449,11 @@ int main(int argc, char *argv[])
 
         G_fine = .0;
 
-        Array< SparseMatrix*> el2dofs_R(ref_levels);
-        Array< SparseMatrix*> el2dofs_W(ref_levels);
+        Array< Table*> el2dofs_R(ref_levels);
+        Array< Table*> el2dofs_W(ref_levels);
         Array< SparseMatrix*> P_Hdiv_lvls(ref_levels);
         Array< SparseMatrix*> P_L2_lvls(ref_levels);
-        Array< SparseMatrix*> e_AE_lvls(ref_levels);
+        Array< Table*> AE_e_lvls(ref_levels);
 
         for (int l = 0; l < ref_levels; ++l)
         {
@@ -440,7 +462,7 @@ int main(int argc, char *argv[])
 
             P_Hdiv_lvls[l] = hierarchy->GetPspace(SpaceName::HDIV, l);
             P_L2_lvls[l] = hierarchy->GetPspace(SpaceName::L2, l);
-            e_AE_lvls[l] = P_L2_lvls[l];
+            AE_e_lvls[l] = TransposedPattern(*P_L2_lvls[l]);
         }
 
         const Array<int>* coarse_essbdr_dofs_Hdiv = hierarchy->GetEssBdrTdofsOrDofs
@@ -454,7 +476,7 @@ int main(int argc, char *argv[])
                       M_local, B_local,
                       G_fine,
                       gform,
-                      P_L2_lvls, P_Hdiv_lvls, e_AE_lvls,
+                      P_L2_lvls, P_Hdiv_lvls, AE_e_lvls,
                       el2dofs_R,
                       el2dofs_W,
                       hierarchy->GetDofTrueDof(SpaceName::HDIV, num_levels - 1),
@@ -468,6 +490,9 @@ int main(int argc, char *argv[])
 
         delete coarse_essbdr_dofs_Hdiv;
 
+        for (int l = 0; l < ref_levels; ++l)
+            delete AE_e_lvls[l];
+
         delete M_local;
         delete B_local;
     }
@@ -570,6 +595,9 @@ int main(int argc, char *argv[])
                                       with_hcurl_smoothers, verbose);
 #endif
 
+    if (report_memory)
+        PrintMemoryUsage(comm, "DivConstraintSolver", PartsolFinder->MemoryUsage());
+
     // Constructing the constraint rhs
     FunctionCoefficient * rhs_coeff = problem->GetFEformulation().GetFormulation()->GetTest()->GetRhs();
     ParLinearForm * constrfform_new = new ParLinearForm(hierarchy->GetSpace(SpaceName::L2, 0));
@@ -941,9 +969,9 @@ int main(int argc, char *argv[])
 
     Array<SparseMatrix*> Constraint_mat_lvls_mg(num_levels);
     Array<BlockMatrix*> Funct_mat_lvls_mg(num_levels);
-    Array<SparseMatrix*> AE_e_lvls(num_levels - 1);
+    Array<Table*> AE_e_lvls(num_levels - 1);
 
-    Array<BlockMatrix*> el2dofs_funct_lvls(num_levels - 1);
+    Array<BlockTable*> el2dofs_funct_lvls(num_levels - 1);
     std::deque<std::vector<HypreParMatrix*> > d_td_Funct_lvls(num_levels - 1);
 
     std::vector<Array<int>*> fullbdr_attribs(numblocks_funct);
@@ -1053,7 +1081,7 @@ int main(int argc, char *argv[])
 
             d_td_Funct_lvls[l] = hierarchy->GetDofTrueDof(*space_names_funct, l);
 
-            AE_e_lvls[l] = Transpose(*hierarchy->GetPspace(SpaceName::L2, l));
+            AE_e_lvls[l] = TransposedPattern(*hierarchy->GetPspace(SpaceName::L2, l));
             if (strcmp(space_for_S,"H1") == 0) // S is present
             {
                 SchwarzSmoothers_lvls[l] = new LocalProblemSolverWithS
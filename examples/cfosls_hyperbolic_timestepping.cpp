@@ -29,6 +29,9 @@
 /// (***) The example was tested for memory leaks with valgrind, in Hdiv-L2 formulation, 3D/4D.
 ///
 /// Typical run of this example: ./cfosls_hyperbolic_timestepping --whichD 3 -no-vis
+/// With -amgreuse N > 0 the preconditioners of the time slabs are recreated N + 1 more
+/// times, as after an update of the coefficients, reusing the BoomerAMG setups up to N
+/// times, and the number of iterations of each time slab is printed for every sweep.
 /// If you ant Hdiv-H1-L2 formulation, you will need not only change --spaceS option but also
 /// change the source code, around 4.
 ///
@@ -89,6 +92,9 @@ int main(int argc, char *argv[])
 
    int feorder = 0;
 
+   // maximal number of reuses of the BoomerAMG setups, see FOSLSProblem::SetAMGReuse()
+   int amg_reuse = 0;
+
    bool visualization = 0;
 
    // 2. Parse command-line options.
@@ -116,6 +122,9 @@ int main(int argc, char *argv[])
                   "Space for S (H1 or L2).");
    args.AddOption(&space_for_sigma, "-spacesigma", "--spacesigma",
                   "Space for sigma (Hdiv or H1).");
+   args.AddOption(&amg_reuse, "-amgreuse", "--amg-reuse",
+                  "Maximal number of reuses of the BoomerAMG setups when the"
+                  " preconditioners of the time slabs are recreated (0 = no reuse).");
    args.AddOption(&visualization, "-vis", "--visualization", "-no-vis",
                   "--no-visualization",
                   "Enable or disable GLVis visualization.");
@@ -511,7 +520,48 @@ int main(int argc, char *argv[])
    fine_timestepping->ComputeError(checksol);
    fine_timestepping->ComputeBndError(checksol);
 
-   // 10. Free the used memory.
+   // 10. Recreating the preconditioners of the time slabs, as after an update of the
+   // coefficients, and solving again. The BoomerAMG setups of the previous sweep are
+   // reused up to amg_reuse times, after that a full setup is done again
+   if (amg_reuse > 0)
+   {
+       if (verbose)
+           std::cout << "\n\nRecreating the preconditioners with BoomerAMG setup reuse = "
+                     << amg_reuse << "\n";
+
+       for (int tslab = 0; tslab < nslabs; ++tslab)
+           timeslabs_problems[tslab]->SetAMGReuse(amg_reuse);
+
+       StopWatch chrono;
+       for (int sweep = 0; sweep <= amg_reuse + 1; ++sweep)
+       {
+           chrono.Clear();
+           chrono.Start();
+           for (int tslab = 0; tslab < nslabs; ++tslab)
+           {
+               FOSLSProblem * problem_tslab = timeslabs_problems[tslab];
+               problem_tslab->ResetPrec(prec_option);
+           }
+           chrono.Stop();
+
+           fine_timestepping->SequentialSolve(rhs, *input_tslab0, checksol, false);
+
+           if (verbose)
+           {
+               // the first sweep does full setups, since the initial preconditioners
+               // were created without reuse
+               std::cout << "sweep " << sweep << ": preconditioner setup took "
+                         << chrono.RealTime() << "s, iterations per time slab:";
+               for (int tslab = 0; tslab < nslabs; ++tslab)
+                   std::cout << " " << timeslabs_problems[tslab]->GetNumIterations();
+               std::cout << "\n";
+           }
+       }
+
+       fine_timestepping->ComputeError(checksol);
+   }
+
+   // 11. Free the used memory.
    delete fine_timestepping;
 
    for (int tslab = 0; tslab < nslabs; ++tslab )
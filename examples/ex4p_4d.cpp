@@ -582,7 +582,8 @@ int main(int argc, char *argv[])
 	   }
 	   else if (hybridization)
 	   {
-		  hfec = new DG_Interface_FECollection(order-1, dim);
+		  if (dim == 4) { hfec = new DG0_Interface_4DFECollection(order-1, dim); }
+		  else { hfec = new DG_Interface_FECollection(order-1, dim); }
 		  hfes = new ParFiniteElementSpace(pmesh, hfec);
 		  a->EnableHybridization(hfes, new NormalTraceJumpIntegrator(),
 								 ess_tdof_list);
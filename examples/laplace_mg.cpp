@@ -4,6 +4,13 @@
 ///
 /// This is a modified version in which the Laplace problem is considered.
 /// The problem is sovled with a geomtric multigrid preconditioner.
+/// The coarsest level is solved with CG (-coarse 0) or with a direct solver
+/// for the coarsest matrix consolidated on the root rank (-coarse 1) or on
+/// all ranks (-coarse 2), see ConsolidatedCoarseSolver.
+///
+/// Sample runs:  mpirun -np 4 laplace_mg
+///               mpirun -np 4 laplace_mg -coarse 1
+///               mpirun -np 4 laplace_mg -dim 4 -sref 0 -coarse 2
 
 #include "mfem.hpp"
 #include <fstream>
@@ -37,6 +44,7 @@ int main(int argc, char *argv[])
    const char *mesh_file = "../data/star.mesh";
    int order = 1;
    bool visualization = 0;
+   int coarse_solver = 0;
 
    OptionsParser args(argc, argv);
    args.AddOption(&mesh_file, "-m", "--mesh",
@@ -47,6 +55,9 @@ int main(int argc, char *argv[])
                   "Number of parallel refinements 4d mesh.");
    args.AddOption(&nDimensions, "-dim", "--whichD",
                   "Dimension of the space-time problem.");
+   args.AddOption(&coarse_solver, "-coarse", "--coarse-solver",
+                  "Coarsest level solver: 0 - CG, 1 - direct on the root rank, "
+                  "2 - direct on all ranks.");
    args.AddOption(&visualization, "-vis", "--visualization", "-no-vis",
                   "--no-visualization",
                   "Enable or disable GLVis visualization.");
@@ -247,6 +258,21 @@ int main(int argc, char *argv[])
 #else
    Multigrid * prec = new Multigrid(A, TrueP_H);
 #endif
+   if (coarse_solver > 0)
+   {
+       const bool direct = prec->SetConsolidatedCoarseSolver(coarse_solver == 2);
+       if (verbose)
+       {
+           if (direct)
+               cout << "Coarsest level solver: direct, on "
+                    << (coarse_solver == 2 ? "all ranks" : "the root rank") << "\n";
+           else
+               cout << "Coarsest level solver: CG (the coarsest matrix is singular) \n";
+       }
+   }
+   else if (verbose)
+       cout << "Coarsest level solver: CG \n";
+
    CGSolver solver(comm);
    if (verbose)
        cout << "Linear solver: CG \n";
@@ -13,10 +13,46 @@
 
 #include "fem.hpp"
 #include <cmath>
+#include <algorithm>
 
 namespace mfem
 {
 
+// Set @a batch to the consecutive elements, starting from @a first, that use
+// the same FiniteElement in both @a fes1 and @a fes2, so that their element
+// matrices can be computed with one call to the batched integrator methods.
+// Returns the first element after the batch.
+static int GetElementBatch(FiniteElementSpace &fes1, FiniteElementSpace &fes2,
+                           int first, Array<int> &batch)
+{
+   const int NE = fes1.GetNE();
+   const FiniteElement *fe1 = fes1.GetFE(first);
+   const FiniteElement *fe2 = fes2.GetFE(first);
+
+   // NURBS spaces reuse one FiniteElement object for all elements.
+   int max_size = 1;
+   if (!fes1.GetNURBSext() && !fes2.GetNURBSext())
+   {
+      const int max_batch = 256, max_data = 1 << 20;
+      const int mat_size = fe1->GetDof()*fes1.GetVDim()*
+                           fe2->GetDof()*fes2.GetVDim();
+      max_size = std::max(1, std::min(max_batch, max_data/mat_size));
+   }
+
+   int next = first + 1;
+   while (next < NE && next - first < max_size &&
+          fes1.GetFE(next) == fe1 && fes2.GetFE(next) == fe2)
+   {
+      next++;
+   }
+   batch.SetSize(next - first);
+   for (int e = 0; e < batch.Size(); e++)
+   {
+      batch[e] = first + e;
+   }
+   return next;
+}
+
 void BilinearForm::AllocMat()
 {
    if (static_cond) { return; }
@@ -72,6 +108,8 @@ BilinearForm::BilinearForm (FiniteElementSpace * f)
    element_matrices = NULL;
    static_cond = NULL;
    hybridization = NULL;
+   hyb_local_form = NULL;
+   hyb_local_mat = NULL;
    precompute_sparsity = 0;
 }
 
@@ -88,6 +126,8 @@ BilinearForm::BilinearForm (FiniteElementSpace * f, BilinearForm * bf, int ps)
    element_matrices = NULL;
    static_cond = NULL;
    hybridization = NULL;
+   hyb_local_form = NULL;
+   hyb_local_mat = NULL;
    precompute_sparsity = ps;
 
    bfi = bf->GetDBFI();
@@ -146,6 +186,33 @@ void BilinearForm::EnableHybridization(FiniteElementSpace *constr_space,
    hybridization = new Hybridization(fes, constr_space);
    hybridization->SetConstraintIntegrator(constr_integ);
    hybridization->Init(ess_tdof_list);
+   hyb_local_form = NULL;
+   delete hyb_local_mat;
+   hyb_local_mat = NULL;
+}
+
+void BilinearForm::EnableHybridization(FiniteElementSpace *constr_space,
+                                       BilinearFormIntegrator *constr_integ,
+                                       const Array<int> &ess_tdof_list,
+                                       MixedBilinearForm *local_form)
+{
+   MFEM_VERIFY(local_form->TrialFESpace() == fes,
+               "the trial space of the local form must be the space of the"
+               " BilinearForm");
+   MFEM_VERIFY(local_form->GetDBFI()->Size() > 0,
+               "the local form has no domain integrators");
+   MFEM_VERIFY(!fes->GetMesh()->Nonconforming(),
+               "hybridization of mixed systems is not supported on"
+               " non-conforming meshes");
+
+   delete hybridization;
+   hybridization = new Hybridization(fes, constr_space);
+   hybridization->SetConstraintIntegrator(constr_integ);
+   hybridization->SetLocalSpace(local_form->TestFESpace());
+   hybridization->Init(ess_tdof_list);
+   hyb_local_form = local_form;
+   delete hyb_local_mat;
+   hyb_local_mat = NULL;
 }
 
 void BilinearForm::UseSparsity(int *I, int *J, bool isSorted)
@@ -195,6 +262,7 @@ void BilinearForm::Finalize (int skip_zeros)
    if (mat_e) { mat_e->Finalize(skip_zeros); }
    if (static_cond) { static_cond->Finalize(); }
    if (hybridization) { hybridization->Finalize(); }
+   if (hyb_local_mat) { hyb_local_mat->Finalize(skip_zeros); }
 }
 
 void BilinearForm::AddDomainIntegrator (BilinearFormIntegrator * bfi)
@@ -300,11 +368,53 @@ void BilinearForm::AssembleElementMatrix(
       mat->AddSubMatrix(vdofs, vdofs, elmat, skip_zeros);
       if (hybridization)
       {
-         hybridization->AssembleMatrix(i, elmat);
+         AssembleHybridizationMatrix(i, elmat);
       }
    }
 }
 
+void BilinearForm::AssembleHybridizationMatrix(int i, const DenseMatrix &elmat)
+{
+   if (!hyb_local_form)
+   {
+      hybridization->AssembleMatrix(i, elmat);
+      return;
+   }
+
+   // the element matrix B of the local form
+   FiniteElementSpace *l_fes = hyb_local_form->TestFESpace();
+   const FiniteElement &fe = *fes->GetFE(i);
+   const FiniteElement &l_fe = *l_fes->GetFE(i);
+   ElementTransformation *eltrans = fes->GetElementTransformation(i);
+   Array<BilinearFormIntegrator*> &lbfi = *hyb_local_form->GetDBFI();
+   DenseMatrix B_el;
+   lbfi[0]->AssembleElementMatrix2(fe, l_fe, *eltrans, B_el);
+   for (int k = 1; k < lbfi.Size(); k++)
+   {
+      lbfi[k]->AssembleElementMatrix2(fe, l_fe, *eltrans, elemmat);
+      B_el += elemmat;
+   }
+
+   // the element matrix [A B^T; B 0] of the mixed system
+   const int nf = elmat.Height();
+   DenseMatrix mixed(nf + B_el.Height());
+   mixed = 0.0;
+   mixed.CopyMN(elmat, 0, 0);
+   mixed.CopyMN(B_el, nf, 0);
+   mixed.CopyMNt(B_el, 0, nf);
+   hybridization->AssembleMatrix(i, mixed);
+
+   // B is also assembled to eliminate the essential b.c. from the rhs
+   if (hyb_local_mat == NULL)
+   {
+      hyb_local_mat = new SparseMatrix(l_fes->GetVSize(), fes->GetVSize());
+   }
+   Array<int> f_vdofs, l_vdofs;
+   fes->GetElementVDofs(i, f_vdofs);
+   l_fes->GetElementVDofs(i, l_vdofs);
+   hyb_local_mat->AddSubMatrix(l_vdofs, f_vdofs, B_el);
+}
+
 void BilinearForm::AssembleBdrElementMatrix(
    int i, const DenseMatrix &elmat, Array<int> &vdofs, int skip_zeros)
 {
@@ -351,35 +461,51 @@ void BilinearForm::Assemble (int skip_zeros)
 
    if (dbfi.Size())
    {
-      for (i = 0; i < fes -> GetNE(); i++)
+      // The element matrices are computed in batches of elements of the same
+      // type, see BilinearFormIntegrator::AssembleElementMatrices().
+      Array<int> batch;
+      DenseTensor elmats, elmats_k;
+      for (int first = 0, next; first < fes->GetNE(); first = next)
       {
-         fes->GetElementVDofs(i, vdofs);
          if (element_matrices)
          {
-            elmat_p = &(*element_matrices)(i);
+            next = fes->GetNE();
          }
          else
          {
-            const FiniteElement &fe = *fes->GetFE(i);
-            eltrans = fes->GetElementTransformation(i);
-            dbfi[0]->AssembleElementMatrix(fe, *eltrans, elmat);
+            next = GetElementBatch(*fes, *fes, first, batch);
+            dbfi[0]->AssembleElementMatrices(*fes, batch, elmats);
             for (int k = 1; k < dbfi.Size(); k++)
             {
-               dbfi[k]->AssembleElementMatrix(fe, *eltrans, elemmat);
-               elmat += elemmat;
+               dbfi[k]->AssembleElementMatrices(*fes, batch, elmats_k);
+               for (int e = 0; e < batch.Size(); e++)
+               {
+                  elmats(e) += elmats_k(e);
+               }
             }
-            elmat_p = &elmat;
          }
-         if (static_cond)
+         for (i = first; i < next; i++)
          {
-            static_cond->AssembleMatrix(i, *elmat_p);
-         }
-         else
-         {
-            mat->AddSubMatrix(vdofs, vdofs, *elmat_p, skip_zeros);
-            if (hybridization)
+            fes->GetElementVDofs(i, vdofs);
+            if (element_matrices)
+            {
+               elmat_p = &(*element_matrices)(i);
+            }
+            else
+            {
+               elmat_p = &elmats(i - first);
+            }
+            if (static_cond)
+            {
+               static_cond->AssembleMatrix(i, *elmat_p);
+            }
+            else
             {
-               hybridization->AssembleMatrix(i, *elmat_p);
+               mat->AddSubMatrix(vdofs, vdofs, *elmat_p, skip_zeros);
+               if (hybridization)
+               {
+                  AssembleHybridizationMatrix(i, *elmat_p);
+               }
             }
          }
       }
@@ -556,7 +682,26 @@ void BilinearForm::FormLinearSystem(const Array<int> &ess_tdof_list,
       if (hybridization)
       {
          // Reduction to the Lagrange multipliers system
-         EliminateVDofsInRHS(ess_tdof_list, x, b);
+         if (!hyb_local_form)
+         {
+            EliminateVDofsInRHS(ess_tdof_list, x, b);
+         }
+         else
+         {
+            // x and b also contain the part of the local space, whose rhs is
+            // eliminated with the matrix B of the local form
+            const int f_size = fes->GetVSize();
+            Vector x_f(x.GetData(), f_size), b_f(b.GetData(), f_size);
+            Vector b_l(b.GetData() + f_size, b.Size() - f_size);
+            Vector x_e(f_size);
+            x_e = 0.0;
+            for (int i = 0; i < ess_tdof_list.Size(); i++)
+            {
+               x_e(ess_tdof_list[i]) = x_f(ess_tdof_list[i]);
+            }
+            EliminateVDofsInRHS(ess_tdof_list, x_f, b_f);
+            hyb_local_mat->AddMult(x_e, b_l, -1.0);
+         }
          hybridization->ReduceRHS(b, B);
          X.SetSize(B.Size());
          X = 0.0;
@@ -698,32 +843,47 @@ void BilinearForm::ComputeElementMatrices()
    element_matrices = new DenseTensor(num_dofs_per_el, num_dofs_per_el,
                                       num_elements);
 
-   DenseMatrix tmp;
-   IsoparametricTransformation eltrans;
+   // Split the elements into batches of elements of the same type; the
+   // batches are then processed in parallel.
+   Array<int> batch, offsets;
+   for (int first = 0; first < num_elements; )
+   {
+      offsets.Append(first);
+      first = GetElementBatch(*fes, *fes, first, batch);
+   }
+   offsets.Append(num_elements);
+   const int num_batches = offsets.Size() - 1;
+
+   DenseTensor elmats, tmp;
 
 #ifdef MFEM_USE_OPENMP
-   #pragma omp parallel for private(tmp,eltrans)
+   #pragma omp parallel for private(batch,elmats,tmp)
 #endif
-   for (int i = 0; i < num_elements; i++)
+   for (int b = 0; b < num_batches; b++)
    {
-      DenseMatrix elmat(element_matrices->GetData(i),
-                        num_dofs_per_el, num_dofs_per_el);
-      const FiniteElement &fe = *fes->GetFE(i);
-#ifdef MFEM_DEBUG
-      if (num_dofs_per_el != fe.GetDof()*fes->GetVDim())
+      const int first = offsets[b], n = offsets[b+1] - first;
+      batch.SetSize(n);
+      for (int e = 0; e < n; e++)
+      {
+         batch[e] = first + e;
+      }
+      double *data = element_matrices->GetData(first);
+      elmats.UseExternalData(data, num_dofs_per_el, num_dofs_per_el, n);
+
+      dbfi[0]->AssembleElementMatrices(*fes, batch, elmats);
+      if (elmats.Data() != data)
          mfem_error("BilinearForm::ComputeElementMatrices:"
                     " all elements must have same number of dofs");
-#endif
-      fes->GetElementTransformation(i, &eltrans);
-
-      dbfi[0]->AssembleElementMatrix(fe, eltrans, elmat);
       for (int k = 1; k < dbfi.Size(); k++)
       {
          // note: some integrators may not be thread-safe
-         dbfi[k]->AssembleElementMatrix(fe, eltrans, tmp);
-         elmat += tmp;
+         dbfi[k]->AssembleElementMatrices(*fes, batch, tmp);
+         for (int e = 0; e < n; e++)
+         {
+            elmats(e) += tmp(e);
+         }
       }
-      elmat.ClearExternalData();
+      elmats.Clear();
    }
 }
 
@@ -890,6 +1050,7 @@ void BilinearForm::Update(FiniteElementSpace *nfes)
       mat = NULL;
       delete hybridization;
       hybridization = NULL;
+      hyb_local_form = NULL;
       sequence = fes->GetSequence();
    }
    else
@@ -897,10 +1058,22 @@ void BilinearForm::Update(FiniteElementSpace *nfes)
       if (mat) { *mat = 0.0; }
       if (hybridization) { hybridization->Reset(); }
    }
+   delete hyb_local_mat;
+   hyb_local_mat = NULL;
 
    height = width = fes->GetVSize();
 }
 
+long BilinearForm::MemoryUsage() const
+{
+   long mem = 0;
+   if (mat) { mem += mat->MemoryUsage(); }
+   if (mat_e) { mem += mat_e->MemoryUsage(); }
+   if (element_matrices) { mem += element_matrices->MemoryUsage(); }
+   if (hyb_local_mat) { mem += hyb_local_mat->MemoryUsage(); }
+   return mem;
+}
+
 BilinearForm::~BilinearForm()
 {
    delete mat_e;
@@ -908,6 +1081,7 @@ BilinearForm::~BilinearForm()
    delete element_matrices;
    delete static_cond;
    delete hybridization;
+   delete hyb_local_mat;
 
    if (!extern_bfs)
    {
@@ -1066,18 +1240,36 @@ void MixedBilinearForm::Assemble (int skip_zeros)
 
    if (dom.Size())
    {
-      for (i = 0; i < test_fes -> GetNE(); i++)
+      // The element matrices are computed in batches of elements of the same
+      // type, see BilinearFormIntegrator::AssembleElementMatrices2().
+      Array<int> batch;
+      Array<DenseTensor*> elmats(dom.Size());
+      for (k = 0; k < dom.Size(); k++)
+      {
+         elmats[k] = new DenseTensor;
+      }
+      for (int first = 0, next; first < test_fes -> GetNE(); first = next)
       {
-         trial_fes -> GetElementVDofs (i, tr_vdofs);
-         test_fes  -> GetElementVDofs (i, te_vdofs);
-         eltrans = test_fes -> GetElementTransformation (i);
+         next = GetElementBatch(*trial_fes, *test_fes, first, batch);
          for (k = 0; k < dom.Size(); k++)
          {
-            dom[k] -> AssembleElementMatrix2 (*trial_fes -> GetFE(i),
-                                              *test_fes  -> GetFE(i),
-                                              *eltrans, elemmat);
-            mat -> AddSubMatrix (te_vdofs, tr_vdofs, elemmat, skip_zeros);
+            dom[k] -> AssembleElementMatrices2 (*trial_fes, *test_fes, batch,
+                                                *elmats[k]);
          }
+         for (i = first; i < next; i++)
+         {
+            trial_fes -> GetElementVDofs (i, tr_vdofs);
+            test_fes  -> GetElementVDofs (i, te_vdofs);
+            for (k = 0; k < dom.Size(); k++)
+            {
+               mat -> AddSubMatrix (te_vdofs, tr_vdofs, (*elmats[k])(i-first),
+                                    skip_zeros);
+            }
+         }
+      }
+      for (k = 0; k < dom.Size(); k++)
+      {
+         delete elmats[k];
       }
    }
 
@@ -24,6 +24,8 @@
 namespace mfem
 {
 
+class MixedBilinearForm;
+
 /** Class for bilinear form - "Matrix" with associated FE space and
     BLFIntegrators. */
 class BilinearForm : public Matrix
@@ -69,18 +71,28 @@ protected:
    StaticCondensation *static_cond;
    Hybridization *hybridization;
 
+   /// Mixed form of the space eliminated locally by the hybridization (not
+   /// owned) and its assembled matrix, see EnableHybridization()
+   MixedBilinearForm *hyb_local_form;
+   SparseMatrix *hyb_local_mat;
+
    int precompute_sparsity;
    // Allocate appropriate SparseMatrix and assign it to mat
    void AllocMat();
 
    void ConformingAssemble();
 
+   /** Assemble the element matrix @a elmat of element @a i into the
+       hybridization, together with the element matrix of hyb_local_form. */
+   void AssembleHybridizationMatrix(int i, const DenseMatrix &elmat);
+
    // may be used in the construction of derived classes
    BilinearForm() : Matrix (0)
    {
       fes = NULL; sequence = -1;
       mat = mat_e = NULL; extern_bfs = 0; element_matrices = NULL;
       static_cond = NULL; hybridization = NULL;
+      hyb_local_form = NULL; hyb_local_mat = NULL;
       precompute_sparsity = 0;
    }
 
@@ -114,6 +126,23 @@ public:
                             BilinearFormIntegrator *constr_integ,
                             const Array<int> &ess_tdof_list);
 
+   /** @brief Enable hybridization of the mixed system [A B^T; B 0], where A is
+       this form and B is @a local_form, e.g. RT-L2 for a Darcy problem.
+
+       The trial space of @a local_form must be the space of this form and its
+       test space must be discontinuous; the dofs of the test space are
+       eliminated element by element, see Hybridization::SetLocalSpace(). The
+       vectors x and b of FormLinearSystem() and RecoverFEMSolution() are then
+       the vectors of this form's space followed by the vectors of the test
+       space. The element matrices of @a local_form are computed during the
+       assembly of this form from its domain integrators, so @a local_form
+       need not be assembled; it is not owned. Not supported on
+       non-conforming meshes. This method should be called before assembly. */
+   void EnableHybridization(FiniteElementSpace *constr_space,
+                            BilinearFormIntegrator *constr_integ,
+                            const Array<int> &ess_tdof_list,
+                            MixedBilinearForm *local_form);
+
    /** For scalar FE spaces, precompute the sparsity pattern of the matrix
        (assuming dense element matrices) based on the types of integrators
        present in the bilinear form. */
@@ -274,6 +303,9 @@ public:
        array) to initialize different right-hand sides and boundary condition
        values.
 
+       With the hybridization of a mixed system (see EnableHybridization()), x
+       and b also contain the vectors of the locally eliminated space.
+
        After solving the linear system, the finite element solution x can be
        recovered by calling RecoverFEMSolution (with the same vectors X, b, and
        x).
@@ -351,6 +383,10 @@ public:
    /// Return the FE space associated with the BilinearForm.
    FiniteElementSpace *GetFES() { return fes; }
 
+   /** @brief Return the memory used by the assembled matrices and the stored
+       element matrices, in bytes. */
+   long MemoryUsage() const;
+
    /// Destroys bilinear form.
    virtual ~BilinearForm();
 };
@@ -414,6 +450,10 @@ public:
 
    virtual void Finalize (int skip_zeros = 1);
 
+   FiniteElementSpace *TrialFESpace() const { return trial_fes; }
+
+   FiniteElementSpace *TestFESpace() const { return test_fes; }
+
    /** Extract the associated matrix as SparseMatrix blocks. The number of
        block rows and columns is given by the vector dimensions (vdim) of the
        test and trial spaces, respectively. */
@@ -468,6 +508,9 @@ public:
 
    void Update();
 
+   /// Return the memory used by the assembled matrix, in bytes.
+   long MemoryUsage() const { return mat ? mat->MemoryUsage() : 0; }
+
    virtual ~MixedBilinearForm();
 };
 
@@ -61,6 +61,127 @@ void BilinearFormIntegrator::AssembleElementVector(
               "   is not implemented fot this class.");
 }
 
+void BilinearFormIntegrator::SetTensorSize(DenseTensor &elmats,
+                                           int h, int w, int n)
+{
+   if (elmats.SizeI() != h || elmats.SizeJ() != w || elmats.SizeK() != n)
+   {
+      elmats.SetSize(h, w, n);
+   }
+}
+
+void BilinearFormIntegrator::AssembleElementMatrices(
+   FiniteElementSpace &fes, const Array<int> &elems, DenseTensor &elmats)
+{
+   DenseMatrix elmat;
+   IsoparametricTransformation Trans;
+   for (int e = 0; e < elems.Size(); e++)
+   {
+      fes.GetElementTransformation(elems[e], &Trans);
+      AssembleElementMatrix(*fes.GetFE(elems[e]), Trans, elmat);
+      if (e == 0)
+      {
+         SetTensorSize(elmats, elmat.Height(), elmat.Width(), elems.Size());
+      }
+      MFEM_VERIFY(elmat.Height() == elmats.SizeI() &&
+                  elmat.Width() == elmats.SizeJ(),
+                  "all element matrices in a batch must have the same size");
+      std::copy(elmat.Data(), elmat.Data() + elmat.Height()*elmat.Width(),
+                elmats.GetData(e));
+   }
+}
+
+void BilinearFormIntegrator::AssembleElementMatrices2(
+   FiniteElementSpace &trial_fes, FiniteElementSpace &test_fes,
+   const Array<int> &elems, DenseTensor &elmats)
+{
+   DenseMatrix elmat;
+   IsoparametricTransformation Trans;
+   for (int e = 0; e < elems.Size(); e++)
+   {
+      test_fes.GetElementTransformation(elems[e], &Trans);
+      AssembleElementMatrix2(*trial_fes.GetFE(elems[e]),
+                             *test_fes.GetFE(elems[e]), Trans, elmat);
+      if (e == 0)
+      {
+         SetTensorSize(elmats, elmat.Height(), elmat.Width(), elems.Size());
+      }
+      MFEM_VERIFY(elmat.Height() == elmats.SizeI() &&
+                  elmat.Width() == elmats.SizeJ(),
+                  "all element matrices in a batch must have the same size");
+      std::copy(elmat.Data(), elmat.Data() + elmat.Height()*elmat.Width(),
+                elmats.GetData(e));
+   }
+}
+
+
+RefElementShapes::RefElementShapes(const FiniteElement &fe_,
+                                   const IntegrationRule &ir, int flags)
+   : fe(fe_), dof(fe_.GetDof()), dim(fe_.GetDim())
+{
+   const int nq = ir.GetNPoints();
+   DenseMatrix ds;
+   Vector s;
+   if (flags & SHAPE)
+   {
+      shape.SetSize(dof, nq);
+      for (int q = 0; q < nq; q++)
+      {
+         GetShape(q, s);
+         fe.CalcShape(ir.IntPoint(q), s);
+      }
+   }
+   if (flags & DSHAPE)
+   {
+      dshape.SetSize(dof*dim, nq);
+      for (int q = 0; q < nq; q++)
+      {
+         GetDShape(q, ds);
+         fe.CalcDShape(ir.IntPoint(q), ds);
+      }
+   }
+   if (flags & VSHAPE)
+   {
+      vshape.SetSize(dof*dim, nq);
+      for (int q = 0; q < nq; q++)
+      {
+         GetVShape(q, ds);
+         fe.CalcVShape(ir.IntPoint(q), ds);
+      }
+   }
+   if (flags & DIVSHAPE)
+   {
+      divshape.SetSize(dof, nq);
+      for (int q = 0; q < nq; q++)
+      {
+         GetDivShape(q, s);
+         fe.CalcDivShape(ir.IntPoint(q), s);
+      }
+   }
+}
+
+void RefElementShapes::CalcPhysVShape(int q, ElementTransformation &Trans,
+                                      DenseMatrix &pvshape) const
+{
+   DenseMatrix vs;
+   GetVShape(q, vs);
+   pvshape.SetSize(dof, Trans.GetSpaceDim());
+   switch (fe.GetMapType())
+   {
+      case FiniteElement::H_DIV:
+         // same as VectorFiniteElement::CalcVShape_RT
+         MultABt(vs, Trans.Jacobian(), pvshape);
+         pvshape *= (1.0 / Trans.Weight());
+         break;
+      case FiniteElement::H_CURL:
+         // same as VectorFiniteElement::CalcVShape_ND
+         Mult(vs, Trans.InverseJacobian(), pvshape);
+         break;
+      default:
+         MFEM_ABORT("unsupported map type: " << fe.GetMapType());
+   }
+}
+
 
 void TransposeIntegrator::AssembleElementMatrix (
    const FiniteElement &el, ElementTransformation &Trans, DenseMatrix &elmat)
@@ -380,29 +501,7 @@ void DiffusionIntegrator::AssembleElementMatrix
 #endif
    elmat.SetSize(nd);
 
-   const IntegrationRule *ir = IntRule;
-   if (ir == NULL)
-   {
-      int order;
-      if (el.Space() == FunctionSpace::Pk)
-      {
-         order = 2*el.GetOrder() - 2;
-      }
-      else
-         // order = 2*el.GetOrder() - 2;  // <-- this seems to work fine too
-      {
-         order = 2*el.GetOrder() + dim - 1;
-      }
-
-      if (el.Space() == FunctionSpace::rQk)
-      {
-         ir = &RefinedIntRules.Get(el.GetGeomType(), order);
-      }
-      else
-      {
-         ir = &IntRules.Get(el.GetGeomType(), order);
-      }
-   }
+   const IntegrationRule *ir = IntRule ? IntRule : &GetRule(el);
 
    elmat = 0.0;
    for (int i = 0; i < ir->GetNPoints(); i++)
@@ -410,7 +509,7 @@ void DiffusionIntegrator::AssembleElementMatrix
       const IntegrationPoint &ip = ir->IntPoint(i);
       el.CalcDShape(ip, dshape);
 
-      Trans.SetIntPoint(&ip);
+      Trans.SetIntPoint(*ir, i);
       w = Trans.Weight();
       w = ip.weight / (square ? w : w*w*w);
       // AdjugateJacobian = / adj(J),         if J is square
@@ -434,6 +533,72 @@ void DiffusionIntegrator::AssembleElementMatrix
    }
 }
 
+const IntegrationRule &DiffusionIntegrator::GetRule(const FiniteElement &el)
+{
+   int order;
+   if (el.Space() == FunctionSpace::Pk)
+   {
+      order = 2*el.GetOrder() - 2;
+   }
+   else
+      // order = 2*el.GetOrder() - 2;  // <-- this seems to work fine too
+   {
+      order = 2*el.GetOrder() + el.GetDim() - 1;
+   }
+
+   if (el.Space() == FunctionSpace::rQk)
+   {
+      return RefinedIntRules.Get(el.GetGeomType(), order);
+   }
+   return IntRules.Get(el.GetGeomType(), order);
+}
+
+void DiffusionIntegrator::AssembleElementMatrices(
+   FiniteElementSpace &fes, const Array<int> &elems, DenseTensor &elmats)
+{
+   const int ne = elems.Size();
+   if (MQ || ne == 0)
+   {
+      BilinearFormIntegrator::AssembleElementMatrices(fes, elems, elmats);
+      return;
+   }
+   const FiniteElement &el = *fes.GetFE(elems[0]);
+   const int nd = el.GetDof();
+
+   IsoparametricTransformation Trans;
+   fes.GetElementTransformation(elems[0], &Trans);
+   const int spaceDim = Trans.GetSpaceDim();
+   const bool square = (el.GetDim() == spaceDim);
+   const IntegrationRule *ir = IntRule ? IntRule : &GetRule(el);
+   const RefElementShapes ref(el, *ir, RefElementShapes::DSHAPE);
+
+   SetTensorSize(elmats, nd, nd, ne);
+   DenseMatrix elmat, dshape, dshapedxt(nd, spaceDim);
+   for (int e = 0; e < ne; e++)
+   {
+      if (e > 0) { fes.GetElementTransformation(elems[e], &Trans); }
+      elmat.UseExternalData(elmats.GetData(e), nd, nd);
+      elmat = 0.0;
+      for (int i = 0; i < ir->GetNPoints(); i++)
+      {
+         const IntegrationPoint &ip = ir->IntPoint(i);
+         ref.GetDShape(i, dshape);
+
+         Trans.SetIntPoint(*ir, i);
+         double w = Trans.Weight();
+         w = ip.weight / (square ? w : w*w*w);
+         Mult(dshape, Trans.AdjugateJacobian(), dshapedxt);
+         if (Q)
+         {
+            w *= Q->Eval(Trans, ip);
+         }
+         AddMult_a_AAt(w, dshapedxt, elmat);
+      }
+   }
+   elmat.ClearExternalData();
+   dshape.ClearExternalData();
+}
+
 void DiffusionIntegrator::AssembleElementMatrix2(
    const FiniteElement &trial_fe, const FiniteElement &test_fe,
    ElementTransformation &Trans, DenseMatrix &elmat)
@@ -731,21 +896,7 @@ void MassIntegrator::AssembleElementMatrix
    elmat.SetSize(nd);
    shape.SetSize(nd);
 
-   const IntegrationRule *ir = IntRule;
-   if (ir == NULL)
-   {
-      // int order = 2 * el.GetOrder();
-      int order = 2 * el.GetOrder() + Trans.OrderW();
-
-      if (el.Space() == FunctionSpace::rQk)
-      {
-         ir = &RefinedIntRules.Get(el.GetGeomType(), order);
-      }
-      else
-      {
-         ir = &IntRules.Get(el.GetGeomType(), order);
-      }
-   }
+   const IntegrationRule *ir = IntRule ? IntRule : &GetRule(el, Trans);
 
    elmat = 0.0;
    for (int i = 0; i < ir->GetNPoints(); i++)
@@ -753,7 +904,7 @@ void MassIntegrator::AssembleElementMatrix
       const IntegrationPoint &ip = ir->IntPoint(i);
       el.CalcShape(ip, shape);
 
-      Trans.SetIntPoint (&ip);
+      Trans.SetIntPoint(*ir, i);
       w = Trans.Weight() * ip.weight;
       if (Q)
       {
@@ -764,6 +915,58 @@ void MassIntegrator::AssembleElementMatrix
    }
 }
 
+const IntegrationRule &MassIntegrator::GetRule(const FiniteElement &el,
+                                               ElementTransformation &Trans)
+{
+   // int order = 2 * el.GetOrder();
+   int order = 2 * el.GetOrder() + Trans.OrderW();
+
+   if (el.Space() == FunctionSpace::rQk)
+   {
+      return RefinedIntRules.Get(el.GetGeomType(), order);
+   }
+   return IntRules.Get(el.GetGeomType(), order);
+}
+
+void MassIntegrator::AssembleElementMatrices(
+   FiniteElementSpace &fes, const Array<int> &elems, DenseTensor &elmats)
+{
+   const int ne = elems.Size();
+   if (ne == 0) { return; }
+   const FiniteElement &el = *fes.GetFE(elems[0]);
+   const int nd = el.GetDof();
+
+   IsoparametricTransformation Trans;
+   fes.GetElementTransformation(elems[0], &Trans);
+   const IntegrationRule *ir = IntRule ? IntRule : &GetRule(el, Trans);
+   const RefElementShapes ref(el, *ir, RefElementShapes::SHAPE);
+
+   SetTensorSize(elmats, nd, nd, ne);
+   DenseMatrix elmat;
+   Vector shape;
+   for (int e = 0; e < ne; e++)
+   {
+      if (e > 0) { fes.GetElementTransformation(elems[e], &Trans); }
+      elmat.UseExternalData(elmats.GetData(e), nd, nd);
+      elmat = 0.0;
+      for (int i = 0; i < ir->GetNPoints(); i++)
+      {
+         const IntegrationPoint &ip = ir->IntPoint(i);
+         ref.GetShape(i, shape);
+
+         Trans.SetIntPoint(*ir, i);
+         double w = Trans.Weight() * ip.weight;
+         if (Q)
+         {
+            w *= Q -> Eval(Trans, ip);
+         }
+
+         AddMult_a_VVt(w, shape, elmat);
+      }
+   }
+   elmat.ClearExternalData();
+}
+
 void MassIntegrator::AssembleElementMatrix2(
    const FiniteElement &trial_fe, const FiniteElement &test_fe,
    ElementTransformation &Trans, DenseMatrix &elmat)
@@ -795,7 +998,7 @@ void MassIntegrator::AssembleElementMatrix2(
       trial_fe.CalcShape(ip, shape);
       test_fe.CalcShape(ip, te_shape);
 
-      Trans.SetIntPoint (&ip);
+      Trans.SetIntPoint(*ir, i);
       w = Trans.Weight() * ip.weight;
       if (Q)
       {
@@ -1154,7 +1357,7 @@ void VectorFEDivergenceIntegrator::AssembleElementMatrix2(
       double w = ip.weight;
       if (Q)
       {
-         Trans.SetIntPoint(&ip);
+         Trans.SetIntPoint(*ir, i);
          w *= Q->Eval(Trans, ip);
       }
       shape *= w;
@@ -1162,6 +1365,52 @@ void VectorFEDivergenceIntegrator::AssembleElementMatrix2(
    }
 }
 
+void VectorFEDivergenceIntegrator::AssembleElementMatrices2(
+   FiniteElementSpace &trial_fes, FiniteElementSpace &test_fes,
+   const Array<int> &elems, DenseTensor &elmats)
+{
+   const int ne = elems.Size();
+   if (ne == 0) { return; }
+   const FiniteElement &trial_fe = *trial_fes.GetFE(elems[0]);
+   const FiniteElement &test_fe = *test_fes.GetFE(elems[0]);
+   const int trial_nd = trial_fe.GetDof(), test_nd = test_fe.GetDof();
+
+   const IntegrationRule *ir = IntRule;
+   if (ir == NULL)
+   {
+      int order = trial_fe.GetOrder() + test_fe.GetOrder() - 1; // <--
+      ir = &IntRules.Get(trial_fe.GetGeomType(), order);
+   }
+   const RefElementShapes trial_ref(trial_fe, *ir, RefElementShapes::DIVSHAPE);
+   const RefElementShapes test_ref(test_fe, *ir, RefElementShapes::SHAPE);
+
+   SetTensorSize(elmats, test_nd, trial_nd, ne);
+   IsoparametricTransformation Trans;
+   DenseMatrix elmat;
+   Vector divshape, ref_shape, shape(test_nd);
+   for (int e = 0; e < ne; e++)
+   {
+      if (Q) { test_fes.GetElementTransformation(elems[e], &Trans); }
+      elmat.UseExternalData(elmats.GetData(e), test_nd, trial_nd);
+      elmat = 0.0;
+      for (int i = 0; i < ir->GetNPoints(); i++)
+      {
+         const IntegrationPoint &ip = ir->IntPoint(i);
+         trial_ref.GetDivShape(i, divshape);
+         test_ref.GetShape(i, ref_shape);
+         double w = ip.weight;
+         if (Q)
+         {
+            Trans.SetIntPoint(*ir, i);
+            w *= Q->Eval(Trans, ip);
+         }
+         shape.Set(w, ref_shape);
+         AddMultVWt(shape, divshape, elmat);
+      }
+   }
+   elmat.ClearExternalData();
+}
+
 void VectorFEWeakDivergenceIntegrator::AssembleElementMatrix2(
    const FiniteElement &trial_fe, const FiniteElement &test_fe,
    ElementTransformation &Trans, DenseMatrix &elmat)
@@ -1788,7 +2037,7 @@ void VectorFEMassIntegrator::AssembleElementMatrix(
    {
       const IntegrationPoint &ip = ir->IntPoint(i);
 
-      Trans.SetIntPoint (&ip);
+      Trans.SetIntPoint(*ir, i);
 
       el.CalcVShape(Trans, trial_vshape);
 
@@ -1817,6 +2066,54 @@ void VectorFEMassIntegrator::AssembleElementMatrix(
    }
 }
 
+void VectorFEMassIntegrator::AssembleElementMatrices(
+   FiniteElementSpace &fes, const Array<int> &elems, DenseTensor &elmats)
+{
+   const int ne = elems.Size();
+   if (ne == 0 || VQ || MQ ||
+       !RefElementShapes::IsVShapeSupported(*fes.GetFE(elems[0])))
+   {
+      BilinearFormIntegrator::AssembleElementMatrices(fes, elems, elmats);
+      return;
+   }
+   const FiniteElement &el = *fes.GetFE(elems[0]);
+   const int dof = el.GetDof();
+
+   IsoparametricTransformation Trans;
+   fes.GetElementTransformation(elems[0], &Trans);
+   const IntegrationRule *ir = IntRule;
+   if (ir == NULL)
+   {
+      int order = Trans.OrderW() + 2 * el.GetOrder();
+      ir = &IntRules.Get(el.GetGeomType(), order);
+   }
+   const RefElementShapes ref(el, *ir, RefElementShapes::VSHAPE);
+
+   SetTensorSize(elmats, dof, dof, ne);
+   DenseMatrix elmat, trial_vshape;
+   for (int e = 0; e < ne; e++)
+   {
+      if (e > 0) { fes.GetElementTransformation(elems[e], &Trans); }
+      elmat.UseExternalData(elmats.GetData(e), dof, dof);
+      elmat = 0.0;
+      for (int i = 0; i < ir->GetNPoints(); i++)
+      {
+         const IntegrationPoint &ip = ir->IntPoint(i);
+
+         Trans.SetIntPoint(*ir, i);
+         ref.CalcPhysVShape(i, Trans, trial_vshape);
+
+         double w = ip.weight * Trans.Weight();
+         if (Q)
+         {
+            w *= Q -> Eval (Trans, ip);
+         }
+         AddMult_a_AAt (w, trial_vshape, elmat);
+      }
+   }
+   elmat.ClearExternalData();
+}
+
 void VectorFEMassIntegrator::AssembleElementMatrix2(
    const FiniteElement &trial_fe, const FiniteElement &test_fe,
    ElementTransformation &Trans, DenseMatrix &elmat)
@@ -2079,7 +2376,7 @@ void DivDivIntegrator::AssembleElementMatrix(
 
       el.CalcDivShape (ip, divshape);
 
-      Trans.SetIntPoint (&ip);
+      Trans.SetIntPoint(*ir, i);
       c = ip.weight / Trans.Weight();
 
       if (Q)
@@ -2092,6 +2389,48 @@ void DivDivIntegrator::AssembleElementMatrix(
    }
 }
 
+void DivDivIntegrator::AssembleElementMatrices(
+   FiniteElementSpace &fes, const Array<int> &elems, DenseTensor &elmats)
+{
+   const int ne = elems.Size();
+   if (ne == 0) { return; }
+   const FiniteElement &el = *fes.GetFE(elems[0]);
+   const int dof = el.GetDof();
+
+   const IntegrationRule *ir = IntRule;
+   if (ir == NULL)
+   {
+      int order = 2 * el.GetOrder() - 2; // <--- OK for RTk
+      ir = &IntRules.Get(el.GetGeomType(), order);
+   }
+   const RefElementShapes ref(el, *ir, RefElementShapes::DIVSHAPE);
+
+   SetTensorSize(elmats, dof, dof, ne);
+   IsoparametricTransformation Trans;
+   DenseMatrix elmat;
+   Vector divshape;
+   for (int e = 0; e < ne; e++)
+   {
+      fes.GetElementTransformation(elems[e], &Trans);
+      elmat.UseExternalData(elmats.GetData(e), dof, dof);
+      elmat = 0.0;
+      for (int i = 0; i < ir -> GetNPoints(); i++)
+      {
+         const IntegrationPoint &ip = ir->IntPoint(i);
+         ref.GetDivShape(i, divshape);
+
+         Trans.SetIntPoint(*ir, i);
+         double c = ip.weight / Trans.Weight();
+         if (Q)
+         {
+            c *= Q -> Eval (Trans, ip);
+         }
+         AddMult_a_VVt (c, divshape, elmat);
+      }
+   }
+   elmat.ClearExternalData();
+}
+
 
 void VectorDiffusionIntegrator::AssembleElementMatrix(
    const FiniteElement &el,
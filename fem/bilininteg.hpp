@@ -18,6 +18,63 @@
 namespace mfem
 {
 
+class FiniteElementSpace;
+
+/** @brief Shape functions of a FiniteElement tabulated at all points of an
+    IntegrationRule on the reference element.
+
+    The data is computed once and shared (read-only) by all elements of a
+    batch in the batched assembly methods of the integrators, see
+    BilinearFormIntegrator::AssembleElementMatrices(). The flags select which
+    of the arrays are computed. */
+class RefElementShapes
+{
+public:
+   enum ShapeFlags { SHAPE = 1, DSHAPE = 2, VSHAPE = 4, DIVSHAPE = 8 };
+
+protected:
+   const FiniteElement &fe;
+   int dof, dim;
+   DenseMatrix shape;    // dof x nq
+   DenseMatrix dshape;   // (dof*dim) x nq
+   DenseMatrix vshape;   // (dof*dim) x nq
+   DenseMatrix divshape; // dof x nq
+
+public:
+   RefElementShapes(const FiniteElement &fe_, const IntegrationRule &ir,
+                    int flags);
+
+   /// Set @a s to a view of the shape functions at point @a q.
+   void GetShape(int q, Vector &s) const
+   { s.SetDataAndSize(const_cast<double*>(&shape(0,q)), dof); }
+
+   /// Set @a ds to a view of the reference derivatives (dof x dim) at @a q.
+   void GetDShape(int q, DenseMatrix &ds) const
+   { ds.UseExternalData(const_cast<double*>(&dshape(0,q)), dof, dim); }
+
+   /// Set @a vs to a view of the reference vector shapes (dof x dim) at @a q.
+   void GetVShape(int q, DenseMatrix &vs) const
+   { vs.UseExternalData(const_cast<double*>(&vshape(0,q)), dof, dim); }
+
+   /// Set @a ds to a view of the divergences of the shapes at point @a q.
+   void GetDivShape(int q, Vector &ds) const
+   { ds.SetDataAndSize(const_cast<double*>(&divshape(0,q)), dof); }
+
+   /** @brief Compute the physical vector shapes at point @a q, i.e. the same
+       as FiniteElement::CalcVShape(Trans, pvshape), using the tabulated
+       reference shapes. Only the H_DIV and H_CURL maps are supported, see
+       IsVShapeSupported(). */
+   void CalcPhysVShape(int q, ElementTransformation &Trans,
+                       DenseMatrix &pvshape) const;
+
+   /// Check if CalcPhysVShape() supports the map type of @a fe.
+   static bool IsVShapeSupported(const FiniteElement &fe)
+   {
+      return (fe.GetMapType() == FiniteElement::H_DIV ||
+              fe.GetMapType() == FiniteElement::H_CURL);
+   }
+};
+
 /// Abstract base class BilinearFormIntegrator
 class BilinearFormIntegrator : public NonlinearFormIntegrator
 {
@@ -27,6 +84,10 @@ protected:
    BilinearFormIntegrator(const IntegrationRule *ir = NULL)
    { IntRule = ir; }
 
+   /** Set the size of @a elmats to h x w x n. The data is kept (and it may be
+       external) if the size is already correct. */
+   static void SetTensorSize(DenseTensor &elmats, int h, int w, int n);
+
 public:
    /// Given a particular Finite Element computes the element matrix elmat.
    virtual void AssembleElementMatrix(const FiniteElement &el,
@@ -42,6 +103,27 @@ public:
                                        ElementTransformation &Trans,
                                        DenseMatrix &elmat);
 
+   /** @brief Compute the element matrices of the elements @a elems of @a fes
+       and store them in @a elmats, as elmats(e) for elems[e].
+
+       All elements must use the same FiniteElement (see
+       FiniteElementSpace::GetFE()). The default implementation calls
+       AssembleElementMatrix() for every element; derived classes may
+       override it to evaluate the reference shape functions only once for
+       the whole batch. If @a elmats already has the right size, its data
+       (which may be external) is overwritten. */
+   virtual void AssembleElementMatrices(FiniteElementSpace &fes,
+                                        const Array<int> &elems,
+                                        DenseTensor &elmats);
+
+   /** @brief Batched version of AssembleElementMatrix2(), see
+       AssembleElementMatrices(). The element transformations are taken from
+       @a test_fes. */
+   virtual void AssembleElementMatrices2(FiniteElementSpace &trial_fes,
+                                         FiniteElementSpace &test_fes,
+                                         const Array<int> &elems,
+                                         DenseTensor &elmats);
+
    virtual void AssembleFaceMatrix(const FiniteElement &el1,
                                    const FiniteElement &el2,
                                    FaceElementTransformations &Trans,
@@ -1607,6 +1689,15 @@ public:
                                        ElementTransformation &Trans,
                                        DenseMatrix &elmat);
 
+   /** Batched version of AssembleElementMatrix(); a MatrixCoefficient falls
+       back to the element-by-element assembly. */
+   virtual void AssembleElementMatrices(FiniteElementSpace &fes,
+                                        const Array<int> &elems,
+                                        DenseTensor &elmats);
+
+   /// The default quadrature rule used by AssembleElementMatrix().
+   static const IntegrationRule &GetRule(const FiniteElement &el);
+
    /// Perform the local action of the BilinearFormIntegrator
    virtual void AssembleElementVector(const FiniteElement &el,
                                       ElementTransformation &Tr,
@@ -1647,6 +1738,14 @@ public:
                                        const FiniteElement &test_fe,
                                        ElementTransformation &Trans,
                                        DenseMatrix &elmat);
+
+   virtual void AssembleElementMatrices(FiniteElementSpace &fes,
+                                        const Array<int> &elems,
+                                        DenseTensor &elmats);
+
+   /// The default quadrature rule used by AssembleElementMatrix().
+   static const IntegrationRule &GetRule(const FiniteElement &el,
+                                         ElementTransformation &Trans);
 };
 
 class BoundaryMassIntegrator : public MassIntegrator
@@ -1771,6 +1870,10 @@ public:
                                        const FiniteElement &test_fe,
                                        ElementTransformation &Trans,
                                        DenseMatrix &elmat);
+   virtual void AssembleElementMatrices2(FiniteElementSpace &trial_fes,
+                                         FiniteElementSpace &test_fes,
+                                         const Array<int> &elems,
+                                         DenseTensor &elmats);
 };
 
 
@@ -1935,6 +2038,13 @@ public:
                                        const FiniteElement &test_fe,
                                        ElementTransformation &Trans,
                                        DenseMatrix &elmat);
+
+   /** Batched version of AssembleElementMatrix() for H(div) and H(curl)
+       elements; vector and matrix coefficients fall back to the
+       element-by-element assembly. */
+   virtual void AssembleElementMatrices(FiniteElementSpace &fes,
+                                        const Array<int> &elems,
+                                        DenseTensor &elmats);
 };
 
 /** Integrator for (Q div u, p) where u=(v1,...,vn) and all vi are in the same
@@ -1978,6 +2088,10 @@ public:
    virtual void AssembleElementMatrix(const FiniteElement &el,
                                       ElementTransformation &Trans,
                                       DenseMatrix &elmat);
+
+   virtual void AssembleElementMatrices(FiniteElementSpace &fes,
+                                        const Array<int> &elems,
+                                        DenseTensor &elmats);
 };
 
 /** Integrator for
@@ -28,6 +28,18 @@ double PWConstCoefficient::Eval(ElementTransformation & T,
    return (constants(att-1));
 }
 
+void Coefficient::Eval(Vector &V, ElementTransformation &T,
+                       const IntegrationRule &ir)
+{
+   V.SetSize(ir.GetNPoints());
+   for (int i = 0; i < ir.GetNPoints(); i++)
+   {
+      const IntegrationPoint &ip = ir.IntPoint(i);
+      T.SetIntPoint(&ip);
+      V(i) = Eval(T, ip);
+   }
+}
+
 double FunctionCoefficient::Eval(ElementTransformation & T,
                                  const IntegrationPoint & ip)
 {
@@ -45,6 +57,23 @@ double FunctionCoefficient::Eval(ElementTransformation & T,
    }
 }
 
+void FunctionCoefficient::Eval(Vector &V, ElementTransformation &T,
+                               const IntegrationRule &ir)
+{
+   DenseMatrix transips;
+   Vector transip;
+
+   T.Transform(ir, transips);
+
+   V.SetSize(ir.GetNPoints());
+   for (int i = 0; i < ir.GetNPoints(); i++)
+   {
+      transips.GetColumnReference(i, transip);
+      V(i) = Function ? (*Function)(transip)
+             : (*TDFunction)(transip, GetTime());
+   }
+}
+
 double GridFunctionCoefficient::Eval (ElementTransformation &T,
                                       const IntegrationPoint &ip)
 {
@@ -101,6 +130,37 @@ void VectorFunctionCoefficient::Eval(Vector &V, ElementTransformation &T,
    }
 }
 
+void VectorFunctionCoefficient::Eval(DenseMatrix &M, ElementTransformation &T,
+                                     const IntegrationRule &ir)
+{
+   if (Q)
+   {
+      // the scaling coefficient needs the integration points set in T
+      VectorCoefficient::Eval(M, T, ir);
+      return;
+   }
+
+   DenseMatrix transips;
+   Vector transip, Mi;
+
+   T.Transform(ir, transips);
+
+   M.SetSize(vdim, ir.GetNPoints());
+   for (int i = 0; i < ir.GetNPoints(); i++)
+   {
+      transips.GetColumnReference(i, transip);
+      M.GetColumnReference(i, Mi);
+      if (Function)
+      {
+         (*Function)(transip, Mi);
+      }
+      else
+      {
+         (*TDFunction)(transip, GetTime(), Mi);
+      }
+   }
+}
+
 VectorArrayCoefficient::VectorArrayCoefficient (int dim)
    : VectorCoefficient(dim), Coeff(dim)
 {
@@ -247,21 +307,31 @@ void MatrixRestrictedCoefficient::Eval(DenseMatrix &K, ElementTransformation &T,
 double LpNormLoop(double p, Coefficient &coeff, Mesh &mesh,
                   const IntegrationRule *irs[])
 {
-   double norm = 0.0;
-   ElementTransformation *tr;
-
-   for (int i = 0; i < mesh.GetNE(); i++)
+   const int NE = mesh.GetNE();
+   const bool inf_norm = (p == numeric_limits<double>::infinity());
+   // Per-element contributions, combined in element order at the end, so that
+   // the result does not depend on the number of threads.
+   Vector elem_norm(NE);
+   IsoparametricTransformation tr;
+   Vector vals;
+
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for private(tr,vals)
+#endif
+   for (int i = 0; i < NE; i++)
    {
-      tr = mesh.GetElementTransformation(i);
+      mesh.GetElementTransformation(i, &tr);
       const IntegrationRule &ir = *irs[mesh.GetElementType(i)];
+      coeff.Eval(vals, tr, ir);
+      double norm = 0.0;
       for (int j = 0; j < ir.GetNPoints(); j++)
       {
-         const IntegrationPoint &ip = ir.IntPoint(j);
-         tr->SetIntPoint(&ip);
-         double val = fabs(coeff.Eval(*tr, ip));
-         if (p < numeric_limits<double>::infinity())
+         double val = fabs(vals(j));
+         if (!inf_norm)
          {
-            norm += ip.weight * tr->Weight() * pow(val, p);
+            const IntegrationPoint &ip = ir.IntPoint(j);
+            tr.SetIntPoint(&ip);
+            norm += ip.weight * tr.Weight() * pow(val, p);
          }
          else
          {
@@ -271,40 +341,48 @@ double LpNormLoop(double p, Coefficient &coeff, Mesh &mesh,
             }
          }
       }
+      elem_norm(i) = norm;
    }
-   return norm;
+
+   if (NE == 0) { return 0.0; }
+   return inf_norm ? elem_norm.Max() : elem_norm.Sum();
 }
 
 double LpNormLoop(double p, VectorCoefficient &coeff, Mesh &mesh,
                   const IntegrationRule *irs[])
 {
-   double norm = 0.0;
-   ElementTransformation *tr;
-   int vdim = coeff.GetVDim();
-   Vector vval(vdim);
-   double val;
-
-   for (int i = 0; i < mesh.GetNE(); i++)
+   const int NE = mesh.GetNE();
+   const bool inf_norm = (p == numeric_limits<double>::infinity());
+   const int vdim = coeff.GetVDim();
+   Vector elem_norm(NE);
+   IsoparametricTransformation tr;
+   DenseMatrix vvals;
+
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for private(tr,vvals)
+#endif
+   for (int i = 0; i < NE; i++)
    {
-      tr = mesh.GetElementTransformation(i);
+      mesh.GetElementTransformation(i, &tr);
       const IntegrationRule &ir = *irs[mesh.GetElementType(i)];
+      coeff.Eval(vvals, tr, ir);
+      double norm = 0.0;
       for (int j = 0; j < ir.GetNPoints(); j++)
       {
-         const IntegrationPoint &ip = ir.IntPoint(j);
-         tr->SetIntPoint(&ip);
-         coeff.Eval(vval, *tr, ip);
-         if (p < numeric_limits<double>::infinity())
+         if (!inf_norm)
          {
+            const IntegrationPoint &ip = ir.IntPoint(j);
+            tr.SetIntPoint(&ip);
             for (int idim(0); idim < vdim; ++idim)
             {
-               norm += ip.weight * tr->Weight() * pow(fabs( vval(idim) ), p);
+               norm += ip.weight * tr.Weight() * pow(fabs( vvals(idim,j) ), p);
             }
          }
          else
          {
             for (int idim(0); idim < vdim; ++idim)
             {
-               val = fabs(vval(idim));
+               double val = fabs(vvals(idim,j));
                if (norm < val)
                {
                   norm = val;
@@ -312,9 +390,11 @@ double LpNormLoop(double p, VectorCoefficient &coeff, Mesh &mesh,
             }
          }
       }
+      elem_norm(i) = norm;
    }
 
-   return norm;
+   if (NE == 0) { return 0.0; }
+   return inf_norm ? elem_norm.Max() : elem_norm.Sum();
 }
 
 double ComputeLpNorm(double p, Coefficient &coeff, Mesh &mesh,
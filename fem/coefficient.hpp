@@ -49,6 +49,15 @@ public:
       return Eval(T, ip);
    }
 
+   /** @brief Evaluate the coefficient at all points of @a ir in the element
+       described by @a T and store the values in @a V.
+
+       The general implementation uses the Eval method for one
+       IntegrationPoint. Can be overloaded for more efficient implementation.
+       On return, the integration point of @a T is unspecified. */
+   virtual void Eval(Vector &V, ElementTransformation &T,
+                     const IntegrationRule &ir);
+
    virtual ~Coefficient() { }
 };
 
@@ -135,9 +144,17 @@ public:
       TDFunction = reinterpret_cast<double(*)(const Vector&,double)>(tdf);
    }
 
+   using Coefficient::Eval;
+
    /// Evaluate coefficient
    virtual double Eval(ElementTransformation &T,
                        const IntegrationPoint &ip);
+
+   /** Evaluate the coefficient at all points of @a ir, mapping the points to
+       physical space with a single call to ElementTransformation::Transform.
+    */
+   virtual void Eval(Vector &V, ElementTransformation &T,
+                     const IntegrationRule &ir);
 };
 
 class GridFunction;
@@ -294,6 +311,12 @@ public:
    virtual void Eval(Vector &V, ElementTransformation &T,
                      const IntegrationPoint &ip);
 
+   /** Evaluate the coefficient at all points of @a ir, mapping the points to
+       physical space with a single call to ElementTransformation::Transform.
+    */
+   virtual void Eval(DenseMatrix &M, ElementTransformation &T,
+                     const IntegrationRule &ir);
+
    virtual ~VectorFunctionCoefficient() { }
 };
 
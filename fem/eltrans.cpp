@@ -19,10 +19,36 @@ namespace mfem
 ElementTransformation::ElementTransformation()
    : IntPoint(static_cast<IntegrationPoint *>(NULL)),
      EvalState(0),
+     mesh(NULL),
+     geom_factors(NULL),
+     geom_factors_ir(NULL),
+     geom_factors_version(-1),
      Attribute(-1),
      ElementNo(-1)
 { }
 
+void ElementTransformation::SetIntPoint(const IntegrationRule &ir, int q)
+{
+   SetIntPoint(&ir.IntPoint(q));
+   if (mesh == NULL) { return; }
+   // The entry is looked up again if the cache was cleared, the mesh was
+   // modified, or the rule at this address is not the one the entry was
+   // found for (e.g. a reused temporary rule); comparing point q is enough,
+   // since the factors at q depend only on its coordinates.
+   if (geom_factors_ir != &ir ||
+       geom_factors_version != mesh->GetGeometricFactorsVersion() ||
+       (geom_factors &&
+        (geom_factors->sequence != mesh->GetSequence() ||
+         geom_factors->nq != ir.GetNPoints() ||
+         !geom_factors->MatchesPoint(ir.IntPoint(q), q))))
+   {
+      geom_factors = mesh->GetGeometricFactors(ir);
+      geom_factors_ir = &ir;
+      geom_factors_version = mesh->GetGeometricFactorsVersion();
+   }
+   if (geom_factors) { geom_factors->SetIntPoint(*this, q); }
+}
+
 double ElementTransformation::EvalWeight()
 {
    MFEM_ASSERT((EvalState & WEIGHT_MASK) == 0, "");
@@ -213,7 +239,7 @@ int IsoparametricTransformation::TransformBack(const Vector &pt,
    const int sdim = PointMat.Height();
    const int geom = FElem->GetGeomType();
    IntegrationPoint xip, prev_xip;
-   double xd[3], yd[3], dxd[3], Jid[9];
+   double xd[4], yd[4], dxd[4], Jid[16];
    Vector x(xd, dim), y(yd, sdim), dx(dxd, dim);
    DenseMatrix Jinv(Jid, dim, sdim);
    bool hit_bdr = false, prev_hit_bdr;
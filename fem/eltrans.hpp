@@ -20,6 +20,9 @@
 namespace mfem
 {
 
+class Mesh;
+class GeometricFactors;
+
 class ElementTransformation
 {
 protected:
@@ -45,6 +48,17 @@ protected:
    const DenseMatrix &EvalAdjugateJ();
    const DenseMatrix &EvalInverseJ();
 
+   // The Mesh this transformation describes element ElementNo of; NULL for
+   // boundary, face and edge transformations. See SetIntPoint(ir, q).
+   Mesh *mesh;
+   // Geometric factors cache entry found for the rule geom_factors_ir and
+   // the value of Mesh::GetGeometricFactorsVersion() at that time.
+   const GeometricFactors *geom_factors;
+   const IntegrationRule *geom_factors_ir;
+   long geom_factors_version;
+
+   friend class GeometricFactors;
+
 public:
    int Attribute, ElementNo;
 
@@ -54,6 +68,19 @@ public:
    { IntPoint = ip; EvalState = 0; WeightIsEvaluated = JacobianIsEvaluated = 0; }
    const IntegrationPoint &GetIntPoint() { return *IntPoint; }
 
+   /** @brief Set the @a q-th point of @a ir as the current integration point.
+
+       If the transformation describes an element of a Mesh with enabled
+       geometric factors cache (see Mesh::EnableGeometricFactors()), the
+       Jacobian, its adjugate and the weight are loaded from the cache instead
+       of being evaluated. */
+   void SetIntPoint(const IntegrationRule &ir, int q);
+
+   /** @brief Mark the transformation as describing element ElementNo of @a m,
+       or as a non-element transformation if @a m is NULL. */
+   void SetMesh(Mesh *m)
+   { mesh = m; geom_factors = NULL; geom_factors_ir = NULL; }
+
    virtual void Transform(const IntegrationPoint &, Vector &) = 0;
    virtual void Transform(const IntegrationRule &, DenseMatrix &) = 0;
 
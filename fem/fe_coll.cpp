@@ -218,6 +218,10 @@ FiniteElementCollection *FiniteElementCollection::New(const char *name)
                                       FiniteElement::VALUE,
                                       BasisType::GetType(name[12]));
    }
+   else if (!strncmp(name, "DG_Iface_4D", 11))
+   {
+      fec = new DG0_Interface_4DFECollection(atoi(name + 13), 4);
+   }
    else if (!strncmp(name, "DG_Iface_", 9))
    {
       fec = new DG_Interface_FECollection(atoi(name + 13), atoi(name + 9));
@@ -2617,6 +2621,8 @@ DG0_Interface_4DFECollection::DG0_Interface_4DFECollection(const int p, const in
    : RT0_4DFECollection(p, dim, map_type, false, ob_type)
 {
    MFEM_VERIFY(dim == 4, "Wrong dimension, dim = " << dim);
+   MFEM_VERIFY(map_type == FiniteElement::VALUE,
+               "only VALUE map type is supported in 4D");
 
    const char *prefix =
       (map_type == FiniteElement::VALUE) ? "DG_Iface" : "DG_IntIface";
@@ -2631,6 +2637,15 @@ DG0_Interface_4DFECollection::DG0_Interface_4DFECollection(const int p, const in
    }
 }
 
+int *DG0_Interface_4DFECollection::DofOrderForOrientation(int GeomType,
+                                                          int Or) const
+{
+   static int ind_pos[] = { 0 };
+
+   if (GeomType == Geometry::TETRAHEDRON) { return ind_pos; }
+   return NULL;
+}
+
 ND_FECollection::ND_FECollection(const int p, const int dim,
                                  const int cb_type, const int ob_type)
 {
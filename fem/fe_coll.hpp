@@ -981,6 +981,10 @@ public:
    DG0_Interface_4DFECollection(const int p, const int dim,
                              const int map_type = FiniteElement::VALUE,
                              const int ob_type = BasisType::GaussLegendre);
+
+   /// The interface dofs are not signed, see DG_Interface_FECollection.
+   virtual int *DofOrderForOrientation(int GeomType, int Or) const;
+   virtual const char *Name() const { return rt_name; }
 };
 
 /// Discontinuous collection defined locally by a given finite element.
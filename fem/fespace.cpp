@@ -1555,6 +1555,21 @@ const FiniteElement *FiniteElementSpace::GetTraceElement(
    return fec->TraceFiniteElementForGeometry(geom_type);
 }
 
+long FiniteElementSpace::MemoryUsage() const
+{
+   long mem = dof_elem_array.MemoryUsage() + dof_ldof_array.MemoryUsage();
+   if (pdofs) { mem += (mesh->GetNPlanars()+1)*sizeof(int); }
+   if (fdofs) { mem += (mesh->GetNFaces()+1)*sizeof(int); }
+   if (bdofs) { mem += (mesh->GetNE()+1)*sizeof(int); }
+   if (elem_dof) { mem += sizeof(Table) + elem_dof->MemoryUsage(); }
+   if (bdrElem_dof) { mem += sizeof(Table) + bdrElem_dof->MemoryUsage(); }
+   if (cP) { mem += cP->MemoryUsage(); }
+   if (cR) { mem += cR->MemoryUsage(); }
+   SparseMatrix *Tmat = dynamic_cast<SparseMatrix *>(T);
+   if (Tmat && own_T) { mem += Tmat->MemoryUsage(); }
+   return mem;
+}
+
 FiniteElementSpace::~FiniteElementSpace()
 {
    Destroy();
@@ -378,6 +378,10 @@ public:
 
    void Save(std::ostream &out) const;
 
+   /** @brief Return the (approximate) memory used by the space, in bytes,
+       excluding the mesh and the finite element collection. */
+   virtual long MemoryUsage() const;
+
    virtual ~FiniteElementSpace();
 };
 
@@ -168,6 +168,11 @@ Geometry::Geometry()
    GeomCenter[PENTATOPE].z = 0.2;
    GeomCenter[PENTATOPE].t = 0.2;
 
+   GeomCenter[TESSERACT].x = 0.5;
+   GeomCenter[TESSERACT].y = 0.5;
+   GeomCenter[TESSERACT].z = 0.5;
+   GeomCenter[TESSERACT].t = 0.5;
+
    PerfGeomToGeomJac[POINT]       = NULL;
    PerfGeomToGeomJac[SEGMENT]     = NULL;
    PerfGeomToGeomJac[TRIANGLE]    = new DenseMatrix(2);
@@ -311,6 +316,57 @@ bool Geometry::CheckPoint(int GeomType, const IntegrationPoint &ip)
          if (ip.x < 0.0 || ip.x > 1.0 || ip.y < 0.0 || ip.y > 1.0 ||
              ip.z < 0.0 || ip.z > 1.0) { return false; }
          break;
+      case Geometry::PENTATOPE:
+         if (ip.x < 0.0 || ip.y < 0.0 || ip.z < 0.0 || ip.t < 0.0 ||
+             ip.x+ip.y+ip.z+ip.t > 1.0) { return false; }
+         break;
+      case Geometry::TESSERACT:
+         if (ip.x < 0.0 || ip.x > 1.0 || ip.y < 0.0 || ip.y > 1.0 ||
+             ip.z < 0.0 || ip.z > 1.0 || ip.t < 0.0 || ip.t > 1.0)
+         { return false; }
+         break;
+      default:
+         MFEM_ABORT("Unknown type of reference element!");
+   }
+   return true;
+}
+
+// static method
+bool Geometry::CheckPoint(int GeomType, const IntegrationPoint &ip, double eps)
+{
+   switch (GeomType)
+   {
+      case Geometry::POINT:
+         if (std::abs(ip.x) > eps) { return false; }
+         break;
+      case Geometry::SEGMENT:
+         if (ip.x < -eps || ip.x > 1.0+eps) { return false; }
+         break;
+      case Geometry::TRIANGLE:
+         if (ip.x < -eps || ip.y < -eps || ip.x+ip.y > 1.0+eps)
+         { return false; }
+         break;
+      case Geometry::SQUARE:
+         if (ip.x < -eps || ip.x > 1.0+eps || ip.y < -eps || ip.y > 1.0+eps)
+         { return false; }
+         break;
+      case Geometry::TETRAHEDRON:
+         if (ip.x < -eps || ip.y < -eps || ip.z < -eps ||
+             ip.x+ip.y+ip.z > 1.0+eps) { return false; }
+         break;
+      case Geometry::CUBE:
+         if (ip.x < -eps || ip.x > 1.0+eps || ip.y < -eps || ip.y > 1.0+eps ||
+             ip.z < -eps || ip.z > 1.0+eps) { return false; }
+         break;
+      case Geometry::PENTATOPE:
+         if (ip.x < -eps || ip.y < -eps || ip.z < -eps || ip.t < -eps ||
+             ip.x+ip.y+ip.z+ip.t > 1.0+eps) { return false; }
+         break;
+      case Geometry::TESSERACT:
+         if (ip.x < -eps || ip.x > 1.0+eps || ip.y < -eps || ip.y > 1.0+eps ||
+             ip.z < -eps || ip.z > 1.0+eps || ip.t < -eps || ip.t > 1.0+eps)
+         { return false; }
+         break;
       default:
          MFEM_ABORT("Unknown type of reference element!");
    }
@@ -340,6 +396,7 @@ inline bool IntersectSegment(double lbeg[N], double lend[N],
       if (dim >= 1) { end.x = t*lend[0] + (1.0-t)*lbeg[0]; }
       if (dim >= 2) { end.y = t*lend[1] + (1.0-t)*lbeg[1]; }
       if (dim >= 3) { end.z = t*lend[2] + (1.0-t)*lbeg[2]; }
+      if (dim >= 4) { end.t = t*lend[3] + (1.0-t)*lbeg[3]; }
       return false;
    }
    return true;
@@ -392,6 +449,26 @@ bool Geometry::ProjectPoint(int GeomType, const IntegrationPoint &beg,
                           };
          return internal::IntersectSegment<6,3>(lbeg, lend, end);
       }
+      case Geometry::PENTATOPE:
+      {
+         double lend[5] = { end.x, end.y, end.z, end.t,
+                            1.0-end.x-end.y-end.z-end.t
+                          };
+         double lbeg[5] = { beg.x, beg.y, beg.z, beg.t,
+                            1.0-beg.x-beg.y-beg.z-beg.t
+                          };
+         return internal::IntersectSegment<5,4>(lbeg, lend, end);
+      }
+      case Geometry::TESSERACT:
+      {
+         double lend[8] = { end.x, end.y, end.z, end.t,
+                            1.0-end.x, 1.0-end.y, 1.0-end.z, 1.0-end.t
+                          };
+         double lbeg[8] = { beg.x, beg.y, beg.z, beg.t,
+                            1.0-beg.x, 1.0-beg.y, 1.0-beg.z, 1.0-beg.t
+                          };
+         return internal::IntersectSegment<8,4>(lbeg, lend, end);
+      }
       default:
          MFEM_ABORT("Unknown type of reference element!");
    }
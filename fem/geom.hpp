@@ -63,6 +63,10 @@ public:
    static void GetRandomPoint(int GeomType, IntegrationPoint &ip);
    /// Check if the given point is inside the given reference element.
    static bool CheckPoint(int GeomType, const IntegrationPoint &ip);
+   /** Check if the given point is inside the given reference element, allowing
+       the point to be outside by at most @a eps in each of the reference
+       coordinate constraints. */
+   static bool CheckPoint(int GeomType, const IntegrationPoint &ip, double eps);
    /** Check if the end point is inside the reference element, if not overwrite
        it with the point on the boundary that lies on the line segment between
        beg and end (beg must be inside the element). Return true if end is
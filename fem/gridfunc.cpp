@@ -262,8 +262,11 @@ int GridFunction::VectorDim() const
    if (!fes->GetNE())
    {
       const FiniteElementCollection *fec = fes->FEColl();
-      static const int geoms[3] =
-      { Geometry::SEGMENT, Geometry::TRIANGLE, Geometry::TETRAHEDRON };
+      static const int geoms[4] =
+      {
+         Geometry::SEGMENT, Geometry::TRIANGLE, Geometry::TETRAHEDRON,
+         Geometry::PENTATOPE
+      };
       fe = fec->FiniteElementForGeometry(geoms[fes->GetMesh()->Dimension()-1]);
    }
    else
@@ -542,6 +545,49 @@ void GridFunction::GetVectorValues(int i, const IntegrationRule &ir,
    GetVectorValues(*Tr, ir, vals);
 }
 
+void GridFunction::GetPointValues(const Array<int> &elem_ids,
+                                  const Array<IntegrationPoint> &ips,
+                                  DenseMatrix &vals) const
+{
+   const int npts = elem_ids.Size();
+   MFEM_VERIFY(ips.Size() == npts, "invalid number of integration points");
+
+   int vsize = VectorDim();
+   const int sdim = fes->GetMesh()->SpaceDimension();
+   if (sdim == 4 && fes->GetNE() > 0 &&
+       fes->GetFE(0)->GetMapType() == FiniteElement::H_DIV_SKEW)
+   {
+      vsize = sdim*sdim;
+   }
+   vals.SetSize(vsize, npts);
+   vals = 0.0;
+
+   IntegrationRule ir(1);
+   DenseMatrix loc_vals;
+   for (int j = 0; j < npts; j++)
+   {
+      const int el = elem_ids[j];
+      if (el < 0) { continue; }
+      ir.IntPoint(0) = ips[j];
+      GetVectorValues(*fes->GetElementTransformation(el), ir, loc_vals);
+      for (int k = 0; k < vsize; k++)
+      {
+         vals(k,j) = loc_vals(k,0);
+      }
+   }
+}
+
+int GridFunction::InterpolateAtPoints(const DenseMatrix &point_mat,
+                                      DenseMatrix &vals)
+{
+   Array<int> elem_ids;
+   Array<IntegrationPoint> ips;
+   const int found = fes->GetMesh()->FindPoints(point_mat, elem_ids, ips,
+                                                false);
+   GetPointValues(elem_ids, ips, vals);
+   return found;
+}
+
 int GridFunction::GetFaceVectorValues(
    int i, int side, const IntegrationRule &ir,
    DenseMatrix &vals, DenseMatrix &tr) const
@@ -1302,16 +1348,7 @@ void GridFunction::ProjectCoefficient(Coefficient &coeff)
 
    if (delta_c == NULL)
    {
-      Array<int> vdofs;
-      Vector vals;
-
-      for (int i = 0; i < fes->GetNE(); i++)
-      {
-         fes->GetElementVDofs(i, vdofs);
-         vals.SetSize(vdofs.Size());
-         fes->GetFE(i)->Project(coeff, *fes->GetElementTransformation(i), vals);
-         SetSubVector(vdofs, vals);
-      }
+      ProjectElementwise(&coeff, NULL);
    }
    else
    {
@@ -1323,6 +1360,67 @@ void GridFunction::ProjectCoefficient(Coefficient &coeff)
    }
 }
 
+void GridFunction::ProjectElementwise(Coefficient *coeff,
+                                      VectorCoefficient *vcoeff)
+{
+   const int NE = fes->GetNE();
+   Array<int> vdofs;
+   Vector vals;
+#ifndef MFEM_USE_OPENMP
+   for (int i = 0; i < NE; i++)
+   {
+      fes->GetElementVDofs(i, vdofs);
+      vals.SetSize(vdofs.Size());
+      if (coeff)
+      {
+         fes->GetFE(i)->Project(*coeff, *fes->GetElementTransformation(i),
+                                vals);
+      }
+      else
+      {
+         fes->GetFE(i)->Project(*vcoeff, *fes->GetElementTransformation(i),
+                                vals);
+      }
+      SetSubVector(vdofs, vals);
+   }
+#else
+   // Project all elements in parallel into a temporary buffer, then scatter
+   // the local values in element order. This way shared dofs get the same
+   // values as in the serial version, independent of the number of threads.
+   Array<int> offsets(NE+1);
+   offsets[0] = 0;
+   for (int i = 0; i < NE; i++)
+   {
+      offsets[i+1] = offsets[i] + fes->GetFE(i)->GetDof()*fes->GetVDim();
+   }
+   Vector buffer(offsets[NE]);
+   IsoparametricTransformation T;
+
+   #pragma omp parallel for private(T,vals)
+   for (int i = 0; i < NE; i++)
+   {
+      fes->GetElementTransformation(i, &T);
+      vals.SetDataAndSize(buffer.GetData() + offsets[i],
+                          offsets[i+1] - offsets[i]);
+      if (coeff)
+      {
+         fes->GetFE(i)->Project(*coeff, T, vals);
+      }
+      else
+      {
+         fes->GetFE(i)->Project(*vcoeff, T, vals);
+      }
+   }
+
+   for (int i = 0; i < NE; i++)
+   {
+      fes->GetElementVDofs(i, vdofs);
+      vals.SetDataAndSize(buffer.GetData() + offsets[i], vdofs.Size());
+      SetSubVector(vdofs, vals);
+   }
+#endif
+}
+
 void GridFunction::ProjectCoefficient(
    Coefficient &coeff, Array<int> &dofs, int vd)
 {
@@ -1349,17 +1447,7 @@ void GridFunction::ProjectCoefficient(
 
 void GridFunction::ProjectCoefficient(VectorCoefficient &vcoeff)
 {
-   int i;
-   Array<int> vdofs;
-   Vector vals;
-
-   for (i = 0; i < fes->GetNE(); i++)
-   {
-      fes->GetElementVDofs(i, vdofs);
-      vals.SetSize(vdofs.Size());
-      fes->GetFE(i)->Project(vcoeff, *fes->GetElementTransformation(i), vals);
-      SetSubVector(vdofs, vals);
-   }
+   ProjectElementwise(NULL, &vcoeff);
 }
 
 void GridFunction::ProjectCoefficient(
@@ -1669,20 +1757,24 @@ void GridFunction::ProjectBdrCoefficientTangent(
 double GridFunction::ComputeL2Error(
    Coefficient *exsol[], const IntegrationRule *irs[]) const
 {
-   double error = 0.0, a;
-   const FiniteElement *fe;
-   ElementTransformation *transf;
-   Vector shape;
+   const int NE = fes->GetNE();
+   const int vdim = fes->GetVDim();
+   // The element contributions are summed up in element order at the end, so
+   // the result does not depend on the number of threads.
+   Vector elem_err(NE);
+   IsoparametricTransformation T;
+   Vector shape, loc_data, exact_col;
+   DenseMatrix exact;
    Array<int> vdofs;
-   int fdof, d, i, intorder, j, k;
 
-   for (i = 0; i < fes->GetNE(); i++)
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for private(T,shape,loc_data,exact_col,exact,vdofs)
+#endif
+   for (int i = 0; i < NE; i++)
    {
-      fe = fes->GetFE(i);
-      fdof = fe->GetDof();
-      transf = fes->GetElementTransformation(i);
-      shape.SetSize(fdof);
-      intorder = 2*fe->GetOrder() + 1; // <----------
+      const FiniteElement *fe = fes->GetFE(i);
+      const int fdof = fe->GetDof();
+      const int intorder = 2*fe->GetOrder() + 1; // <----------
       const IntegrationRule *ir;
       if (irs)
       {
@@ -1692,30 +1784,35 @@ double GridFunction::ComputeL2Error(
       {
          ir = &(IntRules.Get(fe->GetGeomType(), intorder));
       }
+      const int nip = ir->GetNPoints();
+      fes->GetElementTransformation(i, &T);
       fes->GetElementVDofs(i, vdofs);
-      for (j = 0; j < ir->GetNPoints(); j++)
+      GetSubVector(vdofs, loc_data);
+      exact.SetSize(nip, vdim);
+      for (int d = 0; d < vdim; d++)
+      {
+         exact.GetColumnReference(d, exact_col);
+         exsol[d]->Eval(exact_col, T, *ir);
+      }
+      shape.SetSize(fdof);
+      double error = 0.0;
+      for (int j = 0; j < nip; j++)
       {
          const IntegrationPoint &ip = ir->IntPoint(j);
          fe->CalcShape(ip, shape);
-         for (d = 0; d < fes->GetVDim(); d++)
+         T.SetIntPoint(&ip);
+         const double w = ip.weight * T.Weight();
+         for (int d = 0; d < vdim; d++)
          {
-            a = 0;
-            for (k = 0; k < fdof; k++)
-               if (vdofs[fdof*d+k] >= 0)
-               {
-                  a += (*this)(vdofs[fdof*d+k]) * shape(k);
-               }
-               else
-               {
-                  a -= (*this)(-1-vdofs[fdof*d+k]) * shape(k);
-               }
-            transf->SetIntPoint(&ip);
-            a -= exsol[d]->Eval(*transf, ip);
-            error += ip.weight * transf->Weight() * a * a;
+            const double a = shape * ((const double *)loc_data + fdof*d) -
+                             exact(j,d);
+            error += w * a * a;
          }
       }
+      elem_err(i) = error;
    }
 
+   const double error = elem_err.Sum();
    if (error < 0.0)
    {
       return -sqrt(-error);
@@ -1727,9 +1824,9 @@ double GridFunction::ComputeL2Error(
    VectorCoefficient &exsol, const IntegrationRule *irs[],
    Array<int> *elems) const
 {
-   double error = 0.0;
-   const FiniteElement *fe;
-   ElementTransformation *T;
+   const int NE = fes->GetNE();
+   Vector elem_err(NE);
+   IsoparametricTransformation eltrans;
    DenseMatrix vals, exact_vals;
    Vector loc_errs;
 
@@ -1739,10 +1836,16 @@ double GridFunction::ComputeL2Error(
    Array<int> vdofs;
    Vector valsvec;
 
-   for (int i = 0; i < fes->GetNE(); i++)
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for private(eltrans,vals,exact_vals,loc_errs,\
+                                    exactmat,exact_valsmat,shape,vdofs,valsvec)
+#endif
+   for (int i = 0; i < NE; i++)
    {
+      elem_err(i) = 0.0;
       if (elems != NULL && (*elems)[i] == 0) { continue; }
-      fe = fes->GetFE(i);
+      const FiniteElement *fe = fes->GetFE(i);
+      ElementTransformation *T = &eltrans;
       int intorder = 2*fe->GetOrder() + 1; // <----------
       const IntegrationRule *ir;
 
@@ -1755,7 +1858,7 @@ double GridFunction::ComputeL2Error(
       {
          ir = &(IntRules.Get(fe->GetGeomType(), intorder));
       }
-      T = fes->GetElementTransformation(i);
+      fes->GetElementTransformation(i, &eltrans);
       GetVectorValues(*T, *ir, vals);
       exsol.Eval(exact_vals, *T, *ir);
 
@@ -1767,12 +1870,9 @@ double GridFunction::ComputeL2Error(
           MFEM_ASSERT(fe->GetDim() == 4, "");
           int dim = fe->GetDim();
 
-          if (i == 0) // only for the first element
-          {
-              valsvec.SetSize(dim*dim);
-              exactmat.SetSize(dim,dim);
-              exact_valsmat.SetSize(dim*dim,ir->GetNPoints());
-          }
+          valsvec.SetSize(dim*dim);
+          exactmat.SetSize(dim,dim);
+          exact_valsmat.SetSize(dim*dim,ir->GetNPoints());
           exactmat = 0.0;
 
           for (int j = 0; j < ir->GetNPoints(); j++)
@@ -1838,14 +1938,18 @@ double GridFunction::ComputeL2Error(
 
       loc_errs.SetSize(vals.Width());
       vals.Norm2(loc_errs);
+      double error = 0.0;
       for (int j = 0; j < ir->GetNPoints(); j++)
       {
          const IntegrationPoint &ip = ir->IntPoint(j);
          T->SetIntPoint(&ip);
          error += ip.weight * T->Weight() * (loc_errs(j) * loc_errs(j));
       }
+      elem_err(i) = error;
    }
 
+   // sum up in element order, independent of the number of threads
+   const double error = elem_err.Sum();
    if (error < 0.0)
    {
       return -sqrt(-error);
@@ -2004,20 +2108,22 @@ double GridFunction::ComputeH1Error(
 double GridFunction::ComputeMaxError(
    Coefficient *exsol[], const IntegrationRule *irs[]) const
 {
-   double error = 0.0, a;
-   const FiniteElement *fe;
-   ElementTransformation *transf;
-   Vector shape;
+   const int NE = fes->GetNE();
+   const int vdim = fes->GetVDim();
+   Vector elem_err(NE);
+   IsoparametricTransformation T;
+   Vector shape, loc_data, exact_col;
+   DenseMatrix exact;
    Array<int> vdofs;
-   int fdof, d, i, intorder, j, k;
 
-   for (i = 0; i < fes->GetNE(); i++)
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for private(T,shape,loc_data,exact_col,exact,vdofs)
+#endif
+   for (int i = 0; i < NE; i++)
    {
-      fe = fes->GetFE(i);
-      fdof = fe->GetDof();
-      transf = fes->GetElementTransformation(i);
-      shape.SetSize(fdof);
-      intorder = 2*fe->GetOrder() + 1; // <----------
+      const FiniteElement *fe = fes->GetFE(i);
+      const int fdof = fe->GetDof();
+      const int intorder = 2*fe->GetOrder() + 1; // <----------
       const IntegrationRule *ir;
       if (irs)
       {
@@ -2027,35 +2133,35 @@ double GridFunction::ComputeMaxError(
       {
          ir = &(IntRules.Get(fe->GetGeomType(), intorder));
       }
+      const int nip = ir->GetNPoints();
+      fes->GetElementTransformation(i, &T);
       fes->GetElementVDofs(i, vdofs);
-      for (j = 0; j < ir->GetNPoints(); j++)
+      GetSubVector(vdofs, loc_data);
+      exact.SetSize(nip, vdim);
+      for (int d = 0; d < vdim; d++)
       {
-         const IntegrationPoint &ip = ir->IntPoint(j);
-         fe->CalcShape(ip, shape);
-         transf->SetIntPoint(&ip);
-         for (d = 0; d < fes->GetVDim(); d++)
+         exact.GetColumnReference(d, exact_col);
+         exsol[d]->Eval(exact_col, T, *ir);
+      }
+      shape.SetSize(fdof);
+      double error = 0.0;
+      for (int j = 0; j < nip; j++)
+      {
+         fe->CalcShape(ir->IntPoint(j), shape);
+         for (int d = 0; d < vdim; d++)
          {
-            a = 0;
-            for (k = 0; k < fdof; k++)
-               if (vdofs[fdof*d+k] >= 0)
-               {
-                  a += (*this)(vdofs[fdof*d+k]) * shape(k);
-               }
-               else
-               {
-                  a -= (*this)(-1-vdofs[fdof*d+k]) * shape(k);
-               }
-            a -= exsol[d]->Eval(*transf, ip);
-            a = fabs(a);
+            const double a = fabs(shape * ((const double *)loc_data + fdof*d) -
+                                  exact(j,d));
             if (error < a)
             {
                error = a;
             }
          }
       }
+      elem_err(i) = error;
    }
 
-   return error;
+   return (NE > 0) ? elem_err.Max() : 0.0;
 }
 
 double GridFunction::ComputeW11Error(
@@ -58,6 +58,12 @@ protected:
        degree of freedom. */
    void ProjectDiscCoefficient(VectorCoefficient &coeff, Array<int> &dof_attr);
 
+   /** Element-by-element projection of either @a coeff or @a vcoeff (the
+       other one is NULL). With MFEM_USE_OPENMP the elements are processed in
+       parallel; shared dofs still get the value from the last element, as in
+       the serial version. */
+   void ProjectElementwise(Coefficient *coeff, VectorCoefficient *vcoeff);
+
    void Destroy();
 
 public:
@@ -129,6 +135,20 @@ public:
    int GetFaceVectorValues(int i, int side, const IntegrationRule &ir,
                            DenseMatrix &vals, DenseMatrix &tr) const;
 
+   /** @brief Evaluate the function at the points described by @a elem_ids and
+       @a ips, e.g. as returned by Mesh::FindPoints(). Column j of @a vals is
+       the (vector) value at point j; it is set to zero if elem_ids[j] < 0. */
+   void GetPointValues(const Array<int> &elem_ids,
+                       const Array<IntegrationPoint> &ips,
+                       DenseMatrix &vals) const;
+
+   /** @brief Locate the physical points given as the columns of @a point_mat
+       with Mesh::FindPoints() and evaluate the function there, see
+       GetPointValues(). Returns the number of points found. In parallel, the
+       values are returned on all ranks. */
+   virtual int InterpolateAtPoints(const DenseMatrix &point_mat,
+                                   DenseMatrix &vals);
+
    void GetValuesFrom(GridFunction &);
 
    void GetBdrValuesFrom(GridFunction &);
@@ -29,8 +29,8 @@ namespace mfem
 
 Hybridization::Hybridization(FiniteElementSpace *fespace,
                              FiniteElementSpace *c_fespace)
-   : fes(fespace), c_fes(c_fespace), c_bfi(NULL), Ct(NULL), H(NULL),
-     Af_data(NULL), Af_ipiv(NULL)
+   : fes(fespace), c_fes(c_fespace), l_fes(NULL), c_bfi(NULL), symm(true),
+     Ct(NULL), H(NULL), Af_data(NULL), Af_ipiv(NULL)
 {
 #ifdef MFEM_USE_MPI
    pC = P_pc = NULL;
@@ -107,9 +107,11 @@ void Hybridization::ConstructC()
          if (!FTr) { continue; }
 
          int o1 = hat_offsets[FTr->Elem1No];
-         int s1 = hat_offsets[FTr->Elem1No+1] - o1;
+         int s1 = hat_offsets[FTr->Elem1No+1] - o1 -
+                  GetNumLocalDofs(FTr->Elem1No);
          int o2 = hat_offsets[FTr->Elem2No];
-         int s2 = hat_offsets[FTr->Elem2No+1] - o2;
+         int s2 = hat_offsets[FTr->Elem2No+1] - o2 -
+                  GetNumLocalDofs(FTr->Elem2No);
          vdofs.SetSize(s1 + s2);
          for (int j = 0; j < s1; j++)
          {
@@ -158,7 +160,8 @@ void Hybridization::ConstructC()
                }
             }
             int o1 = hat_offsets[FTr->Elem1No];
-            int s1 = hat_offsets[FTr->Elem1No+1] - o1;
+            int s1 = hat_offsets[FTr->Elem1No+1] - o1 -
+                     GetNumLocalDofs(FTr->Elem1No);
             vdofs.SetSize(s1);
             for (int j = 0; j < s1; j++)
             {
@@ -224,7 +227,7 @@ void Hybridization::Init(const Array<int> &ess_tdof_list)
    for (int i = 0; i < NE; i++)
    {
       fes->GetElementVDofs(i, vdofs);
-      num_hat_dofs += vdofs.Size();
+      num_hat_dofs += vdofs.Size() + GetNumLocalDofs(i);
       hat_offsets[i+1] = num_hat_dofs;
    }
 
@@ -306,6 +309,13 @@ void Hybridization::Init(const Array<int> &ess_tdof_list)
       {
          hat_dofs_marker[hat_offsets[i]+j] = ! free_vdofs_marker[vdofs[j]];
       }
+      // The dofs of l_fes are eliminated together with the "boundary" dofs:
+      // the mixed element matrix restricted to the "internal" dofs may be
+      // singular, e.g. the zero L2-L2 block for RT0-P0.
+      for (int j = hat_offsets[i] + vdofs.Size(); j < hat_offsets[i+1]; j++)
+      {
+         hat_dofs_marker[j] = -1;
+      }
    }
 #ifndef MFEM_DEBUG
    // In DEBUG mode this array is used below.
@@ -365,6 +375,7 @@ void Hybridization::Init(const Array<int> &ess_tdof_list)
 
    Af_data = new double[Af_offsets[NE]];
    Af_ipiv = new int[Af_f_offsets[NE]];
+   symm = true;
 
 #ifdef MFEM_DEBUG
    // check that Ref = 0
@@ -442,6 +453,17 @@ void Hybridization::AssembleMatrix(int el, const DenseMatrix &A)
 {
    Array<int> i_dofs, b_dofs;
 
+   MFEM_ASSERT(A.Height() == hat_offsets[el+1] - hat_offsets[el] &&
+               A.Width() == A.Height(), "invalid element matrix size");
+   const double tol = 1e-12*A.MaxMaxNorm();
+   for (int j = 1; symm && j < A.Width(); j++)
+   {
+      for (int i = 0; i < j; i++)
+      {
+         if (std::abs(A(i,j) - A(j,i)) > tol) { symm = false; break; }
+      }
+   }
+
    GetIBDofs(el, i_dofs, b_dofs);
 
    DenseMatrix A_ii(Af_data + Af_offsets[el], i_dofs.Size(), i_dofs.Size());
@@ -569,10 +591,7 @@ void Hybridization::AssembleBdrMatrix(int bdr_el, const DenseMatrix &A)
 void Hybridization::ComputeH()
 {
    const int skip_zeros = 1;
-   Array<int> c_dof_marker(Ct->Width());
-   Array<int> b_dofs, c_dofs;
    const int NE = fes->GetNE();
-   DenseMatrix Cb_t, Sb_inv_Cb_t, Hb;
 #ifndef MFEM_USE_MPI
    H = new SparseMatrix(Ct->Width());
 #else
@@ -581,78 +600,99 @@ void Hybridization::ComputeH()
    SparseMatrix *V = pC ? new SparseMatrix(Ct->Height(), Ct->Width()) : NULL;
 #endif
 
-   c_dof_marker = -1;
-   int c_mark_start = 0;
-   for (int el = 0; el < NE; el++)
+   // The element blocks are factored independently, so the elements are
+   // processed in parallel; only the assembly into H (or V) is serialized.
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel
+#endif
    {
-      int i_dofs_size;
-      GetBDofs(el, i_dofs_size, b_dofs);
+      // c_dof_marker[c_dof] is the local index of c_dof in the current element
+      // or -1; it is reset after each element.
+      Array<int> c_dof_marker(Ct->Width());
+      Array<int> b_dofs, c_dofs;
+      DenseMatrix Cb_t, Sb_inv_Cb_t, Hb;
+      c_dof_marker = -1;
+#ifdef MFEM_USE_OPENMP
+      #pragma omp for
+#endif
+      for (int el = 0; el < NE; el++)
+      {
+         int i_dofs_size;
+         GetBDofs(el, i_dofs_size, b_dofs);
 
-      LUFactors LU_ii(Af_data + Af_offsets[el], Af_ipiv + Af_f_offsets[el]);
-      double *A_ib_data = LU_ii.data + i_dofs_size*i_dofs_size;
-      double *A_bi_data = A_ib_data + i_dofs_size*b_dofs.Size();
-      LUFactors LU_bb(A_bi_data + i_dofs_size*b_dofs.Size(),
-                      LU_ii.ipiv + i_dofs_size);
+         LUFactors LU_ii(Af_data + Af_offsets[el], Af_ipiv + Af_f_offsets[el]);
+         double *A_ib_data = LU_ii.data + i_dofs_size*i_dofs_size;
+         double *A_bi_data = A_ib_data + i_dofs_size*b_dofs.Size();
+         LUFactors LU_bb(A_bi_data + i_dofs_size*b_dofs.Size(),
+                         LU_ii.ipiv + i_dofs_size);
 
-      LU_ii.Factor(i_dofs_size);
-      LU_ii.BlockFactor(i_dofs_size, b_dofs.Size(),
-                        A_ib_data, A_bi_data, LU_bb.data);
-      LU_bb.Factor(b_dofs.Size());
+         LU_ii.Factor(i_dofs_size);
+         LU_ii.BlockFactor(i_dofs_size, b_dofs.Size(),
+                           A_ib_data, A_bi_data, LU_bb.data);
+         LU_bb.Factor(b_dofs.Size());
 
-      // Extract Cb_t from Ct, define c_dofs
-      c_dofs.SetSize(0);
-      for (int i = 0; i < b_dofs.Size(); i++)
-      {
-         const int row = b_dofs[i];
-         const int ncols = Ct->RowSize(row);
-         const int *cols = Ct->GetRowColumns(row);
-         for (int j = 0; j < ncols; j++)
+         // Extract Cb_t from Ct, define c_dofs
+         c_dofs.SetSize(0);
+         for (int i = 0; i < b_dofs.Size(); i++)
+         {
+            const int row = b_dofs[i];
+            const int ncols = Ct->RowSize(row);
+            const int *cols = Ct->GetRowColumns(row);
+            for (int j = 0; j < ncols; j++)
+            {
+               const int c_dof = cols[j];
+               if (c_dof_marker[c_dof] < 0)
+               {
+                  c_dof_marker[c_dof] = c_dofs.Size();
+                  c_dofs.Append(c_dof);
+               }
+            }
+         }
+         Cb_t.SetSize(b_dofs.Size(), c_dofs.Size());
+         Cb_t = 0.0;
+         for (int i = 0; i < b_dofs.Size(); i++)
          {
-            const int c_dof = cols[j];
-            if (c_dof_marker[c_dof] < c_mark_start)
+            const int row = b_dofs[i];
+            const int ncols = Ct->RowSize(row);
+            const int *cols = Ct->GetRowColumns(row);
+            const double *vals = Ct->GetRowEntries(row);
+            for (int j = 0; j < ncols; j++)
             {
-               c_dof_marker[c_dof] = c_mark_start + c_dofs.Size();
-               c_dofs.Append(c_dof);
+               Cb_t(i,c_dof_marker[cols[j]]) = vals[j];
             }
          }
-      }
-      Cb_t.SetSize(b_dofs.Size(), c_dofs.Size());
-      Cb_t = 0.0;
-      for (int i = 0; i < b_dofs.Size(); i++)
-      {
-         const int row = b_dofs[i];
-         const int ncols = Ct->RowSize(row);
-         const int *cols = Ct->GetRowColumns(row);
-         const double *vals = Ct->GetRowEntries(row);
-         for (int j = 0; j < ncols; j++)
+         for (int j = 0; j < c_dofs.Size(); j++)
          {
-            const int loc_j = c_dof_marker[cols[j]] - c_mark_start;
-            Cb_t(i,loc_j) = vals[j];
+            c_dof_marker[c_dofs[j]] = -1;
          }
-      }
 
-      // Compute Hb = Cb Sb^{-1} Cb^t
-      Sb_inv_Cb_t = Cb_t;
-      LU_bb.Solve(Cb_t.Height(), Cb_t.Width(), Sb_inv_Cb_t.Data());
+         // Compute Hb = Cb Sb^{-1} Cb^t
+         Sb_inv_Cb_t = Cb_t;
+         LU_bb.Solve(Cb_t.Height(), Cb_t.Width(), Sb_inv_Cb_t.Data());
 #ifdef MFEM_USE_MPI
-      if (!pC)
+         if (!pC)
 #endif
-      {
-         Hb.SetSize(Cb_t.Width());
-         MultAtB(Cb_t, Sb_inv_Cb_t, Hb);
+         {
+            Hb.SetSize(Cb_t.Width());
+            MultAtB(Cb_t, Sb_inv_Cb_t, Hb);
+            if (symm) { Hb.Symmetrize(); }
 
-         // Assemble Hb into H
-         H->AddSubMatrix(c_dofs, c_dofs, Hb, skip_zeros);
-      }
+            // Assemble Hb into H
+#ifdef MFEM_USE_OPENMP
+            #pragma omp critical (Hybridization_H)
+#endif
+            H->AddSubMatrix(c_dofs, c_dofs, Hb, skip_zeros);
+         }
 #ifdef MFEM_USE_MPI
-      else
-      {
-         V->AddSubMatrix(b_dofs, c_dofs, Sb_inv_Cb_t, skip_zeros);
-      }
+         else
+         {
+#ifdef MFEM_USE_OPENMP
+            #pragma omp critical (Hybridization_H)
 #endif
-
-      c_mark_start += c_dofs.Size();
-      MFEM_VERIFY(c_mark_start >= 0, "overflow"); // check for overflow
+            V->AddSubMatrix(b_dofs, c_dofs, Sb_inv_Cb_t, skip_zeros);
+         }
+#endif
+      }
    }
    const bool fix_empty_rows = true;
 #ifndef MFEM_USE_MPI
@@ -728,19 +768,23 @@ void Hybridization::MultAfInv(const Vector &b, const Vector &lambda, Vector &bf,
    // b1 = Rf^t b (assuming that Ref = 0)
    Vector b1;
    const SparseMatrix *R = fes->GetRestrictionMatrix();
+   const int f_size = R ? R->Height() : fes->GetVSize();
+   MFEM_ASSERT(b.Size() == f_size + (l_fes ? l_fes->GetVSize() : 0),
+               "'b' has incorrect size");
    if (!R)
    {
-      b1.SetDataAndSize(b.GetData(), b.Size());
+      b1.SetDataAndSize(b.GetData(), f_size);
    }
    else
    {
+      Vector b_f(b.GetData(), f_size);
       b1.SetSize(fes->GetVSize());
-      R->MultTranspose(b, b1);
+      R->MultTranspose(b_f, b1);
    }
 
    const int NE = fes->GetMesh()->GetNE();
-   Array<int> vdofs, i_dofs, b_dofs;
-   Vector el_vals, bf_i, i_vals, b_vals;
+   Array<int> vdofs, l_vdofs;
+   Vector el_vals, el_f_vals, bf_i;
    bf.SetSize(hat_offsets[NE]);
    if (mode == 1)
    {
@@ -761,45 +805,76 @@ void Hybridization::MultAfInv(const Vector &b, const Vector &lambda, Vector &bf,
       Ct->Mult(lambda, bf);
 #endif
    }
-   // Apply Af^{-1}
+   // Gather the element right-hand sides in bf; every vdof is given to the
+   // first element that contains it, so this pass is done serially.
    Array<bool> vdof_marker(b1.Size());
    vdof_marker = false;
    for (int i = 0; i < NE; i++)
    {
       fes->GetElementVDofs(i, vdofs);
-      b1.GetSubVector(vdofs, el_vals);
-      for (int j = 0; j < vdofs.Size(); j++)
+      const int nf = vdofs.Size();
+      el_vals.SetSize(hat_offsets[i+1] - hat_offsets[i]);
+      el_f_vals.SetDataAndSize(el_vals.GetData(), nf);
+      b1.GetSubVector(vdofs, el_f_vals);
+      for (int j = 0; j < nf; j++)
       {
          int vdof = vdofs[j];
          if (vdof < 0) { vdof = -1 - vdof; }
          if (vdof_marker[vdof]) { el_vals(j) = 0.0; }
          else { vdof_marker[vdof] = true; }
       }
-      bf_i.SetDataAndSize(&bf[hat_offsets[i]], vdofs.Size());
-      if (mode == 1)
+      if (l_fes)
       {
-         el_vals -= bf_i;
+         // the l_fes part of b; the rows of Ct for these dofs are 0
+         l_fes->GetElementVDofs(i, l_vdofs);
+         for (int j = 0; j < l_vdofs.Size(); j++)
+         {
+            el_vals(nf+j) = b(f_size + l_vdofs[j]);
+         }
       }
-      GetIBDofs(i, i_dofs, b_dofs);
-      el_vals.GetSubVector(i_dofs, i_vals);
-      el_vals.GetSubVector(b_dofs, b_vals);
-
-      LUFactors LU_ii(Af_data + Af_offsets[i], Af_ipiv + Af_f_offsets[i]);
-      double *U_ib = LU_ii.data + i_dofs.Size()*i_dofs.Size();
-      double *L_bi = U_ib + i_dofs.Size()*b_dofs.Size();
-      LUFactors LU_bb(L_bi + b_dofs.Size()*i_dofs.Size(),
-                      LU_ii.ipiv + i_dofs.Size());
-      LU_ii.BlockForwSolve(i_dofs.Size(), b_dofs.Size(), 1, L_bi,
-                           i_vals.GetData(), b_vals.GetData());
-      LU_bb.Solve(b_dofs.Size(), 1, b_vals.GetData());
-      bf_i = 0.0;
+      bf_i.SetDataAndSize(&bf[hat_offsets[i]], el_vals.Size());
       if (mode == 1)
       {
-         LU_ii.BlockBackSolve(i_dofs.Size(), b_dofs.Size(), 1, U_ib,
-                              b_vals.GetData(), i_vals.GetData());
-         bf_i.SetSubVector(i_dofs, i_vals);
+         el_vals -= bf_i;
+      }
+      bf_i = el_vals;
+   }
+
+   // Apply Af^{-1}, element by element in parallel
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel
+#endif
+   {
+      Array<int> i_dofs, b_dofs;
+      Vector bf_el, i_vals, b_vals;
+#ifdef MFEM_USE_OPENMP
+      #pragma omp for
+#endif
+      for (int i = 0; i < NE; i++)
+      {
+         bf_el.SetDataAndSize(&bf[hat_offsets[i]],
+                              hat_offsets[i+1] - hat_offsets[i]);
+         GetIBDofs(i, i_dofs, b_dofs);
+         bf_el.GetSubVector(i_dofs, i_vals);
+         bf_el.GetSubVector(b_dofs, b_vals);
+
+         LUFactors LU_ii(Af_data + Af_offsets[i], Af_ipiv + Af_f_offsets[i]);
+         double *U_ib = LU_ii.data + i_dofs.Size()*i_dofs.Size();
+         double *L_bi = U_ib + i_dofs.Size()*b_dofs.Size();
+         LUFactors LU_bb(L_bi + b_dofs.Size()*i_dofs.Size(),
+                         LU_ii.ipiv + i_dofs.Size());
+         LU_ii.BlockForwSolve(i_dofs.Size(), b_dofs.Size(), 1, L_bi,
+                              i_vals.GetData(), b_vals.GetData());
+         LU_bb.Solve(b_dofs.Size(), 1, b_vals.GetData());
+         bf_el = 0.0;
+         if (mode == 1)
+         {
+            LU_ii.BlockBackSolve(i_dofs.Size(), b_dofs.Size(), 1, U_ib,
+                                 b_vals.GetData(), i_vals.GetData());
+            bf_el.SetSubVector(i_dofs, i_vals);
+         }
+         bf_el.SetSubVector(b_dofs, b_vals);
       }
-      bf_i.SetSubVector(b_dofs, b_vals);
    }
 }
 
@@ -840,32 +915,44 @@ void Hybridization::ComputeSolution(const Vector &b, const Vector &sol_r,
    // sol = Rf bf
    GridFunction s;
    const SparseMatrix *R = fes->GetRestrictionMatrix();
+   const int f_size = R ? R->Height() : fes->GetVSize();
+   MFEM_ASSERT(sol.Size() == f_size + (l_fes ? l_fes->GetVSize() : 0),
+               "'sol' has incorrect size");
+   Vector sol_f(sol.GetData(), f_size);
    if (!R)
    {
-      MFEM_ASSERT(sol.Size() == fes->GetVSize(), "");
-      s.MakeRef(fes, sol, 0);
+      s.MakeRef(fes, sol_f, 0);
    }
    else
    {
       s.SetSpace(fes);
-      R->MultTranspose(sol, s);
+      R->MultTranspose(sol_f, s);
    }
    const int NE = fes->GetMesh()->GetNE();
-   Array<int> vdofs;
+   Array<int> vdofs, l_vdofs;
    for (int i = 0; i < NE; i++)
    {
       fes->GetElementVDofs(i, vdofs);
-      for (int j = hat_offsets[i]; j < hat_offsets[i+1]; j++)
+      const int l_start = hat_offsets[i] + vdofs.Size();
+      for (int j = hat_offsets[i]; j < l_start; j++)
       {
          if (hat_dofs_marker[j] == 1) { continue; } // skip essential b.c.
          int vdof = vdofs[j-hat_offsets[i]];
          if (vdof >= 0) { s(vdof) = bf(j); }
          else { s(-1-vdof) = -bf(j); }
       }
+      if (l_fes)
+      {
+         l_fes->GetElementVDofs(i, l_vdofs);
+         for (int j = 0; j < l_vdofs.Size(); j++)
+         {
+            sol(f_size + l_vdofs[j]) = bf(l_start + j);
+         }
+      }
    }
    if (R)
    {
-      R->Mult(s, sol); // assuming that Ref = 0
+      R->Mult(s, sol_f); // assuming that Ref = 0
    }
 }
 
@@ -873,6 +960,7 @@ void Hybridization::Reset()
 {
    delete H;
    H = NULL;
+   symm = true;
 #ifdef MFEM_USE_MPI
    pH.Clear();
 #endif
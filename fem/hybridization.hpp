@@ -56,12 +56,21 @@ namespace mfem
         \f[ S_b = \hat{A}_b - \hat{A}_{bf} \hat{A}_{f}^{-1} \hat{A}_{fb}. \f]
 
     Hybridization can also be viewed as a discretization method for imposing
-    (weak) continuity constraints between neighboring elements. */
+    (weak) continuity constraints between neighboring elements.
+
+    Mixed systems, e.g. the RT-L2 discretization of a Darcy problem, can be
+    hybridized by adding the discontinuous space with SetLocalSpace(): its dofs
+    are appended to the element dofs of the constrained space and they are
+    eliminated element by element. For RT0-P0, also in 4D with RT0_4D and
+    DG0_Interface_4D spaces, the hybridized matrix \f$ H \f$ is then symmetric
+    positive definite and can be solved with PCG and AMG. */
 class Hybridization
 {
 protected:
    FiniteElementSpace *fes, *c_fes;
+   FiniteElementSpace *l_fes; // optional discontinuous space, see SetLocalSpace
    BilinearFormIntegrator *c_bfi;
+   bool symm; // all assembled element matrices are symmetric
 
    SparseMatrix *Ct, *H;
 
@@ -75,6 +84,10 @@ protected:
    OperatorHandle pH;
 #endif
 
+   /// Number of dofs of l_fes in element el, appended to its hat dofs.
+   int GetNumLocalDofs(int el) const
+   { return l_fes ? l_fes->GetFE(el)->GetDof()*l_fes->GetVDim() : 0; }
+
    void ConstructC();
 
    void GetIBDofs(int el, Array<int> &i_dofs, Array<int> &b_dofs) const;
@@ -88,7 +101,7 @@ protected:
    //           the non-"boundary" part of bf is set to 0;
    // - mode 1: bf = Af^{-1} ( Rf^t b - Cf^t lambda ), where
    //           the "essential" part of bf is set to 0.
-   // Input: size(b)      =   fes->GetConformingVSize()
+   // Input: size(b)      =   fes->GetConformingVSize() (+ l_fes->GetVSize())
    //        size(lambda) = c_fes->GetConformingVSize()
    void MultAfInv(const Vector &b, const Vector &lambda, Vector &bf,
                   int mode) const;
@@ -105,10 +118,22 @@ public:
    void SetConstraintIntegrator(BilinearFormIntegrator *c_integ)
    { delete c_bfi; c_bfi = c_integ; }
 
+   /** @brief Add a discontinuous space, e.g. L2, whose element dofs are
+       eliminated locally together with the dofs of the constrained space.
+
+       The element matrices given to AssembleMatrix() are then the matrices of
+       the mixed system on the element dofs of fes followed by the element dofs
+       of @a l_fespace, and the vectors in ReduceRHS() and ComputeSolution()
+       are the fes vectors followed by the @a l_fespace vectors. Must be called
+       before Init(). */
+   void SetLocalSpace(FiniteElementSpace *l_fespace) { l_fes = l_fespace; }
+
    /// Prepare the Hybridization object for assembly.
    void Init(const Array<int> &ess_tdof_list);
 
-   /// Assemble the element matrix A into the hybridized system matrix.
+   /** Assemble the element matrix A into the hybridized system matrix. If all
+       element matrices are symmetric, the element contributions to H are
+       symmetrized to remove round-off. */
    void AssembleMatrix(int el, const DenseMatrix &A);
 
    /// Assemble the boundary element matrix A into the hybridized system matrix.
@@ -17,6 +17,7 @@
 
 #include "fem.hpp"
 #include <cmath>
+#include <algorithm>
 
 #ifdef MFEM_USE_MPFR
 #include <mpfr.h>
@@ -149,6 +150,30 @@ void IntegrationRule::GrundmannMollerSimplexRule(int s, int n)
    }
 }
 
+int IntegrationRule::AddPentPermutations(
+   const int off, const double l0, const double l1, const double l2,
+   const double l3, const double l4, const double weight)
+{
+   const double l[5] = { l0, l1, l2, l3, l4 };
+   // permute the group indices of the coordinates in lexicographic order, so
+   // that every distinct point is generated once
+   int perm[5];
+   perm[0] = 0;
+   for (int i = 1; i < 5; i++)
+   {
+      perm[i] = (l[i] == l[i-1]) ? perm[i-1] : i;
+   }
+   int np = 0;
+   do
+   {
+      IntPoint(off + np).Set4w(l[perm[1]], l[perm[2]], l[perm[3]], l[perm[4]],
+                               weight);
+      np++;
+   }
+   while (std::next_permutation(perm, perm + 5));
+   return np;
+}
+
 
 #ifdef MFEM_USE_MPFR
 
@@ -1610,36 +1635,137 @@ IntegrationRule *IntegrationRules::CubeIntegrationRule(int Order)
    return CubeIntRules[Order];
 }
 
+/** Integration rules for reference pentatope
+    {[0,0,0,0],[1,0,0,0],[0,1,0,0],[0,0,1,0],[0,0,0,1]}
+
+    The rules of degrees 3 to 9 are fully symmetric, with positive weights
+    and interior points; they were computed (and can be verified) with the
+    miniapp miniapps/tools/pentatope-quadrature. The rules of degree 10 and
+    higher are conical product rules with negative weights. */
 IntegrationRule *IntegrationRules::PentatopeIntegrationRule(int Order)
 {
    IntegrationRule *ir;
+   // Note: Set PentatopeIntRules[*] to ir only *after* ir is fully
+   // constructed. This is needed in multithreaded environment.
 
+   // assuming that orders <= 10 are pre-allocated
    switch (Order)
    {
       case 0:  // 1 point - degree 1
       case 1:
-         PentatopeIntRules[0] = PentatopeIntRules[1] = ir = new IntegrationRule(1);
+         ir = new IntegrationRule(1);
          ir->AddPentMidPoint(0, 1./24.);
+         PentatopeIntRules[0] = PentatopeIntRules[1] = ir;
          return ir;
 
-      case 2:  // 5 points - degree 3
-      case 3:
-         PentatopeIntRules[2] = PentatopeIntRules[3] = ir = new IntegrationRule(5);
-         ir->AddPentPoints5(0,0.118350341907227374, 0.526598632371090503, 1/120.);
+      case 2:  // 5 points - degree 2
+         ir = new IntegrationRule(5);
+         ir->AddPentPoints5(0, 0.118350341907227374, 0.526598632371090503,
+                            1./120.);
+         PentatopeIntRules[2] = ir;
+         return ir;
+
+      case 3:  // 15 points - degree 3
+         ir = new IntegrationRule(15);
+         ir->AddPentPoints5(0, 0.020700981333817023, 6.5931069551536132E-04);
+         ir->AddPentPoints10(5, 0.3092695245786245, 3.8370113189089877E-03);
+         PentatopeIntRules[3] = ir;
+         return ir;
+
+      case 4:  // 20 points - degree 4
+         ir = new IntegrationRule(20);
+         ir->AddPentPoints5(0, 0.24545721375761376, 3.5837789549162677E-03);
+         ir->AddPentPoints5(5, 0.084781901467071458, 1.9397285718391222E-03);
+         ir->AddPentPoints10(10, 0.054196647434505141,
+                             1.4049129032889715E-03);
+         PentatopeIntRules[4] = ir;
+         return ir;
+
+      case 5:  // 30 points - degree 5
+         ir = new IntegrationRule(30);
+         ir->AddPentPoints5(0, 0.084379535584275425, 1.9719287808965327E-03);
+         ir->AddPentPoints5(5, 0.23785713020523269, 2.3114403924539609E-03);
+         ir->AddPentPoints10(10, 0.31000906067011846,
+                             9.8522996144777383E-04);
+         ir->AddPentPoints10(20, 0.052614386261744757,
+                             1.0397521185436464E-03);
+         PentatopeIntRules[5] = ir;
+         return ir;
+
+      case 6:  // 56 points - degree 6
+         ir = new IntegrationRule(56);
+         ir->AddPentMidPoint(0, 4.6857940692539559E-03);
+         ir->AddPentPoints5(1, 0.24960880031194244, 9.3125038887828277E-04);
+         ir->AddPentPoints10(6, 0.30860173234278093, 9.1164029653734093E-04);
+         ir->AddPentPoints20(16, 0.0085064715662151683, 0.13926710203674753,
+                             4.9945017863201773E-05);
+         ir->AddPentPoints20(36, 0.065152077273434, 0.55038485615384802,
+                             1.1104658665191927E-03);
+         PentatopeIntRules[6] = ir;
+         return ir;
+
+      case 7:  // 76 points - degree 7
+         ir = new IntegrationRule(76);
+         ir->AddPentMidPoint(0, 1.1780319483246789E-03);
+         ir->AddPentPoints5(1, 0.24940208930937807, 7.1515800064806886E-04);
+         ir->AddPentPoints10(6, 0.1283114044638122, 6.318067815019022E-04);
+         ir->AddPentPoints10(16, 0.039027995660106923,
+                             3.5109543407236871E-04);
+         ir->AddPentPoints20(26, 0.033847470986564279, 0.15219515835896816,
+                             1.7124728506173146E-04);
+         ir->AddPentPoints30(46, 0.044833796455796104, 0.20987108571623247,
+                             7.886292286041431E-04);
+         PentatopeIntRules[7] = ir;
+         return ir;
+
+      case 8:  // 115 points - degree 8
+         ir = new IntegrationRule(115);
+         ir->AddPentPoints5(0, 0.23607431104202151, 1.4706957574150529E-03);
+         ir->AddPentPoints5(5, 0.12909365254524863, 1.1676117053663721E-03);
+         ir->AddPentPoints5(10, 0.016254548129435348,
+                            1.6793469263943394E-05);
+         ir->AddPentPoints20(15, 0.027775403958304811, 0.61938470572779736,
+                             1.4276183394143989E-04);
+         ir->AddPentPoints20(35, 0.094037907936397866, 0.7175736240084426,
+                             1.7806730428670129E-04);
+         ir->AddPentPoints30(55, 0.11188160181840558, 0.37945293644610473,
+                             3.3892046128204434E-04);
+         ir->AddPentPoints30(85, 0.2243799236131841, 0.036032976224068231,
+                             3.9356551344718908E-04);
+         PentatopeIntRules[8] = ir;
+         return ir;
+
+      case 9:  // 230 points - degree 9
+         ir = new IntegrationRule(230);
+         ir->AddPentPoints10(0, 0.1294180981006415, 6.7575499419186987E-04);
+         ir->AddPentPoints10(10, 0.31390061510654876, 2.9294536766725354E-04);
+         ir->AddPentPoints20(20, 0.02291335698518283, 0.67544199034137964,
+                             6.8158303077021332E-05);
+         ir->AddPentPoints20(40, 0.061089461101857485, 6.5886349351578627E-04,
+                             4.7404770982479013E-05);
+         ir->AddPentPoints20(60, 0.17681358675948208, 0.42760612468398018,
+                             3.3270961150789211E-04);
+         ir->AddPentPoints30(80, 0.14362440620928096, 0.34778644567569816,
+                             2.7029501183241248E-04);
+         ir->AddPentPoints60(110, 0.024603994030786502, 0.46840270698480885,
+                             0.10594467255874278, 8.4157210595749255E-05);
+         ir->AddPentPoints60(170, 0.038923657777474641, 0.16485329753149552,
+                             0.16526779811961675, 1.6426543910017105E-04);
+         PentatopeIntRules[9] = ir;
          return ir;
 
       default:
       {
-         //construct the higher integration rules with the duffy transformation --> 1d integral in time and a tet quad-rule w.r.t space
-
+         // Higher orders: conical product (Duffy transformation) of a 1D rule
+         // in time and a tetrahedral rule in space. The tetrahedral rules of
+         // these orders are Grundmann-Moller rules, so these rules have
+         // negative weights.
          IntegrationRule *timeIR = SegmentIntegrationRule(Order+3);
          IntegrationRule *tetIR = TetrahedronIntegrationRule(Order);
 
          int NIP = timeIR->GetNPoints() * tetIR->GetNPoints();
          AllocIntRule(PentatopeIntRules, Order);
-         PentatopeIntRules[Order] = ir = new IntegrationRule(NIP);
-
-         //    cout << "higher integration rules for pentatopes implemented with duffy ( order = " << Order << " ) --> " << NIP << " int. points!" << endl;
+         ir = new IntegrationRule(NIP);
 
          double xi,yi,zi,ti, weight;
 
@@ -1655,18 +1781,16 @@ IntegrationRule *IntegrationRules::PentatopeIntegrationRule(int Order)
                zi = (1.-ti)*tetIR->IntPoint(j).z;
                weight = timeIR->IntPoint(i).weight * tetIR->IntPoint(j).weight * (1.-ti) *
                         (1.-ti) * (1.-ti);
-               //          if(weight<0) cout << "warning weight is negative!" << endl;
 
                ir->AddPentPoint(pos, xi,yi,zi,ti,weight);
 
                pos++;
             }
          }
+         PentatopeIntRules[Order] = ir;
+         return ir;
       }
    }
-
-   return PentatopeIntRules[Order];
-
 }
 
 IntegrationRule *IntegrationRules::TesseractIntegrationRule(int Order)
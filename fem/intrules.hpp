@@ -235,6 +235,44 @@ private:
       IntPoint(off + 4).Set4w(a, a, a, b, weight);
    }
 
+   // given a, add the permutations of (a,a,a,a,b), where 4*a + b = 1
+   void AddPentPoints5(const int off, const double a, const double weight)
+   { AddPentPoints5(off, a, 1. - 4.*a, weight); }
+
+   /** Add all distinct permutations of the barycentric coordinates (l0,...,l4)
+       of a point in the pentatope, where equal coordinates must be grouped
+       together; returns the number of added points. */
+   int AddPentPermutations(const int off, const double l0, const double l1,
+                           const double l2, const double l3, const double l4,
+                           const double weight);
+
+   // given a, add the permutations of (a,a,a,b,b), where 3*a + 2*b = 1
+   void AddPentPoints10(const int off, const double a, const double weight)
+   {
+      const double b = (1. - 3.*a)/2.;
+      AddPentPermutations(off, a, a, a, b, b, weight);
+   }
+
+   // given (a,b), add the permutations of (a,a,a,b,c), 3*a + b + c = 1
+   void AddPentPoints20(const int off, const double a, const double b,
+                        const double weight)
+   { AddPentPermutations(off, a, a, a, b, 1. - 3.*a - b, weight); }
+
+   // given (a,b), add the permutations of (a,a,b,b,c), 2*(a + b) + c = 1
+   void AddPentPoints30(const int off, const double a, const double b,
+                        const double weight)
+   { AddPentPermutations(off, a, a, b, b, 1. - 2.*(a + b), weight); }
+
+   // given (a,b,c), add the permutations of (a,a,b,c,d), 2*a + b + c + d = 1
+   void AddPentPoints60(const int off, const double a, const double b,
+                        const double c, const double weight)
+   { AddPentPermutations(off, a, a, b, c, 1. - 2.*a - b - c, weight); }
+
+   // given (a,b,c,d), add the permutations of (a,b,c,d,e), a+b+c+d+e = 1
+   void AddPentPoints120(const int off, const double a, const double b,
+                         const double c, const double d, const double weight)
+   { AddPentPermutations(off, a, b, c, d, 1. - a - b - c - d, weight); }
+
 public:
    IntegrationRule() : Array<IntegrationPoint>() { }
 
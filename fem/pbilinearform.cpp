@@ -296,6 +296,39 @@ void ParBilinearForm::FormLinearSystem(
       // Schur complement reduction to the exposed dofs
       static_cond->ReduceSystem(x, b, X, B, copy_interior);
    }
+   else if (hybridization && hyb_local_form)
+   {
+      // Reduction to the Lagrange multipliers system; x and b also contain
+      // the part of the local space, whose dofs are not shared, so that the
+      // local and the true vectors coincide
+      const int f_size = P.Height();
+      Vector x_f(x.GetData(), f_size), b_f(b.GetData(), f_size);
+      Vector b_l(b.GetData() + f_size, b.Size() - f_size);
+      HypreParVector true_X(pfes), true_B(pfes);
+      P.MultTranspose(b_f, true_B);
+      R.Mult(x_f, true_X);
+      p_mat.EliminateBC(p_mat_e, ess_tdof_list, true_X, true_B);
+      R.MultTranspose(true_B, b_f);
+
+      // eliminate the essential b.c. from b_l with the matrix B
+      Vector true_X_e(true_X.Size()), x_e(f_size);
+      true_X_e = 0.0;
+      for (int i = 0; i < ess_tdof_list.Size(); i++)
+      {
+         true_X_e(ess_tdof_list[i]) = true_X(ess_tdof_list[i]);
+      }
+      P.Mult(true_X_e, x_e);
+      hyb_local_mat->AddMult(x_e, b_l, -1.0);
+
+      Vector true_b(true_B.Size() + b_l.Size());
+      Vector true_b_f(true_b.GetData(), true_B.Size());
+      Vector true_b_l(true_b.GetData() + true_B.Size(), b_l.Size());
+      true_b_f = true_B;
+      true_b_l = b_l;
+      hybridization->ReduceRHS(true_b, B);
+      X.SetSize(B.Size());
+      X = 0.0;
+   }
    else if (hybridization)
    {
       // Reduction to the Lagrange multipliers system
@@ -372,6 +405,28 @@ void ParBilinearForm::RecoverFEMSolution(
       // Private dofs back solve
       static_cond->ComputeSolution(b, X, x);
    }
+   else if (hybridization && hyb_local_form)
+   {
+      // Primal unknowns recovery, including the part of the local space
+      const int f_size = P.Height();
+      const int l_size = x.Size() - f_size;
+      Vector x_f(x.GetData(), f_size), b_f(b.GetData(), f_size);
+      Vector x_l(x.GetData() + f_size, l_size);
+      Vector b_l(b.GetData() + f_size, l_size);
+      const int true_size = pfes->TrueVSize();
+      Vector true_b(true_size + l_size), true_x(true_size + l_size);
+      Vector true_b_f(true_b.GetData(), true_size);
+      Vector true_b_l(true_b.GetData() + true_size, l_size);
+      Vector true_x_f(true_x.GetData(), true_size);
+      Vector true_x_l(true_x.GetData() + true_size, l_size);
+      P.MultTranspose(b_f, true_b_f);
+      true_b_l = b_l;
+      const SparseMatrix &R = *pfes->GetRestrictionMatrix();
+      R.Mult(x_f, true_x_f); // get essential b.c. from x
+      hybridization->ComputeSolution(true_b, X, true_x);
+      P.Mult(true_x_f, x_f);
+      x_l = true_x_l;
+   }
    else if (hybridization)
    {
       // Primal unknowns recovery
@@ -163,6 +163,9 @@ public:
        array) to initialize different right-hand sides and boundary condition
        values.
 
+       With the hybridization of a mixed system (see EnableHybridization()), x
+       and b also contain the vectors of the locally eliminated space.
+
        After solving the linear system, the finite element solution x can be
        recovered by calling RecoverFEMSolution (with the same vectors X, b, and
        x). */
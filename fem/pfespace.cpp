@@ -37,6 +37,7 @@ ParFiniteElementSpace::ParFiniteElementSpace(
    num_face_nbr_dofs = -1;
 
    P = NULL;
+   Pplan = NULL;
    R = NULL;
    gcomm = NULL;
 
@@ -950,8 +951,30 @@ const FiniteElement *ParFiniteElementSpace::GetFaceNbrFaceFE(int i) const
    return fec->FiniteElementForGeometry(geom);
 }
 
+long ParFiniteElementSpace::MemoryUsage() const
+{
+   long mem = ldof_group.MemoryUsage() +
+              ldof_ltdof.MemoryUsage() +
+              dof_offsets.MemoryUsage() +
+              tdof_offsets.MemoryUsage() +
+              tdof_nb_offsets.MemoryUsage() +
+              old_dof_offsets.MemoryUsage() +
+              ldof_sign.MemoryUsage();
+
+   // the update operator is a HypreParMatrix in parallel
+   HypreParMatrix *Thm = dynamic_cast<HypreParMatrix *>(T);
+   if (Thm && own_T) { mem += Thm->MemoryUsage(); }
+
+   if (P) { mem += P->MemoryUsage(); }
+   if (R) { mem += R->MemoryUsage(); }
+   if (Pplan) { mem += Pplan->MemoryUsage(); }
+
+   return FiniteElementSpace::MemoryUsage() + mem;
+}
+
 void ParFiniteElementSpace::Lose_Dof_TrueDof_Matrix()
 {
+   delete Pplan; Pplan = NULL;
    hypre_ParCSRMatrix *csrP = (hypre_ParCSRMatrix*)(*P);
    hypre_ParCSRMatrixOwnsRowStarts(csrP) = 1;
    hypre_ParCSRMatrixOwnsColStarts(csrP) = 1;
@@ -2239,6 +2262,7 @@ void ParFiniteElementSpace::Destroy()
    // preserve old_dof_offsets
    ldof_sign.DeleteAll();
 
+   delete Pplan; Pplan = NULL;
    delete P; P = NULL;
    delete R; R = NULL;
 
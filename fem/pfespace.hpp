@@ -68,6 +68,9 @@ private:
    /// The (block-diagonal) matrix R (restriction of dof to true dof)
    mutable SparseMatrix *R;
 
+   /// Persistent communication plan for the products with P
+   mutable ParMatVecPlan *Pplan;
+
    ParNURBSExtension *pNURBSext() const
    { return dynamic_cast<ParNURBSExtension *>(NURBSext); }
 
@@ -194,6 +197,15 @@ public:
    HypreParMatrix *Dof_TrueDof_Matrix() const
    { if (!P) { Build_Dof_TrueDof_Matrix(); } return P; }
 
+   /** @brief Products with the true dof-to-dof interpolation matrix and its
+       transpose using persistent MPI requests, see ParMatVecPlan. Used by
+       ParGridFunction for Distribute(), ParallelAssemble(), etc. */
+   const ParMatVecPlan *Dof_TrueDof_Plan() const
+   {
+      if (!Pplan) { Pplan = new ParMatVecPlan(*Dof_TrueDof_Matrix()); }
+      return Pplan;
+   }
+
    /** @brief For a non-conforming mesh, construct and return the interpolation
        matrix from the partially conforming true dofs to the local dofs. The
        returned pointer must be deleted by the caller. */
@@ -274,6 +286,10 @@ public:
       old_dof_offsets.DeleteAll();
    }
 
+   /** @brief Return the (approximate) memory used by the local part of the
+       space, in bytes, including the Dof_TrueDof matrix and its plan. */
+   virtual long MemoryUsage() const;
+
    virtual ~ParFiniteElementSpace() { Destroy(); }
 
    // Obsolete, kept for backward compatibility
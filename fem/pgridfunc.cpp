@@ -115,12 +115,12 @@ void ParGridFunction::MakeRef(ParFiniteElementSpace *f, Vector &v, int v_offset)
 
 void ParGridFunction::Distribute(const Vector *tv)
 {
-   pfes->Dof_TrueDof_Matrix()->Mult(*tv, *this);
+   pfes->Dof_TrueDof_Plan()->Mult(*tv, *this);
 }
 
 void ParGridFunction::AddDistribute(double a, const Vector *tv)
 {
-   pfes->Dof_TrueDof_Matrix()->Mult(a, *tv, 1.0, *this);
+   pfes->Dof_TrueDof_Plan()->Mult(a, *tv, 1.0, *this);
 }
 
 HypreParVector *ParGridFunction::GetTrueDofs() const
@@ -132,13 +132,13 @@ HypreParVector *ParGridFunction::GetTrueDofs() const
 
 void ParGridFunction::ParallelAverage(Vector &tv) const
 {
-   pfes->Dof_TrueDof_Matrix()->MultTranspose(*this, tv);
+   pfes->Dof_TrueDof_Plan()->MultTranspose(*this, tv);
    pfes->DivideByGroupSize(tv);
 }
 
 void ParGridFunction::ParallelAverage(HypreParVector &tv) const
 {
-   pfes->Dof_TrueDof_Matrix()->MultTranspose(*this, tv);
+   pfes->Dof_TrueDof_Plan()->MultTranspose(*this, tv);
    pfes->DivideByGroupSize(tv);
 }
 
@@ -168,12 +168,12 @@ HypreParVector *ParGridFunction::ParallelProject() const
 
 void ParGridFunction::ParallelAssemble(Vector &tv) const
 {
-   pfes->Dof_TrueDof_Matrix()->MultTranspose(*this, tv);
+   pfes->Dof_TrueDof_Plan()->MultTranspose(*this, tv);
 }
 
 void ParGridFunction::ParallelAssemble(HypreParVector &tv) const
 {
-   pfes->Dof_TrueDof_Matrix()->MultTranspose(*this, tv);
+   pfes->Dof_TrueDof_Plan()->MultTranspose(*this, tv);
 }
 
 HypreParVector *ParGridFunction::ParallelAssemble() const
@@ -234,6 +234,19 @@ void ParGridFunction::ExchangeFaceNbrData()
    delete [] requests;
 }
 
+int ParGridFunction::InterpolateAtPoints(const DenseMatrix &point_mat,
+                                         DenseMatrix &vals)
+{
+   // ParMesh::FindPoints assigns every found point to exactly one rank, so
+   // the local values can simply be summed up.
+   const int found = GridFunction::InterpolateAtPoints(point_mat, vals);
+   Vector loc_vals(vals.Height()*vals.Width());
+   loc_vals = vals.GetData();
+   MPI_Allreduce(loc_vals.GetData(), vals.GetData(), loc_vals.Size(),
+                 MPI_DOUBLE, MPI_SUM, pfes->GetComm());
+   return found;
+}
+
 double ParGridFunction::GetValue(int i, const IntegrationPoint &ip, int vdim)
 const
 {
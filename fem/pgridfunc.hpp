@@ -174,6 +174,11 @@ public:
    double GetValue(ElementTransformation &T)
    { return GetValue(T.ElementNo, T.GetIntPoint()); }
 
+   /** Locate the points on all ranks (see ParMesh::FindPoints()) and make the
+       interpolated values available on all ranks. Collective. */
+   virtual int InterpolateAtPoints(const DenseMatrix &point_mat,
+                                   DenseMatrix &vals);
+
    using GridFunction::ProjectCoefficient;
    virtual void ProjectCoefficient(Coefficient &coeff);
 
@@ -11,6 +11,10 @@
 
 #include "staticcond.hpp"
 
+#ifdef MFEM_USE_OPENMP
+#include <omp.h>
+#endif
+
 namespace mfem
 {
 
@@ -214,14 +218,58 @@ void StaticCondensation::AssembleMatrix(int el, const DenseMatrix &elmat)
          A_ee.CopyMN(elmat, ned, ned, i*nd,     j*nd,     i*ned, j*ned);
       }
    }
-   // Compute the Schur complement
-   LUFactors lu(A_pp.Data(), A_ipiv + A_ipiv_offsets[el]);
-   lu.Factor(nvpd);
-   lu.BlockFactor(nvpd, nved, A_pe.Data(), A_ep.Data(), A_ee.Data());
-
-   // Assemble the Schur complement
+   // Assemble A_ee into the Schur complement; the factorization of A_pp and
+   // the rest of the Schur complement are computed in FactorElementMatrices()
    const int skip_zeros = 0;
    S->AddSubMatrix(rvdofs, rvdofs, A_ee, skip_zeros);
+   A_pending.Append(el);
+}
+
+void StaticCondensation::FactorElementMatrices()
+{
+   const int num_pending = A_pending.Size();
+   if (num_pending == 0) { return; }
+
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel
+#endif
+   {
+      Array<int> rvdofs;
+      DenseMatrix A_ep, S_ee;
+#ifdef MFEM_USE_OPENMP
+      #pragma omp for
+#endif
+      for (int k = 0; k < num_pending; k++)
+      {
+         const int el = A_pending[k];
+         tr_fes->GetElementVDofs(el, rvdofs);
+         const int nvpd = elem_pdof.RowSize(el);
+         const int nved = rvdofs.Size();
+         LUFactors lu(A_data + A_offsets[el], A_ipiv + A_ipiv_offsets[el]);
+         double *A_pe = lu.data + nvpd*nvpd;
+         if (symm)
+         {
+            DenseMatrix A_pe_mat(A_pe, nvpd, nved);
+            A_ep.Transpose(A_pe_mat);
+         }
+         else
+         {
+            A_ep.Reset(A_pe + nvpd*nved, nved, nvpd);
+         }
+         // S_ee = -A_ep (A_pp)^{-1} A_pe
+         S_ee.SetSize(nved);
+         S_ee = 0.0;
+         lu.Factor(nvpd);
+         lu.BlockFactor(nvpd, nved, A_pe, A_ep.Data(), S_ee.Data());
+
+         const int skip_zeros = 0;
+#ifdef MFEM_USE_OPENMP
+         #pragma omp critical (StaticCondensation_S)
+#endif
+         S->AddSubMatrix(rvdofs, rvdofs, S_ee, skip_zeros);
+      }
+   }
+   A_pending.DeleteAll();
 }
 
 void StaticCondensation::AssembleBdrMatrix(int el, const DenseMatrix &elmat)
@@ -234,6 +282,8 @@ void StaticCondensation::AssembleBdrMatrix(int el, const DenseMatrix &elmat)
 
 void StaticCondensation::Finalize()
 {
+   FactorElementMatrices();
+
    const int skip_zeros = 0;
    if (!Parallel())
    {
@@ -327,46 +377,85 @@ void StaticCondensation::ReduceRHS(const Vector &b, Vector &sc_b) const
    {
       b_r.SetSize(nedofs);
    }
+   MFEM_ASSERT(A_pending.Size() == 0, "Finalize() was not called");
    for (int i = 0; i < nedofs; i++)
    {
       b_r(i) = b(rdof_edof[i]);
    }
 
-   DenseMatrix U_pe, L_ep;
-   Vector b_p, b_ep;
-   Array<int> rvdofs;
-   for (int i = 0; i < NE; i++)
+   // Thread 0 scatters directly into b_r, the other threads into their own
+   // buffers in b_t which are added to b_r at the end.
+#ifdef MFEM_USE_OPENMP
+   const int nt = omp_get_max_threads();
+#else
+   const int nt = 1;
+#endif
+   Vector b_t((nt-1)*nedofs);
+   b_t = 0.0;
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel
+#endif
    {
-      tr_fes->GetElementVDofs(i, rvdofs);
-      const int ned = rvdofs.Size();
-      const int *rd = rvdofs.GetData();
-      const int npd = elem_pdof.RowSize(i);
-      const int *pd = elem_pdof.GetRow(i);
-      b_p.SetSize(npd);
-      b_ep.SetSize(ned);
-      for (int j = 0; j < npd; j++)
+#ifdef MFEM_USE_OPENMP
+      const int t = omp_get_thread_num();
+#else
+      const int t = 0;
+#endif
+      double *br = (t == 0) ? b_r.GetData() : b_t.GetData() + (t-1)*nedofs;
+      DenseMatrix U_pe, L_ep;
+      Vector b_p, b_ep;
+      Array<int> rvdofs;
+#ifdef MFEM_USE_OPENMP
+      #pragma omp for
+#endif
+      for (int i = 0; i < NE; i++)
       {
-         b_p(j) = b(pd[j]);
-      }
+         tr_fes->GetElementVDofs(i, rvdofs);
+         const int ned = rvdofs.Size();
+         const int *rd = rvdofs.GetData();
+         const int npd = elem_pdof.RowSize(i);
+         const int *pd = elem_pdof.GetRow(i);
+         b_p.SetSize(npd);
+         b_ep.SetSize(ned);
+         for (int j = 0; j < npd; j++)
+         {
+            b_p(j) = b(pd[j]);
+         }
 
-      LUFactors lu(A_data + A_offsets[i], A_ipiv + A_ipiv_offsets[i]);
-      lu.LSolve(npd, 1, b_p);
+         LUFactors lu(A_data + A_offsets[i], A_ipiv + A_ipiv_offsets[i]);
+         lu.LSolve(npd, 1, b_p);
 
-      if (symm)
-      {
-         // TODO: handle the symmetric case correctly.
-         U_pe.UseExternalData(lu.data + npd*npd, npd, ned);
-         U_pe.MultTranspose(b_p, b_ep);
-      }
-      else
-      {
-         L_ep.UseExternalData(lu.data + npd*(npd+ned), ned, npd);
-         L_ep.Mult(b_p, b_ep);
+         if (symm)
+         {
+            // TODO: handle the symmetric case correctly.
+            U_pe.UseExternalData(lu.data + npd*npd, npd, ned);
+            U_pe.MultTranspose(b_p, b_ep);
+         }
+         else
+         {
+            L_ep.UseExternalData(lu.data + npd*(npd+ned), ned, npd);
+            L_ep.Mult(b_p, b_ep);
+         }
+         for (int j = 0; j < ned; j++)
+         {
+            if (rd[j] >= 0) { br[rd[j]] -= b_ep(j); }
+            else            { br[-1-rd[j]] += b_ep(j); }
+         }
       }
-      for (int j = 0; j < ned; j++)
+   }
+   if (nt > 1)
+   {
+      double *br = b_r.GetData();
+      const double *bt = b_t.GetData();
+#ifdef MFEM_USE_OPENMP
+      #pragma omp parallel for
+#endif
+      for (int i = 0; i < nedofs; i++)
       {
-         if (rd[j] >= 0) { b_r(rd[j]) -= b_ep(j); }
-         else            { b_r(-1-rd[j]) += b_ep(j); }
+         for (int t = 1; t < nt; t++)
+         {
+            br[i] += bt[(t-1)*nedofs + i];
+         }
       }
    }
    if (!Parallel())
@@ -509,30 +598,41 @@ void StaticCondensation::ComputeSolution(
    {
       sol(rdof_edof[i]) = sol_r(i);
    }
+   MFEM_ASSERT(A_pending.Size() == 0, "Finalize() was not called");
    const int NE = fes->GetNE();
-   Vector b_p, s_e;
-   Array<int> rvdofs;
-   for (int i = 0; i < NE; i++)
+   // The private dofs of different elements are disjoint, so the elements can
+   // be processed in parallel.
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel
+#endif
    {
-      tr_fes->GetElementVDofs(i, rvdofs);
-      const int ned = rvdofs.Size();
-      const int npd = elem_pdof.RowSize(i);
-      const int *pd = elem_pdof.GetRow(i);
-      b_p.SetSize(npd);
-
-      for (int j = 0; j < npd; j++)
+      Vector b_p, s_e;
+      Array<int> rvdofs;
+#ifdef MFEM_USE_OPENMP
+      #pragma omp for
+#endif
+      for (int i = 0; i < NE; i++)
       {
-         b_p(j) = b(pd[j]);
-      }
-      sol_r.GetSubVector(rvdofs, s_e);
+         tr_fes->GetElementVDofs(i, rvdofs);
+         const int ned = rvdofs.Size();
+         const int npd = elem_pdof.RowSize(i);
+         const int *pd = elem_pdof.GetRow(i);
+         b_p.SetSize(npd);
+
+         for (int j = 0; j < npd; j++)
+         {
+            b_p(j) = b(pd[j]);
+         }
+         sol_r.GetSubVector(rvdofs, s_e);
 
-      LUFactors lu(A_data + A_offsets[i], A_ipiv + A_ipiv_offsets[i]);
-      lu.LSolve(npd, 1, b_p);
-      lu.BlockBackSolve(npd, ned, 1, lu.data + npd*npd, s_e, b_p);
+         LUFactors lu(A_data + A_offsets[i], A_ipiv + A_ipiv_offsets[i]);
+         lu.LSolve(npd, 1, b_p);
+         lu.BlockBackSolve(npd, ned, 1, lu.data + npd*npd, s_e, b_p);
 
-      for (int j = 0; j < npd; j++)
-      {
-         sol(pd[j]) = b_p(j);
+         for (int j = 0; j < npd; j++)
+         {
+            sol(pd[j]) = b_p(j);
+         }
       }
    }
 }
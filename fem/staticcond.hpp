@@ -84,9 +84,15 @@ class StaticCondensation
    Array<int> A_offsets, A_ipiv_offsets;
    double *A_data;
    int *A_ipiv;
+   // Elements whose blocks are saved in A_data but not factored yet.
+   Array<int> A_pending;
 
    Array<int> ess_rtdof_list;
 
+   /** Factor the blocks of the pending elements (in parallel, with OpenMP) and
+       add their contributions -A_ep (A_pp)^{-1} A_pe to the Schur complement. */
+   void FactorElementMatrices();
+
 public:
    /// Construct a StaticCondensation object.
    StaticCondensation(FiniteElementSpace *fespace);
@@ -114,14 +120,16 @@ public:
 #endif
    /** Assemble the contribution to the Schur complement from the given
        element matrix 'elmat'; save the other blocks internally: A_pp_inv, A_pe,
-       and A_ep. */
+       and A_ep. The factorization of A_pp and the rest of the Schur complement
+       contribution are computed for all elements at once in Finalize(). */
    void AssembleMatrix(int el, const DenseMatrix &elmat);
 
    /** Assemble the contribution to the Schur complement from the given boundary
        element matrix 'elmat'. */
    void AssembleBdrMatrix(int el, const DenseMatrix &elmat);
 
-   /// Finalize the construction of the Schur complement matrix.
+   /** Finalize the construction of the Schur complement matrix, factoring the
+       element blocks saved by AssembleMatrix(). */
    void Finalize();
 
    /// Determine and save internally essential reduced true dofs.
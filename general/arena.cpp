@@ -0,0 +1,114 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+// Implementation of class MemoryArena
+
+#include "arena.hpp"
+#include "error.hpp"
+
+namespace mfem
+{
+
+MemoryArena::MemoryArena(size_t chunk_size)
+   : current(-1), offset(0), used(0), peak(0),
+     min_chunk_size(chunk_size), num_heap_allocs(0)
+{ }
+
+void MemoryArena::AddChunk(size_t bytes)
+{
+   // grow geometrically, so that the number of chunks stays small
+   size_t size = min_chunk_size;
+   if (chunks.size() > 0 && 2*chunks.back().size > size)
+   {
+      size = 2*chunks.back().size;
+   }
+   if (bytes > size) { size = bytes; }
+
+   Chunk c;
+   c.data = new char[size];
+   c.size = size;
+   chunks.push_back(c);
+   num_heap_allocs++;
+}
+
+void MemoryArena::FreeChunks()
+{
+   for (unsigned i = 0; i < chunks.size(); i++)
+   {
+      delete [] chunks[i].data;
+   }
+   chunks.clear();
+}
+
+void MemoryArena::Merge()
+{
+   const size_t total = MemoryUsage();
+   FreeChunks();
+   AddChunk(total);
+}
+
+void *MemoryArena::AllocBytes(size_t bytes)
+{
+   bytes = (bytes + alignment - 1) / alignment * alignment;
+
+   if (current < 0 || offset + bytes > chunks[current].size)
+   {
+      // the chunks after the current one are free, skip the ones that are
+      // too small for this request
+      int c = current + 1;
+      while (c < (int) chunks.size() && chunks[c].size < bytes) { c++; }
+      if (c == (int) chunks.size()) { AddChunk(bytes); }
+      current = c;
+      offset = 0;
+   }
+
+   void *ptr = chunks[current].data + offset;
+   offset += bytes;
+   used += bytes;
+   if (used > peak) { peak = used; }
+   return ptr;
+}
+
+void MemoryArena::Release(const Mark &m)
+{
+   MFEM_ASSERT(m.used <= used, "marks must be released in reverse order");
+
+   current = m.chunk;
+   offset = m.offset;
+   used = m.used;
+
+   if (used == 0 && chunks.size() > 1)
+   {
+      Merge();
+      current = -1;
+   }
+}
+
+void MemoryArena::Clear()
+{
+   MFEM_VERIFY(used == 0, "the arena is still in use");
+
+   FreeChunks();
+   current = -1;
+   offset = 0;
+}
+
+long MemoryArena::MemoryUsage() const
+{
+   long mem = 0;
+   for (unsigned i = 0; i < chunks.size(); i++)
+   {
+      mem += chunks[i].size;
+   }
+   return mem;
+}
+
+}
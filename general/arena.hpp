@@ -0,0 +1,147 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#ifndef MFEM_ARENA
+#define MFEM_ARENA
+
+#include "../config/config.hpp"
+#include <cstddef>
+#include <vector>
+
+namespace mfem
+{
+
+/** @brief Stack-like (bump pointer) allocator for short-lived temporaries.
+
+    Memory is taken from a list of large chunks by advancing a pointer and is
+    returned all at once by rewinding the pointer to a position obtained with
+    GetMark(), usually through an ArenaScope. When a request does not fit into
+    the current chunk a new chunk is allocated; once the arena is completely
+    released, the chunks are merged into a single one, large enough for the
+    peak usage seen so far. Hence, after the first application of a solver,
+    repeated applications with the same allocation pattern do not allocate
+    any heap memory.
+
+    The arena only provides raw storage, which MFEM containers use through
+    their external data interfaces, e.g.
+    @code
+       ArenaScope scope(arena);
+       Vector v(scope.Alloc<double>(n), n);
+       DenseMatrix M(scope.Alloc<double>(h*w), h, w);
+       u.NewDataAndSize(scope.Alloc<double>(n), n);   // existing Vector
+       bv.Update(scope.Alloc<double>(offsets.Last()), offsets);  // BlockVector
+       a.MakeRef(scope.Alloc<int>(n), n);             // Array<int>
+       LUFactors lu(scope.Alloc<double>(n*n), scope.Alloc<int>(n));
+    @endcode
+    The containers must not be resized beyond the borrowed size and must not
+    be used after the scope is closed. No constructors or destructors are
+    called on the storage, so only plain types should be allocated.
+
+    The arena is not thread-safe. */
+class MemoryArena
+{
+public:
+   /// Position in the arena, see GetMark() and Release().
+   struct Mark
+   {
+      int chunk;
+      size_t offset, used;
+   };
+
+private:
+   struct Chunk
+   {
+      char *data;
+      size_t size;
+   };
+
+   std::vector<Chunk> chunks;
+   int current;     // chunk from which memory is currently taken
+   size_t offset;   // first free byte in the current chunk
+   size_t used;     // bytes handed out (including alignment padding)
+   size_t peak;     // maximum of used
+   size_t min_chunk_size;
+   long num_heap_allocs;
+
+   // alignment of the returned pointers, in bytes
+   static const size_t alignment = 16;
+
+   void AddChunk(size_t bytes);
+   void FreeChunks();
+   void Merge();
+
+   // not copyable
+   MemoryArena(const MemoryArena &);
+   MemoryArena &operator=(const MemoryArena &);
+
+public:
+   /** @brief Create an empty arena; the first chunk is allocated with the
+       first request and has at least @a chunk_size bytes. */
+   explicit MemoryArena(size_t chunk_size = 64*1024);
+
+   ~MemoryArena() { FreeChunks(); }
+
+   /// Return a pointer to @a bytes bytes of uninitialized memory.
+   void *AllocBytes(size_t bytes);
+
+   /// Return a pointer to uninitialized memory for @a n objects of type T.
+   template <class T>
+   T *Alloc(int n) { return static_cast<T*>(AllocBytes(n*sizeof(T))); }
+
+   /// Current position in the arena.
+   Mark GetMark() const
+   {
+      Mark m = { current, offset, used };
+      return m;
+   }
+
+   /** @brief Return all memory allocated after the mark @a m was obtained;
+       marks must be released in reverse order. */
+   void Release(const Mark &m);
+
+   /// Free all chunks. Nothing should be allocated from the arena.
+   void Clear();
+
+   /// Number of bytes currently allocated from the arena.
+   size_t Used() const { return used; }
+   /// Maximum number of bytes allocated from the arena at the same time.
+   size_t Peak() const { return peak; }
+   /// Number of chunk allocations performed by the arena so far.
+   long NumHeapAllocs() const { return num_heap_allocs; }
+
+   /// Total size of the chunks in bytes.
+   long MemoryUsage() const;
+};
+
+/** @brief Scope guard for a MemoryArena: the memory allocated through the
+    scope (or directly from the arena while the scope is open) is returned to
+    the arena in the destructor. Scopes can be nested. */
+class ArenaScope
+{
+private:
+   MemoryArena &arena;
+   const MemoryArena::Mark mark;
+
+   ArenaScope(const ArenaScope &);
+   ArenaScope &operator=(const ArenaScope &);
+
+public:
+   explicit ArenaScope(MemoryArena &a) : arena(a), mark(a.GetMark()) { }
+
+   ~ArenaScope() { arena.Release(mark); }
+
+   template <class T>
+   T *Alloc(int n) { return arena.Alloc<T>(n); }
+};
+
+}
+
+#endif
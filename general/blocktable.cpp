@@ -0,0 +1,217 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+// Implementation of class BlockTable
+
+#include "blocktable.hpp"
+#include "error.hpp"
+
+namespace mfem
+{
+
+BlockTable::BlockTable(const Array<int> &row_offsets_,
+                       const Array<int> &col_offsets_)
+   : owns_blocks(false),
+     nRowBlocks(row_offsets_.Size()-1),
+     nColBlocks(col_offsets_.Size()-1),
+     Aij(nRowBlocks, nColBlocks)
+{
+   row_offsets_.Copy(row_offsets);
+   col_offsets_.Copy(col_offsets);
+   Aij = (Table *)NULL;
+}
+
+BlockTable::~BlockTable()
+{
+   if (owns_blocks)
+   {
+      for (int i = 0; i < nRowBlocks; i++)
+         for (int j = 0; j < nColBlocks; j++)
+         {
+            delete Aij(i,j);
+         }
+   }
+}
+
+void BlockTable::SetBlock(int i, int j, Table *tab)
+{
+   MFEM_ASSERT(0 <= i && i < nRowBlocks && 0 <= j && j < nColBlocks,
+               "block (" << i << "," << j << ") is out of range");
+   MFEM_VERIFY(tab == NULL ||
+               tab->Size() == row_offsets[i+1] - row_offsets[i],
+               "incompatible number of rows in block (" << i << "," << j
+               << ")");
+   Aij(i,j) = tab;
+}
+
+int BlockTable::Size_of_connections() const
+{
+   int nnz = 0;
+   for (int i = 0; i < nRowBlocks; i++)
+      for (int j = 0; j < nColBlocks; j++)
+         if (Aij(i,j))
+         {
+            nnz += Aij(i,j)->Size_of_connections();
+         }
+   return nnz;
+}
+
+Table *BlockTable::CreateMonolithic() const
+{
+   Table *mono = new Table;
+   mono->MakeI(Size());
+   for (int i = 0; i < nRowBlocks; i++)
+      for (int j = 0; j < nColBlocks; j++)
+         if (Aij(i,j))
+         {
+            const Table &T = *Aij(i,j);
+            for (int r = 0; r < T.Size(); r++)
+            {
+               mono->AddColumnsInRow(row_offsets[i] + r, T.RowSize(r));
+            }
+         }
+   mono->MakeJ();
+   for (int i = 0; i < nRowBlocks; i++)
+      for (int j = 0; j < nColBlocks; j++)
+         if (Aij(i,j))
+         {
+            const Table &T = *Aij(i,j);
+            for (int r = 0; r < T.Size(); r++)
+            {
+               const int *row = T.GetRow(r);
+               for (int k = 0; k < T.RowSize(r); k++)
+               {
+                  mono->AddConnection(row_offsets[i] + r,
+                                      col_offsets[j] + row[k]);
+               }
+            }
+         }
+   mono->ShiftUpI();
+   return mono;
+}
+
+long BlockTable::MemoryUsage() const
+{
+   long mem = 0;
+   for (int i = 0; i < nRowBlocks; i++)
+      for (int j = 0; j < nColBlocks; j++)
+         if (Aij(i,j))
+         {
+            mem += Aij(i,j)->MemoryUsage();
+         }
+   return mem;
+}
+
+BlockTable *Transpose(const BlockTable &A)
+{
+   BlockTable *At = new BlockTable(A.ColOffsets(), A.RowOffsets());
+   At->owns_blocks = 1;
+
+   const Array<int> &col_offsets = A.ColOffsets();
+   for (int irowAt = 0; irowAt < At->NumRowBlocks(); ++irowAt)
+      for (int jcolAt = 0; jcolAt < At->NumColBlocks(); ++jcolAt)
+         if (!A.IsZeroBlock(jcolAt, irowAt))
+         {
+            Table *T = new Table;
+            Transpose(A.GetBlock(jcolAt, irowAt), *T,
+                      col_offsets[irowAt+1] - col_offsets[irowAt]);
+            At->SetBlock(irowAt, jcolAt, T);
+         }
+   return At;
+}
+
+// C = A_1 B_1 + ... + A_n B_n as boolean matrices
+static Table *MultSum(const Array<const Table *> &A,
+                      const Array<const Table *> &B, int nrows, int ncols)
+{
+   Array<int> marker(ncols);
+   Table *C = new Table;
+
+   C->MakeI(nrows);
+   marker = -1;
+   for (int i = 0; i < nrows; i++)
+      for (int p = 0; p < A.Size(); p++)
+      {
+         const int *row_A = A[p]->GetRow(i);
+         for (int j = 0; j < A[p]->RowSize(i); j++)
+         {
+            const int *row_B = B[p]->GetRow(row_A[j]);
+            for (int l = 0; l < B[p]->RowSize(row_A[j]); l++)
+            {
+               if (marker[row_B[l]] != i)
+               {
+                  marker[row_B[l]] = i;
+                  C->AddAColumnInRow(i);
+               }
+            }
+         }
+      }
+
+   C->MakeJ();
+   marker = -1;
+   for (int i = 0; i < nrows; i++)
+      for (int p = 0; p < A.Size(); p++)
+      {
+         const int *row_A = A[p]->GetRow(i);
+         for (int j = 0; j < A[p]->RowSize(i); j++)
+         {
+            const int *row_B = B[p]->GetRow(row_A[j]);
+            for (int l = 0; l < B[p]->RowSize(row_A[j]); l++)
+            {
+               if (marker[row_B[l]] != i)
+               {
+                  marker[row_B[l]] = i;
+                  C->AddConnection(i, row_B[l]);
+               }
+            }
+         }
+      }
+   C->ShiftUpI();
+
+   return C;
+}
+
+BlockTable *Mult(const BlockTable &A, const BlockTable &B)
+{
+   MFEM_VERIFY(A.NumColBlocks() == B.NumRowBlocks() && A.Width() == B.Size(),
+               "incompatible BlockTables");
+
+   BlockTable *C = new BlockTable(A.RowOffsets(), B.ColOffsets());
+   C->owns_blocks = 1;
+   Array<const Table *> A_pieces(A.NumColBlocks()), B_pieces(A.NumColBlocks());
+
+   const Array<int> &row_offsets = A.RowOffsets();
+   const Array<int> &col_offsets = B.ColOffsets();
+   for (int irowC = 0; irowC < A.NumRowBlocks(); ++irowC)
+      for (int jcolC = 0; jcolC < B.NumColBlocks(); ++jcolC)
+      {
+         A_pieces.SetSize(0);
+         B_pieces.SetSize(0);
+         for (int k = 0; k < A.NumColBlocks(); ++k)
+            if (!A.IsZeroBlock(irowC, k) && !B.IsZeroBlock(k, jcolC))
+            {
+               A_pieces.Append(&A.GetBlock(irowC, k));
+               B_pieces.Append(&B.GetBlock(k, jcolC));
+            }
+
+         if (A_pieces.Size() > 0)
+         {
+            C->SetBlock(irowC, jcolC,
+                        MultSum(A_pieces, B_pieces,
+                                row_offsets[irowC+1] - row_offsets[irowC],
+                                col_offsets[jcolC+1] - col_offsets[jcolC]));
+         }
+      }
+
+   return C;
+}
+
+}
@@ -0,0 +1,93 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#ifndef MFEM_BLOCKTABLE
+#define MFEM_BLOCKTABLE
+
+#include "../config/config.hpp"
+#include "array.hpp"
+#include "table.hpp"
+
+namespace mfem
+{
+
+/** @brief A relation between sets of entities split in blocks, e.g. between
+    elements and the dofs of several finite element spaces.
+
+    The blocks are Tables, i.e. relations without values, and the class
+    mirrors the interface of BlockMatrix. Since a Table does not know its
+    number of columns, the block widths are given by the column offsets.
+    Unlike BlockMatrix, the offsets are copied, so that the results of
+    Transpose() and Mult() do not refer to the offsets of their arguments. */
+class BlockTable
+{
+public:
+   /** @brief Constructor for a block table with the given offsets (of size
+       number of blocks + 1). */
+   BlockTable(const Array<int> &row_offsets, const Array<int> &col_offsets);
+
+   //! Set A(i,j) = tab
+   void SetBlock(int i, int j, Table *tab);
+   //! Return the number of row blocks
+   int NumRowBlocks() const { return nRowBlocks; }
+   //! Return the number of column blocks
+   int NumColBlocks() const { return nColBlocks; }
+   //! Return the total number of rows
+   int Size() const { return row_offsets[nRowBlocks]; }
+   //! Return the total number of columns
+   int Width() const { return col_offsets[nColBlocks]; }
+   //! Return a reference to block (i,j). Reference may be invalid if Aij(i,j)
+   //! == NULL
+   Table &GetBlock(int i, int j) { return *Aij(i,j); }
+   //! Return a reference to block (i,j). Reference may be invalid if Aij(i,j)
+   //! == NULL. (const version)
+   const Table &GetBlock(int i, int j) const { return *Aij(i,j); }
+   //! Check if block (i,j) is a zero block.
+   int IsZeroBlock(int i, int j) const { return (Aij(i,j) == NULL) ? 1 : 0; }
+   //! Return the row offsets for block starts
+   const Array<int> &RowOffsets() const { return row_offsets; }
+   //! Return the column offsets for block starts
+   const Array<int> &ColOffsets() const { return col_offsets; }
+   //! Returns the total number of connections.
+   int Size_of_connections() const;
+   //! Returns a monolithic Table with the connections of all blocks.
+   Table *CreateMonolithic() const;
+
+   long MemoryUsage() const;
+
+   //! Destructor
+   ~BlockTable();
+   //! if owns_blocks the Table objects Aij will be deallocated.
+   int owns_blocks;
+
+private:
+   //! Number of row blocks
+   int nRowBlocks;
+   //! Number of columns blocks
+   int nColBlocks;
+   //! row offsets for each block start (length nRowBlocks+1).
+   Array<int> row_offsets;
+   //! column offsets for each block start (length nColBlocks+1).
+   Array<int> col_offsets;
+   //! 2D array that stores each block of the BlockTable. Aij(iblock, jblock)
+   //! == NULL if block (iblock, jblock) is empty.
+   Array2D<Table *> Aij;
+};
+
+//! Transpose a BlockTable: result = A'
+BlockTable *Transpose(const BlockTable &A);
+
+//! Multiply two BlockTables as boolean matrices: result = A * B
+BlockTable *Mult(const BlockTable &A, const BlockTable &B);
+
+}
+
+#endif
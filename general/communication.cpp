@@ -25,6 +25,7 @@
 #include "text.hpp"
 
 #include <iostream>
+#include <iomanip>
 #include <map>
 
 using namespace std;
@@ -704,6 +705,36 @@ MPI_Comm ReorderRanksZCurve(MPI_Comm comm)
 }
 #endif // __bgq__
 
+long GlobalMemoryUsage(MPI_Comm comm, long mem)
+{
+   long glob_mem;
+   MPI_Allreduce(&mem, &glob_mem, 1, MPI_LONG, MPI_SUM, comm);
+   return glob_mem;
+}
+
+void PrintMemoryUsage(MPI_Comm comm, const char *name, long mem,
+                      std::ostream &out)
+{
+   int myid, num_procs;
+   MPI_Comm_rank(comm, &myid);
+   MPI_Comm_size(comm, &num_procs);
+
+   long mem_min, mem_max, mem_sum;
+   MPI_Reduce(&mem, &mem_min, 1, MPI_LONG, MPI_MIN, 0, comm);
+   MPI_Reduce(&mem, &mem_max, 1, MPI_LONG, MPI_MAX, 0, comm);
+   MPI_Reduce(&mem, &mem_sum, 1, MPI_LONG, MPI_SUM, 0, comm);
+
+   if (myid == 0)
+   {
+      const double MiB = 1024.*1024;
+      out << std::setw(40) << std::left << name << std::right
+          << " min " << std::setw(10) << mem_min/MiB
+          << " max " << std::setw(10) << mem_max/MiB
+          << " avg " << std::setw(10) << mem_sum/MiB/num_procs
+          << " total " << std::setw(10) << mem_sum/MiB << " MiB\n";
+   }
+}
+
 
 } // namespace mfem
 
@@ -111,6 +111,13 @@ public:
    /// Load the data from a stream.
    void Load(std::istream &in);
 
+   /// Return the memory used by the topology, in bytes.
+   long MemoryUsage() const
+   {
+      return group_lproc.MemoryUsage() + groupmaster_lproc.MemoryUsage() +
+             lproc_proc.MemoryUsage() + group_mgroup.MemoryUsage();
+   }
+
    virtual ~GroupTopology() {}
 };
 
@@ -311,6 +318,17 @@ struct MPITypeMap { static const MPI_Datatype mpi_type; };
 MPI_Comm ReorderRanksZCurve(MPI_Comm comm);
 
 
+/** @brief Return the sum over the ranks of @a comm of the local memory usage
+    @a mem, e.g. the result of a MemoryUsage() method, on all ranks. */
+long GlobalMemoryUsage(MPI_Comm comm, long mem);
+
+/** @brief Print one line of a memory report for an object distributed over
+    the ranks of @a comm: the min, max, average and total over the ranks of
+    the local memory usage @a mem, in MiB. Collective; rank 0 prints. */
+void PrintMemoryUsage(MPI_Comm comm, const char *name, long mem,
+                      std::ostream &out = std::cout);
+
+
 } // namespace mfem
 
 #endif
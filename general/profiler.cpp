@@ -0,0 +1,434 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+// Implementation of class Profiler
+
+#include "profiler.hpp"
+#include "array.hpp"
+#include "error.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <map>
+#include <limits>
+
+namespace mfem
+{
+
+Profiler::Profiler()
+   : enabled(false), current(0)
+{
+   nodes.resize(1);
+   ClearNode(0, "", -1, false);
+   sw.Start();
+   if (getenv("MFEM_PROFILE")) { enabled = true; }
+}
+
+void Profiler::Enable(bool on)
+{
+   enabled = on;
+}
+
+void Profiler::ClearNode(int n, const char *name, int parent, bool counter)
+{
+   Node &c = nodes[n];
+   c.name = name;
+   c.parent = parent;
+   c.first_child = c.last_child = c.next_sibling = -1;
+   c.calls = 0;
+   c.time = c.start = c.count = 0.0;
+   c.counter = counter;
+}
+
+int Profiler::FindChild(const char *name, int index, bool counter)
+{
+   char buf[256];
+   if (index >= 0)
+   {
+      snprintf(buf, sizeof(buf), "%s %d", name, index);
+      name = buf;
+   }
+   for (int i = nodes[current].first_child; i >= 0; i = nodes[i].next_sibling)
+   {
+      const Node &c = nodes[i];
+      if (c.counter == counter && strcmp(c.name.c_str(), name) == 0)
+      {
+         return i;
+      }
+   }
+
+   const int n = nodes.size();
+   nodes.resize(n + 1);
+   ClearNode(n, name, current, counter);
+   Node &p = nodes[current];
+   if (p.last_child >= 0) { nodes[p.last_child].next_sibling = n; }
+   else { p.first_child = n; }
+   p.last_child = n;
+   return n;
+}
+
+void Profiler::Start(const char *name, int index)
+{
+   opened.push_back(enabled);
+   if (!enabled) { return; }
+   const int n = FindChild(name, index, false);
+   current = n;
+   nodes[n].calls++;
+   nodes[n].start = sw.RealTime();
+}
+
+void Profiler::Stop()
+{
+   MFEM_VERIFY(!opened.empty(), "Profiler::Stop() without a matching Start()");
+   const bool was_opened = opened.back();
+   opened.pop_back();
+   if (!was_opened) { return; }
+   Node &c = nodes[current];
+   c.time += sw.RealTime() - c.start;
+   current = c.parent;
+}
+
+void Profiler::Count(const char *name, double value)
+{
+   if (!enabled) { return; }
+   Node &c = nodes[FindChild(name, -1, true)];
+   c.calls++;
+   c.count += value;
+}
+
+void Profiler::Clear()
+{
+   MFEM_VERIFY(current == 0, "Profiler::Clear() with an open scope");
+   nodes.resize(1);
+   ClearNode(0, "", -1, false);
+}
+
+void Profiler::GetEntries(int node, const std::string &path, int depth,
+                          std::vector<Entry> &entries) const
+{
+   for (int i = nodes[node].first_child; i >= 0; i = nodes[i].next_sibling)
+   {
+      const Node &c = nodes[i];
+      Entry e;
+      e.path = path.empty() ? c.name : path + '/' + c.name;
+      e.depth = depth;
+      e.ranks = 1;
+      e.counter = c.counter;
+      for (int k = 0; k < 3; k++)
+      {
+         e.calls[k] = c.calls;
+         e.time[k] = c.time;
+         e.count[k] = c.count;
+      }
+      entries.push_back(e);
+      GetEntries(i, e.path, depth + 1, entries);
+   }
+}
+
+void Profiler::GetEntries(std::vector<Entry> &entries) const
+{
+   entries.clear();
+   GetEntries(0, std::string(), 0, entries);
+}
+
+#ifdef MFEM_USE_MPI
+// Compare the paths component by component, so that every scope is followed
+// by its children; a scope goes before a counter with the same path.
+static bool EntryPathLess(const Profiler::Entry &a, const Profiler::Entry &b)
+{
+   const std::string &p = a.path, &q = b.path;
+   const size_t n = std::min(p.size(), q.size());
+   for (size_t i = 0; i < n; i++)
+   {
+      if (p[i] != q[i])
+      {
+         if (p[i] == '/') { return true; }
+         if (q[i] == '/') { return false; }
+         return p[i] < q[i];
+      }
+   }
+   if (p.size() != q.size()) { return p.size() < q.size(); }
+   return !a.counter && b.counter;
+}
+
+void Profiler::ReduceEntries(MPI_Comm comm, std::vector<Entry> &entries) const
+{
+   int myid, num_procs;
+   MPI_Comm_rank(comm, &myid);
+   MPI_Comm_size(comm, &num_procs);
+
+   std::vector<Entry> local;
+   GetEntries(local);
+
+   // 1. Build the union of the paths on rank 0, in the order of the first
+   //    rank where they appear, and broadcast it. An entry is packed as
+   //    "depth counter path\n".
+   std::string buf;
+   for (size_t i = 0; i < local.size(); i++)
+   {
+      char d[32];
+      snprintf(d, sizeof(d), "%d %d ", local[i].depth, int(local[i].counter));
+      buf += d + local[i].path + '\n';
+   }
+   int len = buf.size();
+   Array<int> lens(num_procs), displs(num_procs + 1);
+   MPI_Gather(&len, 1, MPI_INT, lens.GetData(), 1, MPI_INT, 0, comm);
+   std::vector<char> all;
+   if (myid == 0)
+   {
+      displs[0] = 0;
+      for (int p = 0; p < num_procs; p++) { displs[p+1] = displs[p] + lens[p]; }
+      all.resize(displs[num_procs] + 1);
+   }
+   MPI_Gatherv(const_cast<char *>(buf.data()), len, MPI_CHAR,
+               all.empty() ? NULL : &all[0], lens.GetData(),
+               displs.GetData(), MPI_CHAR, 0, comm);
+
+   std::string joint;
+   if (myid == 0)
+   {
+      std::map<std::string, int> seen;
+      size_t pos = 0, end = displs[num_procs];
+      while (pos < end)
+      {
+         const char *line = &all[pos];
+         const char *nl = static_cast<const char *>(
+                             memchr(line, '\n', end - pos));
+         const std::string s(line, nl - line);
+         if (seen.insert(std::make_pair(s, 0)).second) { joint += s + '\n'; }
+         pos += s.size() + 1;
+      }
+      len = joint.size();
+   }
+   MPI_Bcast(&len, 1, MPI_INT, 0, comm);
+   joint.resize(len);
+   MPI_Bcast(&joint[0], len, MPI_CHAR, 0, comm);
+
+   // 2. Unpack the union and locate the local entries; a scope and a counter
+   //    may have the same path.
+   entries.clear();
+   typedef std::map<std::pair<std::string, bool>, int> EntryMap;
+   EntryMap local_index;
+   for (size_t i = 0; i < local.size(); i++)
+   {
+      local_index[std::make_pair(local[i].path, local[i].counter)] = i;
+   }
+   for (size_t pos = 0; pos < joint.size(); )
+   {
+      const size_t nl = joint.find('\n', pos);
+      const size_t sp = joint.find(' ', joint.find(' ', pos) + 1);
+      Entry e;
+      char *next;
+      e.depth = strtol(joint.c_str() + pos, &next, 10);
+      e.counter = strtol(next, NULL, 10);
+      e.path = joint.substr(sp + 1, nl - sp - 1);
+      entries.push_back(e);
+      pos = nl + 1;
+   }
+   // the union has the entries of all ranks, but its order is only that of
+   // the tree on the first rank
+   std::stable_sort(entries.begin(), entries.end(), EntryPathLess);
+
+   // 3. Reduce: min, max and sum over the ranks where the entry exists.
+   const int ne = entries.size();
+   if (ne == 0) { return; }
+   const double inf = std::numeric_limits<double>::infinity();
+   std::vector<double> mins(3*ne), maxs(3*ne), sums(4*ne);
+   for (int i = 0; i < ne; i++)
+   {
+      EntryMap::const_iterator it =
+         local_index.find(std::make_pair(entries[i].path, entries[i].counter));
+      const bool found = (it != local_index.end());
+      const Entry *l = found ? &local[it->second] : NULL;
+      const double v[3] = { found ? l->calls[0] : 0.0,
+                            found ? l->time[0] : 0.0,
+                            found ? l->count[0] : 0.0
+                          };
+      for (int k = 0; k < 3; k++)
+      {
+         mins[3*i+k] = found ? v[k] : inf;
+         maxs[3*i+k] = found ? v[k] : -inf;
+         sums[4*i+k] = v[k];
+      }
+      sums[4*i+3] = found ? 1.0 : 0.0;
+   }
+   MPI_Allreduce(MPI_IN_PLACE, &mins[0], 3*ne, MPI_DOUBLE, MPI_MIN, comm);
+   MPI_Allreduce(MPI_IN_PLACE, &maxs[0], 3*ne, MPI_DOUBLE, MPI_MAX, comm);
+   MPI_Allreduce(MPI_IN_PLACE, &sums[0], 4*ne, MPI_DOUBLE, MPI_SUM, comm);
+   for (int i = 0; i < ne; i++)
+   {
+      Entry &e = entries[i];
+      e.ranks = int(sums[4*i+3]);
+      double *stats[3] = { e.calls, e.time, e.count };
+      for (int k = 0; k < 3; k++)
+      {
+         stats[k][0] = mins[3*i+k];
+         stats[k][1] = maxs[3*i+k];
+         stats[k][2] = sums[4*i+k]/e.ranks;
+      }
+   }
+}
+#endif
+
+// Escape the characters of s that are special in a JSON string.
+static std::string JSONString(const std::string &s)
+{
+   std::string r("\"");
+   for (size_t i = 0; i < s.size(); i++)
+   {
+      if (s[i] == '"' || s[i] == '\\') { r += '\\'; }
+      r += s[i];
+   }
+   return r + '"';
+}
+
+// Quote s if it contains characters that are special in a CSV field.
+static std::string CSVString(const std::string &s)
+{
+   if (s.find_first_of(",\"\n") == std::string::npos) { return s; }
+   std::string r("\"");
+   for (size_t i = 0; i < s.size(); i++)
+   {
+      if (s[i] == '"') { r += '"'; }
+      r += s[i];
+   }
+   return r + '"';
+}
+
+void Profiler::WriteTree(const std::vector<Entry> &entries, std::ostream &out)
+{
+   std::ios::fmtflags old_flags = out.flags();
+   out << std::left << std::setw(40) << "scope" << std::right
+       << std::setw(12) << "calls" << std::setw(14) << "time avg"
+       << std::setw(14) << "time min" << std::setw(14) << "time max"
+       << std::setw(14) << "count" << '\n';
+   for (size_t i = 0; i < entries.size(); i++)
+   {
+      const Entry &e = entries[i];
+      const size_t slash = e.path.rfind('/');
+      const std::string name = (slash == std::string::npos) ?
+                               e.path : e.path.substr(slash + 1);
+      out << std::left << std::setw(40)
+          << std::string(2*e.depth, ' ') + name << std::right
+          << std::setw(12) << e.calls[2];
+      if (!e.counter)
+      {
+         out << std::setw(14) << e.time[2] << std::setw(14) << e.time[0]
+             << std::setw(14) << e.time[1];
+      }
+      else
+      {
+         out << std::setw(56) << e.count[2];
+      }
+      out << '\n';
+   }
+   out.flags(old_flags);
+   out << std::flush;
+}
+
+void Profiler::WriteJSON(const std::vector<Entry> &entries, std::ostream &out)
+{
+   const char *names[3] = { "calls", "time", "count" };
+   out << "[\n";
+   for (size_t i = 0; i < entries.size(); i++)
+   {
+      const Entry &e = entries[i];
+      const double *stats[3] = { e.calls, e.time, e.count };
+      out << "  { \"path\": " << JSONString(e.path)
+          << ", \"depth\": " << e.depth << ", \"ranks\": " << e.ranks
+          << ", \"counter\": " << (e.counter ? "true" : "false");
+      for (int k = 0; k < 3; k++)
+      {
+         out << ", \"" << names[k] << "\": { \"min\": " << stats[k][0]
+             << ", \"max\": " << stats[k][1] << ", \"avg\": " << stats[k][2]
+             << " }";
+      }
+      out << " }" << (i + 1 < entries.size() ? "," : "") << '\n';
+   }
+   out << "]" << std::endl;
+}
+
+void Profiler::WriteCSV(const std::vector<Entry> &entries, std::ostream &out)
+{
+   out << "path,depth,ranks,counter,calls_min,calls_max,calls_avg,time_min,time_max,"
+       "time_avg,count_min,count_max,count_avg\n";
+   for (size_t i = 0; i < entries.size(); i++)
+   {
+      const Entry &e = entries[i];
+      const double *stats[3] = { e.calls, e.time, e.count };
+      out << CSVString(e.path) << ',' << e.depth << ',' << e.ranks << ','
+          << int(e.counter);
+      for (int k = 0; k < 3; k++)
+      {
+         out << ',' << stats[k][0] << ',' << stats[k][1] << ','
+             << stats[k][2];
+      }
+      out << '\n';
+   }
+   out << std::flush;
+}
+
+void Profiler::Print(std::ostream &out) const
+{
+   std::vector<Entry> entries;
+   GetEntries(entries);
+   WriteTree(entries, out);
+}
+
+void Profiler::PrintJSON(std::ostream &out) const
+{
+   std::vector<Entry> entries;
+   GetEntries(entries);
+   WriteJSON(entries, out);
+}
+
+void Profiler::PrintCSV(std::ostream &out) const
+{
+   std::vector<Entry> entries;
+   GetEntries(entries);
+   WriteCSV(entries, out);
+}
+
+#ifdef MFEM_USE_MPI
+void Profiler::Print(MPI_Comm comm, std::ostream &out) const
+{
+   std::vector<Entry> entries;
+   ReduceEntries(comm, entries);
+   int myid;
+   MPI_Comm_rank(comm, &myid);
+   if (myid == 0) { WriteTree(entries, out); }
+}
+
+void Profiler::PrintJSON(MPI_Comm comm, std::ostream &out) const
+{
+   std::vector<Entry> entries;
+   ReduceEntries(comm, entries);
+   int myid;
+   MPI_Comm_rank(comm, &myid);
+   if (myid == 0) { WriteJSON(entries, out); }
+}
+
+void Profiler::PrintCSV(MPI_Comm comm, std::ostream &out) const
+{
+   std::vector<Entry> entries;
+   ReduceEntries(comm, entries);
+   int myid;
+   MPI_Comm_rank(comm, &myid);
+   if (myid == 0) { WriteCSV(entries, out); }
+}
+#endif
+
+Profiler profiler;
+
+}
@@ -0,0 +1,148 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#ifndef MFEM_PROFILER
+#define MFEM_PROFILER
+
+#include "../config/config.hpp"
+#include "tic_toc.hpp"
+
+#ifdef MFEM_USE_MPI
+#include <mpi.h>
+#endif
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace mfem
+{
+
+/** @brief Hierarchical registry of named timers and counters.
+
+    A scope is opened with Start() and closed with Stop(); the scopes opened
+    while another scope is open become its children, so the same name can be
+    used under different parents, e.g. "smoother" under "level 0" and under
+    "level 1". Every scope records the number of calls and the total (wall)
+    time, measured with a single running StopWatch. Count() adds a value to a
+    named counter in the current scope.
+
+    The profiler is switched on and off at run time with Enable(); when it is
+    disabled, which is the default, Start(), Stop() and Count() do not record
+    anything, so the instrumentation can stay in the code. A Stop() closes the
+    scope of the matching Start() only if that scope was opened, so Enable()
+    may also be called while scopes are open. The global object mfem::profiler
+    is enabled at startup if the environment variable MFEM_PROFILE is set.
+
+    The profiler is not thread-safe: it should only be used outside of OpenMP
+    parallel regions. */
+class Profiler
+{
+public:
+   /// Statistics of one scope or counter, over one or several MPI ranks.
+   struct Entry
+   {
+      std::string path;  ///< names of the enclosing scopes separated by '/'
+      int depth;         ///< number of enclosing scopes
+      int ranks;         ///< number of ranks where the entry exists
+      bool counter;      ///< a counter (see Count()) rather than a scope
+      double calls[3];   ///< min, max, avg of the number of calls
+      double time[3];    ///< min, max, avg of the total time (0 for counters)
+      double count[3];   ///< min, max, avg of the counted value
+   };
+
+private:
+   struct Node
+   {
+      std::string name;
+      int parent, first_child, last_child, next_sibling;
+      long calls;
+      double time, start, count;
+      bool counter;
+   };
+
+   bool enabled;
+   StopWatch sw;
+   std::vector<Node> nodes; // nodes[0] is the root
+   int current;             // innermost open scope
+   std::vector<bool> opened; // for each Start(), whether a scope was opened
+
+   void ClearNode(int n, const char *name, int parent, bool counter);
+   int FindChild(const char *name, int index, bool counter);
+
+   void GetEntries(int node, const std::string &path, int depth,
+                   std::vector<Entry> &entries) const;
+   void GetEntries(std::vector<Entry> &entries) const;
+#ifdef MFEM_USE_MPI
+   void ReduceEntries(MPI_Comm comm, std::vector<Entry> &entries) const;
+#endif
+
+   static void WriteTree(const std::vector<Entry> &entries, std::ostream &out);
+   static void WriteJSON(const std::vector<Entry> &entries, std::ostream &out);
+   static void WriteCSV(const std::vector<Entry> &entries, std::ostream &out);
+
+public:
+   Profiler();
+
+   /// Switch the profiler on or off; the recorded data is kept.
+   void Enable(bool on = true);
+   bool Enabled() const { return enabled; }
+
+   /// Open the child scope @a name of the current scope.
+   void Start(const char *name) { Start(name, -1); }
+   /** @brief Open the child scope "name index" of the current scope, e.g. a
+       multigrid level; a negative @a index is ignored. */
+   void Start(const char *name, int index);
+   /** @brief Close the current scope, if the profiler was enabled at the
+       matching Start(). */
+   void Stop();
+   /// Add @a value to the counter @a name of the current scope.
+   void Count(const char *name, double value = 1.0);
+
+   /// Remove all recorded data. No scope should be open.
+   void Clear();
+
+   /// Print the recorded data as an indented tree.
+   void Print(std::ostream &out = std::cout) const;
+   /// Print the recorded data as a JSON array of entries.
+   void PrintJSON(std::ostream &out) const;
+   /** @brief Print the recorded data as comma-separated values, one entry per
+       line, with a header line. */
+   void PrintCSV(std::ostream &out) const;
+
+#ifdef MFEM_USE_MPI
+   /** @brief Collective versions of the Print methods: the entries are
+       matched by their paths and kinds across the ranks of @a comm, sorted
+       by their paths, and the min, max and average over the ranks are
+       printed by rank 0. */
+   void Print(MPI_Comm comm, std::ostream &out = std::cout) const;
+   void PrintJSON(MPI_Comm comm, std::ostream &out) const;
+   void PrintCSV(MPI_Comm comm, std::ostream &out) const;
+#endif
+};
+
+/// The global profiler used by the library.
+extern Profiler profiler;
+
+/** @brief Scope guard for the global profiler: Start() in the constructor and
+    Stop() in the destructor. */
+class ProfileScope
+{
+public:
+   explicit ProfileScope(const char *name, int index = -1)
+   { profiler.Start(name, index); }
+
+   ~ProfileScope() { profiler.Stop(); }
+};
+
+}
+
+#endif
@@ -0,0 +1,224 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#include "sorted_keys.hpp"
+
+#ifdef MFEM_USE_OPENMP
+#include <omp.h>
+#endif
+
+namespace mfem
+{
+
+// Number of bits sorted in one pass of the radix sort.
+static const int radix_bits = 8;
+static const int radix_size = 1 << radix_bits;
+
+// Maximal key size, for the temporary copies in Index().
+static const int max_key_size = 8;
+
+SortedKeyTable::SortedKeyTable(int ks, int nv, int nk)
+   : key_size(ks), num_vertices(nv), num_keys(nk), num_unique(0)
+{
+   MFEM_VERIFY(ks >= 1 && ks <= max_key_size, "invalid key size: " << ks);
+   keys.SetSize(nk*ks);
+}
+
+void SortedKeyTable::Set(int k, const int *v)
+{
+   MFEM_ASSERT(0 <= k && k < num_keys, "invalid key occurrence: " << k);
+   int *key = &keys[k*key_size];
+   // insertion sort, the keys are short
+   for (int i = 0; i < key_size; i++)
+   {
+      const int vi = v[i];
+      MFEM_ASSERT(0 <= vi && vi < num_vertices, "invalid vertex: " << vi);
+      int j = i;
+      for ( ; j > 0 && key[j-1] > vi; j--) { key[j] = key[j-1]; }
+      key[j] = vi;
+   }
+}
+
+int SortedKeyTable::Compare(const int *a, const int *b) const
+{
+   for (int i = 0; i < key_size; i++)
+   {
+      if (a[i] != b[i]) { return (a[i] < b[i]) ? -1 : 1; }
+   }
+   return 0;
+}
+
+void SortedKeyTable::Finalize()
+{
+   const int n = num_keys, K = key_size, R = key_size + 1;
+
+   // Records: the key followed by the index of its occurrence.
+   Array<int> rec(n*R), tmp(n*R);
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for
+#endif
+   for (int k = 0; k < n; k++)
+   {
+      for (int i = 0; i < K; i++) { rec[k*R+i] = keys[k*K+i]; }
+      rec[k*R+K] = k;
+   }
+   keys.DeleteAll();
+
+   int num_digits = 0;
+   for (int m = num_vertices - 1; m > 0; m >>= radix_bits) { num_digits++; }
+
+#ifdef MFEM_USE_OPENMP
+   const int max_threads = omp_get_max_threads();
+#else
+   const int max_threads = 1;
+#endif
+   Array<int> hist(max_threads*radix_size);
+
+   // Stable LSD radix sort: the digits of the last key entry first. Each
+   // thread counts and scatters a contiguous chunk of the records, so the
+   // order of the occurrences with equal keys is preserved.
+   for (int i = K-1; i >= 0; i--)
+   {
+      for (int d = 0; d < num_digits; d++)
+      {
+         const int shift = d*radix_bits;
+         bool skip = false;
+#ifdef MFEM_USE_OPENMP
+         #pragma omp parallel
+#endif
+         {
+#ifdef MFEM_USE_OPENMP
+            const int nt = omp_get_num_threads(), t = omp_get_thread_num();
+#else
+            const int nt = 1, t = 0;
+#endif
+            const int lo = (int)((long)n*t/nt), hi = (int)((long)n*(t+1)/nt);
+            int *h = &hist[t*radix_size];
+            for (int b = 0; b < radix_size; b++) { h[b] = 0; }
+            for (int j = lo; j < hi; j++)
+            {
+               h[(rec[j*R+i] >> shift) & (radix_size-1)]++;
+            }
+#ifdef MFEM_USE_OPENMP
+            #pragma omp barrier
+            #pragma omp single
+#endif
+            {
+               int offset = 0;
+               for (int b = 0; b < radix_size; b++)
+               {
+                  int count = 0;
+                  for (int s = 0; s < nt; s++)
+                  {
+                     const int c = hist[s*radix_size+b];
+                     hist[s*radix_size+b] = offset + count;
+                     count += c;
+                  }
+                  // all records have the same digit: nothing to do
+                  if (count == n) { skip = true; }
+                  offset += count;
+               }
+            }
+            if (!skip)
+            {
+               for (int j = lo; j < hi; j++)
+               {
+                  const int dst = h[(rec[j*R+i] >> shift) & (radix_size-1)]++;
+                  for (int l = 0; l < R; l++) { tmp[dst*R+l] = rec[j*R+l]; }
+               }
+            }
+         }
+         if (!skip) { mfem::Swap(rec, tmp); }
+      }
+   }
+   tmp.DeleteAll();
+
+   // Mark the first occurrence of each key: it starts a group of equal keys
+   // in the sorted records.
+   number.SetSize(n);
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for
+#endif
+   for (int j = 0; j < n; j++)
+   {
+      number[rec[j*R+K]] =
+         (j == 0 || Compare(&rec[j*R], &rec[(j-1)*R]) != 0) ? 1 : 0;
+   }
+
+   // Number the first occurrences in the order of occurrence.
+   num_unique = 0;
+   for (int k = 0; k < n; k++)
+   {
+      const int first = number[k];
+      number[k] = num_unique;
+      num_unique += first;
+   }
+
+   // Propagate the numbers to all occurrences and keep the distinct keys for
+   // the lookups in Index().
+   sorted.SetSize(num_unique*K);
+   sorted_no.SetSize(num_unique);
+   for (int j = 0, u = -1, no = -1; j < n; j++)
+   {
+      if (j == 0 || Compare(&rec[j*R], &rec[(j-1)*R]) != 0)
+      {
+         no = number[rec[j*R+K]];
+         u++;
+         for (int i = 0; i < K; i++) { sorted[u*K+i] = rec[j*R+i]; }
+         sorted_no[u] = no;
+      }
+      number[rec[j*R+K]] = no;
+   }
+}
+
+int SortedKeyTable::Index(const int *v) const
+{
+   int key[max_key_size];
+   for (int i = 0; i < key_size; i++)
+   {
+      const int vi = v[i];
+      int j = i;
+      for ( ; j > 0 && key[j-1] > vi; j--) { key[j] = key[j-1]; }
+      key[j] = vi;
+   }
+
+   int lo = 0, hi = num_unique;
+   while (lo < hi)
+   {
+      const int mid = lo + (hi - lo)/2;
+      const int c = Compare(&sorted[mid*key_size], key);
+      if (c == 0) { return sorted_no[mid]; }
+      if (c < 0) { lo = mid + 1; }
+      else { hi = mid; }
+   }
+   return -1;
+}
+
+int SortedKeyTable::operator()(const int *v) const
+{
+   const int no = Index(v);
+   if (no < 0)
+   {
+      std::ostringstream key;
+      for (int i = 0; i < key_size; i++) { key << (i ? "," : "(") << v[i]; }
+      MFEM_ABORT("SortedKeyTable::operator(): key " << key.str()
+                 << ") not found");
+   }
+   return no;
+}
+
+long SortedKeyTable::MemoryUsage() const
+{
+   return keys.MemoryUsage() + number.MemoryUsage() + sorted.MemoryUsage() +
+          sorted_no.MemoryUsage();
+}
+
+}
@@ -0,0 +1,83 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#ifndef MFEM_SORTED_KEYS
+#define MFEM_SORTED_KEYS
+
+#include "../config/config.hpp"
+#include "array.hpp"
+
+namespace mfem
+{
+
+/** @brief Flat table of unordered integer keys of fixed length (e.g. the
+    vertices of edges, triangles or tetrahedra), numbered by sorting.
+
+    This is an alternative to DSTable, STable3D and STable4D for building mesh
+    topology. All key occurrences are first stored with Set(). Finalize() then
+    sorts them with a stable LSD radix sort (thread-parallel when
+    MFEM_USE_OPENMP is defined) and numbers the distinct keys in the order of
+    their first occurrence. This is the same numbering that the hash tables
+    produce when the keys are pushed in the order of the occurrences.
+
+    Compared to the hash tables, the memory is allocated in a few flat arrays
+    and there is no per-row list traversal, which matters for meshes with
+    millions of elements. */
+class SortedKeyTable
+{
+private:
+   int key_size, num_vertices, num_keys, num_unique;
+
+   Array<int> keys;      // num_keys x key_size, cleared by Finalize()
+   Array<int> number;    // number of each occurrence
+   Array<int> sorted;    // distinct keys in lexicographic order
+   Array<int> sorted_no; // numbers of the keys in 'sorted'
+
+   int Compare(const int *a, const int *b) const;
+
+public:
+   /** @brief Create a table for @a nk occurrences of keys with @a ks entries
+       in the range [0, @a nv). */
+   SortedKeyTable(int ks, int nv, int nk);
+
+   /// Set the vertices of the key occurrence @a k; their order is irrelevant.
+   void Set(int k, const int *v);
+
+   /// Sort the keys and number them, see the class description.
+   void Finalize();
+
+   int KeySize() const { return key_size; }
+
+   /// Return the number of key occurrences.
+   int NumberOfKeys() const { return num_keys; }
+
+   /// Return the number of distinct keys (after Finalize()).
+   int NumberOfElements() const { return num_unique; }
+
+   /// Return the number of the key occurrence @a k (after Finalize()).
+   int operator[](int k) const { return number[k]; }
+
+   /// Return the numbers of all key occurrences (after Finalize()).
+   const Array<int> &GetNumbers() const { return number; }
+
+   /** @brief Return the number of the key with vertices @a v (in any order),
+       or -1 if it is not in the table (after Finalize()). */
+   int Index(const int *v) const;
+
+   /// Like Index(), but abort if the key is not in the table.
+   int operator()(const int *v) const;
+
+   long MemoryUsage() const;
+};
+
+}
+
+#endif
@@ -536,6 +536,36 @@ void Mult (const Table &A, const Table &B, Table &C)
 }
 
 
+void Mult (const Table &A, const Table &B, Table &C, Array<int> &counts)
+{
+   Mult(A, B, C);
+
+   const int *i_A = A.GetI(), *j_A = A.GetJ();
+   const int *i_B = B.GetI(), *j_B = B.GetJ();
+   const int *i_C = C.GetI(), *j_C = C.GetJ();
+   const int  nrows_A = A.Size();
+
+   Array<int> C_marker(C.Width());
+   C_marker = -1;
+   counts.SetSize(i_C[nrows_A]);
+   counts = 0;
+   for (int i = 0; i < nrows_A; i++)
+   {
+      for (int k = i_C[i]; k < i_C[i+1]; k++)
+      {
+         C_marker[j_C[k]] = k;
+      }
+      for (int j = i_A[i]; j < i_A[i+1]; j++)
+      {
+         const int k = j_A[j];
+         for (int l = i_B[k]; l < i_B[k+1]; l++)
+         {
+            counts[C_marker[j_B[l]]]++;
+         }
+      }
+   }
+}
+
 Table * Mult (const Table &A, const Table &B)
 {
    Table * C = new Table;
@@ -175,6 +175,12 @@ void Transpose(const Array<int> &A, Table &At, int _ncols_A = -1);
 void Mult (const Table &A, const Table &B, Table &C);
 Table * Mult (const Table &A, const Table &B);
 
+/** C = A * B  (as integer matrices with unit entries). The value of the k-th
+    connection of C, i.e. the number of connections i -> j in A and j -> m in
+    B connecting i to m, is returned in @a counts(k). The connections of C are
+    the same as with Mult(A, B, C). */
+void Mult (const Table &A, const Table &B, Table &C, Array<int> &counts);
+
 
 /** Data type STable. STable is similar to Table, but it's for symmetric
     connectivity, i.e. TYPE I is equivalent to TYPE II. In the first
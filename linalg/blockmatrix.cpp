@@ -125,6 +125,21 @@ int BlockMatrix::NumNonZeroElems() const
    return nnz_elem;
 }
 
+long BlockMatrix::MemoryUsage() const
+{
+   long mem = nRowBlocks*nColBlocks*sizeof(SparseMatrix *);
+   if (owns_blocks)
+      for (int jcol = 0; jcol != nColBlocks; ++jcol)
+         for (int irow = 0; irow != nRowBlocks; ++irow)
+         {
+            if (Aij(irow,jcol))
+            {
+               mem += Aij(irow,jcol)->MemoryUsage();
+            }
+         }
+   return mem;
+}
+
 
 double& BlockMatrix::Elem (int i, int j)
 {
@@ -91,6 +91,9 @@ public:
    //@{
    //! Returns the total number of non zeros in the matrix.
    virtual int NumNonZeroElems() const;
+   //! Returns the memory used by the matrix, in bytes, including the blocks
+   //! only if they are owned.
+   long MemoryUsage() const;
    /// Gets the columns indexes and values for row *row*.
    /// The return value is always 0 since cols and srow are copies of the values in the matrix.
    virtual int GetRow(const int row, Array<int> &cols, Vector &srow) const;
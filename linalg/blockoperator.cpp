@@ -88,6 +88,45 @@ void BlockOperator::Mult (const Vector & x, Vector & y) const
    }
 }
 
+void BlockOperator::Mult (const MultiVector & x, MultiVector & y) const
+{
+   MFEM_ASSERT(x.Size() == width, "incorrect input MultiVector size");
+   MFEM_ASSERT(y.Size() == height, "incorrect output MultiVector size");
+   MFEM_ASSERT(x.NumVectors() == y.NumVectors(),
+               "incorrect number of vectors");
+
+   const int nv = x.NumVectors();
+   MultiVector xb, tb;
+
+   // Copy the column blocks of x to contiguous MultiVectors, so that every
+   // block is applied to all vectors at once.
+   xmulti.SetSize(width*nv);
+   for (int jCol=0; jCol < nColBlocks; ++jCol)
+   {
+      xb.SetDataAndSize(xmulti.GetData() + nv*col_offsets[jCol],
+                        col_offsets[jCol+1] - col_offsets[jCol], nv);
+      x.GetSubVectors(col_offsets[jCol], xb);
+   }
+
+   y = 0.0;
+   for (int iRow=0; iRow < nRowBlocks; ++iRow)
+   {
+      const int h = row_offsets[iRow+1] - row_offsets[iRow];
+      tmpmulti.SetSize(h*nv);
+      tb.SetDataAndSize(tmpmulti.GetData(), h, nv);
+      for (int jCol=0; jCol < nColBlocks; ++jCol)
+      {
+         if (op(iRow,jCol))
+         {
+            xb.SetDataAndSize(xmulti.GetData() + nv*col_offsets[jCol],
+                              col_offsets[jCol+1] - col_offsets[jCol], nv);
+            op(iRow,jCol)->Mult(xb, tb);
+            y.AddSubVectors(row_offsets[iRow], coef(iRow,jCol), tb);
+         }
+      }
+   }
+}
+
 // Action of the transpose operator
 void BlockOperator::MultTranspose (const Vector & x, Vector & y) const
 {
@@ -167,6 +206,38 @@ void BlockDiagonalPreconditioner::Mult (const Vector & x, Vector & y) const
       }
 }
 
+void BlockDiagonalPreconditioner::Mult (const MultiVector & x,
+                                        MultiVector & y) const
+{
+   MFEM_ASSERT(x.Size() == width, "incorrect input MultiVector size");
+   MFEM_ASSERT(y.Size() == height, "incorrect output MultiVector size");
+   MFEM_ASSERT(x.NumVectors() == y.NumVectors(),
+               "incorrect number of vectors");
+
+   const int nv = x.NumVectors();
+   MultiVector xb, yb;
+
+   xmulti.SetSize(width*nv);
+   ymulti.SetSize(height*nv);
+   y = 0.0;
+   for (int i=0; i<nBlocks; ++i)
+   {
+      const int s = offsets[i+1] - offsets[i];
+      xb.SetDataAndSize(xmulti.GetData() + nv*offsets[i], s, nv);
+      x.GetSubVectors(offsets[i], xb);
+      if (op[i])
+      {
+         yb.SetDataAndSize(ymulti.GetData() + nv*offsets[i], s, nv);
+         op[i]->Mult(xb, yb);
+         y.AddSubVectors(offsets[i], 1.0, yb);
+      }
+      else
+      {
+         y.AddSubVectors(offsets[i], 1.0, xb);
+      }
+   }
+}
+
 // Action of the transpose operator
 void BlockDiagonalPreconditioner::MultTranspose (const Vector & x,
                                                  Vector & y) const
@@ -91,6 +91,9 @@ public:
    /// Operator application
    virtual void Mult (const Vector & x, Vector & y) const;
 
+   /// Operator application to several vectors, block by block
+   virtual void Mult (const MultiVector & x, MultiVector & y) const;
+
    /// Action of the transpose operator
    virtual void MultTranspose (const Vector & x, Vector & y) const;
 
@@ -118,6 +121,8 @@ private:
    mutable BlockVector xblock;
    mutable BlockVector yblock;
    mutable Vector tmp;
+   //! Temporary storage for the blocks of MultiVectors
+   mutable Vector xmulti, tmpmulti;
 };
 
 //! @class BlockDiagonalPreconditioner
@@ -159,6 +164,9 @@ public:
    /// Operator application
    virtual void Mult (const Vector & x, Vector & y) const;
 
+   /// Operator application to several vectors, block by block
+   virtual void Mult (const MultiVector & x, MultiVector & y) const;
+
    /// Action of the transpose operator
    virtual void MultTranspose (const Vector & x, Vector & y) const;
 
@@ -180,6 +188,8 @@ private:
    //! methods.
    mutable BlockVector xblock;
    mutable BlockVector yblock;
+   //! Temporary storage for the blocks of MultiVectors
+   mutable Vector xmulti, ymulti;
 };
 
 //! @class BlockLowerTriangularPreconditioner
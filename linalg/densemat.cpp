@@ -2927,11 +2927,118 @@ dgemm_(char *, char *, int *, int *, int *, double *, double *,
        int *, double *, int *, double *, double *, int *);
 #endif
 
+// Small-matrix kernels with the inner (summation) dimension K known at compile
+// time. In the element computations K is usually the reference or physical
+// space dimension (1-4) while the other dimensions are numbers of dofs. The
+// K-loop is fully unrolled and the loop over the contiguous row index is
+// innermost, so it can be vectorized by the compiler. The order of the
+// summation is the same as in the generic loops, so the results do not change.
+
+// a {=|+=} b.c, where b is m x K and c is K x n
+template <bool Add, int K>
+static inline void kMult(const int m, const int n, const double *b,
+                         const double *c, double *a)
+{
+   for (int j = 0; j < n; j++, a += m, c += K)
+   {
+      for (int i = 0; i < m; i++)
+      {
+         double d = Add ? a[i] : 0.0;
+         for (int k = 0; k < K; k++)
+         {
+            d += b[i+k*m] * c[k];
+         }
+         a[i] = d;
+      }
+   }
+}
+
+// C {=|+=} A.B^t, where A is m x K and B is n x K
+template <bool Add, int K>
+static inline void kMultABt(const int m, const int n, const double *A,
+                            const double *B, double *C)
+{
+   double Bj[K];
+   for (int j = 0; j < n; j++, C += m)
+   {
+      for (int k = 0; k < K; k++)
+      {
+         Bj[k] = B[j+k*n];
+      }
+      for (int i = 0; i < m; i++)
+      {
+         double d = Add ? C[i] : 0.0;
+         for (int k = 0; k < K; k++)
+         {
+            d += A[i+k*m] * Bj[k];
+         }
+         C[i] = d;
+      }
+   }
+}
+
+// C = A^t.B, where A is K x m and B is K x n
+template <int K>
+static inline void kMultAtB(const int m, const int n, const double *A,
+                            const double *B, double *C)
+{
+   for (int j = 0; j < n; j++, B += K)
+   {
+      const double *Ai = A;
+      for (int i = 0; i < m; i++, Ai += K)
+      {
+         double d = 0.0;
+         for (int k = 0; k < K; k++)
+         {
+            d += Ai[k] * B[k];
+         }
+         *(C++) = d;
+      }
+   }
+}
+
+// C += a A.A^t, where A is n x K. The full matrix is computed column by
+// column; the products A(i,k)*A(j,k) are symmetric, so C stays symmetric.
+template <int K>
+static inline void kAddMult_a_AAt(const double a, const int n, const double *A,
+                                  double *C)
+{
+   double Aj[K];
+   for (int j = 0; j < n; j++, C += n)
+   {
+      for (int k = 0; k < K; k++)
+      {
+         Aj[k] = A[j+k*n];
+      }
+      for (int i = 0; i < n; i++)
+      {
+         double d = 0.0;
+         for (int k = 0; k < K; k++)
+         {
+            d += A[i+k*n] * Aj[k];
+         }
+         C[i] += a * d;
+      }
+   }
+}
+
 void Mult(const DenseMatrix &b, const DenseMatrix &c, DenseMatrix &a)
 {
    MFEM_ASSERT(a.Height() == b.Height() && a.Width() == c.Width() &&
                b.Width() == c.Height(), "incompatible dimensions");
 
+   switch (b.Width())
+   {
+      case 1: kMult<false,1>(a.Height(), a.Width(), b.Data(), c.Data(),
+                                a.Data()); return;
+      case 2: kMult<false,2>(a.Height(), a.Width(), b.Data(), c.Data(),
+                                a.Data()); return;
+      case 3: kMult<false,3>(a.Height(), a.Width(), b.Data(), c.Data(),
+                                a.Data()); return;
+      case 4: kMult<false,4>(a.Height(), a.Width(), b.Data(), c.Data(),
+                                a.Data()); return;
+   }
+
 #ifdef MFEM_USE_LAPACK
    static char transa = 'N', transb = 'N';
    static double alpha = 1.0, beta = 0.0;
@@ -2968,6 +3075,18 @@ void AddMult(const DenseMatrix &b, const DenseMatrix &c, DenseMatrix &a)
    MFEM_ASSERT(a.Height() == b.Height() && a.Width() == c.Width() &&
                b.Width() == c.Height(), "incompatible dimensions");
 
+   switch (b.Width())
+   {
+      case 1: kMult<true,1>(a.Height(), a.Width(), b.Data(), c.Data(),
+                               a.Data()); return;
+      case 2: kMult<true,2>(a.Height(), a.Width(), b.Data(), c.Data(),
+                               a.Data()); return;
+      case 3: kMult<true,3>(a.Height(), a.Width(), b.Data(), c.Data(),
+                               a.Data()); return;
+      case 4: kMult<true,4>(a.Height(), a.Width(), b.Data(), c.Data(),
+                               a.Data()); return;
+   }
+
 #ifdef MFEM_USE_LAPACK
    static char transa = 'N', transb = 'N';
    static double alpha = 1.0, beta = 1.0;
@@ -3194,6 +3313,19 @@ void CalcInverse(const DenseMatrix &a, DenseMatrix &inva)
       return;
    }
 
+   if (a.Height() == 4)
+   {
+      // Get the determinant from the first row and the adjugate instead of
+      // computing the 2x2 and 3x3 minors twice.
+      CalcAdjugate(a, inva);
+      t = a(0,0)*inva(0,0) + a(0,1)*inva(1,0) + a(0,2)*inva(2,0) +
+          a(0,3)*inva(3,0);
+      MFEM_ASSERT(std::abs(t) > 1.0e-14 * pow(a.FNorm()/a.Width(), a.Width()),
+                  "singular matrix!");
+      inva *= 1.0 / t;
+      return;
+   }
+
 #ifdef MFEM_DEBUG
    t = a.Det();
    MFEM_ASSERT(std::abs(t) > 1.0e-14 * pow(a.FNorm()/a.Width(), a.Width()),
@@ -3227,12 +3359,6 @@ void CalcInverse(const DenseMatrix &a, DenseMatrix &inva)
          inva(2,1) = (a(0,1)*a(2,0)-a(0,0)*a(2,1))*t;
          inva(2,2) = (a(0,0)*a(1,1)-a(0,1)*a(1,0))*t;
          break;
-      case 4:
-      {
-         CalcAdjugate(a, inva);
-         inva *= t;
-         break;
-      }
    }
 }
 
@@ -3387,6 +3513,18 @@ void MultABt(const DenseMatrix &A, const DenseMatrix &B, DenseMatrix &ABt)
    }
 #endif
 
+   switch (A.Width())
+   {
+      case 1: kMultABt<false,1>(A.Height(), B.Height(), A.Data(), B.Data(),
+                                   ABt.Data()); return;
+      case 2: kMultABt<false,2>(A.Height(), B.Height(), A.Data(), B.Data(),
+                                   ABt.Data()); return;
+      case 3: kMultABt<false,3>(A.Height(), B.Height(), A.Data(), B.Data(),
+                                   ABt.Data()); return;
+      case 4: kMultABt<false,4>(A.Height(), B.Height(), A.Data(), B.Data(),
+                                   ABt.Data()); return;
+   }
+
 #ifdef MFEM_USE_LAPACK
    static char transa = 'N', transb = 'T';
    static double alpha = 1.0, beta = 0.0;
@@ -3510,6 +3648,18 @@ void AddMultABt(const DenseMatrix &A, const DenseMatrix &B, DenseMatrix &ABt)
    }
 #endif
 
+   switch (A.Width())
+   {
+      case 1: kMultABt<true,1>(A.Height(), B.Height(), A.Data(), B.Data(),
+                                  ABt.Data()); return;
+      case 2: kMultABt<true,2>(A.Height(), B.Height(), A.Data(), B.Data(),
+                                  ABt.Data()); return;
+      case 3: kMultABt<true,3>(A.Height(), B.Height(), A.Data(), B.Data(),
+                                  ABt.Data()); return;
+      case 4: kMultABt<true,4>(A.Height(), B.Height(), A.Data(), B.Data(),
+                                  ABt.Data()); return;
+   }
+
 #ifdef MFEM_USE_LAPACK
    static char transa = 'N', transb = 'T';
    static double alpha = 1.0, beta = 1.0;
@@ -3662,6 +3812,18 @@ void MultAtB(const DenseMatrix &A, const DenseMatrix &B, DenseMatrix &AtB)
    }
 #endif
 
+   switch (A.Height())
+   {
+      case 1: kMultAtB<1>(A.Width(), B.Width(), A.Data(), B.Data(),
+                             AtB.Data()); return;
+      case 2: kMultAtB<2>(A.Width(), B.Width(), A.Data(), B.Data(),
+                             AtB.Data()); return;
+      case 3: kMultAtB<3>(A.Width(), B.Width(), A.Data(), B.Data(),
+                             AtB.Data()); return;
+      case 4: kMultAtB<4>(A.Width(), B.Width(), A.Data(), B.Data(),
+                             AtB.Data()); return;
+   }
+
 #ifdef MFEM_USE_LAPACK
    static char transa = 'T', transb = 'N';
    static double alpha = 1.0, beta = 0.0;
@@ -3711,6 +3873,14 @@ void MultAtB(const DenseMatrix &A, const DenseMatrix &B, DenseMatrix &AtB)
 
 void AddMult_a_AAt(double a, const DenseMatrix &A, DenseMatrix &AAt)
 {
+   switch (A.Width())
+   {
+      case 1: kAddMult_a_AAt<1>(a, A.Height(), A.Data(), AAt.Data()); return;
+      case 2: kAddMult_a_AAt<2>(a, A.Height(), A.Data(), AAt.Data()); return;
+      case 3: kAddMult_a_AAt<3>(a, A.Height(), A.Data(), AAt.Data()); return;
+      case 4: kAddMult_a_AAt<4>(a, A.Height(), A.Data(), AAt.Data()); return;
+   }
+
    double d;
 
    for (int i = 0; i < A.Height(); i++)
@@ -3848,11 +4018,27 @@ void AddMult_a_VVt(const double a, const Vector &v, DenseMatrix &VVt)
 
 
 void LUFactors::Factor(int m)
+{
+   const bool nonsingular = TryFactor(m);
+#ifdef MFEM_USE_LAPACK
+   MFEM_VERIFY(nonsingular, "LAPACK: error in DGETRF");
+#else
+   MFEM_ASSERT(nonsingular, "division by zero");
+#endif
+   (void)nonsingular;
+}
+
+bool LUFactors::TryFactor(int m, double TOL)
 {
 #ifdef MFEM_USE_LAPACK
    int info = 0;
    if (m) { dgetrf_(&m, &m, data, &m, ipiv, &info); }
-   MFEM_VERIFY(!info, "LAPACK: error in DGETRF");
+   MFEM_VERIFY(info >= 0, "LAPACK: error in DGETRF");
+   if (info > 0) { return false; }
+   for (int i = 0; i < m; i++)
+   {
+      if (std::abs(data[i+i*m]) <= TOL) { return false; }
+   }
 #else
    // compiling without LAPACK
    double *data = this->data;
@@ -3881,7 +4067,10 @@ void LUFactors::Factor(int m)
             }
          }
       }
-      MFEM_ASSERT(data[i+i*m] != 0.0, "division by zero");
+      if (std::abs(data[i+i*m]) <= TOL)
+      {
+         return false; // singular
+      }
       const double a_ii_inv = 1.0/data[i+i*m];
       for (int j = i+1; j < m; j++)
       {
@@ -3897,6 +4086,7 @@ void LUFactors::Factor(int m)
       }
    }
 #endif
+   return true;
 }
 
 double LUFactors::Det(int m) const
@@ -427,6 +427,11 @@ public:
        original matrix and P is a permutation matrix represented by ipiv. */
    void Factor(int m);
 
+   /** Same as Factor(), but instead of failing on a singular matrix, returns
+       false if a pivot with absolute value not greater than TOL is found. In
+       this case the factors are incomplete and must not be used. */
+   bool TryFactor(int m, double TOL = 0.0);
+
    /** Assuming L.U = P.A factored data of size (m x m), compute |A|
        from the diagonal values of U and the permutation information. */
    double Det(int m) const;
@@ -545,6 +550,10 @@ public:
    /// Print the numerical conditioning of the inversion: ||A^{-1} A - I||.
    void TestInversion();
 
+   /// Return the memory used by the LU factors, in bytes.
+   long MemoryUsage() const
+   { return lu.data ? width*(width*sizeof(double) + sizeof(int)) : 0; }
+
    /// Destroys dense inverse matrix.
    virtual ~DenseMatrixInverse();
 };
@@ -15,6 +15,7 @@
 
 #include "linalg.hpp"
 #include "../fem/fem.hpp"
+#include "../general/profiler.hpp"
 
 #include <fstream>
 #include <iomanip>
@@ -877,6 +878,29 @@ void HypreParMatrix::GetDiag(Vector &diag) const
    }
 }
 
+void HypreParMatrix::GetRowL1Norms(Vector &l1) const
+{
+   int size = Height();
+   const bool has_offd = (hypre_CSRMatrixNumCols(A->offd) > 0);
+   l1.SetSize(size);
+   for (int j = 0; j < size; j++)
+   {
+      double norm = 0.0;
+      for (HYPRE_Int k = A->diag->i[j]; k < A->diag->i[j+1]; k++)
+      {
+         norm += fabs(A->diag->data[k]);
+      }
+      if (has_offd)
+      {
+         for (HYPRE_Int k = A->offd->i[j]; k < A->offd->i[j+1]; k++)
+         {
+            norm += fabs(A->offd->data[k]);
+         }
+      }
+      l1(j) = norm;
+   }
+}
+
 static void MakeWrapper(const hypre_CSRMatrix *mat, SparseMatrix &wrapper)
 {
    HYPRE_Int nr = hypre_CSRMatrixNumRows(mat);
@@ -973,6 +997,46 @@ void HypreParMatrix::Mult(double a, const Vector &x, double b, Vector &y) const
    hypre_ParCSRMatrixMatvec(a, A, *X, b, *Y);
 }
 
+// Describe the local data of v as num_vectors vectors stored one after the
+// other, the layout of MultiVector.
+static void SetMultiVectorLayout(hypre_ParVector *v, int num_vectors)
+{
+   hypre_Vector *local = hypre_ParVectorLocalVector(v);
+   hypre_VectorNumVectors(local) = num_vectors;
+   hypre_VectorMultiVecStorageMethod(local) = 0;
+   hypre_VectorVectorStride(local) = hypre_VectorSize(local);
+   hypre_VectorIndexStride(local) = 1;
+}
+
+void HypreParMatrix::Mult(double a, const MultiVector &x,
+                          double b, MultiVector &y) const
+{
+   MFEM_ASSERT(x.Size() == Width(), "invalid x.Size() = " << x.Size()
+               << ", expected size = " << Width());
+   MFEM_ASSERT(y.Size() == Height(), "invalid y.Size() = " << y.Size()
+               << ", expected size = " << Height());
+   MFEM_ASSERT(x.NumVectors() == y.NumVectors(), "incompatible MultiVectors");
+
+   const int nv = x.NumVectors();
+   if (nv == 1)
+   {
+      Vector xv, yv;
+      x.GetVectorReference(0, xv);
+      y.GetVectorReference(0, yv);
+      Mult(a, xv, b, yv);
+      return;
+   }
+
+   HypreParVector xm(A->comm, GetGlobalNumCols(), x.GetData(),
+                     GetColStarts());
+   HypreParVector ym(A->comm, GetGlobalNumRows(), y.GetData(),
+                     GetRowStarts());
+   SetMultiVectorLayout(xm, nv);
+   SetMultiVectorLayout(ym, nv);
+
+   hypre_ParCSRMatrixMatvec(a, A, xm, b, ym);
+}
+
 void HypreParMatrix::MultTranspose(double a, const Vector &x,
                                    double b, Vector &y) const
 {
@@ -1406,6 +1470,54 @@ HypreParMatrix* HypreParMatrix::EliminateRowsCols(const Array<int> &rows_cols)
    return new HypreParMatrix(Ae);
 }
 
+static long CSRMemoryUsage(hypre_CSRMatrix *csr)
+{
+   if (!csr) { return 0; }
+   HYPRE_Int num_rows = hypre_CSRMatrixNumRows(csr);
+   HYPRE_Int *I = hypre_CSRMatrixI(csr);
+   long nnz = I ? I[num_rows] : 0;
+   long mem = sizeof(hypre_CSRMatrix);
+   if (I) { mem += (num_rows + 1)*sizeof(HYPRE_Int); }
+   if (hypre_CSRMatrixJ(csr)) { mem += nnz*sizeof(HYPRE_Int); }
+   if (hypre_CSRMatrixData(csr)) { mem += nnz*sizeof(double); }
+   if (hypre_CSRMatrixRownnz(csr))
+   {
+      mem += hypre_CSRMatrixNumRownnz(csr)*sizeof(HYPRE_Int);
+   }
+   return mem;
+}
+
+static long ParCSRMemoryUsage(hypre_ParCSRMatrix *A)
+{
+   if (!A) { return 0; }
+
+   hypre_CSRMatrix *offd = hypre_ParCSRMatrixOffd(A);
+   long mem = sizeof(hypre_ParCSRMatrix) +
+              CSRMemoryUsage(hypre_ParCSRMatrixDiag(A)) +
+              CSRMemoryUsage(offd);
+   if (hypre_ParCSRMatrixColMapOffd(A))
+   {
+      mem += hypre_CSRMatrixNumCols(offd)*sizeof(HYPRE_Int);
+   }
+
+   hypre_ParCSRCommPkg *comm_pkg = hypre_ParCSRMatrixCommPkg(A);
+   if (comm_pkg)
+   {
+      HYPRE_Int num_sends = hypre_ParCSRCommPkgNumSends(comm_pkg);
+      HYPRE_Int num_recvs = hypre_ParCSRCommPkgNumRecvs(comm_pkg);
+      mem += sizeof(hypre_ParCSRCommPkg) +
+             (2*num_sends + 1 + 2*num_recvs + 1 +
+              hypre_ParCSRCommPkgSendMapStart(comm_pkg, num_sends)) *
+             sizeof(HYPRE_Int);
+   }
+   return mem;
+}
+
+long HypreParMatrix::MemoryUsage() const
+{
+   return ParCSRMemoryUsage(A);
+}
+
 void HypreParMatrix::Print(const char *fname, HYPRE_Int offi, HYPRE_Int offj)
 {
    hypre_ParCSRMatrixPrintIJ(A,offi,offj,fname);
@@ -1633,6 +1745,461 @@ void EliminateBC(HypreParMatrix &A, HypreParMatrix &Ae,
    }
 }
 
+ParMatVecPlan::ParMatVecPlan(const HypreParMatrix &A)
+   : Operator(A.Height(), A.Width())
+{
+   Init(A);
+   CreateRequests();
+}
+
+void ParMatVecPlan::Init(const HypreParMatrix &A)
+{
+   comm = A.GetComm();
+
+   HYPRE_Int *cmap;
+   A.GetDiag(diag);
+   A.GetOffd(offd, cmap);
+
+   hypre_ParCSRMatrix *csrA = A;
+   hypre_ParCSRCommPkg *comm_pkg = hypre_ParCSRMatrixCommPkg(csrA);
+   if (!comm_pkg)
+   {
+      hypre_MatvecCommPkgCreate(csrA);
+      comm_pkg = hypre_ParCSRMatrixCommPkg(csrA);
+   }
+
+   int num_sends = hypre_ParCSRCommPkgNumSends(comm_pkg);
+   HYPRE_Int *send_map_starts = hypre_ParCSRCommPkgSendMapStarts(comm_pkg);
+   HYPRE_Int *send_map_elmts = hypre_ParCSRCommPkgSendMapElmts(comm_pkg);
+   send_ranks.SetSize(num_sends);
+   send_offsets.SetSize(num_sends+1);
+   for (int k = 0; k <= num_sends; k++)
+   {
+      if (k < num_sends)
+      {
+         send_ranks[k] = hypre_ParCSRCommPkgSendProc(comm_pkg, k);
+      }
+      send_offsets[k] = send_map_starts[k];
+   }
+   send_rows.SetSize(send_offsets[num_sends]);
+   for (int i = 0; i < send_rows.Size(); i++)
+   {
+      send_rows[i] = send_map_elmts[i];
+   }
+
+   int num_recvs = hypre_ParCSRCommPkgNumRecvs(comm_pkg);
+   HYPRE_Int *recv_vec_starts = hypre_ParCSRCommPkgRecvVecStarts(comm_pkg);
+   recv_ranks.SetSize(num_recvs);
+   recv_offsets.SetSize(num_recvs+1);
+   for (int k = 0; k <= num_recvs; k++)
+   {
+      if (k < num_recvs)
+      {
+         recv_ranks[k] = hypre_ParCSRCommPkgRecvProc(comm_pkg, k);
+      }
+      recv_offsets[k] = recv_vec_starts[k];
+   }
+   MFEM_VERIFY(recv_offsets[num_recvs] == offd.Width(),
+               "inconsistent communication package");
+}
+
+void ParMatVecPlan::CreateRequests()
+{
+   const int tag = 46;
+   int num_sends = send_ranks.Size(), num_recvs = recv_ranks.Size();
+
+   send_buf.SetSize(send_offsets[num_sends]);
+   recv_buf.SetSize(recv_offsets[num_recvs]);
+
+   // Mult(): receive the off-diagonal columns of x, send the local entries
+   requests.SetSize(num_recvs + num_sends);
+   for (int k = 0; k < num_recvs; k++)
+   {
+      MPI_Recv_init(recv_buf.GetData() + recv_offsets[k],
+                    recv_offsets[k+1] - recv_offsets[k], MPI_DOUBLE,
+                    recv_ranks[k], tag, comm, &requests[k]);
+   }
+   for (int k = 0; k < num_sends; k++)
+   {
+      MPI_Send_init(send_buf.GetData() + send_offsets[k],
+                    send_offsets[k+1] - send_offsets[k], MPI_DOUBLE,
+                    send_ranks[k], tag, comm, &requests[num_recvs+k]);
+   }
+
+   // MultTranspose(): the same messages in the reverse direction
+   t_requests.SetSize(num_sends + num_recvs);
+   for (int k = 0; k < num_sends; k++)
+   {
+      MPI_Recv_init(send_buf.GetData() + send_offsets[k],
+                    send_offsets[k+1] - send_offsets[k], MPI_DOUBLE,
+                    send_ranks[k], tag, comm, &t_requests[k]);
+   }
+   for (int k = 0; k < num_recvs; k++)
+   {
+      MPI_Send_init(recv_buf.GetData() + recv_offsets[k],
+                    recv_offsets[k+1] - recv_offsets[k], MPI_DOUBLE,
+                    recv_ranks[k], tag, comm, &t_requests[num_sends+k]);
+   }
+}
+
+void ParMatVecPlan::Mult(double a, const Vector &x, double b, Vector &y) const
+{
+   MFEM_ASSERT(x.Size() == width && y.Size() == height,
+               "invalid vector sizes");
+
+   int num_sends = send_ranks.Size(), num_recvs = recv_ranks.Size();
+
+   if (num_recvs > 0) { MPI_Startall(num_recvs, requests.GetData()); }
+   for (int i = 0; i < send_rows.Size(); i++)
+   {
+      send_buf(i) = x(send_rows[i]);
+   }
+   if (num_sends > 0)
+   {
+      MPI_Startall(num_sends, requests.GetData() + num_recvs);
+   }
+
+   if (b == 0.0) { y = 0.0; }
+   else if (b != 1.0) { y *= b; }
+   diag.AddMult(x, y, a);
+
+   if (num_recvs > 0)
+   {
+      MPI_Waitall(num_recvs, requests.GetData(), MPI_STATUSES_IGNORE);
+      offd.AddMult(recv_buf, y, a);
+   }
+   if (num_sends > 0)
+   {
+      MPI_Waitall(num_sends, requests.GetData() + num_recvs,
+                  MPI_STATUSES_IGNORE);
+   }
+}
+
+void ParMatVecPlan::MultTranspose(double a, const Vector &x, double b,
+                                  Vector &y) const
+{
+   MFEM_ASSERT(x.Size() == height && y.Size() == width,
+               "invalid vector sizes");
+
+   int num_sends = send_ranks.Size(), num_recvs = recv_ranks.Size();
+
+   if (num_sends > 0) { MPI_Startall(num_sends, t_requests.GetData()); }
+   if (num_recvs > 0)
+   {
+      offd.MultTranspose(x, recv_buf);
+      MPI_Startall(num_recvs, t_requests.GetData() + num_sends);
+   }
+
+   if (b == 0.0) { y = 0.0; }
+   else if (b != 1.0) { y *= b; }
+   diag.AddMultTranspose(x, y, a);
+
+   if (num_sends > 0)
+   {
+      MPI_Waitall(num_sends, t_requests.GetData(), MPI_STATUSES_IGNORE);
+      for (int i = 0; i < send_rows.Size(); i++)
+      {
+         y(send_rows[i]) += a * send_buf(i);
+      }
+   }
+   if (num_recvs > 0)
+   {
+      MPI_Waitall(num_recvs, t_requests.GetData() + num_sends,
+                  MPI_STATUSES_IGNORE);
+   }
+}
+
+long ParMatVecPlan::MemoryUsage() const
+{
+   return send_ranks.MemoryUsage() + send_offsets.MemoryUsage() +
+          send_rows.MemoryUsage() + recv_ranks.MemoryUsage() +
+          recv_offsets.MemoryUsage() + send_buf.MemoryUsage() +
+          recv_buf.MemoryUsage() + requests.MemoryUsage() +
+          t_requests.MemoryUsage();
+}
+
+ParMatVecPlan::~ParMatVecPlan()
+{
+   for (int i = 0; i < requests.Size(); i++)
+   {
+      MPI_Request_free(&requests[i]);
+   }
+   for (int i = 0; i < t_requests.Size(); i++)
+   {
+      MPI_Request_free(&t_requests[i]);
+   }
+}
+
+BlockParMatVecPlan::BlockParMatVecPlan(const Array2D<HypreParMatrix *> &A)
+{
+   int nr = A.NumRows(), nc = A.NumCols();
+
+   row_offsets.SetSize(nr+1);
+   col_offsets.SetSize(nc+1);
+   row_offsets = -1;
+   col_offsets = -1;
+   blocks.SetSize(nr, nc);
+   comm = MPI_COMM_NULL;
+   for (int i = 0; i < nr; i++)
+   {
+      for (int j = 0; j < nc; j++)
+      {
+         blocks(i,j) = NULL;
+         if (!A(i,j)) { continue; }
+
+         MFEM_VERIFY((row_offsets[i+1] < 0 ||
+                      row_offsets[i+1] == A(i,j)->Height()) &&
+                     (col_offsets[j+1] < 0 ||
+                      col_offsets[j+1] == A(i,j)->Width()),
+                     "incompatible sizes of the block (" << i << "," << j
+                     << ")");
+         row_offsets[i+1] = A(i,j)->Height();
+         col_offsets[j+1] = A(i,j)->Width();
+         comm = A(i,j)->GetComm();
+
+         blocks(i,j) = new ParMatVecPlan;
+         blocks(i,j)->Init(*A(i,j));
+      }
+   }
+   row_offsets[0] = col_offsets[0] = 0;
+   MFEM_VERIFY(row_offsets.Min() >= 0 && col_offsets.Min() >= 0,
+               "every block row and column needs a nonzero block");
+   row_offsets.PartialSum();
+   col_offsets.PartialSum();
+   height = row_offsets.Last();
+   width = col_offsets.Last();
+
+   // merge the lists of the blocks by neighbor, the blocks in row-major order
+   Array<int> ranks;
+   for (int i = 0; i < nr; i++)
+   {
+      for (int j = 0; j < nc; j++)
+      {
+         if (blocks(i,j)) { ranks.Append(blocks(i,j)->send_ranks); }
+      }
+   }
+   ranks.Sort();
+   ranks.Unique();
+   send_offsets.Append(0);
+   for (int r = 0; r < ranks.Size(); r++)
+   {
+      for (int i = 0; i < nr; i++)
+      {
+         for (int j = 0; j < nc; j++)
+         {
+            ParMatVecPlan *b = blocks(i,j);
+            int k = b ? b->send_ranks.Find(ranks[r]) : -1;
+            if (k < 0) { continue; }
+            for (int m = b->send_offsets[k]; m < b->send_offsets[k+1]; m++)
+            {
+               send_rows.Append(col_offsets[j] + b->send_rows[m]);
+            }
+         }
+      }
+      send_ranks.Append(ranks[r]);
+      send_offsets.Append(send_rows.Size());
+   }
+
+   ranks.SetSize(0);
+   recv_map_offsets.SetSize(nr, nc);
+   int num_ext = 0;
+   for (int i = 0; i < nr; i++)
+   {
+      for (int j = 0; j < nc; j++)
+      {
+         recv_map_offsets(i,j) = num_ext;
+         if (!blocks(i,j)) { continue; }
+         ranks.Append(blocks(i,j)->recv_ranks);
+         num_ext += blocks(i,j)->offd.Width();
+         blocks(i,j)->recv_buf.SetSize(blocks(i,j)->offd.Width());
+      }
+   }
+   ranks.Sort();
+   ranks.Unique();
+   recv_map.SetSize(num_ext);
+   recv_offsets.Append(0);
+   int pos = 0;
+   for (int r = 0; r < ranks.Size(); r++)
+   {
+      for (int i = 0; i < nr; i++)
+      {
+         for (int j = 0; j < nc; j++)
+         {
+            ParMatVecPlan *b = blocks(i,j);
+            int k = b ? b->recv_ranks.Find(ranks[r]) : -1;
+            if (k < 0) { continue; }
+            for (int p = b->recv_offsets[k]; p < b->recv_offsets[k+1]; p++)
+            {
+               recv_map[recv_map_offsets(i,j) + p] = pos++;
+            }
+         }
+      }
+      recv_ranks.Append(ranks[r]);
+      recv_offsets.Append(pos);
+   }
+
+   CreateRequests();
+}
+
+void BlockParMatVecPlan::MultBegin(const Vector &x) const
+{
+   MFEM_ASSERT(x.Size() == width, "invalid vector size");
+
+   int num_sends = send_ranks.Size(), num_recvs = recv_ranks.Size();
+
+   if (num_recvs > 0) { MPI_Startall(num_recvs, requests.GetData()); }
+   for (int i = 0; i < send_rows.Size(); i++)
+   {
+      send_buf(i) = x(send_rows[i]);
+   }
+   if (num_sends > 0)
+   {
+      MPI_Startall(num_sends, requests.GetData() + num_recvs);
+   }
+}
+
+void BlockParMatVecPlan::MultEnd(const Vector &x, Vector &y) const
+{
+   MFEM_ASSERT(x.Size() == width && y.Size() == height,
+               "invalid vector sizes");
+
+   int num_sends = send_ranks.Size(), num_recvs = recv_ranks.Size();
+   Vector xj, yi;
+
+   y = 0.0;
+   for (int i = 0; i < blocks.NumRows(); i++)
+   {
+      for (int j = 0; j < blocks.NumCols(); j++)
+      {
+         if (!blocks(i,j)) { continue; }
+         xj.SetDataAndSize(x.GetData() + col_offsets[j],
+                           col_offsets[j+1] - col_offsets[j]);
+         yi.SetDataAndSize(y.GetData() + row_offsets[i],
+                           row_offsets[i+1] - row_offsets[i]);
+         blocks(i,j)->diag.AddMult(xj, yi);
+      }
+   }
+
+   if (num_recvs > 0)
+   {
+      MPI_Waitall(num_recvs, requests.GetData(), MPI_STATUSES_IGNORE);
+   }
+   for (int i = 0; i < blocks.NumRows(); i++)
+   {
+      for (int j = 0; j < blocks.NumCols(); j++)
+      {
+         ParMatVecPlan *b = blocks(i,j);
+         if (!b || b->recv_buf.Size() == 0) { continue; }
+         const int *map = recv_map.GetData() + recv_map_offsets(i,j);
+         for (int p = 0; p < b->recv_buf.Size(); p++)
+         {
+            b->recv_buf(p) = recv_buf(map[p]);
+         }
+         yi.SetDataAndSize(y.GetData() + row_offsets[i],
+                           row_offsets[i+1] - row_offsets[i]);
+         b->offd.AddMult(b->recv_buf, yi);
+      }
+   }
+   if (num_sends > 0)
+   {
+      MPI_Waitall(num_sends, requests.GetData() + num_recvs,
+                  MPI_STATUSES_IGNORE);
+   }
+}
+
+void BlockParMatVecPlan::MultTransposeBegin(const Vector &x) const
+{
+   MFEM_ASSERT(x.Size() == height, "invalid vector size");
+
+   int num_sends = send_ranks.Size(), num_recvs = recv_ranks.Size();
+   Vector xi;
+
+   if (num_sends > 0) { MPI_Startall(num_sends, t_requests.GetData()); }
+   for (int i = 0; i < blocks.NumRows(); i++)
+   {
+      for (int j = 0; j < blocks.NumCols(); j++)
+      {
+         ParMatVecPlan *b = blocks(i,j);
+         if (!b || b->recv_buf.Size() == 0) { continue; }
+         xi.SetDataAndSize(x.GetData() + row_offsets[i],
+                           row_offsets[i+1] - row_offsets[i]);
+         b->offd.MultTranspose(xi, b->recv_buf);
+         const int *map = recv_map.GetData() + recv_map_offsets(i,j);
+         for (int p = 0; p < b->recv_buf.Size(); p++)
+         {
+            recv_buf(map[p]) = b->recv_buf(p);
+         }
+      }
+   }
+   if (num_recvs > 0)
+   {
+      MPI_Startall(num_recvs, t_requests.GetData() + num_sends);
+   }
+}
+
+void BlockParMatVecPlan::MultTransposeEnd(const Vector &x, Vector &y) const
+{
+   MFEM_ASSERT(x.Size() == height && y.Size() == width,
+               "invalid vector sizes");
+
+   int num_sends = send_ranks.Size(), num_recvs = recv_ranks.Size();
+   Vector xi, yj;
+
+   y = 0.0;
+   for (int i = 0; i < blocks.NumRows(); i++)
+   {
+      for (int j = 0; j < blocks.NumCols(); j++)
+      {
+         if (!blocks(i,j)) { continue; }
+         xi.SetDataAndSize(x.GetData() + row_offsets[i],
+                           row_offsets[i+1] - row_offsets[i]);
+         yj.SetDataAndSize(y.GetData() + col_offsets[j],
+                           col_offsets[j+1] - col_offsets[j]);
+         blocks(i,j)->diag.AddMultTranspose(xi, yj);
+      }
+   }
+
+   if (num_sends > 0)
+   {
+      MPI_Waitall(num_sends, t_requests.GetData(), MPI_STATUSES_IGNORE);
+      for (int i = 0; i < send_rows.Size(); i++)
+      {
+         y(send_rows[i]) += send_buf(i);
+      }
+   }
+   if (num_recvs > 0)
+   {
+      MPI_Waitall(num_recvs, t_requests.GetData() + num_sends,
+                  MPI_STATUSES_IGNORE);
+   }
+}
+
+long BlockParMatVecPlan::MemoryUsage() const
+{
+   long mem = ParMatVecPlan::MemoryUsage() + row_offsets.MemoryUsage() +
+              col_offsets.MemoryUsage() + recv_map.MemoryUsage() +
+              recv_map_offsets.NumRows()*recv_map_offsets.NumCols()*sizeof(int);
+   for (int i = 0; i < blocks.NumRows(); i++)
+   {
+      for (int j = 0; j < blocks.NumCols(); j++)
+      {
+         if (blocks(i,j)) { mem += blocks(i,j)->MemoryUsage(); }
+      }
+   }
+   return mem;
+}
+
+BlockParMatVecPlan::~BlockParMatVecPlan()
+{
+   for (int i = 0; i < blocks.NumRows(); i++)
+   {
+      for (int j = 0; j < blocks.NumCols(); j++)
+      {
+         delete blocks(i,j);
+      }
+   }
+}
+
 // Taubin or "lambda-mu" scheme, which alternates between positive and
 // negative step sizes to approximate low-pass filter effect.
 
@@ -2088,6 +2655,7 @@ void HypreSolver::Mult(const HypreParVector &b, HypreParVector &x) const
    }
    if (!setup_called)
    {
+      ProfileScope scope("hypre setup");
       SetupFcn()(*this, *A, b, x);
       setup_called = 1;
    }
@@ -2425,12 +2993,19 @@ HypreParaSails::~HypreParaSails()
 
 HypreBoomerAMG::HypreBoomerAMG()
 {
+   max_reuse = num_reuse = 0;
+   setup_size = setup_first_row = 0;
+   setup_height = 0;
+   setup_row_starts = setup_col_starts = NULL;
    HYPRE_BoomerAMGCreate(&amg_precond);
    SetDefaultOptions();
 }
 
 HypreBoomerAMG::HypreBoomerAMG(HypreParMatrix &A) : HypreSolver(&A)
 {
+   max_reuse = num_reuse = 0;
+   setup_row_starts = setup_col_starts = NULL;
+   ResetSetupInfo(A);
    HYPRE_BoomerAMGCreate(&amg_precond);
    SetDefaultOptions();
 }
@@ -2546,7 +3121,22 @@ void HypreBoomerAMG::SetOperator(const Operator &op)
    const HypreParMatrix *new_A = dynamic_cast<const HypreParMatrix *>(&op);
    MFEM_VERIFY(new_A, "new Operator must be a HypreParMatrix!");
 
+   if (A && CanReuseSetup(*new_A))
+   {
+      // keep the hierarchy, hypre's solve uses the new fine level matrix
+      KeepSetupStarts();
+      num_reuse++;
+      profiler.Count("BoomerAMG setup reuse");
+      A = const_cast<HypreParMatrix *>(new_A);
+      delete X;
+      delete B;
+      B = X = NULL;
+      return;
+   }
+
    if (A) { ResetAMGPrecond(); }
+   num_reuse = 0;
+   ResetSetupInfo(*new_A);
 
    // update base classes: Operator, Solver, HypreSolver
    height = new_A->Height();
@@ -2558,6 +3148,108 @@ void HypreBoomerAMG::SetOperator(const Operator &op)
    B = X = NULL;
 }
 
+void HypreBoomerAMG::ResetSetupInfo(const HypreParMatrix &setup_A)
+{
+   setup_size = setup_A.GetGlobalNumRows();
+   setup_first_row = hypre_ParCSRMatrixFirstRowIndex((hypre_ParCSRMatrix*)setup_A);
+   setup_height = setup_A.Height();
+   hypre_TFree(setup_row_starts);
+   hypre_TFree(setup_col_starts);
+   setup_row_starts = setup_col_starts = NULL;
+}
+
+void HypreBoomerAMG::KeepSetupStarts()
+{
+   // After a reuse the current operator is not the one of the setup, and the
+   // arrays of the operator of the setup were already taken over before.
+   if (!setup_called || num_reuse > 0) { return; }
+
+   // The first interpolation matrix and the fine level work vectors of the
+   // hierarchy share the column and row partitioning arrays of the operator.
+   hypre_ParCSRMatrix *setup_A = *A;
+   if (hypre_ParCSRMatrixOwnsRowStarts(setup_A))
+   {
+      setup_row_starts = hypre_ParCSRMatrixRowStarts(setup_A);
+      hypre_ParCSRMatrixOwnsRowStarts(setup_A) = 0;
+   }
+   if (hypre_ParCSRMatrixOwnsColStarts(setup_A))
+   {
+      if (hypre_ParCSRMatrixColStarts(setup_A) !=
+          hypre_ParCSRMatrixRowStarts(setup_A))
+      {
+         setup_col_starts = hypre_ParCSRMatrixColStarts(setup_A);
+      }
+      else
+      {
+         setup_row_starts = hypre_ParCSRMatrixColStarts(setup_A);
+      }
+      hypre_ParCSRMatrixOwnsColStarts(setup_A) = 0;
+   }
+}
+
+bool HypreBoomerAMG::CanReuseSetup(const HypreParMatrix &new_A) const
+{
+   // The old matrix is not accessed here, it may have been deleted already.
+   // The partitionings are compared by their contents on every processor:
+   // the partitioning arrays of the matrices may be different copies, and
+   // the array of a deleted matrix may have been reallocated for new_A. The
+   // remaining fine level data of the hierarchy, like the l1 norms of the
+   // smoother, is owned by hypre and computed from the old matrix values.
+   // The rigid body modes are tied to the hypre object which computed them.
+   hypre_ParCSRMatrix *new_hA = new_A;
+   int reuse = (setup_called && num_reuse < max_reuse && rbms.Size() == 0 &&
+                new_A.Height() == setup_height &&
+                new_A.GetGlobalNumRows() == setup_size &&
+                hypre_ParCSRMatrixFirstRowIndex(new_hA) == setup_first_row);
+   int all_reuse;
+   MPI_Allreduce(&reuse, &all_reuse, 1, MPI_INT, MPI_MIN, new_A.GetComm());
+   return all_reuse;
+}
+
+void HypreBoomerAMG::TakeSetup(HypreBoomerAMG &other)
+{
+   MFEM_VERIFY(A, "the operator must be set before TakeSetup()");
+
+   if (rbms.Size() > 0 || !other.CanReuseSetup(*A)) { return; }
+
+   other.KeepSetupStarts();
+
+   // swap the hypre objects: other keeps the one without a setup
+   HYPRE_Solver tmp = amg_precond;
+   amg_precond = other.amg_precond;
+   other.amg_precond = tmp;
+
+   setup_called = 1;
+   num_reuse = other.num_reuse + 1;
+   setup_size = other.setup_size;
+   setup_first_row = other.setup_first_row;
+   setup_height = other.setup_height;
+   Swap(setup_row_starts, other.setup_row_starts);
+   Swap(setup_col_starts, other.setup_col_starts);
+   other.setup_called = 0;
+   other.num_reuse = 0;
+   profiler.Count("BoomerAMG setup reuse");
+}
+
+long HypreBoomerAMG::MemoryUsage() const
+{
+   if (!setup_called) { return 0; }
+
+   hypre_ParAMGData *amg_data = (hypre_ParAMGData *)amg_precond;
+   int num_levels = hypre_ParAMGDataNumLevels(amg_data);
+   hypre_ParCSRMatrix **A_array = hypre_ParAMGDataAArray(amg_data);
+   hypre_ParCSRMatrix **P_array = hypre_ParAMGDataPArray(amg_data);
+
+   // the matrix of level 0 is the operator, not owned by the hierarchy
+   long mem = 0;
+   for (int l = 0; l < num_levels; l++)
+   {
+      if (l > 0 && A_array) { mem += ParCSRMemoryUsage(A_array[l]); }
+      if (l < num_levels-1 && P_array) { mem += ParCSRMemoryUsage(P_array[l]); }
+   }
+   return mem;
+}
+
 void HypreBoomerAMG::SetSystemsOptions(int dim)
 {
    HYPRE_BoomerAMGSetNumFunctions(amg_precond, dim);
@@ -2684,6 +3376,8 @@ HypreBoomerAMG::~HypreBoomerAMG()
    }
 
    HYPRE_BoomerAMGDestroy(amg_precond);
+   hypre_TFree(setup_row_starts);
+   hypre_TFree(setup_col_starts);
 }
 
 
@@ -3131,6 +3825,261 @@ void HypreADS::SetPrintLevel(int print_lvl)
    HYPRE_ADSSetPrintLevel(ads, print_lvl);
 }
 
+// Local rows of A without nonzero off-diagonal entries, i.e. the rows of the
+// essential dofs after elimination.
+static void GetEliminatedRows(hypre_ParCSRMatrix *A, Array<int> &rows)
+{
+   hypre_CSRMatrix *diag = hypre_ParCSRMatrixDiag(A);
+   hypre_CSRMatrix *offd = hypre_ParCSRMatrixOffd(A);
+   HYPRE_Int *diag_I = hypre_CSRMatrixI(diag), *diag_J = hypre_CSRMatrixJ(diag);
+   HYPRE_Int *offd_I = hypre_CSRMatrixI(offd);
+   double *diag_data = hypre_CSRMatrixData(diag);
+   double *offd_data = hypre_CSRMatrixData(offd);
+   bool has_offd = hypre_CSRMatrixNumNonzeros(offd) > 0;
+
+   rows.SetSize(0);
+   for (int i = 0; i < hypre_CSRMatrixNumRows(diag); i++)
+   {
+      bool eliminated = true;
+      for (int j = diag_I[i]; j < diag_I[i+1] && eliminated; j++)
+      {
+         if (diag_J[j] != i && diag_data[j] != 0.0) { eliminated = false; }
+      }
+      for (int j = offd_I[i]; has_offd && j < offd_I[i+1] && eliminated; j++)
+      {
+         if (offd_data[j] != 0.0) { eliminated = false; }
+      }
+      if (eliminated) { rows.Append(i); }
+   }
+}
+
+// Set the given local rows of P to zero.
+static void ZeroRows(hypre_ParCSRMatrix *P, const Array<int> &rows)
+{
+   hypre_CSRMatrix *blocks[2] = { hypre_ParCSRMatrixDiag(P),
+                                  hypre_ParCSRMatrixOffd(P)
+                                };
+   for (int b = 0; b < 2; b++)
+   {
+      if (hypre_CSRMatrixNumNonzeros(blocks[b]) == 0) { continue; }
+      HYPRE_Int *I = hypre_CSRMatrixI(blocks[b]);
+      double *data = hypre_CSRMatrixData(blocks[b]);
+      for (int k = 0; k < rows.Size(); k++)
+      {
+         for (int j = I[rows[k]]; j < I[rows[k]+1]; j++) { data[j] = 0.0; }
+      }
+   }
+}
+
+// Put a unit diagonal entry in the zero local rows of the square matrix A, so
+// that it can be given to BoomerAMG.
+static void FixZeroRows(hypre_ParCSRMatrix *A)
+{
+   hypre_CSRMatrix *diag = hypre_ParCSRMatrixDiag(A);
+   hypre_CSRMatrix *offd = hypre_ParCSRMatrixOffd(A);
+   HYPRE_Int *diag_I = hypre_CSRMatrixI(diag), *diag_J = hypre_CSRMatrixJ(diag);
+   HYPRE_Int *offd_I = hypre_CSRMatrixI(offd);
+   double *diag_data = hypre_CSRMatrixData(diag);
+   double *offd_data = hypre_CSRMatrixData(offd);
+   bool has_offd = hypre_CSRMatrixNumNonzeros(offd) > 0;
+
+   for (int i = 0; i < hypre_CSRMatrixNumRows(diag); i++)
+   {
+      double l1 = 0.0;
+      for (int j = diag_I[i]; j < diag_I[i+1]; j++)
+      {
+         l1 += fabs(diag_data[j]);
+      }
+      for (int j = offd_I[i]; has_offd && j < offd_I[i+1]; j++)
+      {
+         l1 += fabs(offd_data[j]);
+      }
+      if (l1 != 0.0) { continue; }
+
+      int j = diag_I[i];
+      while (j < diag_I[i+1] && diag_J[j] != i) { j++; }
+      MFEM_VERIFY(j < diag_I[i+1], "missing diagonal entry in row " << i);
+      diag_data[j] = 1.0;
+   }
+}
+
+HypreAuxiliarySpace4D::HypreAuxiliarySpace4D(HypreParMatrix &_A,
+                                             ParFiniteElementSpace *fespace,
+                                             bool singular)
+   : Solver(_A.Height()),
+     A(&_A),
+     K(NULL),
+     A_K(NULL),
+     K_solver(NULL)
+{
+   ParMesh *pmesh = fespace->GetParMesh();
+   MFEM_VERIFY(pmesh->Dimension() == 4, "HypreAuxiliarySpace4D requires a 4D "
+               "mesh");
+
+   // the kernel space, the discrete derivative which maps it into fespace and
+   // the number of components of the auxiliary nodal space
+   const char *name = fespace->FEColl()->Name();
+   FiniteElementCollection *ker_fec;
+   DiscreteInterpolator *ker_interp;
+   int vdim;
+   if (!strcmp(name, "ND1_4D"))
+   {
+      ker_fec = new LinearFECollection;
+      ker_interp = new GradientInterpolator;
+      vdim = 4;
+   }
+   else if (!strcmp(name, "F2K0_4D"))
+   {
+      ker_fec = new ND1_4DFECollection;
+      ker_interp = new CurlInterpolator;
+      vdim = 6;
+   }
+   else if (!strcmp(name, "RT0_4D"))
+   {
+      ker_fec = new DivSkew1_4DFECollection;
+      ker_interp = new DivSkewInterpolator;
+      vdim = 4;
+   }
+   else
+   {
+      MFEM_ABORT("HypreAuxiliarySpace4D: unsupported finite element collection "
+                 << name);
+      return;
+   }
+
+   Array<int> ess_rows;
+   GetEliminatedRows(*A, ess_rows);
+
+   smoother = new HypreSmoother(*A, HypreSmoother::l1GS);
+
+   // generate the discrete derivative and the solver in the kernel space
+   if (!singular)
+   {
+      ParFiniteElementSpace *ker_fespace = new ParFiniteElementSpace(pmesh,
+                                                                     ker_fec);
+      ParDiscreteLinearOperator *deriv;
+      deriv = new ParDiscreteLinearOperator(ker_fespace, fespace);
+      deriv->AddDomainInterpolator(ker_interp);
+      deriv->Assemble();
+      deriv->Finalize();
+      K = deriv->ParallelAssemble();
+      K->CopyColStarts(); // since we'll delete ker_fespace
+      delete deriv;
+
+      ZeroRows(*K, ess_rows);
+      A_K = RAP(A, K);
+      FixZeroRows(*A_K);
+
+      if (!strcmp(name, "ND1_4D"))
+      {
+         HypreBoomerAMG *amg = new HypreBoomerAMG(*A_K);
+         amg->SetPrintLevel(0);
+         K_solver = amg;
+      }
+      else
+      {
+         // the kernel matrix has no mass term
+         K_solver = new HypreAuxiliarySpace4D(*A_K, ker_fespace, true);
+      }
+      delete ker_fespace;
+   }
+   else
+   {
+      delete ker_interp;
+   }
+   delete ker_fec;
+
+   // generate the components of the nodal interpolation and their solvers
+   FiniteElementCollection *vert_fec = new LinearFECollection;
+   ParFiniteElementSpace *vert_fespace_d
+      = new ParFiniteElementSpace(pmesh, vert_fec, vdim, Ordering::byVDIM);
+
+   ParDiscreteLinearOperator *id;
+   id = new ParDiscreteLinearOperator(vert_fespace_d, fespace);
+   id->AddDomainInterpolator(new IdentityInterpolator);
+   id->Assemble();
+   id->Finalize();
+
+   Array2D<HypreParMatrix *> Pi_blocks;
+   id->GetParBlocks(Pi_blocks);
+   delete id;
+   delete vert_fespace_d;
+   delete vert_fec;
+
+   Pi.SetSize(vdim);
+   A_Pi.SetSize(vdim);
+   Pi_solvers.SetSize(vdim);
+   for (int k = 0; k < vdim; k++)
+   {
+      Pi[k] = Pi_blocks(0, k);
+      ZeroRows(*Pi[k], ess_rows);
+      A_Pi[k] = RAP(A, Pi[k]);
+      FixZeroRows(*A_Pi[k]);
+      Pi_solvers[k] = new HypreBoomerAMG(*A_Pi[k]);
+      Pi_solvers[k]->SetPrintLevel(0);
+   }
+}
+
+void HypreAuxiliarySpace4D::Correct(const HypreParMatrix &P, const Solver &B,
+                                    const Vector &b, Vector &x) const
+{
+   r = b;
+   A->Mult(-1.0, x, 1.0, r);
+
+   r_aux.SetSize(P.Width());
+   z_aux.SetSize(P.Width());
+   P.MultTranspose(r, r_aux);
+   B.Mult(r_aux, z_aux);
+   P.Mult(1.0, z_aux, 1.0, x);
+}
+
+void HypreAuxiliarySpace4D::Mult(const Vector &b, Vector &x) const
+{
+   r.SetSize(height);
+   z.SetSize(height);
+
+   // pre-smoothing and kernel correction
+   smoother->Mult(b, x);
+   if (K) { Correct(*K, *K_solver, b, x); }
+
+   // additive correction in the components of the auxiliary nodal space
+   r = b;
+   A->Mult(-1.0, x, 1.0, r);
+   z = 0.0;
+   for (int k = 0; k < Pi.Size(); k++)
+   {
+      r_aux.SetSize(Pi[k]->Width());
+      z_aux.SetSize(Pi[k]->Width());
+      Pi[k]->MultTranspose(r, r_aux);
+      Pi_solvers[k]->Mult(r_aux, z_aux);
+      Pi[k]->Mult(1.0, z_aux, 1.0, z);
+   }
+   x += z;
+
+   // kernel correction and post-smoothing, in reverse order for symmetry
+   if (K) { Correct(*K, *K_solver, b, x); }
+   r = b;
+   A->Mult(-1.0, x, 1.0, r);
+   smoother->Mult(r, z);
+   x += z;
+}
+
+HypreAuxiliarySpace4D::~HypreAuxiliarySpace4D()
+{
+   for (int k = 0; k < Pi.Size(); k++)
+   {
+      delete Pi_solvers[k];
+      delete A_Pi[k];
+      delete Pi[k];
+   }
+
+   delete K_solver;
+   delete A_K;
+   delete K;
+
+   delete smoother;
+}
+
 HypreLOBPCG::HypreMultiVector::HypreMultiVector(int n, HypreParVector & v,
                                                 mv_InterfaceInterpreter & interpreter)
    : hpv(NULL),
@@ -342,6 +342,8 @@ public:
 
    /// Get the local diagonal of the matrix.
    void GetDiag(Vector &diag) const;
+   /// Get the l1 norms of the local rows, including the off-diagonal part.
+   void GetRowL1Norms(Vector &l1) const;
    /// Get the local diagonal block. NOTE: 'diag' will not own any data.
    void GetDiag(SparseMatrix &diag) const;
    /// Get the local off-diagonal block. NOTE: 'offd' will not own any data.
@@ -380,6 +382,11 @@ public:
 
    HYPRE_Int *GetColStarts() const { return hypre_ParCSRMatrixColStarts(A); }
 
+   /** @brief Return the (approximate) memory used by the local part of the
+       matrix, in bytes: the diag and offd blocks, the column map of offd and
+       the communication package. */
+   long MemoryUsage() const;
+
    /// Computes y = alpha * A * x + beta * y
    HYPRE_Int Mult(HypreParVector &x, HypreParVector &y,
                   double alpha = 1.0, double beta = 0.0);
@@ -398,6 +405,14 @@ public:
    virtual void MultTranspose(const Vector &x, Vector &y) const
    { MultTranspose(1.0, x, 0.0, y); }
 
+   /** @brief Computes y_j = alpha * A * x_j + beta * y_j for all vectors with
+       a single pass over the matrix and a single exchange of the off-processor
+       entries, using hypre's multivector support in the matvec. */
+   void Mult(double a, const MultiVector &x, double b, MultiVector &y) const;
+
+   virtual void Mult(const MultiVector &x, MultiVector &y) const
+   { Mult(1.0, x, 0.0, y); }
+
    /** The "Boolean" analog of y = alpha * A * x + beta * y, where elements in
        the sparsity pattern of the matrix are treated as "true". */
    void BooleanMult(int alpha, int *x, int beta, int *y)
@@ -494,6 +509,121 @@ HypreParMatrix * RAP(const HypreParMatrix * Rt, const HypreParMatrix *A, const H
 void EliminateBC(HypreParMatrix &A, HypreParMatrix &Ae,
                  const Array<int> &ess_dof_list, const Vector &X, Vector &B);
 
+/** @brief Products with a HypreParMatrix and its transpose which reuse
+    persistent MPI requests.
+
+    The send and receive lists are taken once from the hypre communication
+    package of the matrix and the messages are exchanged with requests created
+    by MPI_Send_init() and MPI_Recv_init() into buffers owned by the plan, so
+    that repeated products, e.g. the Distribute() and ParallelAssemble() calls
+    with the Dof_TrueDof matrix of a ParFiniteElementSpace, do not set up any
+    communication. The receives are posted before the local (diag) part of the
+    product is computed, so the communication overlaps with it.
+
+    The matrix is not owned; its structure should not change while the plan is
+    used. */
+class ParMatVecPlan : public Operator
+{
+protected:
+   MPI_Comm comm;
+
+   /// Local diagonal and off-diagonal blocks of the matrix
+   SparseMatrix diag, offd;
+
+   /** The neighbors which need entries of x in Mult(), the offsets of their
+       segments in send_rows and the local (diag) columns sent to them. */
+   Array<int> send_ranks, send_offsets, send_rows;
+   /** The neighbors which own the off-diagonal columns of the matrix and the
+       offsets of their segments among the off-diagonal columns. */
+   Array<int> recv_ranks, recv_offsets;
+
+   /// Message buffers: entries of x for send_rows and the off-diagonal columns
+   mutable Vector send_buf, recv_buf;
+
+   /** Persistent requests of Mult() and MultTranspose(): first the receives,
+       then the sends. */
+   mutable Array<MPI_Request> requests, t_requests;
+
+   ParMatVecPlan() { }
+
+   /// Set the local blocks and the lists from the matrix.
+   void Init(const HypreParMatrix &A);
+   /// Create the persistent requests, once the lists above are set.
+   void CreateRequests();
+
+   friend class BlockParMatVecPlan;
+
+public:
+   ParMatVecPlan(const HypreParMatrix &A);
+
+   /// Computes y = a * A * x + b * y
+   void Mult(double a, const Vector &x, double b, Vector &y) const;
+   /// Computes y = a * A^t * x + b * y
+   void MultTranspose(double a, const Vector &x, double b, Vector &y) const;
+
+   virtual void Mult(const Vector &x, Vector &y) const
+   { Mult(1.0, x, 0.0, y); }
+   virtual void MultTranspose(const Vector &x, Vector &y) const
+   { MultTranspose(1.0, x, 0.0, y); }
+
+   /// Number of neighbors exchanging messages with this rank in Mult()
+   int GetNumNeighbors() const { return send_ranks.Size() + recv_ranks.Size(); }
+
+   /// Return the memory used by the lists and buffers of the plan, in bytes.
+   virtual long MemoryUsage() const;
+
+   virtual ~ParMatVecPlan();
+};
+
+/** @brief Products with a block matrix of HypreParMatrix blocks and its
+    transpose, with one message per neighbor for all blocks.
+
+    The lists of the blocks (see ParMatVecPlan) are merged by neighbor rank:
+    the entries of all blocks exchanged with a neighbor are packed into one
+    buffer, in the row-major order of the blocks, and sent with one persistent
+    request. The exchange can be split in two halves, MultBegin() and
+    MultEnd(), so that other work can be done while the messages are in
+    flight. NULL blocks are allowed, but every block row and column must have
+    at least one block. The matrices are not owned. */
+class BlockParMatVecPlan : public ParMatVecPlan
+{
+protected:
+   Array<int> row_offsets, col_offsets;
+
+   /// Local blocks and lists of the nonzero blocks (no requests of their own)
+   Array2D<ParMatVecPlan *> blocks;
+   /** Position in the receive buffer of the off-diagonal columns of the
+       blocks, with recv_map_offsets(i,j) the start of the block (i,j). */
+   Array<int> recv_map;
+   Array2D<int> recv_map_offsets;
+
+public:
+   BlockParMatVecPlan(const Array2D<HypreParMatrix *> &A);
+
+   const Array<int> &RowOffsets() const { return row_offsets; }
+   const Array<int> &ColOffsets() const { return col_offsets; }
+
+   /// Start the exchange of the entries of @a x needed by y = A x.
+   void MultBegin(const Vector &x) const;
+   /** @brief Finish the product y = A x started with MultBegin(); @a x must be
+       the same vector and must not be modified in between. */
+   void MultEnd(const Vector &x, Vector &y) const;
+
+   /// Start the exchange of the contributions of @a x to y = A^t x.
+   void MultTransposeBegin(const Vector &x) const;
+   /// Finish the product y = A^t x started with MultTransposeBegin().
+   void MultTransposeEnd(const Vector &x, Vector &y) const;
+
+   virtual void Mult(const Vector &x, Vector &y) const
+   { MultBegin(x); MultEnd(x, y); }
+   virtual void MultTranspose(const Vector &x, Vector &y) const
+   { MultTransposeBegin(x); MultTransposeEnd(x, y); }
+
+   virtual long MemoryUsage() const;
+
+   virtual ~BlockParMatVecPlan();
+};
+
 
 /// Parallel smoothers in hypre
 class HypreSmoother : public Solver
@@ -786,6 +916,31 @@ private:
    /// Finite element space for elasticity problems, see SetElasticityOptions()
    ParFiniteElementSpace *fespace;
 
+   /// Maximal and current number of reuses of the setup, see SetReuseSetup()
+   int max_reuse, num_reuse;
+
+   /// Global size, first local row and number of local rows of the operator
+   /// of the setup, see CanReuseSetup()
+   HYPRE_Int setup_size, setup_first_row;
+   int setup_height;
+
+   /// Row and column partitioning arrays of the operator of the setup, which
+   /// are referenced by the hierarchy, when they were taken over from that
+   /// operator, see KeepSetupStarts()
+   HYPRE_Int *setup_row_starts, *setup_col_starts;
+
+   /// Record the size and partitioning of @a setup_A, the operator of a new
+   /// setup, and free the partitioning arrays of the previous setup
+   void ResetSetupInfo(const HypreParMatrix &setup_A);
+
+   /** Take over the partitioning arrays of the current operator, if it owns
+       them and is the operator of the setup, so that they stay alive for the
+       hierarchy when the setup is reused for another operator. */
+   void KeepSetupStarts();
+
+   /// Can the current setup be used as a preconditioner for @a new_A?
+   bool CanReuseSetup(const HypreParMatrix &new_A) const;
+
    /// Recompute the rigid-body modes vectors (in the rbms array)
    void RecomputeRBMs();
 
@@ -819,6 +974,38 @@ public:
    void SetPrintLevel(int print_level)
    { HYPRE_BoomerAMGSetPrintLevel(amg_precond, print_level); }
 
+   /** @brief Keep the AMG hierarchy for up to @a max_reuse new operators
+       before doing a full setup again.
+
+       While the setup is reused, SetOperator() and TakeSetup() only replace
+       the fine level matrix: the coarsening, the interpolation, the coarse
+       operators and the smoother data of the previous setup are kept. This is
+       meant for sequences of matrices with the same sparsity and parallel
+       partitioning whose entries change slightly, e.g. the time slabs of a
+       time-stepping scheme or the steps of a Newton method; the number of
+       Krylov iterations may grow with the number of reuses. The new matrix
+       must have the same global size and parallel row partitioning as the
+       matrix of the setup; otherwise a full setup is done. The hierarchy
+       refers to the partitioning arrays of the matrix of the setup: if that
+       matrix owns them, they are taken over by this object, so the previous
+       operator must still exist when SetOperator() or TakeSetup() is called.
+       The default, @a max_reuse = 0, does a full setup for every new
+       operator. */
+   void SetReuseSetup(int max_reuse_) { max_reuse = max_reuse_; }
+
+   /** @brief Take over the setup of @a other, if it can be reused for the
+       operator of this object (see SetReuseSetup()); otherwise nothing is
+       done and the setup is computed at the first Mult(). */
+   void TakeSetup(HypreBoomerAMG &other);
+
+   /// Number of times the current setup has been reused
+   int GetNumReuse() const { return num_reuse; }
+
+   /** @brief Return the (approximate) memory used by the local part of the
+       multigrid hierarchy, in bytes: the coarse level matrices and the
+       interpolation matrices. It is 0 before the setup. */
+   long MemoryUsage() const;
+
    /// The typecast to HYPRE_Solver returns the internal amg_precond
    virtual operator HYPRE_Solver() const { return amg_precond; }
 
@@ -902,6 +1089,72 @@ public:
    virtual ~HypreADS();
 };
 
+/** @brief Auxiliary-space preconditioner for the lowest order 4D H(curl),
+    H(div-skew) and H(div) spaces.
+
+    This is the 4D counterpart of HypreAMS and HypreADS for the spaces of the
+    collections ND1_4DFECollection, DivSkew1_4DFECollection and
+    RT0_4DFECollection. The preconditioner is a symmetric multiplicative cycle
+    of a hypre smoother on the fine space, a correction in the kernel of the
+    differential operator and a correction in the auxiliary space of vector
+    linear H1 functions:
+
+       H(curl):      kernel = grad(H1),          auxiliary space = (H1)^4,
+       H(div-skew):  kernel = curl(H(curl)),     auxiliary space = (H1)^6,
+       H(div):       kernel = divskew(H(div-skew)), auxiliary space = (H1)^4.
+
+    The discrete derivative K and the components Pi_k of the nodal
+    interpolation Pi are assembled with the interpolators of bilininteg.hpp and
+    the auxiliary matrices are the Galerkin products K^t A K and Pi_k^t A Pi_k,
+    so no coefficients have to be given. The nodal components are solved with
+    BoomerAMG. In H(curl) the kernel matrix is also solved with BoomerAMG,
+    while in H(div-skew) and H(div) it is solved by a HypreAuxiliarySpace4D
+    preconditioner for the kernel space in singular mode.
+
+    Rows of A which have been eliminated (no off-diagonal entries, e.g. after
+    EliminateRowsCols) are treated as essential dofs: the corresponding rows of
+    K and Pi are set to zero, so the corrections satisfy the boundary
+    conditions.
+
+    If @a singular is true the kernel correction is skipped; this is the right
+    choice when A has no mass term, e.g. for the curl-curl or div-skew-div-skew
+    operators restricted to the range of the kernel. */
+class HypreAuxiliarySpace4D : public Solver
+{
+private:
+   /// The fine space matrix (not owned)
+   HypreParMatrix *A;
+   /// Smoother on the fine space
+   HypreSmoother *smoother;
+
+   /// Discrete derivative from the kernel space and its Galerkin matrix
+   HypreParMatrix *K, *A_K;
+   /// Solver for A_K: BoomerAMG or HypreAuxiliarySpace4D
+   Solver *K_solver;
+
+   /// Components of the nodal interpolation, their matrices and solvers
+   Array<HypreParMatrix *> Pi, A_Pi;
+   Array<HypreBoomerAMG *> Pi_solvers;
+
+   /// Temporary vectors
+   mutable Vector r, z, r_aux, z_aux;
+
+   /// Add to @a x the correction P B P^t (b - A x).
+   void Correct(const HypreParMatrix &P, const Solver &B,
+                const Vector &b, Vector &x) const;
+
+public:
+   HypreAuxiliarySpace4D(HypreParMatrix &A, ParFiniteElementSpace *fespace,
+                         bool singular = false);
+
+   virtual void Mult(const Vector &b, Vector &x) const;
+
+   virtual void SetOperator(const Operator &op)
+   { mfem_error("HypreAuxiliarySpace4D::SetOperator : not defined!"); }
+
+   virtual ~HypreAuxiliarySpace4D();
+};
+
 /** LOBPCG eigenvalue solver in hypre
 
     The Locally Optimal Block Preconditioned Conjugate Gradient (LOBPCG)
@@ -0,0 +1,146 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+// Implementation of class MultiVector
+
+#include "multivector.hpp"
+
+namespace mfem
+{
+
+MultiVector &MultiVector::operator=(const MultiVector &x)
+{
+   MFEM_ASSERT(size == x.size && num_vectors == x.num_vectors,
+               "incompatible MultiVectors");
+   data = x.data;
+   return *this;
+}
+
+void MultiVector::Add(double a, const MultiVector &x)
+{
+   MFEM_ASSERT(size == x.size && num_vectors == x.num_vectors,
+               "incompatible MultiVectors");
+   data.Add(a, x.data);
+}
+
+void MultiVector::Add(const Vector &a, const MultiVector &x)
+{
+   MFEM_ASSERT(size == x.size && num_vectors == x.num_vectors &&
+               a.Size() == num_vectors, "incompatible sizes");
+   for (int j = 0; j < num_vectors; j++)
+   {
+      const double aj = a(j);
+      if (aj == 0.0) { continue; }
+      double *vp = GetVectorData(j);
+      const double *xp = x.GetVectorData(j);
+      for (int i = 0; i < size; i++)
+      {
+         vp[i] += aj * xp[i];
+      }
+   }
+}
+
+void MultiVector::Set(const Vector &a, const MultiVector &x)
+{
+   MFEM_ASSERT(size == x.size && num_vectors == x.num_vectors &&
+               a.Size() == num_vectors, "incompatible sizes");
+   for (int j = 0; j < num_vectors; j++)
+   {
+      const double aj = a(j);
+      double *vp = GetVectorData(j);
+      const double *xp = x.GetVectorData(j);
+      for (int i = 0; i < size; i++)
+      {
+         vp[i] = aj * xp[i];
+      }
+   }
+}
+
+void MultiVector::Scale(const Vector &s)
+{
+   MFEM_ASSERT(s.Size() == num_vectors, "incompatible sizes");
+   for (int j = 0; j < num_vectors; j++)
+   {
+      const double sj = s(j);
+      double *vp = GetVectorData(j);
+      for (int i = 0; i < size; i++)
+      {
+         vp[i] *= sj;
+      }
+   }
+}
+
+void MultiVector::Dot(const MultiVector &y, Vector &d) const
+{
+   MFEM_ASSERT(size == y.size && num_vectors == y.num_vectors,
+               "incompatible MultiVectors");
+   d.SetSize(num_vectors);
+   for (int j = 0; j < num_vectors; j++)
+   {
+      const double *vp = GetVectorData(j), *yp = y.GetVectorData(j);
+      double dot = 0.0;
+      for (int i = 0; i < size; i++)
+      {
+         dot += vp[i] * yp[i];
+      }
+      d(j) = dot;
+   }
+}
+
+void MultiVector::GetSubVectors(int offset, MultiVector &sub) const
+{
+   MFEM_ASSERT(sub.num_vectors == num_vectors &&
+               offset >= 0 && offset + sub.size <= size, "invalid sub-vectors");
+   for (int j = 0; j < num_vectors; j++)
+   {
+      const double *vp = GetVectorData(j) + offset;
+      double *sp = sub.GetVectorData(j);
+      for (int i = 0; i < sub.size; i++)
+      {
+         sp[i] = vp[i];
+      }
+   }
+}
+
+void MultiVector::AddSubVectors(int offset, double a, const MultiVector &sub)
+{
+   MFEM_ASSERT(sub.num_vectors == num_vectors &&
+               offset >= 0 && offset + sub.size <= size, "invalid sub-vectors");
+   for (int j = 0; j < num_vectors; j++)
+   {
+      double *vp = GetVectorData(j) + offset;
+      const double *sp = sub.GetVectorData(j);
+      for (int i = 0; i < sub.size; i++)
+      {
+         vp[i] += a * sp[i];
+      }
+   }
+}
+
+void MultiVector::Swap(MultiVector &other)
+{
+   mfem::Swap(size, other.size);
+   mfem::Swap(num_vectors, other.num_vectors);
+   data.Swap(other.data);
+}
+
+void MultiVector::Print(std::ostream &out, int width) const
+{
+   Vector v;
+   for (int j = 0; j < num_vectors; j++)
+   {
+      GetVectorReference(j, v);
+      out << "vector " << j << ":\n";
+      v.Print(out, width);
+   }
+}
+
+}
@@ -0,0 +1,121 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#ifndef MFEM_MULTIVECTOR
+#define MFEM_MULTIVECTOR
+
+#include "../config/config.hpp"
+#include "vector.hpp"
+
+namespace mfem
+{
+
+/** @brief A set of vectors of the same size, e.g. several right-hand sides of
+    a linear system.
+
+    The vectors are stored one after the other in a single array, so vector
+    @a j occupies the entries [j*Size(), (j+1)*Size()) and can be accessed as
+    a Vector without copying with GetVectorReference(). The operations which
+    take a Vector of coefficients apply the j-th coefficient to the j-th
+    vector. */
+class MultiVector
+{
+protected:
+   int size, num_vectors;
+   Vector data;
+
+public:
+   /// Create an empty MultiVector.
+   MultiVector() : size(0), num_vectors(0) { }
+
+   /// Create @a nv vectors of size @a s; the entries are not initialized.
+   MultiVector(int s, int nv) : size(s), num_vectors(nv), data(s*nv) { }
+
+   /** @brief Create a MultiVector referencing the array @a _data of size at
+       least @a s * @a nv, owned by someone else. */
+   MultiVector(double *_data, int s, int nv)
+      : size(s), num_vectors(nv), data(_data, s*nv) { }
+
+   /// Copy constructor, allocates new data.
+   MultiVector(const MultiVector &x)
+      : size(x.size), num_vectors(x.num_vectors), data(x.data) { }
+
+   /// Resize to @a nv vectors of size @a s; the entries are not initialized.
+   void SetSize(int s, int nv)
+   { size = s; num_vectors = nv; data.SetSize(s*nv); }
+
+   /// Reference the array @a d, owned by someone else.
+   void SetDataAndSize(double *d, int s, int nv)
+   { size = s; num_vectors = nv; data.NewDataAndSize(d, s*nv); }
+
+   /// Size of each vector.
+   inline int Size() const { return size; }
+
+   /// Number of vectors.
+   inline int NumVectors() const { return num_vectors; }
+
+   inline double *GetData() const { return data.GetData(); }
+
+   /// Pointer to the first entry of vector @a j.
+   inline double *GetVectorData(int j) const
+   { return data.GetData() + j*size; }
+
+   /// Make @a v a reference to vector @a j, without copying the data.
+   void GetVectorReference(int j, Vector &v) const
+   { v.SetDataAndSize(GetVectorData(j), size); }
+
+   /// All entries as one Vector of size Size()*NumVectors().
+   Vector &GetValues() { return data; }
+   const Vector &GetValues() const { return data; }
+
+   MultiVector &operator=(double value) { data = value; return *this; }
+
+   /// Copy @a x; the sizes must match.
+   MultiVector &operator=(const MultiVector &x);
+
+   /// v_j += a * x_j
+   void Add(double a, const MultiVector &x);
+
+   /// v_j += a(j) * x_j; the vectors with a(j) == 0 are not touched.
+   void Add(const Vector &a, const MultiVector &x);
+
+   /// v_j = a(j) * x_j
+   void Set(const Vector &a, const MultiVector &x);
+
+   /// v_j *= s(j)
+   void Scale(const Vector &s);
+
+   /// d(j) = (v_j, y_j), local inner products of the corresponding vectors.
+   void Dot(const MultiVector &y, Vector &d) const;
+
+   /** @brief Copy the entries [offset, offset+sub.Size()) of each vector
+       into @a sub, which must have the same number of vectors. */
+   void GetSubVectors(int offset, MultiVector &sub) const;
+
+   /// Add @a a times @a sub to the entries [offset, offset+sub.Size()).
+   void AddSubVectors(int offset, double a, const MultiVector &sub);
+
+   /// Swap the contents with @a other, without copying the data.
+   void Swap(MultiVector &other);
+
+   /// Print the vectors one after the other.
+   void Print(std::ostream &out = std::cout, int width = 8) const;
+};
+
+/// Specialization of the template function Swap<> for class MultiVector
+template<> inline void Swap<MultiVector>(MultiVector &a, MultiVector &b)
+{
+   a.Swap(b);
+}
+
+}
+
+#endif
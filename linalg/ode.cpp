@@ -15,6 +15,27 @@
 namespace mfem
 {
 
+// y = x + a k and z = w + c k in one pass; the update is pointwise, so x, w, y
+// and z may coincide.
+static void FusedStageUpdate(const Vector &x, const Vector &k, double a,
+                             Vector &y, const Vector &w, double c, Vector &z)
+{
+   const int n = x.Size();
+   MFEM_ASSERT(k.Size() == n && y.Size() == n && w.Size() == n &&
+               z.Size() == n, "incompatible vector sizes");
+   const double *xp = x.GetData(), *kp = k.GetData(), *wp = w.GetData();
+   double *yp = y.GetData(), *zp = z.GetData();
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for
+#endif
+   for (int i = 0; i < n; i++)
+   {
+      const double xi = xp[i], ki = kp[i], wi = wp[i];
+      yp[i] = xi + a*ki;
+      zp[i] = wi + c*ki;
+   }
+}
+
 void ForwardEulerSolver::Init(TimeDependentOperator &_f)
 {
    ODESolver::Init(_f);
@@ -49,8 +70,7 @@ void RK2Solver::Step(Vector &x, double &t, double &dt)
 
    f->SetTime(t);
    f->Mult(x, dxdt);
-   add(x, (1. - b)*dt, dxdt, x1);
-   x.Add(a*dt, dxdt);
+   FusedStageUpdate(x, dxdt, (1. - b)*dt, x1, x, a*dt, x);
 
    f->SetTime(t + a*dt);
    f->Mult(x, dxdt);
@@ -79,14 +99,20 @@ void RK3SSPSolver::Step(Vector &x, double &t, double &dt)
    f->Mult(y, k);
 
    // x2 = 3/4*x + 1/4*(x1 + k1), t2 = t + 1/2*dt, k2 = dt*f(t2, x2)
-   y.Add(dt, k);
-   add(3./4, x, 1./4, y, y);
+   {
+      const double a[2] = { 3./4, dt/4 };
+      const Vector *v[2] = { &x, &k };
+      LinearCombination(2, a, v, 1./4, y);
+   }
    f->SetTime(t + dt/2);
    f->Mult(y, k);
 
    // x3 = 1/3*x + 2/3*(x2 + k2), t3 = t + dt
-   y.Add(dt, k);
-   add(1./3, x, 2./3, y, x);
+   {
+      const double a[2] = { 2./3, 2.*dt/3 };
+      const Vector *v[2] = { &y, &k };
+      LinearCombination(2, a, v, 1./3, x);
+   }
    t += dt;
 }
 
@@ -111,17 +137,14 @@ void RK4Solver::Step(Vector &x, double &t, double &dt)
 
    f->SetTime(t);
    f->Mult(x, k); // k1
-   add(x, dt/2, k, y);
-   add(x, dt/6, k, z);
+   FusedStageUpdate(x, k, dt/2, y, x, dt/6, z);
 
    f->SetTime(t + dt/2);
    f->Mult(y, k); // k2
-   add(x, dt/2, k, y);
-   z.Add(dt/3, k);
+   FusedStageUpdate(x, k, dt/2, y, z, dt/3, z);
 
    f->Mult(y, k); // k3
-   add(x, dt, k, y);
-   z.Add(dt/3, k);
+   FusedStageUpdate(x, k, dt, y, z, dt/3, z);
 
    f->SetTime(t + dt);
    f->Mult(y, k); // k4
@@ -137,6 +160,12 @@ ExplicitRKSolver::ExplicitRKSolver(int _s, const double *_a, const double *_b,
    b = _b;
    c = _c;
    k = new Vector[s];
+   terms = new const Vector*[s+1];
+   coeffs = new double[s+1];
+   for (int i = 0; i < s; i++)
+   {
+      terms[i+1] = &k[i];
+   }
 }
 
 void ExplicitRKSolver::Init(TimeDependentOperator &_f)
@@ -161,27 +190,34 @@ void ExplicitRKSolver::Step(Vector &x, double &t, double &dt)
    //         | b[0] b[1] ... b[s-1]
 
    f->SetTime(t);
+   // The stage vectors y = x + dt*(a[l] k[0] + ... ) and the final update of x
+   // are each computed with one fused LinearCombination of all terms.
+   terms[0] = &x;
+   coeffs[0] = 1.0;
    f->Mult(x, k[0]);
    for (int l = 0, i = 1; i < s; i++)
    {
-      add(x, a[l++]*dt, k[0], y);
-      for (int j = 1; j < i; j++)
+      for (int j = 0; j < i; j++)
       {
-         y.Add(a[l++]*dt, k[j]);
+         coeffs[j+1] = a[l++]*dt;
       }
+      LinearCombination(i+1, coeffs, terms, 0.0, y);
 
       f->SetTime(t + c[i-1]*dt);
       f->Mult(y, k[i]);
    }
    for (int i = 0; i < s; i++)
    {
-      x.Add(b[i]*dt, k[i]);
+      coeffs[i+1] = b[i]*dt;
    }
+   LinearCombination(s, coeffs + 1, terms + 1, 1.0, x);
    t += dt;
 }
 
 ExplicitRKSolver::~ExplicitRKSolver()
 {
+   delete [] coeffs;
+   delete [] terms;
    delete [] k;
 }
 
@@ -405,8 +441,8 @@ void SDIRK23Solver::Step(Vector &x, double &t, double &dt)
    // note: with gamma_opt=3, both solve are outside [t,t+dt] since a>1
    f->SetTime(t + gamma*dt);
    f->ImplicitSolve(gamma*dt, x, k);
-   add(x, (1.-2.*gamma)*dt, k, y); // y = x + (1-2*gamma)*dt*k
-   x.Add(dt/2, k);
+   // y = x + (1-2*gamma)*dt*k, x = x + dt/2*k
+   FusedStageUpdate(x, k, (1.-2.*gamma)*dt, y, x, dt/2, x);
 
    f->SetTime(t + (1.-gamma)*dt);
    f->ImplicitSolve(gamma*dt, y, k);
@@ -436,14 +472,12 @@ void SDIRK34Solver::Step(Vector &x, double &t, double &dt)
 
    f->SetTime(t + a*dt);
    f->ImplicitSolve(a*dt, x, k);
-   add(x, (0.5-a)*dt, k, y);
-   add(x,  (2.*a)*dt, k, z);
+   FusedStageUpdate(x, k, (0.5-a)*dt, y, x, (2.*a)*dt, z);
    x.Add(b*dt, k);
 
    f->SetTime(t + dt/2);
    f->ImplicitSolve(a*dt, y, k);
-   z.Add((1.-4.*a)*dt, k);
-   x.Add((1.-2.*b)*dt, k);
+   FusedStageUpdate(z, k, (1.-4.*a)*dt, z, x, (1.-2.*b)*dt, x);
 
    f->SetTime(t + (1.-a)*dt);
    f->ImplicitSolve(a*dt, z, k);
@@ -472,8 +506,7 @@ void SDIRK33Solver::Step(Vector &x, double &t, double &dt)
 
    f->SetTime(t + a*dt);
    f->ImplicitSolve(a*dt, x, k);
-   add(x, (c-a)*dt, k, y);
-   x.Add(b*dt, k);
+   FusedStageUpdate(x, k, (c-a)*dt, y, x, b*dt, x);
 
    f->SetTime(t + c*dt);
    f->ImplicitSolve(a*dt, y, k);
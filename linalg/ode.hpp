@@ -171,6 +171,9 @@ private:
    int s;
    const double *a, *b, *c;
    Vector y, *k;
+   // work arrays for the fused stage updates: terms and their coefficients
+   const Vector **terms;
+   double *coeffs;
 
 public:
    ExplicitRKSolver(int _s, const double *_a, const double *_b,
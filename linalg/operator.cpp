@@ -18,6 +18,20 @@
 namespace mfem
 {
 
+void Operator::Mult(const MultiVector &x, MultiVector &y) const
+{
+   MFEM_ASSERT(x.Size() == width && y.Size() == height &&
+               x.NumVectors() == y.NumVectors(), "incompatible MultiVectors");
+
+   Vector xj, yj;
+   for (int j = 0; j < x.NumVectors(); j++)
+   {
+      x.GetVectorReference(j, xj);
+      y.GetVectorReference(j, yj);
+      Mult(xj, yj);
+   }
+}
+
 void Operator::FormLinearSystem(const Array<int> &ess_tdof_list,
                                 Vector &x, Vector &b,
                                 Operator* &Aout, Vector &X, Vector &B,
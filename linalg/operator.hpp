@@ -13,6 +13,7 @@
 #define MFEM_OPERATOR
 
 #include "vector.hpp"
+#include "multivector.hpp"
 
 namespace mfem
 {
@@ -47,6 +48,16 @@ public:
    /// Operator application: `y=A(x)`.
    virtual void Mult(const Vector &x, Vector &y) const = 0;
 
+   /** @brief Operator application to several vectors: `y_j=A(x_j)`. The
+       default behavior in class Operator is to apply Mult() to each vector;
+       derived classes can overload it to amortize the memory traffic of the
+       operator data over all vectors.
+
+       @note A derived class which overloads Mult(const Vector &, Vector &)
+       hides this method; call it through a reference to Operator or add
+       `using Operator::Mult;` to the derived class. */
+   virtual void Mult(const MultiVector &x, MultiVector &y) const;
+
    /** @brief Action of the transpose operator: `y=A^t(x)`. The default behavior
        in class Operator is to generate an error. */
    virtual void MultTranspose(const Vector &x, Vector &y) const
@@ -30,6 +30,8 @@ IterativeSolver::IterativeSolver()
    rel_tol = abs_tol = 0.0;
 #ifdef MFEM_USE_MPI
    dot_prod_type = 0;
+   reduction_buf = NULL;
+   reduction_size = 0;
 #endif
 }
 
@@ -44,6 +46,8 @@ IterativeSolver::IterativeSolver(MPI_Comm _comm)
    rel_tol = abs_tol = 0.0;
    dot_prod_type = 1;
    comm = _comm;
+   reduction_buf = NULL;
+   reduction_size = 0;
 }
 #endif
 
@@ -68,6 +72,41 @@ double IterativeSolver::Dot(const Vector &x, const Vector &y) const
 #endif
 }
 
+void IterativeSolver::Dot(const MultiVector &x, const MultiVector &y,
+                          Vector &d) const
+{
+   x.Dot(y, d);
+   StartReduction(d.GetData(), d.Size());
+   WaitReduction();
+}
+
+void IterativeSolver::StartReduction(double *buf, int n) const
+{
+#ifdef MFEM_USE_MPI
+   if (dot_prod_type == 0) { return; }
+   reduction_buf = buf;
+   reduction_size = n;
+#if MPI_VERSION >= 3
+   MPI_Iallreduce(MPI_IN_PLACE, buf, n, MPI_DOUBLE, MPI_SUM, comm,
+                  &reduction_request);
+#endif
+#endif
+}
+
+void IterativeSolver::WaitReduction() const
+{
+#ifdef MFEM_USE_MPI
+   if (dot_prod_type == 0) { return; }
+#if MPI_VERSION >= 3
+   MPI_Wait(&reduction_request, MPI_STATUS_IGNORE);
+#else
+   // no non-blocking collectives: do the whole reduction here
+   MPI_Allreduce(MPI_IN_PLACE, reduction_buf, reduction_size, MPI_DOUBLE,
+                 MPI_SUM, comm);
+#endif
+#endif
+}
+
 void IterativeSolver::SetPrintLevel(int print_lvl)
 {
 #ifndef MFEM_USE_MPI
@@ -440,6 +479,177 @@ void CGSolver::Mult(const Vector &b, Vector &x) const
    final_norm = sqrt(betanom);
 }
 
+void CGSolver::Mult(const MultiVector &b, MultiVector &x) const
+{
+   const int nv = b.NumVectors();
+   int i, j, num_active, num_converged = 0;
+   double max_nom;
+   Vector nom(nv), nom0(nv), r0(nv), den(nv), betanom(nv);
+   Vector alpha(nv), beta(nv);
+   Array<int> active(nv);
+
+   R.SetSize(width, nv);
+   D.SetSize(width, nv);
+   Z.SetSize(width, nv);
+
+   if (iterative_mode)
+   {
+      oper->Mult(x, R);
+      subtract(b.GetValues(), R.GetValues(), R.GetValues()); // R = B - A X
+   }
+   else
+   {
+      R = b;
+      x = 0.0;
+   }
+
+   if (prec)
+   {
+      prec->Mult(R, Z); // Z = B R
+      D = Z;
+   }
+   else
+   {
+      D = R;
+   }
+   Dot(D, R, nom);
+   nom0 = nom;
+   max_nom = nom.Max();
+   MFEM_ASSERT(IsFinite(max_nom), "max nom = " << max_nom);
+
+   if (print_level == 1 || print_level == 3)
+   {
+      cout << "   Iteration : " << setw(3) << 0 << "  max (B r, r) = "
+           << max_nom << (print_level == 3 ? " ...\n" : "\n");
+   }
+
+   num_active = 0;
+   for (j = 0; j < nv; j++)
+   {
+      r0(j) = std::max(nom(j)*rel_tol*rel_tol, abs_tol*abs_tol);
+      active[j] = (nom(j) > r0(j));
+      if (active[j]) { num_active++; }
+      else { num_converged++; }
+   }
+   betanom = nom;
+   if (num_active == 0)
+   {
+      converged = 1;
+      final_iter = 0;
+      final_norm = sqrt(max_nom);
+      return;
+   }
+
+   oper->Mult(D, Z);  // Z = A D
+   Dot(Z, D, den);
+
+   // start iteration
+   final_iter = max_iter;
+   for (i = 1; true; )
+   {
+      for (j = 0; j < nv; j++)
+      {
+         if (active[j] && den(j) <= 0.0)
+         {
+            if (print_level >= 0)
+            {
+               cout << "PCG: The operator is not positive definite for vector "
+                    << j << ". (Ad, d) = " << den(j) << '\n';
+            }
+            if (den(j) == 0.0)
+            {
+               active[j] = 0;
+               num_active--;
+            }
+         }
+         alpha(j) = active[j] ? nom(j)/den(j) : 0.0;
+      }
+      x.Add(alpha, D);          //  X = X + alpha D
+      alpha.Neg();
+      R.Add(alpha, Z);          //  R = R - alpha A D
+
+      if (prec)
+      {
+         prec->Mult(R, Z);      //  Z = B R
+         Dot(R, Z, betanom);
+      }
+      else
+      {
+         Dot(R, R, betanom);
+      }
+      max_nom = betanom.Max();
+      MFEM_ASSERT(IsFinite(max_nom), "max betanom = " << max_nom);
+
+      for (j = 0; j < nv; j++)
+      {
+         if (active[j] && betanom(j) < r0(j))
+         {
+            active[j] = 0;
+            num_active--;
+            num_converged++;
+         }
+      }
+
+      if (print_level == 1)
+      {
+         cout << "   Iteration : " << setw(3) << i << "  max (B r, r) = "
+              << max_nom << '\n';
+      }
+
+      if (num_active == 0)
+      {
+         if (print_level == 2)
+         {
+            cout << "Number of PCG iterations: " << i << '\n';
+         }
+         else if (print_level == 3)
+         {
+            cout << "   Iteration : " << setw(3) << i << "  max (B r, r) = "
+                 << max_nom << '\n';
+         }
+         final_iter = i;
+         break;
+      }
+
+      if (++i > max_iter)
+      {
+         break;
+      }
+
+      for (j = 0; j < nv; j++)
+      {
+         beta(j) = active[j] ? betanom(j)/nom(j) : 0.0;
+      }
+      D.Scale(beta);
+      D.Add(1.0, prec ? Z : R); //  D = Z + beta D
+      oper->Mult(D, Z);         //  Z = A D
+      Dot(D, Z, den);
+      nom = betanom;
+   }
+   converged = (num_converged == nv);
+   final_norm = sqrt(max_nom);
+   if (print_level >= 0 && !converged)
+   {
+      if (print_level != 1)
+      {
+         if (print_level != 3)
+         {
+            cout << "   Iteration : " << setw(3) << 0 << "  max (B r, r) = "
+                 << nom0.Max() << " ...\n";
+         }
+         cout << "   Iteration : " << setw(3) << final_iter
+              << "  max (B r, r) = " << max_nom << '\n';
+      }
+      cout << "PCG: No convergence for " << nv - num_converged << " of "
+           << nv << " vectors!" << '\n';
+   }
+   if (print_level >= 1 || (print_level >= 0 && !converged))
+   {
+      cout << "Average reduction factor = "
+           << pow (max_nom/nom0.Max(), 0.5/final_iter) << '\n';
+   }
+}
+
 void CG(const Operator &A, const Vector &b, Vector &x,
         int print_iter, int max_num_iter,
         double RTOLERANCE, double ATOLERANCE)
@@ -1200,6 +1410,202 @@ loop_end:
    }
 }
 
+void MINRESSolver::Mult(const MultiVector &b, MultiVector &x) const
+{
+   // The algorithm of MINRESSolver::Mult(const Vector &, Vector &), with the
+   // scalars replaced by one entry per vector.
+   const int nv = b.NumVectors();
+   int it, j, num_active;
+   Vector beta(nv), eta(nv), gamma0(nv), gamma1(nv), sigma0(nv), sigma1(nv);
+   Vector alpha(nv), delta(nv), rho1(nv), rho2(nv), rho3(nv), norm_goal(nv);
+   Vector c(nv), c1(nv), c2(nv);
+   Array<int> active(nv);
+
+   V0.SetSize(width, nv);
+   V1.SetSize(width, nv);
+   W0.SetSize(width, nv);
+   W1.SetSize(width, nv);
+   Q.SetSize(width, nv);
+   if (prec)
+   {
+      U1.SetSize(width, nv);
+   }
+   MultiVector *z = (prec) ? &U1 : &V1;
+
+   converged = 1;
+
+   if (!iterative_mode)
+   {
+      V1 = b;
+      x = 0.;
+   }
+   else
+   {
+      oper->Mult(x, V1);
+      subtract(b.GetValues(), V1.GetValues(), V1.GetValues());
+   }
+
+   if (prec)
+   {
+      prec->Mult(V1, U1);
+   }
+   Dot(*z, V1, eta);
+   num_active = 0;
+   for (j = 0; j < nv; j++)
+   {
+      eta(j) = beta(j) = sqrt(eta(j));
+      MFEM_ASSERT(IsFinite(eta(j)), "eta = " << eta(j));
+      norm_goal(j) = std::max(rel_tol*eta(j), abs_tol);
+      active[j] = (eta(j) > norm_goal(j));
+      if (active[j]) { num_active++; }
+   }
+   gamma0 = gamma1 = 1.;
+   sigma0 = sigma1 = 0.;
+
+   if (num_active == 0)
+   {
+      it = 0;
+      goto loop_end;
+   }
+
+   if (print_level == 1 || print_level == 3)
+   {
+      cout << "MINRES: iteration " << setw(3) << 0 << ": max ||r||_B = "
+           << eta.Normlinf() << (print_level == 3 ? " ...\n" : "\n");
+   }
+
+   for (it = 1; it <= max_iter; it++)
+   {
+      // (beta == 0) only for a zero vector or an exhausted Krylov space
+      for (j = 0; j < nv; j++)
+      {
+         c(j) = (beta(j) > 0.0) ? 1./beta(j) : 1.;
+      }
+      V1.Scale(c);
+      if (prec)
+      {
+         U1.Scale(c);
+      }
+      oper->Mult(*z, Q);
+      Dot(*z, Q, alpha);
+      if (it > 1) // (V0 == 0) for (it == 1)
+      {
+         c = beta;
+         c.Neg();
+         Q.Add(c, V0);
+      }
+      V0 = Q;
+      c = alpha;
+      c.Neg();
+      V0.Add(c, V1);
+
+      for (j = 0; j < nv; j++)
+      {
+         delta(j) = gamma1(j)*alpha(j) - gamma0(j)*sigma1(j)*beta(j);
+         rho3(j) = sigma0(j)*beta(j);
+         rho2(j) = sigma1(j)*alpha(j) + gamma0(j)*gamma1(j)*beta(j);
+      }
+      if (!prec)
+      {
+         Dot(V0, V0, beta);
+      }
+      else
+      {
+         prec->Mult(V0, Q);
+         Dot(V0, Q, beta);
+      }
+      for (j = 0; j < nv; j++)
+      {
+         beta(j) = sqrt(beta(j));
+         MFEM_ASSERT(IsFinite(beta(j)), "beta = " << beta(j));
+         rho1(j) = hypot(delta(j), beta(j));
+         if (rho1(j) == 0.0) { rho1(j) = 1.; }
+         c(j) = 1./rho1(j);
+         c1(j) = -rho2(j)/rho1(j);
+      }
+
+      if (it == 1)
+      {
+         W0.Set(c, *z);   // (W0 == 0) and (W1 == 0)
+      }
+      else if (it == 2)
+      {
+         W0.Set(c, *z);   // (W0 == 0)
+         W0.Add(c1, W1);
+      }
+      else
+      {
+         for (j = 0; j < nv; j++)
+         {
+            c2(j) = -rho3(j)/rho1(j);
+         }
+         W0.Scale(c2);
+         W0.Add(c1, W1);
+         W0.Add(c, *z);
+      }
+
+      for (j = 0; j < nv; j++)
+      {
+         gamma0(j) = gamma1(j);
+         gamma1(j) = delta(j)/rho1(j);
+         c(j) = active[j] ? gamma1(j)*eta(j) : 0.0;
+      }
+      x.Add(c, W0);
+
+      for (j = 0; j < nv; j++)
+      {
+         sigma0(j) = sigma1(j);
+         sigma1(j) = beta(j)/rho1(j);
+         eta(j) = -sigma1(j)*eta(j);
+         MFEM_ASSERT(IsFinite(eta(j)), "eta = " << eta(j));
+         if (active[j] && fabs(eta(j)) <= norm_goal(j))
+         {
+            active[j] = 0;
+            num_active--;
+         }
+      }
+
+      if (num_active == 0)
+      {
+         goto loop_end;
+      }
+
+      if (print_level == 1)
+      {
+         cout << "MINRES: iteration " << setw(3) << it << ": max ||r||_B = "
+              << eta.Normlinf() << '\n';
+      }
+
+      if (prec)
+      {
+         Swap(U1, Q);
+      }
+      Swap(V0, V1);
+      Swap(W0, W1);
+   }
+   converged = 0;
+   it--;
+
+loop_end:
+   final_iter = it;
+   final_norm = eta.Normlinf();
+
+   if (print_level == 1 || print_level == 3)
+   {
+      cout << "MINRES: iteration " << setw(3) << final_iter
+           << ": max ||r||_B = " << final_norm << '\n';
+   }
+   else if (print_level == 2)
+   {
+      cout << "MINRES: number of iterations: " << final_iter << '\n';
+   }
+   if (!converged && print_level >= 0)
+   {
+      cout << "MINRES: No convergence for " << num_active << " of " << nv
+           << " vectors!\n";
+   }
+}
+
 void MINRES(const Operator &A, const Vector &b, Vector &x, int print_it,
             int max_it, double rtol, double atol)
 {
@@ -1226,6 +1632,939 @@ void MINRES(const Operator &A, Solver &B, const Vector &b, Vector &x,
 }
 
 
+void PipelinedCGSolver::UpdateVectors()
+{
+   r.SetSize(width);
+   u.SetSize(width);
+   w.SetSize(width);
+   m.SetSize(width);
+   n.SetSize(width);
+   p.SetSize(width);
+   s.SetSize(width);
+   q.SetSize(width);
+   z.SetSize(width);
+}
+
+void PipelinedCGSolver::Mult(const Vector &b, Vector &x) const
+{
+   // Preconditioned pipelined CG, Algorithm 4 in P. Ghysels, W. Vanroose,
+   // "Hiding global synchronization latency in the preconditioned Conjugate
+   // Gradient algorithm", Parallel Computing 40 (2014). Without a
+   // preconditioner u = r, m = w and q = s.
+   int i;
+   double r0 = 0.0, nom0 = 0.0, gamma, delta, gamma_old = 0.0;
+   double alpha = 0.0, alpha_old = 0.0, beta, den;
+   double dots[2];
+
+   Vector &uu = prec ? u : r;
+   Vector &mm = prec ? m : w;
+
+   if (iterative_mode)
+   {
+      oper->Mult(x, r);
+      subtract(b, r, r); // r = b - A x
+   }
+   else
+   {
+      r = b;
+      x = 0.0;
+   }
+   if (prec)
+   {
+      prec->Mult(r, u); // u = B r
+   }
+   oper->Mult(uu, w);   // w = A u
+
+   converged = 0;
+   for (i = 0; true; i++)
+   {
+      // start the reductions, then apply the preconditioner and the operator
+      dots[0] = uu * r;
+      dots[1] = uu * w;
+      StartReduction(dots, 2);
+      if (prec)
+      {
+         prec->Mult(w, m); // m = B w
+      }
+      oper->Mult(mm, n);   // n = A m
+      WaitReduction();
+      gamma = dots[0];     // (B r, r)
+      delta = dots[1];     // (A B r, B r)
+      MFEM_ASSERT(IsFinite(gamma), "gamma = " << gamma);
+
+      if (i == 0)
+      {
+         nom0 = gamma;
+         r0 = std::max(gamma*rel_tol*rel_tol, abs_tol*abs_tol);
+         if (print_level == 1 || print_level == 3)
+         {
+            cout << "   Iteration : " << setw(3) << 0 << "  (B r, r) = "
+                 << gamma << (print_level == 3 ? " ...\n" : "\n");
+         }
+         if (gamma <= r0)
+         {
+            converged = 1;
+            break;
+         }
+      }
+      else
+      {
+         if (print_level == 1)
+         {
+            cout << "   Iteration : " << setw(3) << i << "  (B r, r) = "
+                 << gamma << '\n';
+         }
+         if (gamma < r0)
+         {
+            if (print_level == 2)
+            {
+               cout << "Number of pipelined PCG iterations: " << i << '\n';
+            }
+            else if (print_level == 3)
+            {
+               cout << "   Iteration : " << setw(3) << i << "  (B r, r) = "
+                    << gamma << '\n';
+            }
+            converged = 1;
+            break;
+         }
+      }
+      if (i == max_iter)
+      {
+         break;
+      }
+
+      if (i > 0)
+      {
+         beta = gamma/gamma_old;
+         den = delta - beta*gamma/alpha_old;
+      }
+      else
+      {
+         beta = 0.0;
+         den = delta;
+      }
+      MFEM_ASSERT(IsFinite(den), "den = " << den);
+      if (den <= 0.0)
+      {
+         if (print_level >= 0)
+         {
+            cout << "Pipelined PCG: The operator is not positive definite. "
+                 "(Ad, d) = " << den << '\n';
+         }
+         if (den == 0.0)
+         {
+            break;
+         }
+      }
+      alpha = gamma/den;
+
+      if (i > 0)
+      {
+         add(n, beta, z, z);      // z = n + beta z
+         add(w, beta, s, s);      // s = w + beta s
+         add(uu, beta, p, p);     // p = u + beta p
+         if (prec)
+         {
+            add(m, beta, q, q);   // q = m + beta q
+         }
+      }
+      else
+      {
+         z = n;
+         s = w;
+         p = uu;
+         if (prec)
+         {
+            q = m;
+         }
+      }
+      x.Add(alpha, p);            // x = x + alpha p
+      r.Add(-alpha, s);           // r = r - alpha s
+      if (prec)
+      {
+         u.Add(-alpha, q);        // u = u - alpha q
+      }
+      w.Add(-alpha, z);           // w = w - alpha z
+
+      gamma_old = gamma;
+      alpha_old = alpha;
+   }
+
+   final_iter = i;
+   final_norm = sqrt(gamma);
+   if (print_level >= 0 && !converged)
+   {
+      if (print_level != 1)
+      {
+         if (print_level != 3)
+         {
+            cout << "   Iteration : " << setw(3) << 0 << "  (B r, r) = "
+                 << nom0 << " ...\n";
+         }
+         cout << "   Iteration : " << setw(3) << final_iter << "  (B r, r) = "
+              << gamma << '\n';
+      }
+      cout << "Pipelined PCG: No convergence!" << '\n';
+   }
+   if (final_iter > 0 &&
+       (print_level >= 1 || (print_level >= 0 && !converged)))
+   {
+      cout << "Average reduction factor = "
+           << pow (gamma/nom0, 0.5/final_iter) << '\n';
+   }
+}
+
+
+void PipelinedMINRESSolver::UpdateVectors()
+{
+   z0.SetSize(width);
+   z1.SetSize(width);
+   w0.SetSize(width);
+   w1.SetSize(width);
+   n.SetSize(width);
+   d0.SetSize(width);
+   d1.SetSize(width);
+   // m = B w and p = B n are only needed with a preconditioner; the sizes are
+   // set in Mult() since the preconditioner may be set after the operator
+}
+
+void PipelinedMINRESSolver::Mult(const Vector &b, Vector &x) const
+{
+   // The Lanczos vectors and the MINRES updates are those of MINRESSolver;
+   // z, w and m are updated with the three-term recurrences
+   //    X_{j+1} = (Y_j - alpha_j X_j - beta_j X_{j-1})/beta_{j+1}
+   // where Y = B w for X = z, Y = A m for X = w and Y = B A m for X = m.
+   // The recurrences drift from w = A z, m = B w in finite precision; when the
+   // drift is detected or the next Lanczos coefficient can no longer be
+   // computed, the iteration is restarted from the current x with the true
+   // residual.
+   int it = 0, it0;
+   double beta, beta2, alpha, mu, eta, gamma0, gamma1, sigma0, sigma1;
+   double delta, rho1, rho2, rho3, norm_goal = 0.0;
+   double dots[3];
+   bool restart;
+
+   if (prec)
+   {
+      m0.SetSize(width);
+      m1.SetSize(width);
+      p.SetSize(width);
+   }
+   if (!iterative_mode)
+   {
+      x = 0.0;
+   }
+
+   converged = 0;
+   do
+   {
+      // pointers, so that the vectors can be swapped without copies
+      Vector *Z0 = &z0, *Z1 = &z1, *W0 = &w0, *W1 = &w1, *D0 = &d0, *D1 = &d1;
+      Vector *M0 = prec ? &m0 : W0, *M1 = prec ? &m1 : W1;
+      Vector *P = prec ? &p : &n;
+
+      // the residual is stored in d0
+      if (it == 0 && !iterative_mode)
+      {
+         d0 = b;
+      }
+      else
+      {
+         oper->Mult(x, d0);
+         subtract(b, d0, d0);
+      }
+      if (prec)
+      {
+         prec->Mult(d0, z1);
+      }
+      else
+      {
+         z1 = d0;
+      }
+      dots[0] = z1 * d0;
+      StartReduction(dots, 1);
+      oper->Mult(z1, w1);
+      if (prec)
+      {
+         prec->Mult(w1, m1);
+      }
+      WaitReduction();
+
+      eta = beta = sqrt(dots[0]);
+      MFEM_ASSERT(IsFinite(eta), "eta = " << eta);
+      gamma0 = gamma1 = 1.;
+      sigma0 = sigma1 = 0.;
+      restart = false;
+
+      if (it == 0)
+      {
+         norm_goal = std::max(rel_tol*eta, abs_tol);
+         if (print_level == 1 || print_level == 3)
+         {
+            cout << "Pipelined MINRES: iteration " << setw(3) << 0
+                 << ": ||r||_B = " << eta << (print_level == 3 ? " ...\n" : "\n");
+         }
+      }
+      if (eta <= norm_goal)
+      {
+         converged = 1;
+         break;
+      }
+
+      *Z1 /= beta;
+      *W1 /= beta;
+      if (prec)
+      {
+         *M1 /= beta;
+      }
+
+      for (it0 = it; it < max_iter; )
+      {
+         dots[0] = (*Z1) * (*W1);
+         dots[1] = (*W1) * (*M1);
+         dots[2] = (it > it0) ? (*Z0) * (*W1) : 0.0;
+         StartReduction(dots, 3);
+         oper->Mult(*M1, n);
+         if (prec)
+         {
+            prec->Mult(n, *P);
+         }
+         WaitReduction();
+         alpha = dots[0];
+         mu = dots[1];
+         MFEM_ASSERT(IsFinite(alpha) && IsFinite(mu),
+                     "alpha = " << alpha << ", mu = " << mu);
+
+         // the next Lanczos coefficient, (z_0 == 0) in the first iteration;
+         // in exact arithmetic (z_0, w_1) = beta, which is used to detect the
+         // drift of the recurrences
+         beta2 = mu - alpha*alpha - ((it > it0) ? beta*beta : 0.0);
+         if (beta2 <= 0.0 && it == it0 && alpha != 0.0)
+         {
+            // Lanczos (happy) breakdown in the first step: B r is an
+            // eigenvector of B A, the Krylov space is exhausted and the step
+            // with beta_{j+1} = 0 gives the solution; here gamma1 = 1 and
+            // sigma1 = 0, so delta = alpha and d = z/rho1
+            it++;
+            delta = alpha;
+            rho1 = fabs(delta);
+            x.Add((delta/rho1)*eta/rho1, *Z1);
+            eta = 0.0;
+            converged = 1;
+            break;
+         }
+         if (beta2 <= 0.0 || (it > it0 && fabs(dots[2] - beta) > 1e-5*beta))
+         {
+            // restart, unless no progress has been made since the last one
+            restart = (it > it0);
+            if (print_level == 1 || print_level == 3)
+            {
+               cout << "Pipelined MINRES: "
+                    << (restart ? "restart" : "breakdown") << " in iteration "
+                    << setw(3) << it+1 << ", beta^2 = " << beta2 << '\n';
+            }
+            break;
+         }
+         it++;
+
+         delta = gamma1*alpha - gamma0*sigma1*beta;
+         rho3 = sigma0*beta;
+         rho2 = sigma1*alpha + gamma0*gamma1*beta;
+         const double beta_new = sqrt(beta2);
+         rho1 = hypot(delta, beta_new);
+
+         if (it == it0 + 1)
+         {
+            D0->Set(1./rho1, *Z1);   // (d0 == 0) and (d1 == 0)
+         }
+         else if (it == it0 + 2)
+         {
+            add(1./rho1, *Z1, -rho2/rho1, *D1, *D0);   // (d0 == 0)
+         }
+         else
+         {
+            add(-rho3/rho1, *D0, -rho2/rho1, *D1, *D0);
+            D0->Add(1./rho1, *Z1);
+         }
+
+         gamma0 = gamma1;
+         gamma1 = delta/rho1;
+
+         x.Add(gamma1*eta, *D0);
+
+         sigma0 = sigma1;
+         sigma1 = beta_new/rho1;
+
+         eta = -sigma1*eta;
+         MFEM_ASSERT(IsFinite(eta), "eta = " << eta);
+
+         if (fabs(eta) <= norm_goal)
+         {
+            converged = 1;
+            break;
+         }
+
+         if (print_level == 1)
+         {
+            cout << "Pipelined MINRES: iteration " << setw(3) << it
+                 << ": ||r||_B = " << fabs(eta) << '\n';
+         }
+
+         // three-term recurrences for the next z, w and m
+         if (it == it0 + 1)
+         {
+            add(1./beta_new, *M1, -alpha/beta_new, *Z1, *Z0);
+            add(1./beta_new, n, -alpha/beta_new, *W1, *W0);
+            if (prec)
+            {
+               add(1./beta_new, *P, -alpha/beta_new, *M1, *M0);
+            }
+         }
+         else
+         {
+            add(-alpha/beta_new, *Z1, -beta/beta_new, *Z0, *Z0);
+            Z0->Add(1./beta_new, *M1);
+            add(-alpha/beta_new, *W1, -beta/beta_new, *W0, *W0);
+            W0->Add(1./beta_new, n);
+            if (prec)
+            {
+               add(-alpha/beta_new, *M1, -beta/beta_new, *M0, *M0);
+               M0->Add(1./beta_new, *P);
+            }
+         }
+         mfem::Swap(Z0, Z1);
+         mfem::Swap(W0, W1);
+         if (prec)
+         {
+            mfem::Swap(M0, M1);
+         }
+         else
+         {
+            M0 = W0;
+            M1 = W1;
+         }
+         mfem::Swap(D0, D1);
+         beta = beta_new;
+      }
+   }
+   while (restart);
+
+   final_iter = it;
+   final_norm = fabs(eta);
+
+   if (print_level == 1 || print_level == 3)
+   {
+      cout << "Pipelined MINRES: iteration " << setw(3) << final_iter
+           << ": ||r||_B = " << final_norm << '\n';
+   }
+   else if (print_level == 2)
+   {
+      cout << "Pipelined MINRES: number of iterations: " << final_iter << '\n';
+   }
+   if (!converged && print_level >= 0)
+   {
+      cout << "Pipelined MINRES: No convergence!\n";
+   }
+}
+
+
+void SStepCGSolver::UpdateVectors()
+{
+   MFEM_VERIFY(s_step >= 1, "invalid step size: " << s_step);
+   r.SetSize(width);
+   V.SetSize(width, s_step);
+   AV.SetSize(width, s_step);
+   P.SetSize(width, s_step);
+   AP.SetSize(width, s_step);
+}
+
+// Compute P = V + P B for the n x s matrices P, V and the s x s matrix B.
+static void AddMultInPlace(DenseMatrix &P, const DenseMatrix &V,
+                           const DenseMatrix &B)
+{
+   const int n = P.Height(), s = P.Width();
+   Vector row(s);
+   for (int i = 0; i < n; i++)
+   {
+      for (int j = 0; j < s; j++)
+      {
+         double d = V(i,j);
+         for (int l = 0; l < s; l++)
+         {
+            d += P(i,l) * B(l,j);
+         }
+         row(j) = d;
+      }
+      for (int j = 0; j < s; j++)
+      {
+         P(i,j) = row(j);
+      }
+   }
+}
+
+// Solve W a = rhs using the Cholesky factorization of the largest leading
+// block of the s x s SPD matrix W with non-negligible pivots; the entries of
+// a beyond that block are set to zero. Returns the size of the block, which
+// is smaller than s when the columns of the s-step basis are (numerically)
+// linearly dependent, i.e. when the Krylov space is exhausted.
+static int TruncatedCholeskySolve(const DenseMatrix &W, const Vector &rhs,
+                                  DenseMatrix &L, Vector &a)
+{
+   const int s = W.Height();
+   int m = 0;
+   L.SetSize(s);
+   for (int j = 0; j < s; j++)
+   {
+      double d = W(j,j);
+      for (int k = 0; k < j; k++)
+      {
+         d -= L(j,k)*L(j,k);
+      }
+      if (!(d > 1e-12*W(j,j))) { break; }
+      L(j,j) = sqrt(d);
+      for (int i = j+1; i < s; i++)
+      {
+         double v = W(i,j);
+         for (int k = 0; k < j; k++)
+         {
+            v -= L(i,k)*L(j,k);
+         }
+         L(i,j) = v/L(j,j);
+      }
+      m = j+1;
+   }
+   a = 0.0;
+   for (int i = 0; i < m; i++)
+   {
+      double v = rhs(i);
+      for (int k = 0; k < i; k++)
+      {
+         v -= L(i,k)*a(k);
+      }
+      a(i) = v/L(i,i);
+   }
+   for (int i = m-1; i >= 0; i--)
+   {
+      double v = a(i);
+      for (int k = i+1; k < m; k++)
+      {
+         v -= L(k,i)*a(k);
+      }
+      a(i) = v/L(i,i);
+   }
+   return m;
+}
+
+void SStepCGSolver::Mult(const Vector &b, Vector &x) const
+{
+   // A. T. Chronopoulos, C. W. Gear, "s-step iterative methods for symmetric
+   // linear systems", J. Comput. Appl. Math. 25 (1989). The directions P_k of
+   // an outer iteration are the basis V_k, A-orthogonalized against P_{k-1}:
+   //    P_k = V_k + P_{k-1} B_k,  B_k = -W_{k-1}^{-1} (A P_{k-1})^T V_k,
+   //    W_k = P_k^T A P_k,        x_{k+1} = x_k + P_k W_k^{-1} P_k^T r_k.
+   // If W_k is singular, the Krylov space is exhausted after the first m < s
+   // directions: only these are used, and the next outer iteration starts
+   // without P_{k-1}.
+   const int s = s_step, nrows = width;
+   double nom = 0.0, nom0 = 0.0, r0 = 0.0;
+   int it, m = s;
+   bool restart = true;
+
+   DenseMatrix G(s), C(s), W(s), Bk(s), CtB(s), L(s);
+   Vector g(s), h(s), a(s), rhs(s);
+   // reduction buffer: G = V^T A V, C = (A P)^T V, g = V^T r, h = P^T r
+   Vector buf(2*s*s + 2*s);
+
+   if (iterative_mode)
+   {
+      oper->Mult(x, r);
+      subtract(b, r, r); // r = b - A x
+   }
+   else
+   {
+      r = b;
+      x = 0.0;
+   }
+
+   converged = 0;
+   for (it = 0; true; it += m)
+   {
+      // 1. Basis V = [B r, (B A) B r, ...] and A V.
+      for (int j = 0; j < s; j++)
+      {
+         Vector vj(V.GetColumn(j), nrows), avj(AV.GetColumn(j), nrows);
+         if (j == 0)
+         {
+            if (prec) { prec->Mult(r, vj); }
+            else { vj = r; }
+         }
+         else
+         {
+            Vector avp(AV.GetColumn(j-1), nrows);
+            if (prec) { prec->Mult(avp, vj); }
+            else { vj = avp; }
+         }
+         oper->Mult(vj, avj);
+      }
+
+      // 2. All inner products of the outer iteration in one reduction.
+      MultAtB(V, AV, G);
+      V.MultTranspose(r, g);
+      if (!restart)
+      {
+         MultAtB(AP, V, C);
+         P.MultTranspose(r, h);
+      }
+      else
+      {
+         C = 0.0;
+         h = 0.0;
+      }
+      for (int k = 0; k < s*s; k++)
+      {
+         buf(k) = G.Data()[k];
+         buf(s*s+k) = C.Data()[k];
+      }
+      for (int k = 0; k < s; k++)
+      {
+         buf(2*s*s+k) = g(k);
+         buf(2*s*s+s+k) = h(k);
+      }
+      StartReduction(buf.GetData(), buf.Size());
+      WaitReduction();
+      for (int k = 0; k < s*s; k++)
+      {
+         G.Data()[k] = buf(k);
+         C.Data()[k] = buf(s*s+k);
+      }
+      for (int k = 0; k < s; k++)
+      {
+         g(k) = buf(2*s*s+k);
+         h(k) = buf(2*s*s+s+k);
+      }
+
+      // 3. Convergence test with (B r, r) = g(0).
+      nom = g(0);
+      MFEM_ASSERT(IsFinite(nom), "nom = " << nom);
+      if (it == 0)
+      {
+         nom0 = nom;
+         r0 = std::max(nom*rel_tol*rel_tol, abs_tol*abs_tol);
+         if (print_level == 1 || print_level == 3)
+         {
+            cout << "   Iteration : " << setw(3) << 0 << "  (B r, r) = "
+                 << nom << (print_level == 3 ? " ...\n" : "\n");
+         }
+         if (nom <= r0)
+         {
+            converged = 1;
+            break;
+         }
+      }
+      else
+      {
+         if (print_level == 1)
+         {
+            cout << "   Iteration : " << setw(3) << it << "  (B r, r) = "
+                 << nom << '\n';
+         }
+         if (nom < r0)
+         {
+            if (print_level == 2)
+            {
+               cout << "Number of s-step PCG iterations: " << it << '\n';
+            }
+            else if (print_level == 3)
+            {
+               cout << "   Iteration : " << setw(3) << it << "  (B r, r) = "
+                    << nom << '\n';
+            }
+            converged = 1;
+            break;
+         }
+      }
+      if (it >= max_iter)
+      {
+         break;
+      }
+
+      // 4. New directions P, A P and the Gram matrix W = P^T A P.
+      if (!restart)
+      {
+         DenseMatrixInverse Winv(W);
+         Winv.Mult(C, Bk);
+         Bk.Neg();                       // B_k = -W^{-1} C
+         AddMultInPlace(P, V, Bk);
+         AddMultInPlace(AP, AV, Bk);
+         MultAtB(C, Bk, CtB);
+         Add(G, CtB, 1.0, W);            // W = G + C^T B_k
+         Bk.MultTranspose(h, rhs);
+         rhs += g;                       // P^T r = g + B_k^T h
+      }
+      else
+      {
+         P = V;
+         AP = AV;
+         W = G;
+         rhs = g;
+      }
+      // symmetrize against round-off
+      W.Symmetrize();
+
+      // 5. Update the solution and the residual.
+      m = TruncatedCholeskySolve(W, rhs, L, a);
+      if (m == 0)
+      {
+         if (print_level >= 0)
+         {
+            cout << "s-step PCG: breakdown in iteration " << it << '\n';
+         }
+         break;
+      }
+      restart = (m < s);
+      P.AddMult(a, x);                   // x = x + P a
+      a.Neg();
+      AP.AddMult(a, r);                  // r = r - A P a
+   }
+
+   final_iter = it;
+   final_norm = sqrt(std::max(nom, 0.0));
+   if (print_level >= 0 && !converged)
+   {
+      if (print_level != 1)
+      {
+         if (print_level != 3)
+         {
+            cout << "   Iteration : " << setw(3) << 0 << "  (B r, r) = "
+                 << nom0 << " ...\n";
+         }
+         cout << "   Iteration : " << setw(3) << final_iter << "  (B r, r) = "
+              << nom << '\n';
+      }
+      cout << "s-step PCG: No convergence!" << '\n';
+   }
+   if (final_iter > 0 &&
+       (print_level >= 1 || (print_level >= 0 && !converged)))
+   {
+      cout << "Average reduction factor = "
+           << pow (nom/nom0, 0.5/final_iter) << '\n';
+   }
+}
+
+
+// Number of eigenvalues smaller than x of the symmetric tridiagonal matrix
+// with diagonal a and squared off-diagonal b2 (Sturm sequence count).
+static int SturmCount(int n, const double *a, const double *b2, double x)
+{
+   int count = 0;
+   double q = 1.0;
+   for (int i = 0; i < n; i++)
+   {
+      q = a[i] - x - ((i > 0) ? b2[i-1]/q : 0.0);
+      if (q == 0.0) { q = -1e-300; }
+      if (q < 0.0) { count++; }
+   }
+   return count;
+}
+
+ChebyshevSmoother::ChebyshevSmoother(const Operator &A, const Vector &diag,
+                                     int _order, double _eig_ratio,
+                                     int eig_iter)
+   : Solver(A.Height())
+{
+#ifdef MFEM_USE_MPI
+   comm = MPI_COMM_NULL;
+#endif
+   Init(A, diag, _order, _eig_ratio, eig_iter);
+}
+
+#ifdef MFEM_USE_MPI
+ChebyshevSmoother::ChebyshevSmoother(MPI_Comm _comm, const Operator &A,
+                                     const Vector &diag, int _order,
+                                     double _eig_ratio, int eig_iter)
+   : Solver(A.Height()), comm(_comm)
+{
+   Init(A, diag, _order, _eig_ratio, eig_iter);
+}
+#endif
+
+void ChebyshevSmoother::Init(const Operator &A, const Vector &diag,
+                             int _order, double _eig_ratio, int eig_iter)
+{
+   MFEM_VERIFY(A.Height() == A.Width() && diag.Size() == A.Height(),
+               "incompatible operator and scaling");
+   MFEM_VERIFY(_order >= 1, "invalid polynomial order " << _order);
+   MFEM_VERIFY(0.0 < _eig_ratio && _eig_ratio < 1.0,
+               "invalid eigenvalue ratio " << _eig_ratio);
+
+   oper = &A;
+   order = _order;
+   eig_ratio = _eig_ratio;
+
+   dinv.SetSize(height);
+   bool positive = true;
+   for (int i = 0; i < height; i++)
+   {
+      positive = positive && (diag(i) > 0.0);
+      dinv(i) = 1.0/diag(i);
+   }
+   MFEM_VERIFY(positive, "the scaling must be positive");
+
+   r.SetSize(height);
+   d.SetSize(height);
+   z.SetSize(height);
+
+   EstimateEigenvalues(eig_iter);
+}
+
+double ChebyshevSmoother::Dot(const Vector &x, const Vector &y) const
+{
+   double dot = x * y;
+#ifdef MFEM_USE_MPI
+   if (comm != MPI_COMM_NULL)
+   {
+      double local_dot = dot;
+      MPI_Allreduce(&local_dot, &dot, 1, MPI_DOUBLE, MPI_SUM, comm);
+   }
+#endif
+   return dot;
+}
+
+void ChebyshevSmoother::EstimateEigenvalues(int iter)
+{
+   MFEM_VERIFY(iter >= 1, "invalid number of iterations " << iter);
+
+   // CG for D^{-1} A with a random right-hand side; the coefficients of the
+   // first n iterations define the n x n Lanczos matrix T, with diagonal a
+   // and squared off-diagonal b2.
+   Vector a(iter), b2(iter), ad(height);
+   r.Randomize(1);
+   for (int i = 0; i < height; i++)
+   {
+      r(i) = 2.0*r(i) - 1.0;
+      z(i) = dinv(i)*r(i);
+   }
+   d = z;
+   double nom = Dot(z, r), alpha_old = 0.0, beta_old = 0.0;
+   int n = 0;
+   while (n < iter && nom > 0.0)
+   {
+      oper->Mult(d, ad);
+      const double den = Dot(d, ad);
+      MFEM_VERIFY(den > 0.0, "the operator is not positive definite");
+      const double alpha = nom/den;
+
+      a(n) = 1.0/alpha + ((n > 0) ? beta_old/alpha_old : 0.0);
+      if (n > 0) { b2(n-1) = beta_old/(alpha_old*alpha_old); }
+      n++;
+
+      for (int i = 0; i < height; i++)
+      {
+         r(i) -= alpha*ad(i);
+         z(i) = dinv(i)*r(i);
+      }
+      const double nom_new = Dot(z, r);
+      const double beta = nom_new/nom;
+      for (int i = 0; i < height; i++)
+      {
+         d(i) = z(i) + beta*d(i);
+      }
+      nom = nom_new;
+      alpha_old = alpha;
+      beta_old = beta;
+   }
+
+   // largest eigenvalue of T by bisection, starting from Gershgorin bounds
+   double lo = 0.0, hi = 1.0;
+   if (n > 0)
+   {
+      lo = hi = a(0);
+      for (int i = 0; i < n; i++)
+      {
+         const double off = ((i > 0) ? sqrt(b2(i-1)) : 0.0) +
+                            ((i < n-1) ? sqrt(b2(i)) : 0.0);
+         lo = std::min(lo, a(i) - off);
+         hi = std::max(hi, a(i) + off);
+      }
+      while (hi - lo > 1e-8*hi)
+      {
+         const double mid = 0.5*(lo + hi);
+         if (SturmCount(n, a.GetData(), b2.GetData(), mid) == n)
+         {
+            hi = mid;
+         }
+         else
+         {
+            lo = mid;
+         }
+      }
+   }
+
+   // the Lanczos estimate is below the largest eigenvalue
+   max_eig = 1.1*hi;
+   min_eig = eig_ratio*max_eig;
+}
+
+void ChebyshevSmoother::Mult(const Vector &b, Vector &x) const
+{
+   const double theta = 0.5*(max_eig + min_eig);
+   const double delta = 0.5*(max_eig - min_eig);
+   const double sigma = theta/delta;
+   double rho = 1.0/sigma;
+
+   const double *di = dinv.GetData(), *bp = b.GetData();
+   double *rp = r.GetData(), *dp = d.GetData(), *zp = z.GetData();
+   const int s = height;
+
+   // r = D^{-1} (b - A x), d = r/theta
+   if (iterative_mode)
+   {
+      oper->Mult(x, z);
+   }
+   else
+   {
+      x = 0.0;
+      z = 0.0;
+   }
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for
+#endif
+   for (int i = 0; i < s; i++)
+   {
+      rp[i] = di[i]*(bp[i] - zp[i]);
+      dp[i] = rp[i]/theta;
+   }
+
+   for (int k = 1; true; k++)
+   {
+      x += d;
+      if (k == order) { break; }
+
+      // r = r - D^{-1} A d, d = rho_new rho d + 2 rho_new/delta r
+      oper->Mult(d, z);
+      const double rho_new = 1.0/(2.0*sigma - rho);
+      const double c_d = rho_new*rho, c_r = 2.0*rho_new/delta;
+#ifdef MFEM_USE_OPENMP
+      #pragma omp parallel for
+#endif
+      for (int i = 0; i < s; i++)
+      {
+         rp[i] -= di[i]*zp[i];
+         dp[i] = c_d*dp[i] + c_r*rp[i];
+      }
+      rho = rho_new;
+   }
+}
+
+void ChebyshevSmoother::SetOperator(const Operator &op)
+{
+   MFEM_VERIFY(op.Height() == height && op.Width() == width,
+               "the new operator must have the size of the scaling");
+   oper = &op;
+}
+
+
 void NewtonSolver::SetOperator(const Operator &op)
 {
    oper = &op;
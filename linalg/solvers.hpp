@@ -14,6 +14,7 @@
 
 #include "../config/config.hpp"
 #include "operator.hpp"
+#include "densemat.hpp"
 
 #ifdef MFEM_USE_MPI
 #include <mpi.h>
@@ -35,6 +36,9 @@ class IterativeSolver : public Solver
 private:
    int dot_prod_type; // 0 - local, 1 - global over 'comm'
    MPI_Comm comm;
+   mutable MPI_Request reduction_request;
+   mutable double *reduction_buf;
+   mutable int reduction_size;
 #endif
 
 protected:
@@ -49,8 +53,19 @@ protected:
    mutable double final_norm;
 
    double Dot(const Vector &x, const Vector &y) const;
+   /// d(j) = (x_j, y_j) for all vectors, with a single global reduction.
+   void Dot(const MultiVector &x, const MultiVector &y, Vector &d) const;
    double Norm(const Vector &x) const { return sqrt(Dot(x, x)); }
 
+   /** @brief Start the global sum of the @a n local values in @a buf, which
+       is done in place. The result is available after WaitReduction().
+
+       With MPI-3, a non-blocking MPI_Iallreduce is used, so that the work
+       between the two calls overlaps with the communication. */
+   void StartReduction(double *buf, int n) const;
+   /// Complete the reduction started with StartReduction().
+   void WaitReduction() const;
+
 public:
    IterativeSolver();
 
@@ -63,6 +78,11 @@ public:
    void SetMaxIter(int max_it) { max_iter = max_it; }
    void SetPrintLevel(int print_lvl);
 
+   double GetRelTol() const { return rel_tol; }
+   double GetAbsTol() const { return abs_tol; }
+   int GetMaxIter() const { return max_iter; }
+   int GetPrintLevel() const { return print_level; }
+
    int GetNumIterations() const { return final_iter; }
    int GetConverged() const { return converged; }
    double GetFinalNorm() const { return final_norm; }
@@ -112,6 +132,7 @@ class CGSolver : public IterativeSolver
 {
 protected:
    mutable Vector r, d, z;
+   mutable MultiVector R, D, Z; // used by the multiple right-hand side version
 
    void UpdateVectors();
 
@@ -126,6 +147,16 @@ public:
    { IterativeSolver::SetOperator(op); UpdateVectors(); }
 
    virtual void Mult(const Vector &b, Vector &x) const;
+
+   /** @brief Solve for several right-hand sides at once.
+
+       Each right-hand side has its own CG recurrence, but the operator and the
+       preconditioner are applied to all vectors together and the inner
+       products of an iteration are summed in one reduction. A vector is no
+       longer updated once it satisfies the convergence test; the solver has
+       converged when all vectors have, and GetFinalNorm() returns the largest
+       sqrt((B r, r)). */
+   virtual void Mult(const MultiVector &b, MultiVector &x) const;
 };
 
 /// Conjugate gradient method. (tolerances are squared)
@@ -222,6 +253,8 @@ class MINRESSolver : public IterativeSolver
 protected:
    mutable Vector v0, v1, w0, w1, q;
    mutable Vector u1; // used in the preconditioned version
+   // used by the multiple right-hand side version
+   mutable MultiVector V0, V1, W0, W1, Q, U1;
 
 public:
    MINRESSolver() { }
@@ -239,6 +272,16 @@ public:
    virtual void SetOperator(const Operator &op);
 
    virtual void Mult(const Vector &b, Vector &x) const;
+
+   /** @brief Solve for several right-hand sides at once, with one Lanczos
+       process per vector.
+
+       The operator and the preconditioner are applied to all vectors together
+       and the inner products of an iteration are summed in one reduction. The
+       solution of a vector is no longer updated once its residual estimate
+       satisfies the convergence test; GetFinalNorm() returns the largest
+       estimate. */
+   virtual void Mult(const MultiVector &b, MultiVector &x) const;
 };
 
 /// MINRES method without preconditioner. (tolerances are squared)
@@ -251,6 +294,171 @@ void MINRES(const Operator &A, Solver &B, const Vector &b, Vector &x,
             double rtol = 1e-12, double atol = 1e-24);
 
 
+/** @brief Pipelined conjugate gradient method (Ghysels and Vanroose).
+
+    Mathematically equivalent to CGSolver, but the two inner products of an
+    iteration are combined in one global reduction which is overlapped with
+    the application of the preconditioner and of the operator. This hides
+    the latency of the reductions at large process counts, at the cost of
+    more vector updates and of a slightly lower attainable accuracy. The
+    convergence test uses the same quantity (B r, r) as CGSolver. */
+class PipelinedCGSolver : public IterativeSolver
+{
+protected:
+   mutable Vector r, u, w, m, n, p, s, q, z;
+
+   void UpdateVectors();
+
+public:
+   PipelinedCGSolver() { }
+
+#ifdef MFEM_USE_MPI
+   PipelinedCGSolver(MPI_Comm _comm) : IterativeSolver(_comm) { }
+#endif
+
+   virtual void SetOperator(const Operator &op)
+   { IterativeSolver::SetOperator(op); UpdateVectors(); }
+
+   virtual void Mult(const Vector &b, Vector &x) const;
+};
+
+/** @brief Pipelined MINRES method with an SPD preconditioner.
+
+    The preconditioned Lanczos process of MINRESSolver is reformulated so that
+    the inner products of an iteration, (z, A z) and (A z, B A z), are
+    combined in one global reduction, overlapped with the application of the
+    operator and of the preconditioner. The next Lanczos coefficient is then
+    computed as beta^2 = (A z, B A z) - alpha^2 - beta_old^2, which is
+    mathematically equivalent but sensitive to the drift of the recurrences
+    for A z and B A z. When the drift is detected, or beta^2 <= 0, the method
+    restarts from the current iterate with the true residual, so it may need
+    more iterations than MINRESSolver for tight tolerances. The residual norm
+    estimate ||r||_B is the same as in MINRESSolver. */
+class PipelinedMINRESSolver : public IterativeSolver
+{
+protected:
+   // Lanczos vectors z (preconditioned), w = A z, m = B w at the current and
+   // previous step, n = A m, p = B n, and the MINRES search directions
+   mutable Vector z0, z1, w0, w1, m0, m1, n, p, d0, d1;
+
+   void UpdateVectors();
+
+public:
+   PipelinedMINRESSolver() { }
+
+#ifdef MFEM_USE_MPI
+   PipelinedMINRESSolver(MPI_Comm _comm) : IterativeSolver(_comm) { }
+#endif
+
+   virtual void SetOperator(const Operator &op)
+   { IterativeSolver::SetOperator(op); UpdateVectors(); }
+
+   virtual void Mult(const Vector &b, Vector &x) const;
+};
+
+/** @brief s-step (communication-avoiding) conjugate gradient method of
+    Chronopoulos and Gear.
+
+    Every outer iteration builds the basis B r, (B A) B r, ..., (B A)^{s-1} B r
+    with s applications of the operator and the preconditioner and performs
+    the equivalent of s CG iterations with a single global reduction of the
+    Gram matrices. The monomial basis becomes ill-conditioned for larger s,
+    so s <= 5 is recommended. The convergence test is the one of CGSolver,
+    checked every s iterations; GetNumIterations() counts the inner steps. */
+class SStepCGSolver : public IterativeSolver
+{
+protected:
+   int s_step;
+   mutable Vector r;
+   // the s basis vectors V and A V, the directions P and A P of the previous
+   // outer iteration, stored as the columns of the matrices
+   mutable DenseMatrix V, AV, P, AP;
+
+   void UpdateVectors();
+
+public:
+   SStepCGSolver() : s_step(4) { }
+
+#ifdef MFEM_USE_MPI
+   SStepCGSolver(MPI_Comm _comm) : IterativeSolver(_comm), s_step(4) { }
+#endif
+
+   /// Set the number of CG steps per global reduction (default 4).
+   void SetStepSize(int s) { s_step = s; UpdateVectors(); }
+
+   virtual void SetOperator(const Operator &op)
+   { IterativeSolver::SetOperator(op); UpdateVectors(); }
+
+   virtual void Mult(const Vector &b, Vector &x) const;
+};
+
+
+/** @brief Chebyshev polynomial smoother: x <- x + p(D^{-1} A) D^{-1} (b - A x),
+    for a symmetric positive definite operator A and a positive scaling D.
+
+    The polynomial of the given order is the Chebyshev polynomial for the
+    interval [eig_ratio lmax, lmax] of the spectrum of D^{-1} A, so that the
+    upper part of the spectrum is damped. The estimate lmax of the largest
+    eigenvalue is computed in the constructor with a few steps of
+    D^{-1}-preconditioned CG: the CG coefficients give the Lanczos tridiagonal
+    matrix, whose largest eigenvalue is found by bisection.
+
+    D is usually the diagonal of A (Chebyshev) or the l1 norms of its rows
+    (l1-Chebyshev, which is more robust for strongly coupled systems). The
+    smoother only needs the action of A, so it can be used for BlockOperators.
+    Since the polynomial is symmetric, MultTranspose() is the same as Mult(). */
+class ChebyshevSmoother : public Solver
+{
+protected:
+   const Operator *oper;
+   Vector dinv;
+   int order;
+   double max_eig, min_eig, eig_ratio;
+#ifdef MFEM_USE_MPI
+   MPI_Comm comm;
+#endif
+
+   mutable Vector r, d, z;
+
+   double Dot(const Vector &x, const Vector &y) const;
+   void Init(const Operator &A, const Vector &diag, int order,
+             double eig_ratio, int eig_iter);
+
+public:
+   /** @brief Create a smoother of the given @a order for A with the scaling
+       @a diag, estimating the largest eigenvalue with @a eig_iter CG steps. */
+   ChebyshevSmoother(const Operator &A, const Vector &diag, int order = 2,
+                     double eig_ratio = 0.3, int eig_iter = 10);
+
+#ifdef MFEM_USE_MPI
+   /// Parallel version: the inner products are summed over @a comm.
+   ChebyshevSmoother(MPI_Comm comm, const Operator &A, const Vector &diag,
+                     int order = 2, double eig_ratio = 0.3, int eig_iter = 10);
+#endif
+
+   /** @brief Estimate the largest eigenvalue of D^{-1} A with @a iter steps of
+       preconditioned CG started from a random vector and set the damped
+       interval to [eig_ratio lmax, lmax], where lmax is 10% above the
+       estimate. */
+   void EstimateEigenvalues(int iter);
+
+   /// Set the interval of the spectrum of D^{-1} A that is damped.
+   void SetEigenvalueBounds(double min, double max)
+   { min_eig = min; max_eig = max; }
+
+   double GetMaxEigenvalue() const { return max_eig; }
+   double GetMinEigenvalue() const { return min_eig; }
+
+   virtual void Mult(const Vector &b, Vector &x) const;
+   virtual void MultTranspose(const Vector &b, Vector &x) const
+   { Mult(b, x); }
+
+   /** @brief Replace the operator by @a op of the same size, keeping the
+       scaling and the eigenvalue bounds. */
+   virtual void SetOperator(const Operator &op);
+};
+
+
 /// Newton's method for solving F(x)=b for a given operator F.
 /** The method GetGradient() must be implemented for the operator F.
     The preconditioner is used (in non-iterative mode) to evaluate
@@ -22,6 +22,10 @@
 #include <limits>
 #include <cstring>
 
+#ifdef MFEM_USE_OPENMP
+#include <omp.h>
+#endif
+
 namespace mfem
 {
 
@@ -38,7 +42,9 @@ SparseMatrix::SparseMatrix(int nrows, int ncols)
      ColPtrNode(NULL),
      ownGraph(true),
      ownData(true),
-     isSorted(false)
+     isSorted(false),
+     sell(NULL),
+     At(NULL)
 {
    for (int i = 0; i < nrows; i++)
    {
@@ -60,7 +66,9 @@ SparseMatrix::SparseMatrix(int *i, int *j, double *data, int m, int n)
      ColPtrNode(NULL),
      ownGraph(true),
      ownData(true),
-     isSorted(false)
+     isSorted(false),
+     sell(NULL),
+     At(NULL)
 {
 #ifdef MFEM_USE_MEMALLOC
    NodesMem = NULL;
@@ -78,7 +86,9 @@ SparseMatrix::SparseMatrix(int *i, int *j, double *data, int m, int n,
      ColPtrNode(NULL),
      ownGraph(ownij),
      ownData(owna),
-     isSorted(issorted)
+     isSorted(issorted),
+     sell(NULL),
+     At(NULL)
 {
 #ifdef MFEM_USE_MEMALLOC
    NodesMem = NULL;
@@ -104,6 +114,8 @@ SparseMatrix::SparseMatrix(int nrows, int ncols, int rowsize)
    , ownGraph(true)
    , ownData(true)
    , isSorted(false)
+   , sell(NULL)
+   , At(NULL)
 {
 #ifdef MFEM_USE_MEMALLOC
    NodesMem = NULL;
@@ -182,6 +194,8 @@ SparseMatrix::SparseMatrix(const SparseMatrix &mat, bool copy_graph)
    ColPtrJ = NULL;
    ColPtrNode = NULL;
    isSorted = mat.isSorted;
+   sell = NULL;
+   At = NULL;
 }
 
 void SparseMatrix::MakeRef(const SparseMatrix &master)
@@ -208,6 +222,8 @@ void SparseMatrix::SetEmpty()
    NodesMem = NULL;
 #endif
    ownGraph = ownData = isSorted = false;
+   sell = NULL;
+   At = NULL;
 }
 
 int SparseMatrix::RowSize(const int i) const
@@ -508,6 +524,12 @@ void SparseMatrix::AddMult(const Vector &x, Vector &y, const double a) const
       return;
    }
 
+   if (sell)
+   {
+      sell->AddMult(x, y, a);
+      return;
+   }
+
    int *Jp = J, *Ip = I;
 
    if (a == 1.0)
@@ -537,6 +559,7 @@ void SparseMatrix::AddMult(const Vector &x, Vector &y, const double a) const
    }
    else
    {
+#ifndef MFEM_USE_OPENMP
       for (i = j = 0; i < height; i++)
       {
          double d = 0.0;
@@ -546,6 +569,81 @@ void SparseMatrix::AddMult(const Vector &x, Vector &y, const double a) const
          }
          yp[i] += a * d;
       }
+#else
+      #pragma omp parallel for private(j,end)
+      for (i = 0; i < height; i++)
+      {
+         double d = 0.0;
+         for (j = Ip[i], end = Ip[i+1]; j < end; j++)
+         {
+            d += Ap[j] * xp[Jp[j]];
+         }
+         yp[i] += a * d;
+      }
+#endif
+   }
+}
+
+void SparseMatrix::Mult(const MultiVector &x, MultiVector &y) const
+{
+   y = 0.0;
+   AddMult(x, y);
+}
+
+void SparseMatrix::AddMult(const MultiVector &x, MultiVector &y,
+                           const double a) const
+{
+   MFEM_ASSERT(width == x.Size() && height == y.Size() &&
+               x.NumVectors() == y.NumVectors(),
+               "incompatible MultiVectors: x is " << x.Size() << " x "
+               << x.NumVectors() << ", y is " << y.Size() << " x "
+               << y.NumVectors() << ", the matrix is " << height << " x "
+               << width);
+
+   const int nv = x.NumVectors();
+   if (A == NULL || nv == 1)
+   {
+      Vector xj, yj;
+      for (int k = 0; k < nv; k++)
+      {
+         x.GetVectorReference(k, xj);
+         y.GetVectorReference(k, yj);
+         AddMult(xj, yj, a);
+      }
+      return;
+   }
+
+   // Process the vectors in groups of (up to) four: every row of the matrix is
+   // read once per group and the products are accumulated in registers.
+   const int gs = 4;
+   const int *Ip = I, *Jp = J;
+   const double *Ap = A;
+   for (int k0 = 0; k0 < nv; k0 += gs)
+   {
+      const int ng = std::min(gs, nv - k0);
+      const double *xp = x.GetVectorData(k0);
+      double *yp = y.GetVectorData(k0);
+      const int xs = x.Size(), ys = y.Size();
+#ifdef MFEM_USE_OPENMP
+      #pragma omp parallel for
+#endif
+      for (int i = 0; i < height; i++)
+      {
+         double d[gs] = { 0.0, 0.0, 0.0, 0.0 };
+         for (int j = Ip[i], end = Ip[i+1]; j < end; j++)
+         {
+            const double aij = Ap[j];
+            const double *xj = xp + Jp[j];
+            for (int k = 0; k < ng; k++)
+            {
+               d[k] += aij * xj[k*xs];
+            }
+         }
+         for (int k = 0; k < ng; k++)
+         {
+            yp[i + k*ys] += a * d[k];
+         }
+      }
    }
 }
 
@@ -583,6 +681,12 @@ void SparseMatrix::AddMultTranspose(const Vector &x, Vector &y,
       return;
    }
 
+   if (At)
+   {
+      At->AddMult(x, y, a);
+      return;
+   }
+
    for (i = 0; i < height; i++)
    {
       double xi = a * x(i);
@@ -594,6 +698,32 @@ void SparseMatrix::AddMultTranspose(const Vector &x, Vector &y,
    }
 }
 
+void SparseMatrix::BuildSellCSigma(int C, int sigma)
+{
+   MFEM_VERIFY(Finalized(), "the matrix must be finalized");
+   delete sell;
+   sell = new SellCSigmaMatrix(*this, C, sigma);
+}
+
+void SparseMatrix::ResetSellCSigma()
+{
+   delete sell;
+   sell = NULL;
+}
+
+void SparseMatrix::BuildTranspose() const
+{
+   MFEM_VERIFY(Finalized(), "the matrix must be finalized");
+   delete At;
+   At = Transpose(*this);
+}
+
+void SparseMatrix::ResetTranspose() const
+{
+   delete At;
+   At = NULL;
+}
+
 void SparseMatrix::PartMult(
    const Array<int> &rows, const Vector &x, Vector &y) const
 {
@@ -2517,6 +2647,39 @@ void SparseMatrix::PrintInfo(std::ostream &out) const
    }
 }
 
+long SparseMatrix::MemoryUsage() const
+{
+   long mem = 0;
+   if (I != NULL && ownGraph)
+   {
+      mem += (height+1 + I[height])*sizeof(int);
+   }
+   if (A != NULL && ownData)
+   {
+      mem += I[height]*sizeof(double);
+   }
+   if (Rows != NULL)
+   {
+      mem += height*sizeof(RowNode*);
+#ifdef MFEM_USE_MEMALLOC
+      mem += NodesMem->MemoryUsage();
+#else
+      for (int i = 0; i < height; i++)
+      {
+         for (RowNode *aux = Rows[i]; aux != NULL; aux = aux->Prev)
+         {
+            mem += sizeof(RowNode);
+         }
+      }
+#endif
+   }
+   if (ColPtrJ != NULL) { mem += width*sizeof(int); }
+   if (ColPtrNode != NULL) { mem += width*sizeof(RowNode*); }
+   if (sell) { mem += sell->MemoryUsage(); }
+   if (At) { mem += At->MemoryUsage(); }
+   return mem;
+}
+
 void SparseMatrix::Destroy()
 {
    if (I != NULL && ownGraph)
@@ -2563,6 +2726,9 @@ void SparseMatrix::Destroy()
       delete NodesMem;
    }
 #endif
+
+   delete sell;
+   delete At;
 }
 
 int SparseMatrix::ActualWidth()
@@ -2608,51 +2774,80 @@ SparseMatrix *Transpose (const SparseMatrix &A)
       A.Finalized(),
       "Finalize must be called before Transpose. Use TransposeRowMatrix instead");
 
-   int i, j, end;
-   int m, n, nnz, *A_i, *A_j, *At_i, *At_j;
-   double *A_data, *At_data;
-
-   m      = A.Height(); // number of rows of A
-   n      = A.Width();  // number of columns of A
-   nnz    = A.NumNonZeroElems();
-   A_i    = A.GetI();
-   A_j    = A.GetJ();
-   A_data = A.GetData();
-
-   At_i = new int[n+1];
-   At_j = new int[nnz];
-   At_data = new double[nnz];
-
-   for (i = 0; i <= n; i++)
-   {
-      At_i[i] = 0;
-   }
-   for (i = 0; i < nnz; i++)
-   {
-      At_i[A_j[i]+1]++;
-   }
-   for (i = 1; i < n; i++)
-   {
-      At_i[i+1] += At_i[i];
-   }
-
-   for (i = j = 0; i < m; i++)
+   const int m = A.Height(); // number of rows of A
+   const int n = A.Width();  // number of columns of A
+   const int nnz = A.NumNonZeroElems();
+   const int *A_i = A.GetI(), *A_j = A.GetJ();
+   const double *A_data = A.GetData();
+
+   int *At_i = new int[n+1];
+   int *At_j = new int[nnz];
+   double *At_data = new double[nnz];
+
+   // Each thread counts and scatters the entries of a contiguous block of rows
+   // of A, so the rows of At are ordered by increasing column index as in a
+   // serial transpose. The threads need n counters each; their number is
+   // limited so that the counters take no more memory than the column
+   // indices of A, which also keeps num_threads*n within the int range.
+#ifdef MFEM_USE_OPENMP
+   const int num_threads =
+      std::max(1, std::min(omp_get_max_threads(), (n > 0) ? nnz/n : 1));
+#else
+   const int num_threads = 1;
+#endif
+   Array<int> offsets(num_threads*n);
+   At_i[0] = 0;
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel num_threads(num_threads)
+#endif
    {
-      end = A_i[i+1];
-      for ( ; j < end; j++)
+#ifdef MFEM_USE_OPENMP
+      const int nt = omp_get_num_threads(), t = omp_get_thread_num();
+#else
+      const int nt = 1, t = 0;
+#endif
+      const int lo = (int)((long)m*t/nt), hi = (int)((long)m*(t+1)/nt);
+      int *cnt = offsets.GetData() + t*n;
+      for (int c = 0; c < n; c++) { cnt[c] = 0; }
+      for (int j = A_i[lo]; j < A_i[hi]; j++) { cnt[A_j[j]]++; }
+#ifdef MFEM_USE_OPENMP
+      #pragma omp barrier
+      #pragma omp for
+#endif
+      for (int c = 0; c < n; c++)
       {
-         At_j[At_i[A_j[j]]] = i;
-         At_data[At_i[A_j[j]]] = A_data[j];
-         At_i[A_j[j]]++;
+         int sum = 0;
+         for (int s = 0; s < nt; s++) { sum += offsets[s*n+c]; }
+         At_i[c+1] = sum;
+      }
+#ifdef MFEM_USE_OPENMP
+      #pragma omp single
+#endif
+      for (int c = 0; c < n; c++) { At_i[c+1] += At_i[c]; }
+#ifdef MFEM_USE_OPENMP
+      #pragma omp for
+#endif
+      for (int c = 0; c < n; c++)
+      {
+         int offset = At_i[c];
+         for (int s = 0; s < nt; s++)
+         {
+            const int k = offsets[s*n+c];
+            offsets[s*n+c] = offset;
+            offset += k;
+         }
+      }
+      for (int i = lo; i < hi; i++)
+      {
+         for (int j = A_i[i]; j < A_i[i+1]; j++)
+         {
+            const int dst = cnt[A_j[j]]++;
+            At_j[dst] = i;
+            At_data[dst] = A_data[j];
+         }
       }
    }
 
-   for (i = n; i > 0; i--)
-   {
-      At_i[i] = At_i[i-1];
-   }
-   At_i[0] = 0;
-
    return  new SparseMatrix (At_i, At_j, At_data, n, m);
 }
 
@@ -2736,74 +2931,30 @@ SparseMatrix *TransposeAbstractSparseMatrix (const AbstractSparseMatrix &A,
 SparseMatrix *Mult (const SparseMatrix &A, const SparseMatrix &B,
                     SparseMatrix *OAB)
 {
-   int nrowsA, ncolsA, nrowsB, ncolsB;
-   int *A_i, *A_j, *B_i, *B_j, *C_i, *C_j, *B_marker;
-   double *A_data, *B_data, *C_data;
-   int ia, ib, ic, ja, jb, num_nonzeros;
-   int row_start, counter;
-   double a_entry, b_entry;
-   SparseMatrix *C;
-
-   nrowsA = A.Height();
-   ncolsA = A.Width();
-   nrowsB = B.Height();
-   ncolsB = B.Width();
+   const int nrowsA = A.Height();
+   const int ncolsA = A.Width();
+   const int nrowsB = B.Height();
+   const int ncolsB = B.Width();
 
    MFEM_VERIFY(ncolsA == nrowsB,
                "number of columns of A (" << ncolsA
                << ") must equal number of rows of B (" << nrowsB << ")");
 
-   A_i    = A.GetI();
-   A_j    = A.GetJ();
-   A_data = A.GetData();
-   B_i    = B.GetI();
-   B_j    = B.GetJ();
-   B_data = B.GetData();
-
-   B_marker = new int[ncolsB];
+   const int *A_i = A.GetI(), *A_j = A.GetJ();
+   const int *B_i = B.GetI(), *B_j = B.GetJ();
+   const double *A_data = A.GetData(), *B_data = B.GetData();
+   int *C_i, *C_j = NULL;
+   double *C_data = NULL;
+   SparseMatrix *C = OAB;
+   const bool symbolic = (OAB == NULL);
 
-   for (ib = 0; ib < ncolsB; ib++)
-   {
-      B_marker[ib] = -1;
-   }
-
-   if (OAB == NULL)
+   if (symbolic)
    {
       C_i = new int[nrowsA+1];
-
-      C_i[0] = num_nonzeros = 0;
-      for (ic = 0; ic < nrowsA; ic++)
-      {
-         for (ia = A_i[ic]; ia < A_i[ic+1]; ia++)
-         {
-            ja = A_j[ia];
-            for (ib = B_i[ja]; ib < B_i[ja+1]; ib++)
-            {
-               jb = B_j[ib];
-               if (B_marker[jb] != ic)
-               {
-                  B_marker[jb] = ic;
-                  num_nonzeros++;
-               }
-            }
-         }
-         C_i[ic+1] = num_nonzeros;
-      }
-
-      C_j    = new int[num_nonzeros];
-      C_data = new double[num_nonzeros];
-
-      C = new SparseMatrix (C_i, C_j, C_data, nrowsA, ncolsB);
-
-      for (ib = 0; ib < ncolsB; ib++)
-      {
-         B_marker[ib] = -1;
-      }
+      C_i[0] = 0;
    }
    else
    {
-      C = OAB;
-
       MFEM_VERIFY(nrowsA == C -> Height() && ncolsB == C -> Width(),
                   "Input matrix sizes do not match output sizes"
                   << " nrowsA = " << nrowsA
@@ -2816,45 +2967,126 @@ SparseMatrix *Mult (const SparseMatrix &A, const SparseMatrix &B,
       C_data = C -> GetData();
    }
 
-   counter = 0;
-   for (ic = 0; ic < nrowsA; ic++)
+   // The rows of C are computed independently, each thread using its own
+   // marker array; the static schedule gives every thread a contiguous block
+   // of rows, which are processed in increasing order.
+   int missing = 0;
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel
+#endif
    {
-      // row_start = C_i[ic];
-      row_start = counter;
-      for (ia = A_i[ic]; ia < A_i[ic+1]; ia++)
+      Array<int> B_marker(ncolsB);
+      B_marker = -1;
+
+      if (symbolic)
       {
-         ja = A_j[ia];
-         a_entry = A_data[ia];
-         for (ib = B_i[ja]; ib < B_i[ja+1]; ib++)
+         // Symbolic phase: count the entries in each row of C.
+#ifdef MFEM_USE_OPENMP
+         #pragma omp for schedule(static)
+#endif
+         for (int ic = 0; ic < nrowsA; ic++)
          {
-            jb = B_j[ib];
-            b_entry = B_data[ib];
-            if (B_marker[jb] < row_start)
+            int num = 0;
+            for (int ia = A_i[ic]; ia < A_i[ic+1]; ia++)
             {
-               B_marker[jb] = counter;
-               if (OAB == NULL)
+               const int ja = A_j[ia];
+               for (int ib = B_i[ja]; ib < B_i[ja+1]; ib++)
                {
-                  C_j[counter] = jb;
+                  const int jb = B_j[ib];
+                  if (B_marker[jb] != ic)
+                  {
+                     B_marker[jb] = ic;
+                     num++;
+                  }
                }
-               C_data[counter] = a_entry*b_entry;
-               counter++;
             }
-            else
+            C_i[ic+1] = num;
+         }
+#ifdef MFEM_USE_OPENMP
+         #pragma omp single
+#endif
+         {
+            for (int ic = 0; ic < nrowsA; ic++) { C_i[ic+1] += C_i[ic]; }
+            C_j    = new int[C_i[nrowsA]];
+            C_data = new double[C_i[nrowsA]];
+         }
+         B_marker = -1;
+
+         // Numeric phase, also setting the column indices in the order in
+         // which they are first reached.
+#ifdef MFEM_USE_OPENMP
+         #pragma omp for schedule(static)
+#endif
+         for (int ic = 0; ic < nrowsA; ic++)
+         {
+            const int row_start = C_i[ic];
+            int counter = row_start;
+            for (int ia = A_i[ic]; ia < A_i[ic+1]; ia++)
             {
-               C_data[B_marker[jb]] += a_entry*b_entry;
+               const int ja = A_j[ia];
+               const double a_entry = A_data[ia];
+               for (int ib = B_i[ja]; ib < B_i[ja+1]; ib++)
+               {
+                  const int jb = B_j[ib];
+                  if (B_marker[jb] < row_start)
+                  {
+                     B_marker[jb] = counter;
+                     C_j[counter] = jb;
+                     C_data[counter] = a_entry*B_data[ib];
+                     counter++;
+                  }
+                  else
+                  {
+                     C_data[B_marker[jb]] += a_entry*B_data[ib];
+                  }
+               }
+            }
+         }
+      }
+      else
+      {
+         // Numeric phase only, in the given sparsity pattern of C.
+#ifdef MFEM_USE_OPENMP
+         #pragma omp for schedule(static) reduction(+:missing)
+#endif
+         for (int ic = 0; ic < nrowsA; ic++)
+         {
+            const int row_start = C_i[ic], row_end = C_i[ic+1];
+            for (int k = row_start; k < row_end; k++)
+            {
+               B_marker[C_j[k]] = k;
+               C_data[k] = 0.0;
+            }
+            for (int ia = A_i[ic]; ia < A_i[ic+1]; ia++)
+            {
+               const int ja = A_j[ia];
+               const double a_entry = A_data[ia];
+               for (int ib = B_i[ja]; ib < B_i[ja+1]; ib++)
+               {
+                  const int k = B_marker[B_j[ib]];
+                  if (k >= row_start && k < row_end)
+                  {
+                     C_data[k] += a_entry*B_data[ib];
+                  }
+                  else
+                  {
+                     missing++;
+                  }
+               }
             }
          }
       }
    }
 
-   MFEM_VERIFY(
-      OAB == NULL || counter == OAB->NumNonZeroElems(),
-      "With pre-allocated output matrix, number of non-zeros ("
-      << OAB->NumNonZeroElems()
-      << ") did not match number of entries changed from matrix-matrix multiply, "
-      << counter);
+   MFEM_VERIFY(missing == 0,
+               "With pre-allocated output matrix, " << missing
+               << " products of the matrix-matrix multiply are outside of its"
+               " sparsity pattern");
 
-   delete [] B_marker;
+   if (symbolic)
+   {
+      C = new SparseMatrix (C_i, C_j, C_data, nrowsA, ncolsB);
+   }
 
    return C;
 }
@@ -2991,16 +3223,25 @@ SparseMatrix *RAP (const SparseMatrix &A, const SparseMatrix &R,
 }
 
 SparseMatrix *RAP(const SparseMatrix &Rt, const SparseMatrix &A,
-                  const SparseMatrix &P)
+                  const SparseMatrix &P, SparseMatrix *ORAP)
 {
    SparseMatrix * R = Transpose(Rt);
    SparseMatrix * RA = Mult(*R,A);
    delete R;
-   SparseMatrix * out = Mult(*RA, P);
+   SparseMatrix * out = Mult(*RA, P, ORAP);
    delete RA;
    return out;
 }
 
+SparseMatrix *TransposeMult(const SparseMatrix &A, const SparseMatrix &B,
+                            SparseMatrix *OAtB)
+{
+   SparseMatrix *At = Transpose(A);
+   SparseMatrix *AtB = Mult(*At, B, OAtB);
+   delete At;
+   return AtB;
+}
+
 SparseMatrix *Mult_AtDA (const SparseMatrix &A, const Vector &D,
                          SparseMatrix *OAtDA)
 {
@@ -3148,6 +3389,134 @@ void SparseMatrix::Swap(SparseMatrix &other)
    mfem::Swap(ownGraph, other.ownGraph);
    mfem::Swap(ownData, other.ownData);
    mfem::Swap(isSorted, other.isSorted);
+   mfem::Swap(sell, other.sell);
+   mfem::Swap(At, other.At);
+}
+
+
+SellCSigmaMatrix::SellCSigmaMatrix(const SparseMatrix &A, int C_, int sigma_)
+   : height(A.Height()), C(C_), sigma(sigma_)
+{
+   MFEM_VERIFY(A.Finalized(), "the matrix must be finalized");
+   MFEM_VERIFY(C == 1 || C == 2 || C == 4 || C == 8 || C == 16,
+               "unsupported chunk height C = " << C);
+   MFEM_VERIFY(sigma >= 1, "invalid sorting window sigma = " << sigma);
+
+   const int *I = A.GetI(), *J = A.GetJ();
+   const double *Adata = A.GetData();
+
+   num_chunks = (height + C - 1)/C;
+   perm.SetSize(num_chunks*C);
+   perm = -1;
+
+   // Sort the rows by decreasing length within each window of sigma rows
+   Array<Pair<int,int> > rows(std::min(sigma, height));
+   for (int w0 = 0; w0 < height; w0 += sigma)
+   {
+      const int wsize = std::min(sigma, height - w0);
+      for (int k = 0; k < wsize; k++)
+      {
+         const int i = w0 + k;
+         rows[k].one = -(I[i+1] - I[i]);
+         rows[k].two = i;
+      }
+      SortPairs<int,int>(rows, wsize);
+      for (int k = 0; k < wsize; k++)
+      {
+         perm[w0 + k] = rows[k].two;
+      }
+   }
+
+   chunk_offsets.SetSize(num_chunks+1);
+   chunk_offsets[0] = 0;
+   for (int c = 0; c < num_chunks; c++)
+   {
+      int width = 0;
+      for (int r = 0; r < C; r++)
+      {
+         const int i = perm[c*C + r];
+         if (i >= 0) { width = std::max(width, I[i+1] - I[i]); }
+      }
+      chunk_offsets[c+1] = chunk_offsets[c] + width*C;
+   }
+
+   // Store the chunks column by column; the padding entries are zeros
+   // multiplying x(0), so that the kernel needs no test for them
+   const int nnz = chunk_offsets[num_chunks];
+   col.SetSize(nnz);
+   val.SetSize(nnz);
+   for (int c = 0; c < num_chunks; c++)
+   {
+      const int width = (chunk_offsets[c+1] - chunk_offsets[c])/C;
+      for (int r = 0; r < C; r++)
+      {
+         const int i = perm[c*C + r];
+         const int len = (i >= 0) ? I[i+1] - I[i] : 0;
+         for (int k = 0; k < width; k++)
+         {
+            const int idx = chunk_offsets[c] + k*C + r;
+            if (k < len)
+            {
+               col[idx] = J[I[i] + k];
+               val[idx] = Adata[I[i] + k];
+            }
+            else
+            {
+               col[idx] = 0;
+               val[idx] = 0.0;
+            }
+         }
+      }
+   }
+}
+
+template <int C>
+static void SellCSigmaAddMult(int num_chunks, const int *offsets,
+                              const int *perm, const int *col,
+                              const double *val, const double *x, double *y,
+                              const double a)
+{
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for
+#endif
+   for (int c = 0; c < num_chunks; c++)
+   {
+      double d[C];
+      for (int r = 0; r < C; r++) { d[r] = 0.0; }
+      for (int k = offsets[c], end = offsets[c+1]; k < end; k += C)
+      {
+         // independent lanes: vectorized as a gather and a multiply-add
+         for (int r = 0; r < C; r++)
+         {
+            d[r] += val[k+r] * x[col[k+r]];
+         }
+      }
+      const int *p = perm + c*C;
+      for (int r = 0; r < C; r++)
+      {
+         if (p[r] >= 0) { y[p[r]] += a * d[r]; }
+      }
+   }
+}
+
+void SellCSigmaMatrix::AddMult(const Vector &x, Vector &y, const double a) const
+{
+   MFEM_ASSERT(height == y.Size(), "incompatible output vector size");
+
+   const int *o = chunk_offsets.GetData(), *p = perm.GetData();
+   const int *cp = col.GetData();
+   const double *vp = val.GetData(), *xp = x.GetData();
+   double *yp = y.GetData();
+   switch (C)
+   {
+      case 1: SellCSigmaAddMult<1>(num_chunks, o, p, cp, vp, xp, yp, a); break;
+      case 2: SellCSigmaAddMult<2>(num_chunks, o, p, cp, vp, xp, yp, a); break;
+      case 4: SellCSigmaAddMult<4>(num_chunks, o, p, cp, vp, xp, yp, a); break;
+      case 8: SellCSigmaAddMult<8>(num_chunks, o, p, cp, vp, xp, yp, a); break;
+      case 16:
+         SellCSigmaAddMult<16>(num_chunks, o, p, cp, vp, xp, yp, a); break;
+      default: MFEM_ABORT("unsupported chunk height C = " << C);
+   }
 }
 
 }
@@ -34,6 +34,8 @@ public:
    int Column;
 };
 
+class SellCSigmaMatrix;
+
 /// Data type sparse matrix
 class SparseMatrix : public AbstractSparseMatrix
 {
@@ -77,6 +79,11 @@ protected:
    /// Are the columns sorted already.
    bool isSorted;
 
+   /// Optional SELL-C-sigma copy used by AddMult(), see BuildSellCSigma().
+   SellCSigmaMatrix *sell;
+   /// Optional cached transpose used by AddMultTranspose().
+   mutable SparseMatrix *At;
+
    void Destroy();   // Delete all owned data
    void SetEmpty();  // Init all entries with empty values
 
@@ -186,6 +193,14 @@ public:
    /// y += A * x (default)  or  y += a * A * x
    void AddMult(const Vector &x, Vector &y, const double a = 1.0) const;
 
+   /// Matrix multiplication of several vectors, y_j = A * x_j.
+   virtual void Mult(const MultiVector &x, MultiVector &y) const;
+
+   /** @brief y_j += a * A * x_j for all vectors; the matrix entries are read
+       once for a group of vectors instead of once per vector. */
+   void AddMult(const MultiVector &x, MultiVector &y,
+                const double a = 1.0) const;
+
    /// Multiply a vector with the transposed matrix. y = At * x
    void MultTranspose(const Vector &x, Vector &y) const;
 
@@ -193,6 +208,30 @@ public:
    void AddMultTranspose(const Vector &x, Vector &y,
                          const double a = 1.0) const;
 
+   /** @brief Build a SELL-C-sigma copy of the finalized matrix which is then
+       used by Mult() and AddMult() instead of the CSR arrays. */
+   /** The rows are grouped in chunks of @a C rows (C = 1, 2, 4, 8 or 16),
+       sorted by length within windows of @a sigma rows, which allows the
+       products of the rows in a chunk to be vectorized. The copy is not
+       updated when the entries of the matrix are modified: call
+       ResetSellCSigma() or BuildSellCSigma() again after such changes. */
+   void BuildSellCSigma(int C = 8, int sigma = 256);
+   /// Delete the SELL-C-sigma copy, if any, and return to the CSR products.
+   void ResetSellCSigma();
+   /// Return the SELL-C-sigma copy of the matrix, or NULL if it is not built.
+   const SellCSigmaMatrix *GetSellCSigma() const { return sell; }
+
+   /** @brief Build and keep a copy of the transpose of the finalized matrix,
+       used by MultTranspose() and AddMultTranspose(). */
+   /** With the copy the transposed products are row-wise and thus threaded,
+       at the cost of storing the matrix twice. As with BuildSellCSigma(), the
+       copy is not updated when the entries of the matrix are modified. */
+   void BuildTranspose() const;
+   /// Delete the cached transpose, if any.
+   void ResetTranspose() const;
+   /// Check if a cached transpose is used by MultTranspose().
+   bool HasTranspose() const { return (At != NULL); }
+
    void PartMult(const Array<int> &rows, const Vector &x, Vector &y) const;
    void PartAddMult(const Array<int> &rows, const Vector &x, Vector &y,
                     const double a=1.0) const;
@@ -381,6 +420,10 @@ public:
    /// Returns the number of the nonzero elements in the matrix
    virtual int NumNonZeroElems() const;
 
+   /** @brief Return the memory owned by the matrix, in bytes: the CSR or LIL
+       storage, the SELL-C-sigma copy and the cached transpose, if any. */
+   long MemoryUsage() const;
+
    double MaxNorm() const;
 
    /// Count the number of entries with |a_ij| <= tol.
@@ -408,21 +451,63 @@ public:
    Type GetType() const { return MFEM_SPARSEMAT; }
 };
 
+/** @brief Sliced ELLPACK (SELL-C-sigma) storage of a finalized SparseMatrix,
+    see M. Kreutzer et al., SIAM J. Sci. Comput. 36(5), 2014. */
+/** The rows are sorted by decreasing length within windows of sigma rows and
+    the sorted rows are split into chunks of C rows. Every chunk is stored
+    column by column and is padded with zeros to the length of its longest
+    row, so the C rows of a chunk are processed together in the C lanes of
+    the SIMD registers. Sorting keeps the padding small when the row lengths
+    vary, e.g. for boundary rows. */
+class SellCSigmaMatrix
+{
+protected:
+   int height, C, sigma, num_chunks;
+   /// Offsets of the chunks in #col and #val, size num_chunks+1.
+   Array<int> chunk_offsets;
+   /// Original row of every sorted row, -1 for the padding rows.
+   Array<int> perm;
+   Array<int> col;
+   Array<double> val;
+
+public:
+   SellCSigmaMatrix(const SparseMatrix &A, int C_ = 8, int sigma_ = 256);
+
+   int Height() const { return height; }
+   int ChunkHeight() const { return C; }
+   int Sigma() const { return sigma; }
+   /// Number of stored entries, including the padding.
+   int NumStoredEntries() const { return val.Size(); }
+
+   /// y += a * A * x
+   void AddMult(const Vector &x, Vector &y, const double a = 1.0) const;
+
+   long MemoryUsage() const
+   {
+      return chunk_offsets.MemoryUsage() + perm.MemoryUsage() +
+             col.MemoryUsage() + val.MemoryUsage();
+   }
+};
+
 /// Applies f() to each element of the matrix (after it is finalized).
 void SparseMatrixFunction(SparseMatrix &S, double (*f)(double));
 
 
-/// Transpose of a sparse matrix. A must be finalized.
+/** @brief Transpose of a sparse matrix. A must be finalized. */
+/** With OpenMP the rows of A are split between the threads; the column
+    indices in each row of the result are sorted. */
 SparseMatrix *Transpose(const SparseMatrix &A);
 /// Transpose of a sparse matrix. A does not need to be a CSR matrix.
 SparseMatrix *TransposeAbstractSparseMatrix (const AbstractSparseMatrix &A,
                                              int useActualWidth);
 
 /** Matrix product A.B.
-    If OAB is not NULL, we assume it has the structure
-    of A.B and store the result in OAB.
-    If OAB is NULL, we create a new SparseMatrix to store
-    the result and return a pointer to it.
+    If OAB is not NULL, only the numeric phase is performed: the result is
+    stored in OAB, whose sparsity pattern must contain that of A.B (e.g. OAB
+    is the result of a previous product of matrices with the same structure).
+    If OAB is NULL, the sparsity pattern is computed first (symbolic phase),
+    and we create a new SparseMatrix to store the result and return a pointer
+    to it. With OpenMP both phases are threaded over the rows of A.
     All matrices must be finalized. */
 SparseMatrix *Mult(const SparseMatrix &A, const SparseMatrix &B,
                    SparseMatrix *OAB = NULL);
@@ -442,9 +527,15 @@ DenseMatrix *RAP(const SparseMatrix &A, DenseMatrix &P);
 SparseMatrix *RAP(const SparseMatrix &A, const SparseMatrix &R,
                   SparseMatrix *ORAP = NULL);
 
-/// General RAP with given R^T, A and P
+/** General RAP with given R^T, A and P. ORAP is like OAB above.
+    All matrices must be finalized. */
 SparseMatrix *RAP(const SparseMatrix &Rt, const SparseMatrix &A,
-                  const SparseMatrix &P);
+                  const SparseMatrix &P, SparseMatrix *ORAP = NULL);
+
+/** Matrix product A^t.B. OAtB is like OAB above.
+    All matrices must be finalized. */
+SparseMatrix *TransposeMult(const SparseMatrix &A, const SparseMatrix &B,
+                            SparseMatrix *OAtB = NULL);
 
 /// Matrix multiplication A^t D A. All matrices must be finalized.
 SparseMatrix *Mult_AtDA(const SparseMatrix &A, const Vector &D,
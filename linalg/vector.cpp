@@ -116,6 +116,9 @@ double Vector::operator*(const Vector &v) const
 
 Vector &Vector::operator=(const double *v)
 {
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for
+#endif
    for (int i = 0; i < size; i++)
    {
       data[i] = v[i];
@@ -126,26 +129,36 @@ Vector &Vector::operator=(const double *v)
 Vector &Vector::operator=(const Vector &v)
 {
    SetSize(v.Size());
+   const double *vp = v.data;
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for
+#endif
    for (int i = 0; i < size; i++)
    {
-      data[i] = v.data[i];
+      data[i] = vp[i];
    }
    return *this;
 }
 
 Vector &Vector::operator=(double value)
 {
-   int i, s = size;
+   const int s = size;
    double *p = data, v = value;
-   for (i = 0; i < s; i++)
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for
+#endif
+   for (int i = 0; i < s; i++)
    {
-      *(p++) = v;
+      p[i] = v;
    }
    return *this;
 }
 
 Vector &Vector::operator*=(double c)
 {
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for
+#endif
    for (int i = 0; i < size; i++)
    {
       data[i] *= c;
@@ -156,6 +169,9 @@ Vector &Vector::operator*=(double c)
 Vector &Vector::operator/=(double c)
 {
    double m = 1.0/c;
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for
+#endif
    for (int i = 0; i < size; i++)
    {
       data[i] *= m;
@@ -165,6 +181,9 @@ Vector &Vector::operator/=(double c)
 
 Vector &Vector::operator-=(double c)
 {
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for
+#endif
    for (int i = 0; i < size; i++)
    {
       data[i] -= c;
@@ -179,10 +198,14 @@ Vector &Vector::operator-=(const Vector &v)
    {
       mfem_error("Vector::operator-=(const Vector &)");
    }
+#endif
+   const double *vp = v.data;
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for
 #endif
    for (int i = 0; i < size; i++)
    {
-      data[i] -= v(i);
+      data[i] -= vp[i];
    }
    return *this;
 }
@@ -194,10 +217,14 @@ Vector &Vector::operator+=(const Vector &v)
    {
       mfem_error("Vector::operator+=(const Vector &)");
    }
+#endif
+   const double *vp = v.data;
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for
 #endif
    for (int i = 0; i < size; i++)
    {
-      data[i] += v(i);
+      data[i] += vp[i];
    }
    return *this;
 }
@@ -212,9 +239,13 @@ Vector &Vector::Add(const double a, const Vector &Va)
 #endif
    if (a != 0.0)
    {
+      const double *vp = Va.data;
+#ifdef MFEM_USE_OPENMP
+      #pragma omp parallel for
+#endif
       for (int i = 0; i < size; i++)
       {
-         data[i] += a * Va(i);
+         data[i] += a * vp[i];
       }
    }
    return *this;
@@ -227,10 +258,14 @@ Vector &Vector::Set(const double a, const Vector &Va)
    {
       mfem_error("Vector::Set(const double, const Vector &)");
    }
+#endif
+   const double *vp = Va.data;
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for
 #endif
    for (int i = 0; i < size; i++)
    {
-      data[i] = a * Va(i);
+      data[i] = a * vp[i];
    }
    return *this;
 }
@@ -247,6 +282,9 @@ void Vector::SetVector(const Vector &v, int offset)
    }
 #endif
 
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for
+#endif
    for (int i = 0; i < vs; i++)
    {
       p[i] = vp[i];
@@ -255,6 +293,9 @@ void Vector::SetVector(const Vector &v, int offset)
 
 void Vector::Neg()
 {
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for
+#endif
    for (int i = 0; i < size; i++)
    {
       data[i] = -data[i];
@@ -442,6 +483,76 @@ void subtract(const double a, const Vector &x, const Vector &y, Vector &z)
    }
 }
 
+// z = b*z + sum_k a[k]*v[k][i], k = 0,...,N-1, in one pass over the vectors
+template <int N>
+static void FusedAdd(int size, const double *a, const double *const *v,
+                     double b, double *z)
+{
+   if (b == 0.0)
+   {
+#ifdef MFEM_USE_OPENMP
+      #pragma omp parallel for
+#endif
+      for (int i = 0; i < size; i++)
+      {
+         double s = 0.0;
+         for (int k = 0; k < N; k++) { s += a[k] * v[k][i]; }
+         z[i] = s;
+      }
+   }
+   else
+   {
+#ifdef MFEM_USE_OPENMP
+      #pragma omp parallel for
+#endif
+      for (int i = 0; i < size; i++)
+      {
+         double s = b * z[i];
+         for (int k = 0; k < N; k++) { s += a[k] * v[k][i]; }
+         z[i] = s;
+      }
+   }
+}
+
+void LinearCombination(int n, const double *a, const Vector *const *v,
+                       double b, Vector &z)
+{
+   const int size = z.Size();
+   double *zp = z.GetData();
+   const int gs = 4;
+   double ga[gs];
+   const double *gv[gs];
+
+   int k = 0, ng = 0;
+   do
+   {
+      // collect the next group of (up to) four nonzero terms
+      ng = 0;
+      for ( ; k < n && ng < gs; k++)
+      {
+         if (a[k] == 0.0) { continue; }
+         MFEM_ASSERT(v[k]->Size() == size, "incompatible vector sizes");
+         MFEM_ASSERT(v[k]->GetData() != zp, "v[" << k << "] must not be z");
+         ga[ng] = a[k];
+         gv[ng] = v[k]->GetData();
+         ng++;
+      }
+      switch (ng)
+      {
+         case 0:
+            if (b == 0.0) { z = 0.0; }
+            else if (b != 1.0) { z *= b; }
+            break;
+         case 1: FusedAdd<1>(size, ga, gv, b, zp); break;
+         case 2: FusedAdd<2>(size, ga, gv, b, zp); break;
+         case 3: FusedAdd<3>(size, ga, gv, b, zp); break;
+         case 4: FusedAdd<4>(size, ga, gv, b, zp); break;
+      }
+      b = 1.0;
+   }
+   while (k < n);
+}
+
 void Vector::median(const Vector &lo, const Vector &hi)
 {
    double *v = data;
@@ -672,6 +783,9 @@ double Vector::Norml2() const
 double Vector::Normlinf() const
 {
    double max = 0.0;
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for reduction(max:max)
+#endif
    for (int i = 0; i < size; i++)
    {
       max = std::max(std::abs(data[i]), max);
@@ -682,6 +796,9 @@ double Vector::Normlinf() const
 double Vector::Norml1() const
 {
    double sum = 0.0;
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for reduction(+:sum)
+#endif
    for (int i = 0; i < size; i++)
    {
       sum += std::abs(data[i]);
@@ -745,6 +862,9 @@ double Vector::Sum() const
 {
    double sum = 0.0;
 
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for reduction(+:sum)
+#endif
    for (int i = 0; i < size; i++)
    {
       sum += data[i];
@@ -129,6 +129,10 @@ public:
 
    inline bool OwnsData() const { return (allocsize > 0); }
 
+   /// Return the memory owned by the vector, in bytes.
+   long MemoryUsage() const
+   { return OwnsData() ? allocsize * (long)sizeof(double) : 0; }
+
    /// Changes the ownership of the data; after the call the Vector is empty
    inline void StealData(double **p)
    { *p = data; data = 0; size = allocsize = 0; }
@@ -390,6 +394,15 @@ inline double Distance(const double *x, const double *y, const int n)
    return sqrt(d);
 }
 
+/** @brief Compute z = b z + a[0] v[0] + ... + a[n-1] v[n-1].
+
+    The terms are fused in groups of up to four, so z is read and written once
+    per group instead of once per term, and terms with a zero coefficient are
+    skipped. If b == 0 the old entries of z are not used. The vectors v[i] must
+    be different from z. */
+void LinearCombination(int n, const double *a, const Vector *const *v,
+                       double b, Vector &z);
+
 /// Returns the inner product of x and y
 /** In parallel this computes the inner product of the local vectors,
     producing different results on each MPI rank.
@@ -23,6 +23,7 @@
 #include <cmath>
 #include <cstring>
 #include <ctime>
+#include <algorithm>
 
 #ifdef MFEM_USE_GECKO
 #include "graph.h"
@@ -149,6 +150,229 @@ void Mesh::GetBoundingBox(Vector &min, Vector &max, int ref)
    }
 }
 
+PointLocator &Mesh::GetPointLocator()
+{
+   if (point_locator == NULL)
+   {
+      point_locator = new PointLocator(*this);
+   }
+   else if (!point_locator->IsUpToDate())
+   {
+      point_locator->Update();
+   }
+   return *point_locator;
+}
+
+int Mesh::FindPoints(const DenseMatrix &point_mat, Array<int> &elem_ids,
+                     Array<IntegrationPoint> &ips, bool warn)
+{
+   const int found = GetPointLocator().FindPoints(point_mat, elem_ids, ips);
+   if (warn && found < point_mat.Width())
+   {
+      MFEM_WARNING((point_mat.Width() - found) << " points were not found");
+   }
+   return found;
+}
+
+void Mesh::EnableGeometricFactors(int flags)
+{
+   if (flags == geom_factors_flags) { return; }
+   DeleteGeometricFactors();
+   geom_factors_flags = flags;
+   geom_factors_version++;
+}
+
+const GeometricFactors *Mesh::GetGeometricFactors(const IntegrationRule &ir)
+{
+   if (geom_factors_flags == 0 || BaseGeom < 0) { return NULL; }
+
+   const GeometricFactors *gf = NULL;
+#ifdef MFEM_USE_OPENMP
+   #pragma omp critical
+#endif
+   {
+      if (geom_factors.Size() > 0 && geom_factors[0]->sequence != sequence)
+      {
+         DeleteGeometricFactors();
+      }
+      for (int i = 0; i < geom_factors.Size(); i++)
+      {
+         if (geom_factors[i]->Matches(ir))
+         {
+            gf = geom_factors[i];
+            break;
+         }
+      }
+      if (gf == NULL)
+      {
+         geom_factors.Append(new GeometricFactors(this, ir, geom_factors_flags));
+         gf = geom_factors.Last();
+      }
+   }
+   return gf;
+}
+
+void Mesh::DeleteGeometricFactors()
+{
+   if (geom_factors.Size() == 0) { return; }
+   for (int i = 0; i < geom_factors.Size(); i++)
+   {
+      delete geom_factors[i];
+   }
+   geom_factors.SetSize(0);
+   geom_factors_version++;
+}
+
+long Mesh::GeometricFactorsMemoryUsage() const
+{
+   long mem = geom_factors.MemoryUsage();
+   for (int i = 0; i < geom_factors.Size(); i++)
+   {
+      mem += geom_factors[i]->MemoryUsage();
+   }
+   return mem;
+}
+
+long Mesh::ElementsMemoryUsage(const Array<Element *> &elems)
+{
+   long mem = elems.MemoryUsage();
+   for (int i = 0; i < elems.Size(); i++)
+   {
+      if (elems[i])
+      {
+         mem += sizeof(Element) + elems[i]->GetNVertices()*sizeof(int);
+      }
+   }
+   return mem;
+}
+
+static long TableMemoryUsage(const Table *table)
+{
+   return table ? sizeof(Table) + table->MemoryUsage() : 0;
+}
+
+long Mesh::MemoryUsage() const
+{
+   long mem = ElementsMemoryUsage(elements) +
+              ElementsMemoryUsage(boundary) +
+              ElementsMemoryUsage(faces) +
+              ElementsMemoryUsage(planars) +
+              vertices.MemoryUsage() +
+              swappedElements.MemoryUsage() +
+              swappedFaces.MemoryUsage() +
+              faces_info.MemoryUsage() +
+              nc_faces_info.MemoryUsage() +
+              TableMemoryUsage(el_to_edge) +
+              TableMemoryUsage(el_to_face) +
+              TableMemoryUsage(el_to_planar) +
+              TableMemoryUsage(el_to_el) +
+              be_to_edge.MemoryUsage() +
+              TableMemoryUsage(bel_to_edge) +
+              TableMemoryUsage(bel_to_planar) +
+              be_to_face.MemoryUsage() +
+              TableMemoryUsage(face_edge) +
+              TableMemoryUsage(edge_vertex) +
+              CoarseFineTr.MemoryUsage() +
+              GeometricFactorsMemoryUsage();
+
+   if (Nodes && own_nodes)
+   {
+      mem += Nodes->MemoryUsage() + Nodes->FESpace()->MemoryUsage();
+   }
+   if (ncmesh) { mem += ncmesh->MemoryUsage(); }
+   if (point_locator) { mem += point_locator->MemoryUsage(); }
+
+   return mem;
+}
+
+GeometricFactors::GeometricFactors(Mesh *mesh_, const IntegrationRule &ir,
+                                   int flags)
+   : mesh(mesh_), sequence(mesh_->GetSequence()),
+     computed_factors(flags)
+{
+   const int NE = mesh->GetNE();
+   dim = mesh->Dimension();
+   sdim = mesh->SpaceDimension();
+   nq = ir.GetNPoints();
+
+   points.SetSize(nq);
+   for (int q = 0; q < nq; q++)
+   {
+      points[q] = ir.IntPoint(q);
+   }
+
+   if (flags & JACOBIANS) { J.SetSize(NE*nq*sdim*dim); }
+   if (flags & ADJUGATES) { adjJ.SetSize(NE*nq*dim*sdim); }
+   if (flags & DETERMINANTS) { detJ.SetSize(NE*nq); }
+
+   IsoparametricTransformation T;
+   for (int e = 0; e < NE; e++)
+   {
+      mesh_->GetElementTransformation(e, &T);
+      for (int q = 0; q < nq; q++)
+      {
+         const int k = e*nq + q;
+         T.SetIntPoint(&ir.IntPoint(q));
+         if (flags & JACOBIANS)
+         {
+            const DenseMatrix &Jq = T.Jacobian();
+            std::copy(Jq.Data(), Jq.Data() + sdim*dim, &J(k*sdim*dim));
+         }
+         if (flags & ADJUGATES)
+         {
+            const DenseMatrix &Aq = T.AdjugateJacobian();
+            std::copy(Aq.Data(), Aq.Data() + dim*sdim, &adjJ(k*dim*sdim));
+         }
+         if (flags & DETERMINANTS)
+         {
+            detJ(k) = T.Weight();
+         }
+      }
+   }
+}
+
+bool GeometricFactors::Matches(const IntegrationRule &ir) const
+{
+   if (ir.GetNPoints() != nq) { return false; }
+   for (int q = 0; q < nq; q++)
+   {
+      if (!MatchesPoint(ir.IntPoint(q), q)) { return false; }
+   }
+   return true;
+}
+
+void GeometricFactors::SetIntPoint(ElementTransformation &T, int q) const
+{
+   MFEM_ASSERT(T.mesh == mesh && T.ElementNo >= 0 &&
+               T.ElementNo < mesh->GetNE(), "invalid transformation");
+   const int k = T.ElementNo*nq + q;
+   if (computed_factors & JACOBIANS)
+   {
+      T.dFdx.SetSize(sdim, dim);
+      std::copy(J.GetData() + k*sdim*dim, J.GetData() + (k+1)*sdim*dim,
+                T.dFdx.Data());
+      T.EvalState |= ElementTransformation::JACOBIAN_MASK;
+   }
+   if (computed_factors & ADJUGATES)
+   {
+      T.adjJ.SetSize(dim, sdim);
+      std::copy(adjJ.GetData() + k*dim*sdim, adjJ.GetData() + (k+1)*dim*sdim,
+                T.adjJ.Data());
+      T.EvalState |= ElementTransformation::ADJUGATE_MASK;
+   }
+   if (computed_factors & DETERMINANTS)
+   {
+      T.Wght = detJ(k);
+      T.EvalState |= ElementTransformation::WEIGHT_MASK;
+   }
+}
+
+long GeometricFactors::MemoryUsage() const
+{
+   return (J.Capacity() + adjJ.Capacity() + detJ.Capacity())*sizeof(double) +
+          points.MemoryUsage();
+}
+
 void Mesh::GetCharacteristics(double &h_min, double &h_max,
                               double &kappa_min, double &kappa_max,
                               Vector *Vh, Vector *Vk)
@@ -267,6 +491,7 @@ void Mesh::GetElementTransformation(int i, IsoparametricTransformation *ElTr)
 {
    ElTr->Attribute = GetAttribute(i);
    ElTr->ElementNo = i;
+   ElTr->SetMesh(this);
    if (Nodes == NULL)
    {
       GetPointMatrix(i, ElTr->GetPointMat());
@@ -296,6 +521,7 @@ void Mesh::GetElementTransformation(int i, const Vector &nodes,
 {
    ElTr->Attribute = GetAttribute(i);
    ElTr->ElementNo = i;
+   ElTr->SetMesh(NULL); // nodes other than the mesh nodes
    DenseMatrix &pm = ElTr->GetPointMat();
    if (Nodes == NULL)
    {
@@ -346,6 +572,7 @@ void Mesh::GetBdrElementTransformation(int i, IsoparametricTransformation* ElTr)
 {
    ElTr->Attribute = GetBdrAttribute(i);
    ElTr->ElementNo = i; // boundary element number
+   ElTr->SetMesh(NULL);
    if (Nodes == NULL)
    {
       GetBdrPointMatrix(i, ElTr->GetPointMat());
@@ -374,6 +601,7 @@ void Mesh::GetFaceTransformation(int FaceNo, IsoparametricTransformation *FTr)
 {
    FTr->Attribute = (Dim == 1) ? 1 : faces[FaceNo]->GetAttribute();
    FTr->ElementNo = FaceNo;
+   FTr->SetMesh(NULL);
    DenseMatrix &pm = FTr->GetPointMat();
    if (Nodes == NULL)
    {
@@ -414,9 +642,18 @@ void Mesh::GetFaceTransformation(int FaceNo, IsoparametricTransformation *FTr)
          int face_geom = GetFaceGeometryType(FaceNo);
          int face_type = GetFaceElementType(FaceNo);
 
-         GetLocalFaceTransformation(face_type,
-                                    GetElementType(face_info.Elem1No),
-                                    FaceElemTr.Loc1.Transf, face_info.Elem1Inf);
+         if (face_type == Element::TETRAHEDRON)
+         {
+            GetLocalTetToPentTransformation(FaceElemTr.Loc1.Transf, FaceNo,
+                                            face_info.Elem1No);
+         }
+         else
+         {
+            GetLocalFaceTransformation(face_type,
+                                       GetElementType(face_info.Elem1No),
+                                       FaceElemTr.Loc1.Transf,
+                                       face_info.Elem1Inf);
+         }
          // NOTE: FaceElemTr.Loc1 is overwritten here -- used as a temporary
 
          face_el = Nodes->FESpace()->GetTraceElement(face_info.Elem1No,
@@ -452,6 +689,7 @@ void Mesh::GetEdgeTransformation(int EdgeNo, IsoparametricTransformation *EdTr)
 
    EdTr->Attribute = 1;
    EdTr->ElementNo = EdgeNo;
+   EdTr->SetMesh(NULL);
    DenseMatrix &pm = EdTr->GetPointMat();
    if (Nodes == NULL)
    {
@@ -596,6 +834,52 @@ void Mesh::GetLocalQuadToHexTransformation(
    }
 }
 
+void Mesh::GetLocalTetToPentTransformation(
+   IsoparametricTransformation &Transf, int FaceNo, int ElemNo)
+{
+   DenseMatrix &locpm = Transf.GetPointMat();
+
+   Transf.SetFE(&TetrahedronFE);
+   // The face orientations of pentatopes also depend on the vertex swaps done
+   // in GenerateFaces, so the local vertices are found directly.
+   const int *fv = faces[FaceNo]->GetVertices();
+   const int *ev = elements[ElemNo]->GetVertices();
+   const IntegrationRule *PentVert =
+      Geometries.GetVertices(Geometry::PENTATOPE);
+   locpm.SetSize(4, 4);
+   for (int j = 0; j < 4; j++)
+   {
+      int k = 0;
+      while (k < 5 && ev[k] != fv[j]) { k++; }
+      MFEM_ASSERT(k < 5, "face " << FaceNo << " is not a face of element "
+                  << ElemNo);
+      const IntegrationPoint &vert = PentVert->IntPoint(k);
+      locpm(0, j) = vert.x;
+      locpm(1, j) = vert.y;
+      locpm(2, j) = vert.z;
+      locpm(3, j) = vert.t;
+   }
+}
+
+void Mesh::GetLocalTetToPentTransformation(
+   IsoparametricTransformation &Transf, int inf)
+{
+   DenseMatrix &locpm = Transf.GetPointMat();
+
+   Transf.SetFE(&TetrahedronFE);
+   const IntegrationRule *PentVert =
+      Geometries.GetVertices(Geometry::PENTATOPE);
+   locpm.SetSize(4, 4);
+   for (int j = 0; j < 4; j++, inf /= 5)
+   {
+      const IntegrationPoint &vert = PentVert->IntPoint(inf%5);
+      locpm(0, j) = vert.x;
+      locpm(1, j) = vert.y;
+      locpm(2, j) = vert.z;
+      locpm(3, j) = vert.t;
+   }
+}
+
 void Mesh::GetLocalFaceTransformation(
    int face_type, int elem_type, IsoparametricTransformation &Transf, int inf)
 {
@@ -667,14 +951,30 @@ FaceElementTransformations *Mesh::GetFaceElementTransformations(int FaceNo,
    if (mask & 4)
    {
       int elem_type = GetElementType(face_info.Elem1No);
-      GetLocalFaceTransformation(face_type, elem_type,
-                                 FaceElemTr.Loc1.Transf, face_info.Elem1Inf);
+      if (face_type == Element::TETRAHEDRON)
+      {
+         GetLocalTetToPentTransformation(FaceElemTr.Loc1.Transf, FaceNo,
+                                         face_info.Elem1No);
+      }
+      else
+      {
+         GetLocalFaceTransformation(face_type, elem_type,
+                                    FaceElemTr.Loc1.Transf, face_info.Elem1Inf);
+      }
    }
    if ((mask & 8) && FaceElemTr.Elem2No >= 0)
    {
       int elem_type = GetElementType(face_info.Elem2No);
-      GetLocalFaceTransformation(face_type, elem_type,
-                                 FaceElemTr.Loc2.Transf, face_info.Elem2Inf);
+      if (face_type == Element::TETRAHEDRON)
+      {
+         GetLocalTetToPentTransformation(FaceElemTr.Loc2.Transf, FaceNo,
+                                         face_info.Elem2No);
+      }
+      else
+      {
+         GetLocalFaceTransformation(face_type, elem_type,
+                                    FaceElemTr.Loc2.Transf, face_info.Elem2Inf);
+      }
 
       // NC meshes: prepend slave edge/face transformation to Loc2
       if (Nonconforming() && IsSlaveFace(face_info))
@@ -760,6 +1060,8 @@ int Mesh::GetFaceElementType(int Face) const
    return (Dim == 1) ? Element::POINT : faces[Face]->GetType();
 }
 
+Mesh::TopologyBuilder Mesh::default_topology_builder = Mesh::HASH_TABLES;
+
 void Mesh::Init()
 {
    // in order of declaration:
@@ -773,9 +1075,13 @@ void Mesh::Init()
    sequence = 0;
    Nodes = NULL;
    own_nodes = 1;
+   point_locator = NULL;
+   geom_factors_flags = 0;
+   geom_factors_version = 0;
    NURBSext = NULL;
    ncmesh = NULL;
    last_operation = Mesh::NONE;
+   topology_builder = default_topology_builder;
 }
 
 void Mesh::InitTables()
@@ -822,6 +1128,11 @@ void Mesh::DestroyPointers()
 {
    if (own_nodes) { delete Nodes; }
 
+   delete point_locator;
+   point_locator = NULL;
+
+   DeleteGeometricFactors();
+
    delete ncmesh;
 
    delete NURBSext;
@@ -2651,6 +2962,12 @@ Mesh::Mesh(const Mesh &mesh, bool copy_nodes)
    // Create the new Mesh instance without a record of its refinement history
    sequence = 0;
    last_operation = Mesh::NONE;
+   topology_builder = mesh.topology_builder;
+
+   // The spatial index and the geometric factors are rebuilt on demand
+   point_locator = NULL;
+   geom_factors_flags = mesh.geom_factors_flags;
+   geom_factors_version = 0;
 
    // Duplicate the elements
    elements.SetSize(NumOfElements);
@@ -4777,6 +5094,11 @@ int Mesh::GetElementToEdgeTable(Table & e_to_f, Array<int> &be_to_f)
 {
    int i, NumberOfEdges;
 
+   if (Dim == 4 && topology_builder == SORTED_KEYS && !edge_vertex)
+   {
+      return GetElementToEdgeTableSorted(e_to_f);
+   }
+
    DSTable v_to_v(NumOfVertices);
    GetVertexToVertexTable(v_to_v);
 
@@ -5333,6 +5655,12 @@ STable4D * Mesh::GetElementToFaceTable4D(int ret_ftbl)
    int i, *v;
    STable4D *faces_tbl;
 
+   if (topology_builder == SORTED_KEYS && !ret_ftbl)
+   {
+      GetElementToFaceTable4DSorted();
+      return NULL;
+   }
+
    if (el_to_face != NULL) { delete el_to_face; }
    el_to_face = new Table(NumOfElements, 5);  // 5 faces for one pentatope
    faces_tbl = new STable4D(NumOfVertices);
@@ -5394,6 +5722,12 @@ STable3D * Mesh::GetElementToPlanarTable(int ret_trigtbl)
    int i, *v;
    STable3D *trig_tbl;
 
+   if (topology_builder == SORTED_KEYS && !ret_trigtbl)
+   {
+      GetElementToPlanarTableSorted();
+      return NULL;
+   }
+
    if (el_to_planar != NULL) { delete el_to_planar; }
    el_to_planar = new Table(NumOfElements,
                             24);  // 24 planars at most for a tesseract (pentatope only 10)
@@ -5446,6 +5780,149 @@ STable3D * Mesh::GetElementToPlanarTable(int ret_trigtbl)
    return NULL;
 }
 
+void Mesh::GetElementToFaceTable4DSorted()
+{
+   SortedKeyTable faces_tbl(4, NumOfVertices, 5*NumOfElements);
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for
+#endif
+   for (int i = 0; i < NumOfElements; i++)
+   {
+      MFEM_ASSERT(GetElementType(i) == Element::PENTATOPE,
+                  "Unexpected type of Element.");
+      const int *v = elements[i]->GetVertices();
+      for (int j = 0; j < 5; j++)
+      {
+         const int *fv = pent_t::FaceVert[j];
+         const int key[4] = { v[fv[0]], v[fv[1]], v[fv[2]], v[fv[3]] };
+         faces_tbl.Set(5*i+j, key);
+      }
+   }
+   faces_tbl.Finalize();
+   NumOfFaces = faces_tbl.NumberOfElements();
+
+   if (el_to_face == NULL) { el_to_face = new Table; }
+   el_to_face->SetSize(NumOfElements, 5);  // 5 faces for one pentatope
+   const Array<int> &numbers = faces_tbl.GetNumbers();
+   std::copy(numbers.GetData(), numbers.GetData() + numbers.Size(),
+             el_to_face->GetJ());
+
+   be_to_face.SetSize(NumOfBdrElements);
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for
+#endif
+   for (int i = 0; i < NumOfBdrElements; i++)
+   {
+      MFEM_ASSERT(GetBdrElementType(i) == Element::TETRAHEDRON,
+                  "Unexpected type of boundary Element.");
+      be_to_face[i] = faces_tbl(boundary[i]->GetVertices());
+   }
+}
+
+void Mesh::GetElementToPlanarTableSorted()
+{
+   SortedKeyTable trig_tbl(3, NumOfVertices, 10*NumOfElements);
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for
+#endif
+   for (int i = 0; i < NumOfElements; i++)
+   {
+      MFEM_ASSERT(GetElementType(i) == Element::PENTATOPE,
+                  "Unexpected type of Element.");
+      const int *v = elements[i]->GetVertices();
+      for (int j = 0; j < 10; j++)
+      {
+         const int *fv = pent_t::PlanarVert[j];
+         const int key[3] = { v[fv[0]], v[fv[1]], v[fv[2]] };
+         trig_tbl.Set(10*i+j, key);
+      }
+   }
+   trig_tbl.Finalize();
+   NumOfPlanars = trig_tbl.NumberOfElements();
+
+   if (el_to_planar == NULL) { el_to_planar = new Table; }
+   el_to_planar->SetSize(NumOfElements, 10);  // 10 planars for one pentatope
+   const Array<int> &numbers = trig_tbl.GetNumbers();
+   std::copy(numbers.GetData(), numbers.GetData() + numbers.Size(),
+             el_to_planar->GetJ());
+
+   if (bel_to_planar == NULL) { bel_to_planar = new Table; }
+   bel_to_planar->SetSize(NumOfBdrElements, 4);  // 4 triangles for one tet
+   int *J = bel_to_planar->GetJ();
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for
+#endif
+   for (int i = 0; i < NumOfBdrElements; i++)
+   {
+      MFEM_ASSERT(GetBdrElementType(i) == Element::TETRAHEDRON,
+                  "Unexpected type of boundary Element.");
+      const int *v = boundary[i]->GetVertices();
+      for (int j = 0; j < 4; j++)
+      {
+         const int *fv = tet_t::FaceVert[j];
+         const int key[3] = { v[fv[0]], v[fv[1]], v[fv[2]] };
+         J[4*i+j] = trig_tbl(key);
+      }
+   }
+}
+
+int Mesh::GetElementToEdgeTableSorted(Table &e_to_f)
+{
+   e_to_f.MakeI(NumOfElements);
+   for (int i = 0; i < NumOfElements; i++)
+   {
+      e_to_f.AddColumnsInRow(i, elements[i]->GetNEdges());
+   }
+   e_to_f.MakeJ();
+   const int *I = e_to_f.GetI();
+
+   SortedKeyTable v_to_v(2, NumOfVertices, e_to_f.Size_of_connections());
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for
+#endif
+   for (int i = 0; i < NumOfElements; i++)
+   {
+      const int *v = elements[i]->GetVertices();
+      const int ne = elements[i]->GetNEdges();
+      for (int j = 0; j < ne; j++)
+      {
+         const int *e = elements[i]->GetEdgeVertices(j);
+         const int key[2] = { v[e[0]], v[e[1]] };
+         v_to_v.Set(I[i]+j, key);
+      }
+   }
+   v_to_v.Finalize();
+   const Array<int> &numbers = v_to_v.GetNumbers();
+   std::copy(numbers.GetData(), numbers.GetData() + numbers.Size(),
+             e_to_f.GetJ());
+
+   if (bel_to_edge == NULL) { bel_to_edge = new Table; }
+   bel_to_edge->MakeI(NumOfBdrElements);
+   for (int i = 0; i < NumOfBdrElements; i++)
+   {
+      bel_to_edge->AddColumnsInRow(i, boundary[i]->GetNEdges());
+   }
+   bel_to_edge->MakeJ();
+   const int *bI = bel_to_edge->GetI();
+   int *bJ = bel_to_edge->GetJ();
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for
+#endif
+   for (int i = 0; i < NumOfBdrElements; i++)
+   {
+      const int *v = boundary[i]->GetVertices();
+      const int ne = boundary[i]->GetNEdges();
+      for (int j = 0; j < ne; j++)
+      {
+         const int *e = boundary[i]->GetEdgeVertices(j);
+         const int key[2] = { v[e[0]], v[e[1]] };
+         bJ[bI[i]+j] = v_to_v.Index(key);
+      }
+   }
+
+   return v_to_v.NumberOfElements();
+}
+
 void Mesh::ReorientTetMesh()
 {
    int *v;
@@ -6326,6 +6803,7 @@ void Mesh::CheckDisplacements(const Vector &displacements, double &tmax)
 
 void Mesh::MoveVertices(const Vector &displacements)
 {
+   DeleteGeometricFactors();
    for (int i = 0, nv = vertices.Size(); i < nv; i++)
       for (int j = 0; j < spaceDim; j++)
       {
@@ -6346,6 +6824,7 @@ void Mesh::GetVertices(Vector &vert_coord) const
 
 void Mesh::SetVertices(const Vector &vert_coord)
 {
+   DeleteGeometricFactors();
    for (int i = 0, nv = vertices.Size(); i < nv; i++)
       for (int j = 0; j < spaceDim; j++)
       {
@@ -6394,6 +6873,7 @@ void Mesh::SetNode(int i, const double *coord)
 
 void Mesh::MoveNodes(const Vector &displacements)
 {
+   DeleteGeometricFactors();
    if (Nodes)
    {
       (*Nodes) += displacements;
@@ -6418,6 +6898,7 @@ void Mesh::GetNodes(Vector &node_coord) const
 
 void Mesh::SetNodes(const Vector &node_coord)
 {
+   DeleteGeometricFactors();
    if (Nodes)
    {
       (*Nodes) = node_coord;
@@ -6430,6 +6911,7 @@ void Mesh::SetNodes(const Vector &node_coord)
 
 void Mesh::NewNodes(GridFunction &nodes, bool make_owner)
 {
+   DeleteGeometricFactors();
    if (own_nodes) { delete Nodes; }
    Nodes = &nodes;
    spaceDim = Nodes->FESpace()->GetVDim();
@@ -6444,6 +6926,7 @@ void Mesh::NewNodes(GridFunction &nodes, bool make_owner)
 
 void Mesh::SwapNodes(GridFunction *&nodes, int &own_nodes_)
 {
+   DeleteGeometricFactors();
    mfem::Swap<GridFunction*>(Nodes, nodes);
    mfem::Swap<int>(own_nodes, own_nodes_);
    // TODO:
@@ -7297,6 +7780,14 @@ void Mesh::Swap(Mesh& other, bool non_geometry)
    mfem::Swap(attributes, other.attributes);
    mfem::Swap(bdr_attributes, other.bdr_attributes);
 
+   // The spatial indices refer to their meshes, so just drop them
+   delete point_locator;
+   point_locator = NULL;
+   delete other.point_locator;
+   other.point_locator = NULL;
+   DeleteGeometricFactors();
+   other.DeleteGeometricFactors();
+
    if (non_geometry)
    {
       mfem::Swap(NURBSext, other.NURBSext);
@@ -9787,6 +10278,7 @@ void Mesh::ScaleElements(double sf)
 
 void Mesh::Transform(void (*f)(const Vector&, Vector&))
 {
+   DeleteGeometricFactors();
    // TODO: support for different new spaceDim.
    if (Nodes == NULL)
    {
@@ -9812,6 +10304,7 @@ void Mesh::Transform(void (*f)(const Vector&, Vector&))
 
 void Mesh::Transform(VectorCoefficient &deformation)
 {
+   DeleteGeometricFactors();
    MFEM_VERIFY(spaceDim == deformation.GetVDim(),
                "incompatible vector dimensions");
    if (Nodes == NULL)
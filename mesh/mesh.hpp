@@ -14,6 +14,7 @@
 
 #include "../config/config.hpp"
 #include "../general/stable3d.hpp"
+#include "../general/sorted_keys.hpp"
 #include "triangle.hpp"
 #include "tetrahedron.hpp"
 #include "vertex.hpp"
@@ -33,6 +34,8 @@ class KnotVector;
 class NURBSExtension;
 class FiniteElementSpace;
 class GridFunction;
+class PointLocator;
+class GeometricFactors;
 struct Refinement;
 
 #ifdef MFEM_USE_MPI
@@ -80,6 +83,8 @@ protected:
    struct FaceInfo
    {
       // Inf = 64 * LocalFaceIndex + FaceOrientation
+      // (except for the Elem2Inf of shared pentatope faces, see
+      // ParMesh::ExchangeFaceNbrData)
       int Elem1No, Elem2No, Elem1Inf, Elem2Inf;
       int NCFace; /* -1 if this is a regular conforming/boundary face;
                      index into 'nc_faces_info' if >= 0. */
@@ -126,6 +131,17 @@ protected:
    GridFunction *Nodes;
    int own_nodes;
 
+   // Spatial index used by FindPoints(); created on first use.
+   PointLocator *point_locator;
+
+   // Cached geometric factors, one entry per set of quadrature points; see
+   // GetGeometricFactors(). Caching is disabled when geom_factors_flags == 0.
+   // geom_factors_version is incremented whenever entries are deleted, so
+   // that ElementTransformations holding an entry can detect it.
+   Array<GeometricFactors*> geom_factors;
+   int geom_factors_flags;
+   long geom_factors_version;
+
    static const int vtk_quadratic_tet[10];
    static const int vtk_quadratic_hex[27];
 
@@ -145,6 +161,13 @@ public:
 
    enum Operation { NONE, REFINE, DEREFINE, REBALANCE };
 
+   /// Algorithms for building the face, planar and edge tables of 4D meshes.
+   enum TopologyBuilder
+   {
+      HASH_TABLES, ///< STable4D, STable3D and DSTable (default)
+      SORTED_KEYS  ///< flat key arrays numbered by a radix sort (SortedKeyTable)
+   };
+
    /// A list of all unique element attributes used by the Mesh.
    Array<int> attributes;
    /// A list of all unique boundary attributes used by the Mesh.
@@ -156,6 +179,10 @@ public:
 protected:
    Operation last_operation;
 
+   // Algorithm used for the 4D topology tables; see SetTopologyBuilder().
+   TopologyBuilder topology_builder;
+   static TopologyBuilder default_topology_builder;
+
    void Init();
    void InitTables();
    void SetEmpty();  // Init all data members with empty values
@@ -208,6 +235,10 @@ protected:
    STable3D *GetElementToFaceTable(int ret_ftbl = 0);
    STable4D *GetElementToFaceTable4D(int ret_ftbl = 0);
    STable3D *GetElementToPlanarTable(int ret_ftbl = 0);
+   // Versions of the above (without returned tables) using SortedKeyTable.
+   void GetElementToFaceTable4DSorted();
+   void GetElementToPlanarTableSorted();
+   int GetElementToEdgeTableSorted(Table &e_to_f);
 
    /** Red refinement. Element with index i is refined. The default
        red refinement for now is Uniform. */
@@ -286,6 +317,16 @@ protected:
    /// Used in GetFaceElementTransformations (...)
    void GetLocalQuadToHexTransformation (IsoparametricTransformation &loc,
                                          int i);
+   /** Used in GetFaceElementTransformations (...) for the tetrahedral faces of
+       pentatopes: the local vertices are found by matching the vertices of
+       face FaceNo and element ElemNo. */
+   void GetLocalTetToPentTransformation(IsoparametricTransformation &loc,
+                                        int FaceNo, int ElemNo);
+   /** Used in ParMesh::GetSharedFaceTransformations (...) for the tetrahedral
+       faces of pentatopes: the base 5 digit j of @a inf is the local vertex of
+       the element at vertex j of the face. */
+   void GetLocalTetToPentTransformation(IsoparametricTransformation &loc,
+                                        int inf);
    /// Used in GetFaceElementTransformations (...)
    void GetLocalFaceTransformation(int face_type, int elem_type,
                                    IsoparametricTransformation &Transf,
@@ -357,6 +398,9 @@ protected:
 
    void FreeElement(Element *E);
 
+   // approximate memory used by the elements in the array, see MemoryUsage()
+   static long ElementsMemoryUsage(const Array<Element *> &elems);
+
    void GenerateFaces();
    void GenerateNCFaceInfo();
    void GeneratePlanars();
@@ -1058,6 +1102,23 @@ public:
        Update() calls. */
    long GetSequence() const { return sequence; }
 
+   /** @brief Set the algorithm used to build the face, planar and edge tables
+       of 4D meshes by all Mesh objects constructed afterwards.
+
+       Since the constructors already build the topology, this is how the
+       algorithm is selected at mesh construction; ParMesh uses the setting of
+       the serial mesh it is created from (the face and planar tables needed
+       for the shared entities are still built with hash tables). Both
+       algorithms give the same numbering of the faces, planars and edges. */
+   static void SetDefaultTopologyBuilder(TopologyBuilder tb)
+   { default_topology_builder = tb; }
+   static TopologyBuilder GetDefaultTopologyBuilder()
+   { return default_topology_builder; }
+
+   /// Set the 4D topology algorithm used by later refinements of this mesh.
+   void SetTopologyBuilder(TopologyBuilder tb) { topology_builder = tb; }
+   TopologyBuilder GetTopologyBuilder() const { return topology_builder; }
+
    /// Print the mesh to the given stream using Netgen/Truegrid format.
    virtual void PrintXG(std::ostream &out = std::cout) const;
 
@@ -1121,6 +1182,57 @@ public:
    /// high-order meshes, the geometry is refined first "ref" times.
    void GetBoundingBox(Vector &min, Vector &max, int ref = 2);
 
+   /** @brief Return the spatial index of the mesh elements, (re)building it
+       if the mesh sequence has changed since the last call. */
+   PointLocator &GetPointLocator();
+
+   /** @brief Find the elements containing the physical points given as the
+       columns of @a point_mat (size SpaceDimension() x npts), together with
+       the corresponding reference points @a ips.
+
+       Points that are not found get elem_ids[i] = -1. For ParMesh, every
+       point is assigned to exactly one rank; on all other ranks its element
+       id is -1. Returns the (global, for ParMesh) number of points found. If
+       @a warn is true, a warning is printed when some points are not found.
+
+       The search uses a uniform-bin PointLocator which is built on the first
+       call and reused as long as the mesh sequence does not change. If the
+       mesh nodes are moved, call GetPointLocator().Update(). */
+   virtual int FindPoints(const DenseMatrix &point_mat, Array<int> &elem_ids,
+                          Array<IntegrationPoint> &ips, bool warn = true);
+
+   /** @brief Enable caching of the geometric factors at quadrature points,
+       see GetGeometricFactors(). @a flags is a bitwise OR of
+       GeometricFactors::FactorFlags; 0 disables the cache. */
+   void EnableGeometricFactors(int flags);
+
+   /** @brief Return the geometric factors of all elements at the points of
+       @a ir, computing them on the first call for the points.
+
+       Entries are found by the points of the rule, not by its address, so
+       temporary rules share the entries of equal rules. Entries are deleted
+       only when the mesh sequence changes, when the mesh nodes are modified
+       through the Mesh interface, or by DeleteGeometricFactors(), never by a
+       lookup of another rule. Returns NULL if caching is disabled or the mesh
+       has elements of different geometries. Thread safe with
+       MFEM_USE_OPENMP, as long as the mesh is not modified concurrently. */
+   const GeometricFactors *GetGeometricFactors(const IntegrationRule &ir);
+
+   /// Delete all cached geometric factors.
+   void DeleteGeometricFactors();
+
+   /** @brief Counter incremented whenever cached geometric factors are
+       deleted; entries obtained before a change must not be used. */
+   long GetGeometricFactorsVersion() const { return geom_factors_version; }
+
+   /// Return the memory used by the cached geometric factors, in bytes.
+   long GeometricFactorsMemoryUsage() const;
+
+   /** @brief Return the (approximate) memory used by the mesh, in bytes: the
+       elements, vertices, connectivity tables, nodes (if owned), NCMesh,
+       point locator and cached geometric factors. */
+   virtual long MemoryUsage() const;
+
    void GetCharacteristics(double &h_min, double &h_max,
                            double &kappa_min, double &kappa_max,
                            Vector *Vh = NULL, Vector *Vk = NULL);
@@ -1139,6 +1251,60 @@ public:
    virtual ~Mesh() { DestroyPointers(); }
 };
 
+/** @brief Jacobians, their adjugates and the weights of the element
+    transformations of a Mesh at all points of an IntegrationRule.
+
+    Created and owned by Mesh::GetGeometricFactors(). The data of point q in
+    element e is stored at index k = e*nq + q, where nq is the number of
+    points in the rule. */
+class GeometricFactors
+{
+public:
+   enum FactorFlags
+   {
+      JACOBIANS    = 1 << 0,
+      ADJUGATES    = 1 << 1,
+      DETERMINANTS = 1 << 2,
+      ALL          = JACOBIANS | ADJUGATES | DETERMINANTS
+   };
+
+   const Mesh *mesh;
+   /// Mesh sequence at the time of construction.
+   long sequence;
+   /// Bitwise OR of the computed FactorFlags.
+   int computed_factors;
+   int dim, sdim, nq;
+
+   /// Jacobians, sdim x dim (column-major) at offset k*sdim*dim.
+   Vector J;
+   /// Adjugates (see ElementTransformation::AdjugateJacobian()), dim x sdim.
+   Vector adjJ;
+   /// Weights (see ElementTransformation::Weight()), one per point.
+   Vector detJ;
+
+   GeometricFactors(Mesh *mesh, const IntegrationRule &ir, int flags);
+
+   /// Check if @a ir has the same points as the rule used in the constructor.
+   bool Matches(const IntegrationRule &ir) const;
+
+   /// Check if @a ip is the same as point @a q of the rule.
+   bool MatchesPoint(const IntegrationPoint &ip, int q) const
+   {
+      const IntegrationPoint &p = points[q];
+      return (ip.x == p.x && ip.y == p.y && ip.z == p.z && ip.t == p.t);
+   }
+
+   /** @brief Load the cached factors of point @a q in element T.ElementNo into
+       @a T; the integration point must already be set. */
+   void SetIntPoint(ElementTransformation &T, int q) const;
+
+   long MemoryUsage() const;
+
+private:
+   // copy of the points of IntRule, see Matches()
+   Array<IntegrationPoint> points;
+};
+
 /** Overload operator<< for std::ostream and Mesh; valid also for the derived
     class ParMesh */
 std::ostream &operator<<(std::ostream &out, const Mesh &mesh);
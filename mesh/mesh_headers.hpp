@@ -26,6 +26,7 @@
 #include "tesseract.hpp"
 #include "ncmesh.hpp"
 #include "mesh.hpp"
+#include "point_locator.hpp"
 #include "mesh_operators.hpp"
 #include "nurbs.hpp"
 
@@ -109,6 +109,8 @@ ParMesh::ParMesh(MPI_Comm comm, Mesh &mesh, int *partitioning_,
    MPI_Comm_size(MyComm, &NRanks);
    MPI_Comm_rank(MyComm, &MyRank);
 
+   topology_builder = mesh.GetTopologyBuilder();
+
    if (mesh.Nonconforming())
    {
       pncmesh = new ParNCMesh(comm, *mesh.ncmesh);
@@ -1504,6 +1506,7 @@ void ParMesh::GetFaceNbrElementTransformation(
 
    ElTr->Attribute = elem->GetAttribute();
    ElTr->ElementNo = NumOfElements + i;
+   ElTr->SetMesh(NULL);
 
    if (Nodes == NULL)
    {
@@ -1757,20 +1760,22 @@ void ParMesh::ExchangeFaceNbrData()
                info += GetQuadOrientation(sf_v, lf->GetVertices());
             }
          }
-         /*
-         if (Dim == 4)
+         else if (Dim == 4)
          {
-            Element *lf = faces[lface];
+            // The orientations of pentatope faces also depend on the vertex
+            // swaps done in GenerateFaces, so send the local vertex of the
+            // element at each vertex of the shared face instead, as base 5
+            // digits.
             const int *sf_v = shared_faces[sface[i]]->GetVertices();
-
-            std::cout << "Got into Dim == 4 case in pmesh ExchangeFaceNbrData \n";
-            MFEM_ABORT("Got into Dim == 4 case in pmesh ExchangeFaceNbrData");
-            if  (lf->GetGeometryType() == Geometry::TETRAHEDRON)
+            const int *el_v = elements[el]->GetVertices();
+            info = 0;
+            for (int j = 3; j >= 0; j--)
             {
-               info += GetTetOrientation(sf_v, lf->GetVertices());
+               int k = 0;
+               while (el_v[k] != sf_v[j]) { k++; }
+               info = 5*info + k;
             }
          }
-         */
          send_face_nbr_facedata.AddConnection(fn, info);
       }
    }
@@ -1935,6 +1940,22 @@ void ParMesh::ExchangeFaceNbrData()
          {
             info++; // orientation 0 --> orientation 1
          }
+         else if (Dim == 4)
+         {
+            // reorder the element vertices sent for the vertices of the
+            // shared face to follow the vertices of the local face
+            const int *lf_v = faces[lface]->GetVertices();
+            const int *sf_v = shared_faces[sface[i]]->GetVertices();
+            int nbr_k[4];
+            for (int j = 0; j < 4; j++, info /= 5) { nbr_k[j] = info%5; }
+            info = 0;
+            for (int j = 3; j >= 0; j--)
+            {
+               int p = 0;
+               while (sf_v[p] != lf_v[j]) { p++; }
+               info = 5*info + nbr_k[p];
+            }
+         }
          else
          {
             int nbr_ori = info%64, nbr_v[4];
@@ -2191,14 +2212,30 @@ GetSharedFaceTransformations(int sf, bool fill2)
 
    // setup Loc1 & Loc2
    int elem_type = GetElementType(face_info.Elem1No);
-   GetLocalFaceTransformation(face_type, elem_type, FaceElemTr.Loc1.Transf,
-                              face_info.Elem1Inf);
+   if (face_type == Element::TETRAHEDRON)
+   {
+      GetLocalTetToPentTransformation(FaceElemTr.Loc1.Transf, local_face,
+                                      face_info.Elem1No);
+   }
+   else
+   {
+      GetLocalFaceTransformation(face_type, elem_type, FaceElemTr.Loc1.Transf,
+                                 face_info.Elem1Inf);
+   }
 
    if (fill2)
    {
-      elem_type = face_nbr_elements[FaceElemTr.Elem2No]->GetType();
-      GetLocalFaceTransformation(face_type, elem_type, FaceElemTr.Loc2.Transf,
-                                 face_info.Elem2Inf);
+      if (face_type == Element::TETRAHEDRON)
+      {
+         GetLocalTetToPentTransformation(FaceElemTr.Loc2.Transf,
+                                         face_info.Elem2Inf);
+      }
+      else
+      {
+         elem_type = face_nbr_elements[FaceElemTr.Elem2No]->GetType();
+         GetLocalFaceTransformation(face_type, elem_type,
+                                    FaceElemTr.Loc2.Transf, face_info.Elem2Inf);
+      }
    }
 
    // adjust Loc1 or Loc2 of the master face if this is a slave face
@@ -4800,6 +4837,66 @@ void ParMesh::GetCharacteristics(double &gh_min, double &gh_max,
    MPI_Allreduce(&kappa_max, &gk_max, 1, MPI_DOUBLE, MPI_MAX, MyComm);
 }
 
+int ParMesh::FindPoints(const DenseMatrix &point_mat, Array<int> &elem_ids,
+                        Array<IntegrationPoint> &ips, bool warn)
+{
+   const int npts = point_mat.Width();
+   if (!npts) { return 0; }
+
+   GetPointLocator().FindPoints(point_mat, elem_ids, ips);
+
+   // The lowest rank that found a point becomes its owner
+   Array<int> ranks(npts), owners(npts);
+   for (int i = 0; i < npts; i++)
+   {
+      ranks[i] = (elem_ids[i] >= 0) ? MyRank : NRanks;
+   }
+   MPI_Allreduce(ranks.GetData(), owners.GetData(), npts, MPI_INT, MPI_MIN,
+                 MyComm);
+
+   int found = 0;
+   for (int i = 0; i < npts; i++)
+   {
+      if (owners[i] != MyRank) { elem_ids[i] = -1; }
+      if (owners[i] != NRanks) { found++; }
+   }
+   if (warn && found < npts && MyRank == 0)
+   {
+      MFEM_WARNING((npts - found) << " points were not found");
+   }
+   return found;
+}
+
+long ParMesh::MemoryUsage() const
+{
+   long mem = Mesh::MemoryUsage() +
+              ElementsMemoryUsage(shared_edges) +
+              ElementsMemoryUsage(shared_planars) +
+              ElementsMemoryUsage(shared_faces) +
+              group_svert.MemoryUsage() +
+              group_sedge.MemoryUsage() +
+              group_splan.MemoryUsage() +
+              group_sface.MemoryUsage() +
+              svert_lvert.MemoryUsage() +
+              sedge_ledge.MemoryUsage() +
+              splan_lplan.MemoryUsage() +
+              sface_lface.MemoryUsage() +
+              gtopo.MemoryUsage();
+
+   if (have_face_nbr_data)
+   {
+      mem += face_nbr_group.MemoryUsage() +
+             face_nbr_elements_offset.MemoryUsage() +
+             face_nbr_vertices_offset.MemoryUsage() +
+             ElementsMemoryUsage(face_nbr_elements) +
+             face_nbr_vertices.MemoryUsage() +
+             send_face_nbr_elements.MemoryUsage() +
+             send_face_nbr_vertices.MemoryUsage();
+   }
+
+   return mem;
+}
+
 void ParMesh::PrintInfo(std::ostream &out)
 {
    int i;
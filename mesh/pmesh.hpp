@@ -212,9 +212,21 @@ public:
    void GetCharacteristics(double &h_min, double &h_max,
                            double &kappa_min, double &kappa_max);
 
+   /** @brief Parallel version of Mesh::FindPoints(). All ranks must call it
+       with the same @a point_mat. Every point found by at least one rank is
+       assigned to the lowest such rank; the other ranks set its element id to
+       -1. Returns the global number of points found. */
+   virtual int FindPoints(const DenseMatrix &point_mat, Array<int> &elem_ids,
+                          Array<IntegrationPoint> &ips, bool warn = true);
+
    /// Print various parallel mesh stats
    virtual void PrintInfo(std::ostream &out = std::cout);
 
+   /** @brief Return the (approximate) memory used by the local part of the
+       mesh, in bytes, including the shared entities, the group topology and
+       the face-neighbor data. */
+   virtual long MemoryUsage() const;
+
    /// Save the mesh in a parallel mesh format.
    void ParPrint(std::ostream &out) const;
 
@@ -0,0 +1,228 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#include "point_locator.hpp"
+#include "mesh.hpp"
+
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+namespace mfem
+{
+
+PointLocator::PointLocator(Mesh &m, double bb_tol_, double ref_tol_)
+   : mesh(m), mesh_sequence(-1), sdim(0), bb_tol(bb_tol_), ref_tol(ref_tol_)
+{
+   Update();
+}
+
+bool PointLocator::IsUpToDate() const
+{
+   return (mesh_sequence == mesh.GetSequence() &&
+           elem_bb.Width() == mesh.GetNE());
+}
+
+void PointLocator::Update()
+{
+   mesh_sequence = mesh.GetSequence();
+   sdim = mesh.SpaceDimension();
+   MFEM_VERIFY(sdim >= 1 && sdim <= 4, "invalid space dimension: " << sdim);
+
+   const int NE = mesh.GetNE();
+   // High-order elements may bulge out of the convex hull of their nodes, so
+   // use a more generous enlargement in that case.
+   const double pad_tol = mesh.GetNodes() ? std::max(bb_tol, 0.05) : bb_tol;
+
+   bb_min.SetSize(sdim);
+   bb_max.SetSize(sdim);
+   bb_min = std::numeric_limits<double>::infinity();
+   bb_max = -std::numeric_limits<double>::infinity();
+
+   elem_bb.SetSize(2*sdim, NE);
+   for (int el = 0; el < NE; el++)
+   {
+      mesh.GetElementTransformation(el, &T);
+      const DenseMatrix &pm = T.GetPointMat();
+      double ext = 0.0;
+      for (int d = 0; d < sdim; d++)
+      {
+         double lo = pm(d,0), hi = pm(d,0);
+         for (int j = 1; j < pm.Width(); j++)
+         {
+            lo = std::min(lo, pm(d,j));
+            hi = std::max(hi, pm(d,j));
+         }
+         elem_bb(d,el) = lo;
+         elem_bb(sdim+d,el) = hi;
+         ext = std::max(ext, hi - lo);
+      }
+      const double pad = pad_tol*ext;
+      for (int d = 0; d < sdim; d++)
+      {
+         elem_bb(d,el) -= pad;
+         elem_bb(sdim+d,el) += pad;
+         bb_min(d) = std::min(bb_min(d), elem_bb(d,el));
+         bb_max(d) = std::max(bb_max(d), elem_bb(sdim+d,el));
+      }
+   }
+
+   // Choose the bin sizes so that there is about one element per bin.
+   nbins.SetSize(sdim);
+   inv_h.SetSize(sdim);
+   double vol = 1.0;
+   int nd = 0;
+   for (int d = 0; d < sdim; d++)
+   {
+      const double ext = (NE > 0) ? bb_max(d) - bb_min(d) : 0.0;
+      if (ext > 0.0) { vol *= ext; nd++; }
+   }
+   const double h = nd ? std::pow(vol/std::max(NE, 1), 1.0/nd) : 1.0;
+   int total = 1;
+   for (int d = 0; d < sdim; d++)
+   {
+      const double ext = (NE > 0) ? bb_max(d) - bb_min(d) : 0.0;
+      if (ext > 0.0)
+      {
+         nbins[d] = std::max(1, std::min((int) std::ceil(ext/h),
+                                         std::max(NE, 1)));
+         inv_h(d) = nbins[d]/ext;
+      }
+      else
+      {
+         nbins[d] = 1;
+         inv_h(d) = 0.0;
+      }
+      total *= nbins[d];
+   }
+
+   // Two passes over the elements: count the bin entries, then fill them.
+   bin_to_elem.Clear();
+   bin_to_elem.MakeI(total);
+   int lo[4], hi[4], idx[4];
+   for (int pass = 0; pass < 2; pass++)
+   {
+      for (int el = 0; el < NE; el++)
+      {
+         GetBinCoords(&elem_bb(0,el), lo);
+         GetBinCoords(&elem_bb(sdim,el), hi);
+         for (int d = 0; d < sdim; d++) { idx[d] = lo[d]; }
+         while (true)
+         {
+            const int b = BinIndex(idx);
+            if (pass == 0) { bin_to_elem.AddAColumnInRow(b); }
+            else { bin_to_elem.AddConnection(b, el); }
+
+            int d = 0;
+            for ( ; d < sdim; d++)
+            {
+               if (++idx[d] <= hi[d]) { break; }
+               idx[d] = lo[d];
+            }
+            if (d == sdim) { break; }
+         }
+      }
+      if (pass == 0) { bin_to_elem.MakeJ(); }
+   }
+   bin_to_elem.ShiftUpI();
+}
+
+int PointLocator::BinIndex(const int *idx) const
+{
+   int b = 0;
+   for (int d = sdim-1; d >= 0; d--)
+   {
+      b = b*nbins[d] + idx[d];
+   }
+   return b;
+}
+
+void PointLocator::GetBinCoords(const double *x, int *idx) const
+{
+   for (int d = 0; d < sdim; d++)
+   {
+      int i = (int) std::floor((x[d] - bb_min(d))*inv_h(d));
+      idx[d] = std::min(std::max(i, 0), nbins[d]-1);
+   }
+}
+
+bool PointLocator::InElementBox(int el, const double *x) const
+{
+   for (int d = 0; d < sdim; d++)
+   {
+      if (x[d] < elem_bb(d,el) || x[d] > elem_bb(sdim+d,el)) { return false; }
+   }
+   return true;
+}
+
+bool PointLocator::FindPoint(const Vector &x, int &elem_id,
+                             IntegrationPoint &ip)
+{
+   MFEM_ASSERT(x.Size() == sdim, "invalid point dimension");
+   elem_id = -1;
+   for (int d = 0; d < sdim; d++)
+   {
+      if (x(d) < bb_min(d) || x(d) > bb_max(d)) { return false; }
+   }
+
+   int idx[4];
+   GetBinCoords(x.GetData(), idx);
+   const int b = BinIndex(idx);
+   const int *elems = bin_to_elem.GetRow(b);
+   const int ne = bin_to_elem.RowSize(b);
+   for (int k = 0; k < ne; k++)
+   {
+      const int el = elems[k];
+      if (!InElementBox(el, x.GetData())) { continue; }
+      mesh.GetElementTransformation(el, &T);
+      IntegrationPoint rip;
+      rip.Init();
+      if (T.TransformBack(x, rip) == 0 &&
+          Geometry::CheckPoint(mesh.GetElementBaseGeometry(el), rip, ref_tol))
+      {
+         // bin rows are sorted, so this is the smallest containing element
+         elem_id = el;
+         ip = rip;
+         return true;
+      }
+   }
+   return false;
+}
+
+int PointLocator::FindPoints(const DenseMatrix &point_mat,
+                             Array<int> &elem_ids,
+                             Array<IntegrationPoint> &ips)
+{
+   MFEM_VERIFY(point_mat.Height() == sdim, "invalid point dimension: "
+               << point_mat.Height() << " != " << sdim);
+   const int npts = point_mat.Width();
+   elem_ids.SetSize(npts);
+   ips.SetSize(npts);
+
+   int found = 0;
+   Vector x;
+   for (int i = 0; i < npts; i++)
+   {
+      x.SetDataAndSize(const_cast<double*>(&point_mat(0,i)), sdim);
+      if (FindPoint(x, elem_ids[i], ips[i])) { found++; }
+      else { ips[i].Init(); }
+   }
+   return found;
+}
+
+long PointLocator::MemoryUsage() const
+{
+   return (bb_min.Capacity() + bb_max.Capacity() + inv_h.Capacity())*
+          sizeof(double) + nbins.MemoryUsage() + elem_bb.MemoryUsage() +
+          bin_to_elem.MemoryUsage();
+}
+
+}
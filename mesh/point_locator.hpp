@@ -0,0 +1,98 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#ifndef MFEM_POINT_LOCATOR
+#define MFEM_POINT_LOCATOR
+
+#include "../config/config.hpp"
+#include "../general/array.hpp"
+#include "../general/table.hpp"
+#include "../linalg/vector.hpp"
+#include "../linalg/densemat.hpp"
+#include "../fem/intrules.hpp"
+#include "../fem/eltrans.hpp"
+
+namespace mfem
+{
+
+class Mesh;
+
+/** @brief Uniform-bin spatial index for locating physical points in the
+    elements of a Mesh.
+
+    The bounding box of the mesh is split into a uniform Cartesian grid of
+    bins (about one element per bin) and every element is registered in all
+    bins overlapped by its (slightly enlarged) bounding box. A point query
+    inspects only the elements registered in the bin containing the point and
+    uses ElementTransformation::TransformBack() to compute the reference
+    coordinates. Works for 1D-4D meshes, including meshes with pentatopes and
+    tesseracts, and for high-order (curved) meshes.
+
+    The index is tied to the Mesh sequence: after refinement, derefinement or
+    rebalancing it has to be rebuilt, see IsUpToDate() and Update(). If the
+    mesh nodes are moved without changing the sequence, Update() must be
+    called explicitly. */
+class PointLocator
+{
+protected:
+   Mesh &mesh;
+   long mesh_sequence;
+   int sdim;
+
+   /// Relative enlargement of the element bounding boxes.
+   double bb_tol;
+   /// Tolerance for the reference-element inclusion check.
+   double ref_tol;
+
+   Vector bb_min, bb_max;   // mesh bounding box
+   Vector inv_h;            // inverse bin widths
+   Array<int> nbins;        // number of bins in each direction
+   DenseMatrix elem_bb;     // (2*sdim) x NE: element min/max corners
+   Table bin_to_elem;
+
+   IsoparametricTransformation T;
+
+   /// Return the bin index of the bin coordinates @a idx.
+   int BinIndex(const int *idx) const;
+   /// Compute the bin coordinates of the point @a x, clamped to the grid.
+   void GetBinCoords(const double *x, int *idx) const;
+   bool InElementBox(int el, const double *x) const;
+
+public:
+   /// Build the index for @a m, see Update().
+   PointLocator(Mesh &m, double bb_tol_ = 1e-8, double ref_tol_ = 1e-10);
+
+   /// (Re)build the bins from the current state of the mesh.
+   void Update();
+
+   /// Check if the index corresponds to the current Mesh sequence.
+   bool IsUpToDate() const;
+
+   /** @brief Find the element containing the physical point @a x and the
+       corresponding reference point @a ip. Returns true on success. If
+       several elements contain the point (e.g. the point is on a face), the
+       one with the smallest index is returned. */
+   bool FindPoint(const Vector &x, int &elem_id, IntegrationPoint &ip);
+
+   /** @brief Locate a batch of points given as the columns of @a point_mat
+       (size sdim x npts). Points that are not found get elem_ids[i] = -1.
+       Returns the number of points found. */
+   int FindPoints(const DenseMatrix &point_mat, Array<int> &elem_ids,
+                  Array<IntegrationPoint> &ips);
+
+   const Table &GetBinToElementTable() const { return bin_to_elem; }
+
+   long MemoryUsage() const;
+};
+
+}
+
+#endif
@@ -19,10 +19,14 @@
 #include "general/sets.hpp"
 #include "general/hash.hpp"
 #include "general/mem_alloc.hpp"
+#include "general/arena.hpp"
 #include "general/sort_pairs.hpp"
+#include "general/sorted_keys.hpp"
 #include "general/stable3d.hpp"
 #include "general/table.hpp"
+#include "general/blocktable.hpp"
 #include "general/tic_toc.hpp"
+#include "general/profiler.hpp"
 #include "general/isockstream.hpp"
 #include "general/osockstream.hpp"
 #include "general/socketstream.hpp"
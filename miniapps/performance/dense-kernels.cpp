@@ -0,0 +1,250 @@
+//                    MFEM Dense Small-Matrix Kernels Benchmark
+//
+// Compile with: make dense-kernels
+//
+// Sample runs:  dense-kernels
+//               dense-kernels -r 20000
+//               dense-kernels -r 10 -check
+//
+// Description:  This miniapp times the small-matrix kernels of DenseMatrix
+//               used in element matrix assembly (Mult, MultABt, MultAtB,
+//               AddMult_a_AAt and CalcInverse) against straightforward
+//               reference loops, for the matrix sizes that occur with 4D
+//               elements: 5, 15 and 35 dofs (pentatopes) and 16 and 81 dofs
+//               (tesseracts), with an inner dimension of 1 to 4. The results
+//               of the library kernels are also compared with the reference
+//               loops; with -check the program exits with an error if they
+//               differ.
+
+#include "mfem.hpp"
+#include <iostream>
+#include <iomanip>
+#include <cmath>
+
+using namespace std;
+using namespace mfem;
+
+// Reference versions: plain loops over the entries of the result.
+void RefMult(const DenseMatrix &b, const DenseMatrix &c, DenseMatrix &a)
+{
+   for (int j = 0; j < a.Width(); j++)
+      for (int i = 0; i < a.Height(); i++)
+      {
+         double d = 0.0;
+         for (int k = 0; k < b.Width(); k++)
+         {
+            d += b(i,k) * c(k,j);
+         }
+         a(i,j) = d;
+      }
+}
+
+void RefMultABt(const DenseMatrix &A, const DenseMatrix &B, DenseMatrix &ABt)
+{
+   for (int i = 0; i < A.Height(); i++)
+      for (int j = 0; j < B.Height(); j++)
+      {
+         double d = 0.0;
+         for (int k = 0; k < A.Width(); k++)
+         {
+            d += A(i,k) * B(j,k);
+         }
+         ABt(i,j) = d;
+      }
+}
+
+void RefMultAtB(const DenseMatrix &A, const DenseMatrix &B, DenseMatrix &AtB)
+{
+   for (int i = 0; i < A.Width(); i++)
+      for (int j = 0; j < B.Width(); j++)
+      {
+         double d = 0.0;
+         for (int k = 0; k < A.Height(); k++)
+         {
+            d += A(k,i) * B(k,j);
+         }
+         AtB(i,j) = d;
+      }
+}
+
+void RefAddMult_a_AAt(double a, const DenseMatrix &A, DenseMatrix &AAt)
+{
+   for (int i = 0; i < A.Height(); i++)
+   {
+      for (int j = 0; j < i; j++)
+      {
+         double d = 0.0;
+         for (int k = 0; k < A.Width(); k++)
+         {
+            d += A(i,k) * A(j,k);
+         }
+         AAt(i,j) += (d *= a);
+         AAt(j,i) += d;
+      }
+      double d = 0.0;
+      for (int k = 0; k < A.Width(); k++)
+      {
+         d += A(i,k) * A(i,k);
+      }
+      AAt(i,i) += a * d;
+   }
+}
+
+void RefCalcInverse(const DenseMatrix &a, DenseMatrix &inva)
+{
+   DenseMatrixInverse inv(a);
+   inv.GetInverseMatrix(inva);
+}
+
+// Fill a matrix with random entries in [0,1).
+void Randomize(DenseMatrix &A, int seed)
+{
+   Vector a(A.Data(), A.Height()*A.Width());
+   a.Randomize(seed);
+}
+
+// Return the relative difference between two matrices.
+double RelDiff(const DenseMatrix &A, const DenseMatrix &B)
+{
+   DenseMatrix D(A);
+   D.Add(-1.0, B);
+   const double nrm = A.MaxMaxNorm();
+   return (nrm > 0.0) ? D.MaxMaxNorm()/nrm : D.MaxMaxNorm();
+}
+
+void Report(const char *name, int n, int k, double t_lib, double t_ref,
+            double diff)
+{
+   cout << setw(14) << name << setw(6) << n << setw(4) << k
+        << setw(13) << t_lib << setw(13) << t_ref
+        << setw(9) << setprecision(3) << t_ref/t_lib
+        << setw(12) << diff << setprecision(6) << endl;
+}
+
+int main(int argc, char *argv[])
+{
+   // 1. Parse command-line options.
+   int reps = 2000;
+   bool check = false;
+
+   OptionsParser args(argc, argv);
+   args.AddOption(&reps, "-r", "--repetitions",
+                  "Number of repetitions of each kernel call.");
+   args.AddOption(&check, "-check", "--check", "-no-check", "--no-check",
+                  "Exit with an error if the kernels and the reference loops"
+                  " give different results.");
+   args.Parse();
+   if (!args.Good())
+   {
+      args.PrintUsage(cout);
+      return 1;
+   }
+   args.PrintOptions(cout);
+
+   const int sizes[] = { 5, 15, 35, 16, 81 };
+   const int num_sizes = sizeof(sizes)/sizeof(sizes[0]);
+   StopWatch sw;
+   double max_diff = 0.0;
+
+   cout << "\n" << setw(14) << "kernel" << setw(6) << "n" << setw(4) << "k"
+        << setw(13) << "t_lib (s)" << setw(13) << "t_ref (s)"
+        << setw(9) << "speedup" << setw(12) << "rel. diff" << endl;
+
+   // 2. Products of an n x k matrix (e.g. shape function derivatives) with
+   //    k x k and n x k matrices, as in the element matrix computations.
+   for (int s = 0; s < num_sizes; s++)
+   {
+      const int n = sizes[s];
+      for (int k = 1; k <= 4; k++)
+      {
+         DenseMatrix A(n, k), B(n, k), J(k, k), C(n, k), Cr(n, k);
+         DenseMatrix E(n, n), Er(n, n), F(k, k), Fr(k, k);
+         Randomize(A, 1);
+         Randomize(B, 2);
+         Randomize(J, 3);
+
+         sw.Clear(); sw.Start();
+         for (int r = 0; r < reps; r++) { Mult(A, J, C); }
+         sw.Stop();
+         const double t_lib = sw.RealTime();
+         sw.Clear(); sw.Start();
+         for (int r = 0; r < reps; r++) { RefMult(A, J, Cr); }
+         sw.Stop();
+         double diff = RelDiff(Cr, C);
+         Report("Mult", n, k, t_lib, sw.RealTime(), diff);
+         max_diff = max(max_diff, diff);
+
+         sw.Clear(); sw.Start();
+         for (int r = 0; r < reps; r++) { MultABt(A, B, E); }
+         sw.Stop();
+         const double t_lib2 = sw.RealTime();
+         sw.Clear(); sw.Start();
+         for (int r = 0; r < reps; r++) { RefMultABt(A, B, Er); }
+         sw.Stop();
+         diff = RelDiff(Er, E);
+         Report("MultABt", n, k, t_lib2, sw.RealTime(), diff);
+         max_diff = max(max_diff, diff);
+
+         sw.Clear(); sw.Start();
+         for (int r = 0; r < reps; r++) { MultAtB(A, B, F); }
+         sw.Stop();
+         const double t_lib3 = sw.RealTime();
+         sw.Clear(); sw.Start();
+         for (int r = 0; r < reps; r++) { RefMultAtB(A, B, Fr); }
+         sw.Stop();
+         diff = RelDiff(Fr, F);
+         Report("MultAtB", n, k, t_lib3, sw.RealTime(), diff);
+         max_diff = max(max_diff, diff);
+
+         E = 0.0;
+         sw.Clear(); sw.Start();
+         for (int r = 0; r < reps; r++) { AddMult_a_AAt(0.5, A, E); }
+         sw.Stop();
+         const double t_lib4 = sw.RealTime();
+         Er = 0.0;
+         sw.Clear(); sw.Start();
+         for (int r = 0; r < reps; r++) { RefAddMult_a_AAt(0.5, A, Er); }
+         sw.Stop();
+         // compare the result of a single call
+         E = 0.0;
+         AddMult_a_AAt(0.5, A, E);
+         Er = 0.0;
+         RefAddMult_a_AAt(0.5, A, Er);
+         diff = RelDiff(Er, E);
+         Report("AddMult_a_AAt", n, k, t_lib4, sw.RealTime(), diff);
+         max_diff = max(max_diff, diff);
+      }
+   }
+
+   // 3. Inverses of Jacobian matrices, using LU factorization as reference.
+   for (int k = 1; k <= 4; k++)
+   {
+      DenseMatrix J(k, k), invJ(k, k), invJr(k, k);
+      Randomize(J, 4);
+      for (int i = 0; i < k; i++) { J(i,i) += k; }
+
+      sw.Clear(); sw.Start();
+      for (int r = 0; r < reps; r++) { CalcInverse(J, invJ); }
+      sw.Stop();
+      const double t_lib = sw.RealTime();
+      sw.Clear(); sw.Start();
+      for (int r = 0; r < reps; r++) { RefCalcInverse(J, invJr); }
+      sw.Stop();
+      const double diff = RelDiff(invJr, invJ);
+      Report("CalcInverse", k, k, t_lib, sw.RealTime(), diff);
+      max_diff = max(max_diff, diff);
+   }
+
+   cout << "\nMaximal relative difference: " << max_diff << endl;
+
+   // 4. Allow for round-off differences: CalcInverse uses a different
+   //    algorithm and the compiler may contract the operations differently
+   //    (e.g. into fused multiply-adds) in the library and in this file.
+   if (check && max_diff > 1e-12)
+   {
+      cout << "Error: the kernels and the reference loops differ!" << endl;
+      return 2;
+   }
+
+   return 0;
+}
@@ -0,0 +1,302 @@
+//                     MFEM Communication-Reducing Krylov Solvers
+//
+// Compile with: make krylov-solvers
+//
+// Sample runs:  krylov-solvers
+//               krylov-solvers -m ../../data/star.mesh -r 4 -o 2
+//               krylov-solvers -r 2 -check
+//               krylov-solvers -nrhs 8 -check
+//
+// Description:  This miniapp compares the pipelined and s-step Krylov solvers
+//               (PipelinedCGSolver, SStepCGSolver and PipelinedMINRESSolver)
+//               with CGSolver and MINRESSolver on the Jacobi preconditioned
+//               Laplace problem of Example 1, and checks two cases in which
+//               the Krylov space is exhausted after the first step: a
+//               diagonal operator with its exact (Jacobi) preconditioner and
+//               the 1D finite difference Laplacian with one of its
+//               eigenvectors as the right-hand side. All solvers must
+//               converge in one iteration in these cases. The Laplace problem
+//               is also solved for several random right-hand sides at once
+//               with the MultiVector versions of CGSolver and MINRESSolver,
+//               and the SparseMatrix product with a MultiVector (SpMM) is
+//               checked; both are compared with one-vector computations.
+//               With -check the program exits with an error if a solver does
+//               not converge, differs from the reference solution, or needs
+//               more than one iteration in the exhausted cases.
+
+#include "mfem.hpp"
+#include <iostream>
+#include <iomanip>
+#include <cmath>
+
+using namespace std;
+using namespace mfem;
+
+const int num_solvers = 5;
+const char *solver_names[num_solvers] =
+{ "CG", "pipelined CG", "s-step CG", "MINRES", "pipelined MINRES" };
+
+IterativeSolver *NewSolver(int k)
+{
+   switch (k)
+   {
+      case 0: return new CGSolver;
+      case 1: return new PipelinedCGSolver;
+      case 2: return new SStepCGSolver;
+      case 3: return new MINRESSolver;
+      default: return new PipelinedMINRESSolver;
+   }
+}
+
+// Solve A x = b with solver k and the preconditioner B (if not NULL); return
+// the relative error with respect to x_ref (if not NULL).
+double Solve(int k, const Operator &A, Solver *B, const Vector &b,
+             const Vector *x_ref, Vector &x, int &iter, bool &conv)
+{
+   IterativeSolver *solver = NewSolver(k);
+   solver->SetRelTol(1e-12);
+   solver->SetAbsTol(0.0);
+   solver->SetMaxIter(2000);
+   solver->SetPrintLevel(-1);
+   if (B) { solver->SetPreconditioner(*B); }
+   solver->SetOperator(A);
+   x.SetSize(A.Width());
+   x = 0.0;
+   solver->Mult(b, x);
+   iter = solver->GetNumIterations();
+   conv = solver->GetConverged();
+   delete solver;
+
+   if (!x_ref) { return 0.0; }
+   Vector d(x);
+   d -= *x_ref;
+   return d.Normlinf()/x_ref->Normlinf();
+}
+
+// Solve A X = B for all vectors of B at once with solver k (CG or MINRES) and
+// the preconditioner P; return the largest relative error of the vectors of X
+// with respect to the vectors of X_ref.
+double SolveMulti(int k, const Operator &A, Solver &P, const MultiVector &B,
+                  const MultiVector &X_ref, MultiVector &X, int &iter,
+                  bool &conv)
+{
+   IterativeSolver *solver = NewSolver(k);
+   solver->SetRelTol(1e-12);
+   solver->SetAbsTol(0.0);
+   solver->SetMaxIter(2000);
+   solver->SetPrintLevel(-1);
+   solver->SetPreconditioner(P);
+   solver->SetOperator(A);
+   X.SetSize(A.Width(), B.NumVectors());
+   X = 0.0;
+   solver->Mult(B, X);
+   iter = solver->GetNumIterations();
+   conv = solver->GetConverged();
+   delete solver;
+
+   double err = 0.0;
+   for (int j = 0; j < B.NumVectors(); j++)
+   {
+      Vector x, x_ref;
+      X.GetVectorReference(j, x);
+      X_ref.GetVectorReference(j, x_ref);
+      Vector d(x);
+      d -= x_ref;
+      err = max(err, d.Normlinf()/x_ref.Normlinf());
+   }
+   return err;
+}
+
+void PrintLine(const char *problem, int k, int iter, bool conv, double err)
+{
+   cout << setw(20) << problem << setw(18) << solver_names[k]
+        << setw(8) << iter << setw(6) << (conv ? "yes" : "no")
+        << setw(14) << err << endl;
+}
+
+int main(int argc, char *argv[])
+{
+   // 1. Parse command-line options.
+   const char *mesh_file = "../../data/star.mesh";
+   int ref_levels = 3;
+   int order = 1;
+   int n = 100;
+   int nrhs = 4;
+   bool check = false;
+
+   OptionsParser args(argc, argv);
+   args.AddOption(&mesh_file, "-m", "--mesh",
+                  "Mesh file to use.");
+   args.AddOption(&ref_levels, "-r", "--refine",
+                  "Number of uniform refinements.");
+   args.AddOption(&order, "-o", "--order",
+                  "Finite element order (polynomial degree).");
+   args.AddOption(&n, "-n", "--size",
+                  "Size of the diagonal and the 1D Laplacian problems.");
+   args.AddOption(&nrhs, "-nrhs", "--num-rhs",
+                  "Number of right-hand sides of the MultiVector solves.");
+   args.AddOption(&check, "-check", "--check", "-no-check", "--no-check",
+                  "Exit with an error if a solver fails.");
+   args.Parse();
+   if (!args.Good())
+   {
+      args.PrintUsage(cout);
+      return 1;
+   }
+   args.PrintOptions(cout);
+
+   bool ok = true;
+   cout << "\n" << setw(20) << "problem" << setw(18) << "solver"
+        << setw(8) << "iter" << setw(6) << "conv" << setw(14) << "rel. diff"
+        << endl;
+
+   // 2. The Laplace problem of Example 1 with Jacobi preconditioning; the
+   //    solution of CGSolver is the reference.
+   {
+      Mesh *mesh = new Mesh(mesh_file, 1, 1);
+      for (int l = 0; l < ref_levels; l++)
+      {
+         mesh->UniformRefinement();
+      }
+      H1_FECollection fec(order, mesh->Dimension());
+      FiniteElementSpace fespace(mesh, &fec);
+
+      Array<int> ess_tdof_list, ess_bdr(mesh->bdr_attributes.Max());
+      ess_bdr = 1;
+      fespace.GetEssentialTrueDofs(ess_bdr, ess_tdof_list);
+
+      LinearForm lf(&fespace);
+      ConstantCoefficient one(1.0);
+      lf.AddDomainIntegrator(new DomainLFIntegrator(one));
+      lf.Assemble();
+      GridFunction gf(&fespace);
+      gf = 0.0;
+
+      BilinearForm a(&fespace);
+      a.AddDomainIntegrator(new DiffusionIntegrator(one));
+      a.Assemble();
+      SparseMatrix A;
+      Vector B, X, X_ref;
+      a.FormLinearSystem(ess_tdof_list, gf, lf, A, X, B);
+      DSmoother jacobi(A);
+
+      for (int k = 0; k < num_solvers; k++)
+      {
+         int iter;
+         bool conv;
+         const double err = Solve(k, A, &jacobi, B, (k ? &X_ref : NULL),
+                                  (k ? X : X_ref), iter, conv);
+         PrintLine("Laplace", k, iter, conv, err);
+         if (!conv || err > 1e-8) { ok = false; }
+      }
+
+      // The same problem with nrhs random right-hand sides: the MultiVector
+      // CG and MINRES solves, which apply A with SpMM, are compared with nrhs
+      // one-vector solves, and SpMM with nrhs products with one vector.
+      MultiVector MB(A.Height(), nrhs), MX, MX_ref(A.Height(), nrhs);
+      MB.GetValues().Randomize(1);
+      for (int j = 0; j < ess_tdof_list.Size(); j++)
+      {
+         for (int v = 0; v < nrhs; v++)
+         {
+            MB.GetVectorData(v)[ess_tdof_list[j]] = 0.0;
+         }
+      }
+      const char *multi_problem = "Laplace, MultiVec";
+      const int multi_solvers[2] = { 0, 3 };
+      for (int m = 0; m < 2; m++)
+      {
+         const int k = multi_solvers[m];
+         int iter;
+         bool conv;
+         for (int v = 0; v < nrhs; v++)
+         {
+            Vector b, x_ref;
+            MB.GetVectorReference(v, b);
+            MX_ref.GetVectorReference(v, x_ref);
+            Solve(k, A, &jacobi, b, NULL, x_ref, iter, conv);
+         }
+         const double err = SolveMulti(k, A, jacobi, MB, MX_ref, MX, iter,
+                                       conv);
+         PrintLine(multi_problem, k, iter, conv, err);
+         if (!conv || err > 1e-8) { ok = false; }
+      }
+
+      MultiVector MY(A.Height(), nrhs);
+      A.Mult(MB, MY);
+      double spmm_err = 0.0;
+      for (int v = 0; v < nrhs; v++)
+      {
+         Vector b, y, y_ref(A.Height());
+         MB.GetVectorReference(v, b);
+         MY.GetVectorReference(v, y);
+         A.Mult(b, y_ref);
+         Vector d(y);
+         d -= y_ref;
+         spmm_err = max(spmm_err, d.Normlinf()/y_ref.Normlinf());
+      }
+      cout << setw(20) << multi_problem << setw(18) << "SpMM"
+           << setw(8) << "-" << setw(6) << "-" << setw(14) << spmm_err
+           << endl;
+      if (spmm_err > 1e-14) { ok = false; }
+
+      delete mesh;
+   }
+
+   // 3. A diagonal operator with its exact inverse as the preconditioner.
+   {
+      SparseMatrix D(n);
+      for (int i = 0; i < n; i++) { D.Set(i, i, 1.0 + i); }
+      D.Finalize();
+      DSmoother jacobi(D);
+
+      Vector b(n), x, x_ref(n);
+      b.Randomize(1);
+      for (int i = 0; i < n; i++) { x_ref(i) = b(i)/(1.0 + i); }
+      for (int k = 0; k < num_solvers; k++)
+      {
+         int iter;
+         bool conv;
+         const double err = Solve(k, D, &jacobi, b, &x_ref, x, iter, conv);
+         PrintLine("exact prec.", k, iter, conv, err);
+         if (!conv || iter > 1 || err > 1e-12) { ok = false; }
+      }
+   }
+
+   // 4. The 1D Laplacian tridiag(-1, 2, -1) with the right-hand side equal to
+   //    one of its eigenvectors, sin(j pi i/(n+1)), with eigenvalue
+   //    2 - 2 cos(j pi/(n+1)).
+   {
+      SparseMatrix L(n);
+      for (int i = 0; i < n; i++)
+      {
+         L.Set(i, i, 2.0);
+         if (i > 0) { L.Set(i, i-1, -1.0); }
+         if (i < n-1) { L.Set(i, i+1, -1.0); }
+      }
+      L.Finalize();
+
+      const int j = 3;
+      const double theta = j*M_PI/(n+1), lambda = 2.0 - 2.0*cos(theta);
+      Vector b(n), x, x_ref(n);
+      for (int i = 0; i < n; i++)
+      {
+         b(i) = sin((i+1)*theta);
+         x_ref(i) = b(i)/lambda;
+      }
+      for (int k = 0; k < num_solvers; k++)
+      {
+         int iter;
+         bool conv;
+         const double err = Solve(k, L, NULL, b, &x_ref, x, iter, conv);
+         PrintLine("eigenvector rhs", k, iter, conv, err);
+         if (!conv || iter > 1 || err > 1e-10) { ok = false; }
+      }
+   }
+
+   cout << "\nAll solvers " << (ok ? "passed." : "did not pass.") << endl;
+
+   if (check && !ok) { return 2; }
+
+   return 0;
+}
@@ -0,0 +1,237 @@
+//                     MFEM Memory Arena Miniapp
+//
+// Compile with: make memory-arena
+//
+// Sample runs:  memory-arena
+//               memory-arena -n 1000 -c 256
+//               memory-arena -check
+//
+// Description:  This miniapp checks the MemoryArena and ArenaScope classes,
+//               which provide the per-iteration temporaries of the CFOSLS
+//               solvers, and compares their speed with heap allocation. The
+//               following properties are checked:
+//               - memory is returned in LIFO order, so that a released block
+//                 is handed out again by the next request, and all pointers
+//                 are aligned;
+//               - requests larger than the current chunk add chunks, and the
+//                 chunks are merged into one when the arena is completely
+//                 released, so that repeating the same allocation pattern does
+//                 not allocate any more heap memory;
+//               - nested scopes return exactly the memory allocated while they
+//                 were open, and the data of the outer scopes is preserved.
+//               With -check the program exits with an error if a check fails.
+
+#include "mfem.hpp"
+#include <iostream>
+#include <iomanip>
+
+using namespace std;
+using namespace mfem;
+
+bool ok = true;
+
+void Check(bool cond, const char *what)
+{
+   cout << setw(60) << left << what << (cond ? "passed" : "FAILED") << endl;
+   if (!cond) { ok = false; }
+}
+
+bool Aligned(const void *p)
+{
+   return reinterpret_cast<size_t>(p) % 16 == 0;
+}
+
+// Fill the arena as a solver iteration would: a few nested scopes with
+// matrices and vectors of increasing size; returns a checksum.
+double Iteration(MemoryArena &arena, int n)
+{
+   double sum = 0.0;
+   ArenaScope scope(arena);
+   Vector x(scope.Alloc<double>(n), n);
+   x = 1.0;
+   for (int k = 1; k <= 4; k++)
+   {
+      ArenaScope inner(arena);
+      DenseMatrix M(inner.Alloc<double>(k*n*k), k*n, k);
+      M = 2.0;
+      Array<int> a;
+      a.MakeRef(inner.Alloc<int>(k*n), k*n);
+      a = k;
+      sum += M(0, 0) + a[k*n-1];
+   }
+   return sum + x.Sum();
+}
+
+// The same with heap allocated containers.
+double HeapIteration(int n)
+{
+   double sum = 0.0;
+   Vector x(n);
+   x = 1.0;
+   for (int k = 1; k <= 4; k++)
+   {
+      DenseMatrix M(k*n, k);
+      M = 2.0;
+      Array<int> a(k*n);
+      a = k;
+      sum += M(0, 0) + a[k*n-1];
+   }
+   return sum + x.Sum();
+}
+
+int main(int argc, char *argv[])
+{
+   // 1. Parse command-line options.
+   int n = 100;
+   int chunk_size = 1024;
+   int num_iter = 10000;
+   bool check = false;
+
+   OptionsParser args(argc, argv);
+   args.AddOption(&n, "-n", "--size",
+                  "Size of the temporary vectors.");
+   args.AddOption(&chunk_size, "-c", "--chunk-size",
+                  "Initial chunk size of the arenas in bytes.");
+   args.AddOption(&num_iter, "-i", "--iterations",
+                  "Number of iterations in the timing.");
+   args.AddOption(&check, "-check", "--check", "-no-check", "--no-check",
+                  "Exit with an error if a check fails.");
+   args.Parse();
+   if (!args.Good())
+   {
+      args.PrintUsage(cout);
+      return 1;
+   }
+   args.PrintOptions(cout);
+   cout << endl;
+   // the checks below assume chunks of whole 16-byte blocks
+   chunk_size = max(256, (chunk_size + 15)/16*16);
+
+   // 2. LIFO release and alignment.
+   {
+      MemoryArena arena(chunk_size);
+      const MemoryArena::Mark m0 = arena.GetMark();
+      double *a = arena.Alloc<double>(3);
+      const MemoryArena::Mark m1 = arena.GetMark();
+      int *b = arena.Alloc<int>(5);
+      double *c = arena.Alloc<double>(7);
+      Check(Aligned(a) && Aligned(b) && Aligned(c), "aligned pointers");
+      Check(arena.Used() == 32 + 32 + 64, "used bytes include the padding");
+
+      arena.Release(m1);
+      Check(arena.Used() == 32, "release to a mark");
+      Check(arena.Alloc<int>(5) == b, "released memory is reused first");
+
+      arena.Release(m1);
+      arena.Release(m0);
+      Check(arena.Used() == 0 && arena.Alloc<double>(1) == a,
+            "release to the first mark");
+      arena.Release(m0);
+      Check(arena.Peak() == 128 && arena.NumHeapAllocs() == 1,
+            "peak usage and a single chunk");
+   }
+
+   // 3. Growth and merging of the chunks.
+   {
+      MemoryArena arena(chunk_size);
+      {
+         ArenaScope scope(arena);
+         double *x = scope.Alloc<double>(chunk_size/8);   // fills a chunk
+         x[0] = 1.0;
+         x[chunk_size/8 - 1] = 2.0;
+         // does not fit, the second chunk has twice the size of the first
+         double *y = scope.Alloc<double>(chunk_size/8 + 2);
+         y[chunk_size/8 + 1] = 3.0;
+         Check(arena.NumHeapAllocs() == 2 &&
+               arena.MemoryUsage() == 3*chunk_size,
+               "new chunk for a request that does not fit");
+         double *z = scope.Alloc<double>(1);
+         Check(z == y + chunk_size/8 + 2 && arena.NumHeapAllocs() == 2,
+               "next request continues in the new chunk");
+         Check(x[0] == 1.0 && x[chunk_size/8 - 1] == 2.0,
+               "data of the first chunk is kept");
+      }
+      const size_t peak = arena.Peak();
+      Check(arena.Used() == 0 && arena.NumHeapAllocs() == 3 &&
+            arena.MemoryUsage() == 3*chunk_size,
+            "chunks merged after the complete release");
+
+      {
+         ArenaScope scope(arena);
+         scope.Alloc<double>(chunk_size/8);
+         scope.Alloc<double>(chunk_size/8 + 2);
+         scope.Alloc<double>(1);
+      }
+      Check(arena.NumHeapAllocs() == 3 && arena.Peak() == peak,
+            "repeated pattern needs no heap allocation");
+
+      arena.Clear();
+      Check(arena.MemoryUsage() == 0, "Clear() frees the chunks");
+   }
+
+   // 4. Nested scopes.
+   {
+      MemoryArena arena(chunk_size);
+      ArenaScope outer(arena);
+      Vector u(outer.Alloc<double>(n), n);
+      u = 5.0;
+      const size_t used_outer = arena.Used();
+      double *v_data;
+      {
+         ArenaScope middle(arena);
+         Vector v(middle.Alloc<double>(n), n);
+         v = 6.0;
+         v_data = v.GetData();
+         const size_t used_middle = arena.Used();
+         {
+            ArenaScope inner(arena);
+            // enough to need new chunks
+            Vector w(inner.Alloc<double>(8*chunk_size), 8*chunk_size);
+            w = 7.0;
+         }
+         Check(arena.Used() == used_middle, "inner scope returns its memory");
+         Check(v.Min() == 6.0 && v.Max() == 6.0,
+               "data of the middle scope is kept");
+      }
+      Check(arena.Used() == used_outer, "middle scope returns its memory");
+      Check(u.Min() == 5.0 && u.Max() == 5.0, "data of the outer scope is kept");
+      const long allocs = arena.NumHeapAllocs();
+      {
+         ArenaScope again(arena);
+         Vector v(again.Alloc<double>(n), n);
+         Check(v.GetData() == v_data, "scope reopens at the same place");
+      }
+      Check(arena.NumHeapAllocs() == allocs, "no new chunk for the reopened scope");
+   }
+
+   // 5. Timing of a solver-like allocation pattern.
+   {
+      MemoryArena arena(chunk_size);
+      double sum_arena = 0.0, sum_heap = 0.0;
+      StopWatch sw;
+      sum_arena += Iteration(arena, n);
+      const long allocs = arena.NumHeapAllocs();
+      sw.Start();
+      for (int i = 1; i < num_iter; i++) { sum_arena += Iteration(arena, n); }
+      sw.Stop();
+      const double t_arena = sw.RealTime();
+      sw.Clear();
+      sw.Start();
+      for (int i = 1; i < num_iter; i++) { sum_heap += HeapIteration(n); }
+      sw.Stop();
+      const double t_heap = sw.RealTime();
+      sum_heap += HeapIteration(n);
+      Check(sum_arena == sum_heap, "same results with the arena and the heap");
+      Check(arena.Used() == 0 && arena.NumHeapAllocs() == allocs,
+            "the arena allocates only in the first iteration");
+      cout << "\ntime with the arena : " << t_arena << " s ("
+           << arena.NumHeapAllocs() << " chunk allocations)"
+           << "\ntime with the heap  : " << t_heap << " s" << endl;
+   }
+
+   cout << "\nAll checks " << (ok ? "passed." : "did not pass.") << endl;
+
+   if (check && !ok) { return 2; }
+
+   return 0;
+}
@@ -0,0 +1,163 @@
+//                    MFEM 4D Mesh Topology Construction Benchmark
+//
+// Compile with: make mesh-topology
+//
+// Sample runs:  mesh-topology
+//               mesh-topology -r 3
+//               mesh-topology -m ../../data/cube4d_24.MFEM -r 1 -check
+//
+// Description:  This miniapp times the construction of the face, planar and
+//               edge tables of a pentatope mesh with the two algorithms of
+//               Mesh::TopologyBuilder: the hash tables STable4D, STable3D and
+//               DSTable, and the flat key arrays of SortedKeyTable, which are
+//               numbered with a (thread-parallel) radix sort. The mesh is read
+//               and uniformly refined with each algorithm, and the resulting
+//               tables are compared; with -check the program exits with an
+//               error if they differ.
+
+#include "mfem.hpp"
+#include <iostream>
+#include <iomanip>
+
+using namespace std;
+using namespace mfem;
+
+// Return true if the two tables have the same rows.
+bool SameTable(const Table &a, const Table &b)
+{
+   if (a.Size() != b.Size()) { return false; }
+   for (int i = 0; i < a.Size(); i++)
+   {
+      if (a.RowSize(i) != b.RowSize(i)) { return false; }
+      for (int j = 0; j < a.RowSize(i); j++)
+      {
+         if (a.GetRow(i)[j] != b.GetRow(i)[j]) { return false; }
+      }
+   }
+   return true;
+}
+
+// Compare the topology of two meshes constructed in the same way.
+bool SameTopology(Mesh &a, Mesh &b)
+{
+   if (a.GetNE() != b.GetNE() || a.GetNBE() != b.GetNBE() ||
+       a.GetNFaces() != b.GetNFaces() || a.GetNPlanars() != b.GetNPlanars() ||
+       a.GetNEdges() != b.GetNEdges())
+   {
+      return false;
+   }
+   if (!SameTable(a.ElementToFaceTable(), b.ElementToFaceTable()) ||
+       !SameTable(a.ElementToPlanTable(), b.ElementToPlanTable()) ||
+       !SameTable(a.ElementToEdgeTable(), b.ElementToEdgeTable()))
+   {
+      return false;
+   }
+
+   Array<int> ra, rb, ca, cb;
+   for (int i = 0; i < a.GetNBE(); i++)
+   {
+      if (a.GetBdrElementEdgeIndex(i) != b.GetBdrElementEdgeIndex(i))
+      {
+         return false;
+      }
+      a.GetBdrElementPlanars(i, ra, ca);
+      b.GetBdrElementPlanars(i, rb, cb);
+      if (ra.Size() != rb.Size()) { return false; }
+      for (int j = 0; j < ra.Size(); j++)
+      {
+         if (ra[j] != rb[j]) { return false; }
+      }
+      a.GetBdrElementEdges(i, ra, ca);
+      b.GetBdrElementEdges(i, rb, cb);
+      if (ra.Size() != rb.Size()) { return false; }
+      for (int j = 0; j < ra.Size(); j++)
+      {
+         if (ra[j] != rb[j] || ca[j] != cb[j]) { return false; }
+      }
+   }
+
+   for (int f = 0; f < a.GetNFaces(); f++)
+   {
+      int ea1, ea2, eb1, eb2, ia1, ia2, ib1, ib2;
+      a.GetFaceElements(f, &ea1, &ea2);
+      b.GetFaceElements(f, &eb1, &eb2);
+      a.GetFaceInfos(f, &ia1, &ia2);
+      b.GetFaceInfos(f, &ib1, &ib2);
+      if (ea1 != eb1 || ea2 != eb2 || ia1 != ib1 || ia2 != ib2 ||
+          a.getSwappedFaceElementInfo(f) != b.getSwappedFaceElementInfo(f))
+      {
+         return false;
+      }
+   }
+   return true;
+}
+
+int main(int argc, char *argv[])
+{
+   // 1. Parse command-line options.
+   const char *mesh_file = "../../data/cube4d_96.MFEM";
+   int ref_levels = 2;
+   bool check = false;
+
+   OptionsParser args(argc, argv);
+   args.AddOption(&mesh_file, "-m", "--mesh",
+                  "Mesh file to use (pentatopes only).");
+   args.AddOption(&ref_levels, "-r", "--refine",
+                  "Number of uniform refinements.");
+   args.AddOption(&check, "-check", "--check", "-no-check", "--no-check",
+                  "Exit with an error if the two algorithms give different"
+                  " tables.");
+   args.Parse();
+   if (!args.Good())
+   {
+      args.PrintUsage(cout);
+      return 1;
+   }
+   args.PrintOptions(cout);
+
+   // 2. Read and refine the mesh with both algorithms. The algorithm has to be
+   //    selected before the mesh is constructed.
+   const Mesh::TopologyBuilder builders[2] =
+   { Mesh::HASH_TABLES, Mesh::SORTED_KEYS };
+   const char *names[2] = { "hash tables", "sorted keys" };
+   Mesh *mesh[2];
+   StopWatch sw;
+
+   cout << "\n" << setw(12) << "algorithm" << setw(8) << "level"
+        << setw(12) << "elements" << setw(12) << "faces"
+        << setw(12) << "time (s)" << endl;
+   for (int k = 0; k < 2; k++)
+   {
+      Mesh::SetDefaultTopologyBuilder(builders[k]);
+      sw.Clear(); sw.Start();
+      mesh[k] = new Mesh(mesh_file, 1, 1);
+      sw.Stop();
+      MFEM_VERIFY(mesh[k]->Dimension() == 4, "the mesh must be 4D");
+      cout << setw(12) << names[k] << setw(8) << 0
+           << setw(12) << mesh[k]->GetNE() << setw(12) << mesh[k]->GetNFaces()
+           << setw(12) << sw.RealTime() << endl;
+      for (int l = 1; l <= ref_levels; l++)
+      {
+         sw.Clear(); sw.Start();
+         mesh[k]->UniformRefinement();
+         sw.Stop();
+         cout << setw(12) << names[k] << setw(8) << l
+              << setw(12) << mesh[k]->GetNE()
+              << setw(12) << mesh[k]->GetNFaces()
+              << setw(12) << sw.RealTime() << endl;
+      }
+   }
+   Mesh::SetDefaultTopologyBuilder(Mesh::HASH_TABLES);
+
+   // 3. Compare the topology tables.
+   const bool same = SameTopology(*mesh[0], *mesh[1]);
+   cout << "\nThe two algorithms give " << (same ? "the same" : "different")
+        << " tables." << endl;
+
+   delete mesh[1];
+   delete mesh[0];
+
+   if (check && !same) { return 2; }
+
+   return 0;
+}
@@ -0,0 +1,175 @@
+//                  MFEM Sparse Matrix-Vector Product Benchmark
+//
+// Compile with: make sparse-spmv
+//
+// Sample runs:  sparse-spmv
+//               sparse-spmv -r 2 -n 20
+//               sparse-spmv -m ../../data/cube4d_24.MFEM -r 1 -check
+//
+// Description:  This miniapp times the products with the matrices of a 4D
+//               mixed problem: the RT0_4D mass plus div-div matrix M and the
+//               RT0_4D to L2 divergence matrix B. The CSR product of
+//               SparseMatrix is compared with its SELL-C-sigma copy (see
+//               SparseMatrix::BuildSellCSigma) for C = 4 and C = 8, and the
+//               CSR transposed product of B is compared with the product with
+//               a cached transpose (see SparseMatrix::BuildTranspose). With
+//               -check the program exits with an error if the results of the
+//               different formats differ.
+
+#include "mfem.hpp"
+#include <iostream>
+#include <iomanip>
+
+using namespace std;
+using namespace mfem;
+
+// Time nrep products y = A x (or y = A^t x) and return the time per product.
+double TimeMult(const SparseMatrix &A, const Vector &x, Vector &y, int nrep,
+                bool transp)
+{
+   StopWatch sw;
+   sw.Start();
+   for (int k = 0; k < nrep; k++)
+   {
+      if (transp) { A.MultTranspose(x, y); }
+      else { A.Mult(x, y); }
+   }
+   sw.Stop();
+   return sw.RealTime()/nrep;
+}
+
+// Relative difference of y and y_ref in the max norm.
+double RelDiff(const Vector &y, const Vector &y_ref)
+{
+   Vector d(y);
+   d -= y_ref;
+   return d.Normlinf()/std::max(y_ref.Normlinf(), 1e-300);
+}
+
+void PrintLine(const char *matrix, const char *format, int nnz, double t,
+               double t_ref, double diff)
+{
+   cout << setw(8) << matrix << setw(16) << format << setw(12) << nnz
+        << setw(14) << t << setw(10) << t_ref/t << setw(12) << diff << endl;
+}
+
+int main(int argc, char *argv[])
+{
+   // 1. Parse command-line options.
+   const char *mesh_file = "../../data/cube4d_96.MFEM";
+   int ref_levels = 1;
+   int nrep = 50;
+   int sigma = 256;
+   bool check = false;
+
+   OptionsParser args(argc, argv);
+   args.AddOption(&mesh_file, "-m", "--mesh",
+                  "Mesh file to use (pentatopes only).");
+   args.AddOption(&ref_levels, "-r", "--refine",
+                  "Number of uniform refinements.");
+   args.AddOption(&nrep, "-n", "--repetitions",
+                  "Number of timed products for every format.");
+   args.AddOption(&sigma, "-s", "--sigma",
+                  "Sorting window of the SELL-C-sigma format.");
+   args.AddOption(&check, "-check", "--check", "-no-check", "--no-check",
+                  "Exit with an error if the formats give different"
+                  " products.");
+   args.Parse();
+   if (!args.Good())
+   {
+      args.PrintUsage(cout);
+      return 1;
+   }
+   args.PrintOptions(cout);
+
+   // 2. Read and refine the mesh, and assemble the RT0_4D mass plus div-div
+   //    matrix and the divergence matrix.
+   Mesh *mesh = new Mesh(mesh_file, 1, 1);
+   MFEM_VERIFY(mesh->Dimension() == 4, "the mesh must be 4D");
+   for (int l = 0; l < ref_levels; l++)
+   {
+      mesh->UniformRefinement();
+   }
+
+   FiniteElementCollection *hdiv_coll = new RT0_4DFECollection;
+   FiniteElementCollection *l2_coll = new L2_FECollection(0, 4);
+   FiniteElementSpace *R_space = new FiniteElementSpace(mesh, hdiv_coll);
+   FiniteElementSpace *W_space = new FiniteElementSpace(mesh, l2_coll);
+   cout << "\nNumber of elements: " << mesh->GetNE()
+        << "\nRT0_4D unknowns:    " << R_space->GetVSize()
+        << "\nL2 unknowns:        " << W_space->GetVSize() << endl;
+
+   BilinearForm *mform = new BilinearForm(R_space);
+   mform->AddDomainIntegrator(new VectorFEMassIntegrator);
+   mform->AddDomainIntegrator(new DivDivIntegrator);
+   mform->Assemble();
+   mform->Finalize();
+   SparseMatrix &M = mform->SpMat();
+
+   MixedBilinearForm *bform = new MixedBilinearForm(R_space, W_space);
+   bform->AddDomainIntegrator(new VectorFEDivergenceIntegrator);
+   bform->Assemble();
+   bform->Finalize();
+   SparseMatrix &B = bform->SpMat();
+
+   // 3. Time the products with each format.
+   const int Cs[2] = { 4, 8 };
+   const char *sell_names[2] = { "SELL-4-sigma", "SELL-8-sigma" };
+   SparseMatrix *mats[2] = { &M, &B };
+   const char *mat_names[2] = { "M", "B" };
+   double max_diff = 0.0;
+
+   cout << "\n" << setw(8) << "matrix" << setw(16) << "format"
+        << setw(12) << "stored" << setw(14) << "time (s)"
+        << setw(10) << "speedup" << setw(12) << "rel. diff" << endl;
+   for (int m = 0; m < 2; m++)
+   {
+      SparseMatrix &A = *mats[m];
+      Vector x(A.Width()), y_ref(A.Height()), y(A.Height());
+      x.Randomize(1);
+
+      const double t_csr = TimeMult(A, x, y_ref, nrep, false);
+      PrintLine(mat_names[m], "CSR", A.NumNonZeroElems(), t_csr, t_csr, 0.0);
+      for (int k = 0; k < 2; k++)
+      {
+         A.BuildSellCSigma(Cs[k], sigma);
+         const double t = TimeMult(A, x, y, nrep, false);
+         const double diff = RelDiff(y, y_ref);
+         PrintLine(mat_names[m], sell_names[k],
+                   A.GetSellCSigma()->NumStoredEntries(), t, t_csr, diff);
+         max_diff = std::max(max_diff, diff);
+         A.ResetSellCSigma();
+      }
+   }
+
+   {
+      Vector x(B.Height()), y_ref(B.Width()), y(B.Width());
+      x.Randomize(2);
+
+      const double t_csr = TimeMult(B, x, y_ref, nrep, true);
+      PrintLine("B^t", "CSR", B.NumNonZeroElems(), t_csr, t_csr, 0.0);
+      B.BuildTranspose();
+      const double t = TimeMult(B, x, y, nrep, true);
+      const double diff = RelDiff(y, y_ref);
+      PrintLine("B^t", "cached B^t", B.NumNonZeroElems(), t, t_csr, diff);
+      max_diff = std::max(max_diff, diff);
+      B.ResetTranspose();
+   }
+
+   const bool same = (max_diff < 1e-12);
+   cout << "\nThe formats give " << (same ? "the same" : "different")
+        << " products." << endl;
+
+   // 4. Free the used memory.
+   delete bform;
+   delete mform;
+   delete W_space;
+   delete R_space;
+   delete l2_coll;
+   delete hdiv_coll;
+   delete mesh;
+
+   if (check && !same) { return 2; }
+
+   return 0;
+}
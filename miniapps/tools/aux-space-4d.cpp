@@ -0,0 +1,229 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+//
+//      ----------------------------------------------------------------
+//      Aux Space 4D Miniapp:  Run the 4D auxiliary-space preconditioner
+//      ----------------------------------------------------------------
+//
+// This miniapp solves the definite problems
+//
+//    curl curl u + w u = f           in ND1_4D   (H(curl)),
+//    divskew divskew u + w u = f     in F2K0_4D  (H(div-skew)),
+//    -grad div u + w u = f           in RT0_4D   (H(div)),
+//
+// on a parallel 4D mesh with homogeneous essential boundary conditions and a
+// random right-hand side. Each system is solved by PCG preconditioned with
+// HypreAuxiliarySpace4D and, for comparison, with the l1-Gauss-Seidel smoother
+// alone. The number of iterations of both solvers is printed for every
+// space. With -check the program exits with an error if a PCG solve with the
+// auxiliary-space preconditioner does not converge.
+//
+// Compile with: make aux-space-4d
+//
+// Sample runs:  mpirun -np 4 aux-space-4d
+//               mpirun -np 4 aux-space-4d -s 0 -r 2
+//               mpirun -np 4 aux-space-4d -m ../../data/cube4d_24.MFEM -w 1e-2
+//               mpirun -np 4 aux-space-4d -check
+
+#include "mfem.hpp"
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+using namespace std;
+using namespace mfem;
+
+static const char *space_names[3] = { "ND1_4D", "F2K0_4D", "RT0_4D" };
+
+// Solve the definite problem in the given space with PCG and the given
+// preconditioner type: the auxiliary-space preconditioner (aux = true) or the
+// l1-GS smoother. Returns the number of iterations, or -1 if PCG did not
+// converge.
+int Solve(ParMesh *pmesh, int space, double weight, bool aux, double tol,
+          int max_iter, HYPRE_Int &size)
+{
+   FiniteElementCollection *fec;
+   switch (space)
+   {
+      case 0: fec = new ND1_4DFECollection; break;
+      case 1: fec = new DivSkew1_4DFECollection; break;
+      default: fec = new RT0_4DFECollection; break;
+   }
+   ParFiniteElementSpace *fespace = new ParFiniteElementSpace(pmesh, fec);
+   size = fespace->GlobalTrueVSize();
+
+   Array<int> ess_tdof_list;
+   if (pmesh->bdr_attributes.Size())
+   {
+      Array<int> ess_bdr(pmesh->bdr_attributes.Max());
+      ess_bdr = 1;
+      fespace->GetEssentialTrueDofs(ess_bdr, ess_tdof_list);
+   }
+
+   ConstantCoefficient one(1.0), w(weight);
+   ParBilinearForm *a = new ParBilinearForm(fespace);
+   switch (space)
+   {
+      case 0:
+         a->AddDomainIntegrator(new CurlCurlIntegrator(one));
+         a->AddDomainIntegrator(new VectorFEMassIntegrator(w));
+         break;
+      case 1:
+         a->AddDomainIntegrator(new DivSkewDivSkewIntegrator(one));
+         a->AddDomainIntegrator(new VectorFE_DivSkewMassIntegrator(w));
+         break;
+      default:
+         a->AddDomainIntegrator(new DivDivIntegrator(one));
+         a->AddDomainIntegrator(new VectorFEMassIntegrator(w));
+         break;
+   }
+   a->Assemble();
+
+   ParGridFunction x(fespace), b(fespace);
+   x = 0.0;
+   b = 0.0;
+   HypreParMatrix A;
+   Vector B, X;
+   a->FormLinearSystem(ess_tdof_list, x, b, A, X, B);
+
+   // random right-hand side which vanishes on the essential dofs
+   B.Randomize(1);
+   for (int i = 0; i < ess_tdof_list.Size(); i++)
+   {
+      B(ess_tdof_list[i]) = 0.0;
+   }
+
+   Solver *prec;
+   if (aux) { prec = new HypreAuxiliarySpace4D(A, fespace); }
+   else { prec = new HypreSmoother(A, HypreSmoother::l1GS); }
+
+   CGSolver pcg(MPI_COMM_WORLD);
+   pcg.SetOperator(A);
+   pcg.SetPreconditioner(*prec);
+   pcg.SetRelTol(tol);
+   pcg.SetMaxIter(max_iter);
+   pcg.SetPrintLevel(0);
+   pcg.Mult(B, X);
+   int iter = pcg.GetConverged() ? pcg.GetNumIterations() : -1;
+
+   delete prec;
+   delete a;
+   delete fespace;
+   delete fec;
+
+   return iter;
+}
+
+int main(int argc, char *argv[])
+{
+   // 1. Initialize MPI.
+   int num_procs, myid;
+   MPI_Init(&argc, &argv);
+   MPI_Comm_size(MPI_COMM_WORLD, &num_procs);
+   MPI_Comm_rank(MPI_COMM_WORLD, &myid);
+
+   // 2. Parse command-line options.
+   const char *mesh_file = "../../data/cube4d_96.MFEM";
+   int ser_ref_levels = 1;
+   int par_ref_levels = 0;
+   int space = -1;
+   double weight = 1.0;
+   double tol = 1e-8;
+   int max_iter = 500;
+   bool check = false;
+
+   OptionsParser args(argc, argv);
+   args.AddOption(&mesh_file, "-m", "--mesh",
+                  "Mesh file to use (4D).");
+   args.AddOption(&ser_ref_levels, "-r", "--refine",
+                  "Number of uniform refinements of the serial mesh.");
+   args.AddOption(&par_ref_levels, "-rp", "--refine-parallel",
+                  "Number of uniform refinements of the parallel mesh.");
+   args.AddOption(&space, "-s", "--space",
+                  "Space to solve in: 0 - ND1_4D, 1 - F2K0_4D, 2 - RT0_4D,"
+                  " -1 - all three.");
+   args.AddOption(&weight, "-w", "--weight",
+                  "Weight of the mass term.");
+   args.AddOption(&tol, "-tol", "--tolerance",
+                  "Relative tolerance of PCG.");
+   args.AddOption(&max_iter, "-i", "--max-iter",
+                  "Maximum number of PCG iterations.");
+   args.AddOption(&check, "-check", "--check", "-no-check", "--no-check",
+                  "Exit with an error if PCG with the auxiliary-space"
+                  " preconditioner does not converge.");
+   args.Parse();
+   if (!args.Good())
+   {
+      if (myid == 0) { args.PrintUsage(cout); }
+      MPI_Finalize();
+      return 1;
+   }
+   if (myid == 0) { args.PrintOptions(cout); }
+
+   // 3. Read and refine the serial mesh on all processors, then partition it.
+   ifstream imesh(mesh_file);
+   if (!imesh)
+   {
+      if (myid == 0)
+      {
+         cerr << "\nCan not open mesh file: " << mesh_file << '\n' << endl;
+      }
+      MPI_Finalize();
+      return 2;
+   }
+   Mesh *mesh = new Mesh(imesh, 1, 1);
+   imesh.close();
+   MFEM_VERIFY(mesh->Dimension() == 4, "a 4D mesh is required");
+   for (int l = 0; l < ser_ref_levels; l++)
+   {
+      mesh->UniformRefinement();
+   }
+   ParMesh *pmesh = new ParMesh(MPI_COMM_WORLD, *mesh);
+   delete mesh;
+   for (int l = 0; l < par_ref_levels; l++)
+   {
+      pmesh->UniformRefinement();
+   }
+
+   // 4. Solve in the requested spaces with both preconditioners.
+   bool ok = true;
+   if (myid == 0)
+   {
+      cout << "\nspace        unknowns    PCG+aux    PCG+l1GS" << endl;
+   }
+   for (int s = 0; s < 3; s++)
+   {
+      if (space >= 0 && s != space) { continue; }
+
+      HYPRE_Int size;
+      int aux_iter = Solve(pmesh, s, weight, true, tol, max_iter, size);
+      int gs_iter = Solve(pmesh, s, weight, false, tol, max_iter, size);
+      ok = ok && aux_iter >= 0;
+
+      if (myid == 0)
+      {
+         cout << setw(8) << space_names[s] << setw(16) << size
+              << setw(11) << aux_iter << setw(12) << gs_iter << endl;
+      }
+   }
+   if (myid == 0)
+   {
+      cout << "\n(-1: no convergence in " << max_iter << " iterations)\n"
+           << "PCG with the auxiliary-space preconditioner "
+           << (ok ? "converged" : "did not converge") << '.' << endl;
+   }
+
+   delete pmesh;
+
+   MPI_Finalize();
+
+   return (check && !ok) ? 3 : 0;
+}
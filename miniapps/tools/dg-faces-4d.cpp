@@ -0,0 +1,171 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+//
+//      ----------------------------------------------------------------
+//      DG Faces 4D Miniapp:  Check the parallel DG face terms in 4D
+//      ----------------------------------------------------------------
+//
+// This miniapp checks the face-to-element transformations of the shared faces
+// of a parallel 4D mesh, ParMesh::GetSharedFaceTransformations, which are used
+// by the interior face integrators of ParBilinearForm.
+//
+// A discontinuous function u is interpolated in an L2 space, and the energy
+// a(u,u) of the interior face terms of the symmetric interior penalty DG
+// discretization of the Laplacian is computed on the serial mesh and on the
+// parallel mesh obtained from it. The two values must be equal; the shared
+// faces only contribute correctly if the points of the neighbor element match
+// the points of the local element on the face. With -check the program exits
+// with an error if the values differ.
+//
+// Compile with: make dg-faces-4d
+//
+// Sample runs:  mpirun -np 4 dg-faces-4d
+//               mpirun -np 4 dg-faces-4d -m ../../data/cube4d_24.MFEM -r 2
+//               mpirun -np 4 dg-faces-4d -o 2 -check
+
+#include "mfem.hpp"
+#include <fstream>
+#include <iostream>
+#include <cmath>
+
+using namespace std;
+using namespace mfem;
+
+double u_func(const Vector &x)
+{
+   return sin(x(0) + 2.0*x(1)) * cos(x(2) - x(3)) + x(0)*x(3)*x(3);
+}
+
+int main(int argc, char *argv[])
+{
+   // 1. Initialize MPI.
+   int num_procs, myid;
+   MPI_Init(&argc, &argv);
+   MPI_Comm_size(MPI_COMM_WORLD, &num_procs);
+   MPI_Comm_rank(MPI_COMM_WORLD, &myid);
+
+   // 2. Parse command-line options.
+   const char *mesh_file = "../../data/cube4d_96.MFEM";
+   int ref_levels = 1;
+   int order = 1;
+   double sigma = -1.0;
+   double kappa = 5.0;
+   bool check = false;
+
+   OptionsParser args(argc, argv);
+   args.AddOption(&mesh_file, "-m", "--mesh",
+                  "Mesh file to use (4D).");
+   args.AddOption(&ref_levels, "-r", "--refine",
+                  "Number of uniform refinements of the serial mesh.");
+   args.AddOption(&order, "-o", "--order",
+                  "Finite element order (polynomial degree).");
+   args.AddOption(&sigma, "-s", "--sigma",
+                  "One of the two DG penalty parameters, typically +1/-1."
+                  " See the documentation of class DGDiffusionIntegrator.");
+   args.AddOption(&kappa, "-k", "--kappa",
+                  "One of the two DG penalty parameters, should be positive.");
+   args.AddOption(&check, "-check", "--check", "-no-check", "--no-check",
+                  "Exit with an error if the serial and parallel values"
+                  " differ.");
+   args.Parse();
+   if (!args.Good())
+   {
+      if (myid == 0) { args.PrintUsage(cout); }
+      MPI_Finalize();
+      return 1;
+   }
+   if (myid == 0) { args.PrintOptions(cout); }
+
+   // 3. Read and refine the serial mesh on all processors.
+   ifstream imesh(mesh_file);
+   if (!imesh)
+   {
+      if (myid == 0)
+      {
+         cerr << "\nCan not open mesh file: " << mesh_file << '\n' << endl;
+      }
+      MPI_Finalize();
+      return 2;
+   }
+   Mesh *mesh = new Mesh(imesh, 1, 1);
+   imesh.close();
+   MFEM_VERIFY(mesh->Dimension() == 4, "a 4D mesh is required");
+   for (int l = 0; l < ref_levels; l++)
+   {
+      mesh->UniformRefinement();
+   }
+
+   L2_FECollection fec(order, 4);
+   ConstantCoefficient one(1.0);
+   FunctionCoefficient u_coeff(u_func);
+
+   // 4. The interior face energy on the serial mesh.
+   double ser_energy;
+   {
+      FiniteElementSpace fespace(mesh, &fec);
+      GridFunction u(&fespace);
+      u.ProjectCoefficient(u_coeff);
+
+      BilinearForm a(&fespace);
+      a.AddInteriorFaceIntegrator(new DGDiffusionIntegrator(one, sigma, kappa));
+      a.Assemble();
+      a.Finalize();
+      ser_energy = a.InnerProduct(u, u);
+   }
+
+   // 5. The same energy on the parallel mesh, where the faces between the
+   //    processors are assembled through GetSharedFaceTransformations.
+   ParMesh *pmesh = new ParMesh(MPI_COMM_WORLD, *mesh);
+   delete mesh;
+
+   int num_shared_faces = pmesh->GetNSharedFaces(), glob_shared_faces;
+   MPI_Allreduce(&num_shared_faces, &glob_shared_faces, 1, MPI_INT, MPI_SUM,
+                 MPI_COMM_WORLD);
+
+   double par_energy;
+   {
+      ParFiniteElementSpace pfespace(pmesh, &fec);
+      ParGridFunction u(&pfespace);
+      u.ProjectCoefficient(u_coeff);
+
+      ParBilinearForm a(&pfespace);
+      a.AddInteriorFaceIntegrator(new DGDiffusionIntegrator(one, sigma, kappa));
+      a.Assemble();
+      a.Finalize();
+      HypreParMatrix *A = a.ParallelAssemble();
+      HypreParVector *U = u.ParallelProject();
+      HypreParVector AU(*U);
+      A->Mult(*U, AU);
+      par_energy = InnerProduct(*U, AU);
+      delete U;
+      delete A;
+   }
+   delete pmesh;
+
+   // 6. Compare.
+   const double rel_diff =
+      fabs(par_energy - ser_energy) / fabs(ser_energy);
+   const bool ok = (glob_shared_faces > 0 || num_procs == 1) &&
+                   rel_diff < 1e-10;
+   if (myid == 0)
+   {
+      cout << "\nshared faces      : " << glob_shared_faces / 2
+           << "\nserial   a(u,u)   : " << ser_energy
+           << "\nparallel a(u,u)   : " << par_energy
+           << "\nrelative diff.    : " << rel_diff
+           << "\nThe parallel DG face terms "
+           << (ok ? "match" : "do not match") << " the serial ones." << endl;
+   }
+
+   MPI_Finalize();
+
+   return (check && !ok) ? 3 : 0;
+}
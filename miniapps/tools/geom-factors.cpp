@@ -0,0 +1,204 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+//
+//      ----------------------------------------------------------------
+//      Geom Factors Miniapp:  Check the cached geometric factors
+//      ----------------------------------------------------------------
+//
+// This miniapp checks the cache of the geometric factors at quadrature points,
+// Mesh::EnableGeometricFactors, which is used by the element transformations
+// of the integrators through ElementTransformation::SetIntPoint(ir, q).
+//
+// The matrices of the H1 mass and diffusion forms, of the RT mass and div-div
+// forms and of the mixed RT-L2 divergence form, all with variable
+// coefficients, are assembled with the cache disabled and enabled. The
+// matrices must be equal up to round-off; the assembly times and the memory of
+// the cache are printed for comparison. The second assembly with the cache
+// enabled uses the factors computed by the first one. With -check the program
+// exits with an error if the matrices differ or the cache was not filled.
+//
+// Compile with: make geom-factors
+//
+// Sample runs:  geom-factors
+//               geom-factors -m ../../data/cube4d_24.MFEM -r 2
+//               geom-factors -m ../../data/inline-tet.mesh -r 1 -o 2
+//               geom-factors -check
+
+#include "mfem.hpp"
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <cmath>
+
+using namespace std;
+using namespace mfem;
+
+double q_func(const Vector &x)
+{
+   return 1.0 + x(0)*x(0) + 0.5*sin(x(1) + x(x.Size()-1));
+}
+
+static const int num_forms = 5;
+static const char *form_names[num_forms] =
+{ "H1 mass", "H1 diffusion", "RT mass", "RT div-div", "RT-L2 divergence" };
+
+// Assemble the matrix of the given form on the given spaces.
+SparseMatrix *AssembleForm(int form, FiniteElementSpace &h1_space,
+                           FiniteElementSpace &rt_space,
+                           FiniteElementSpace &l2_space, Coefficient &q)
+{
+   if (form == 4)
+   {
+      MixedBilinearForm b(&rt_space, &l2_space);
+      b.AddDomainIntegrator(new VectorFEDivergenceIntegrator(q));
+      b.Assemble();
+      b.Finalize();
+      return b.LoseMat();
+   }
+
+   BilinearForm a(form < 2 ? &h1_space : &rt_space);
+   switch (form)
+   {
+      case 0: a.AddDomainIntegrator(new MassIntegrator(q)); break;
+      case 1: a.AddDomainIntegrator(new DiffusionIntegrator(q)); break;
+      case 2: a.AddDomainIntegrator(new VectorFEMassIntegrator(q)); break;
+      default: a.AddDomainIntegrator(new DivDivIntegrator(q)); break;
+   }
+   a.Assemble();
+   a.Finalize();
+   return a.LoseMat();
+}
+
+int main(int argc, char *argv[])
+{
+   // 1. Parse command-line options.
+   const char *mesh_file = "../../data/cube4d_96.MFEM";
+   int ref_levels = 1;
+   int order = 1;
+   double tol = 1e-12;
+   bool check = false;
+
+   OptionsParser args(argc, argv);
+   args.AddOption(&mesh_file, "-m", "--mesh",
+                  "Mesh file to use.");
+   args.AddOption(&ref_levels, "-r", "--refine",
+                  "Number of uniform refinements of the mesh.");
+   args.AddOption(&order, "-o", "--order",
+                  "Finite element order of the H1 space (the RT and L2"
+                  " spaces have order - 1; 1 in 4D).");
+   args.AddOption(&tol, "-t", "--tolerance",
+                  "Tolerance of the relative difference of the matrices.");
+   args.AddOption(&check, "-check", "--check", "-no-check", "--no-check",
+                  "Exit with an error if the matrices differ.");
+   args.Parse();
+   if (!args.Good())
+   {
+      args.PrintUsage(cout);
+      return 1;
+   }
+   args.PrintOptions(cout);
+
+   // 2. Read and refine the mesh.
+   ifstream imesh(mesh_file);
+   if (!imesh)
+   {
+      cerr << "\nCan not open mesh file: " << mesh_file << '\n' << endl;
+      return 2;
+   }
+   Mesh *mesh = new Mesh(imesh, 1, 1);
+   imesh.close();
+   const int dim = mesh->Dimension();
+   MFEM_VERIFY(dim > 1, "a 2D, 3D or 4D mesh is required");
+   MFEM_VERIFY(dim < 4 || order == 1, "only order 1 is available in 4D");
+   MFEM_VERIFY(order > 0, "the order must be positive");
+   for (int l = 0; l < ref_levels; l++)
+   {
+      mesh->UniformRefinement();
+   }
+
+   // 3. The H1, RT and L2 spaces.
+   FiniteElementCollection *h1_coll, *rt_coll;
+   if (dim == 4)
+   {
+      h1_coll = new LinearFECollection;
+      rt_coll = new RT0_4DFECollection;
+   }
+   else
+   {
+      h1_coll = new H1_FECollection(order, dim);
+      rt_coll = new RT_FECollection(order - 1, dim);
+   }
+   L2_FECollection l2_coll(order - 1, dim);
+
+   FiniteElementSpace h1_space(mesh, h1_coll);
+   FiniteElementSpace rt_space(mesh, rt_coll);
+   FiniteElementSpace l2_space(mesh, &l2_coll);
+
+   cout << "\nnumber of elements = " << mesh->GetNE()
+        << ", dim(H1) = " << h1_space.GetVSize()
+        << ", dim(RT) = " << rt_space.GetVSize()
+        << ", dim(L2) = " << l2_space.GetVSize() << endl;
+
+   FunctionCoefficient q(q_func);
+
+   // 4. Assemble every form without the cache, with the cache computing the
+   //    factors and with the cache using them, and compare the matrices.
+   bool ok = true;
+   StopWatch chrono;
+   cout << "\nform                 rel. diff.     no cache  cache (new)"
+        << "  cache (used)  cache (bytes)" << endl;
+   for (int f = 0; f < num_forms; f++)
+   {
+      double times[3];
+      SparseMatrix *mats[3];
+      for (int k = 0; k < 3; k++)
+      {
+         if (k == 0) { mesh->EnableGeometricFactors(0); }
+         if (k == 1) { mesh->EnableGeometricFactors(GeometricFactors::ALL); }
+         chrono.Clear();
+         chrono.Start();
+         mats[k] = AssembleForm(f, h1_space, rt_space, l2_space, q);
+         chrono.Stop();
+         times[k] = chrono.RealTime();
+      }
+      const long cache_mem = mesh->GeometricFactorsMemoryUsage();
+      mesh->DeleteGeometricFactors();
+
+      double rel_diff = 0.0;
+      const double norm = mats[0]->MaxNorm();
+      for (int k = 1; k < 3; k++)
+      {
+         SparseMatrix *diff = Add(1.0, *mats[0], -1.0, *mats[k]);
+         rel_diff = max(rel_diff, diff->MaxNorm() / norm);
+         delete diff;
+      }
+      ok = ok && rel_diff <= tol && cache_mem > 0;
+
+      cout << left << setw(20) << form_names[f] << right
+           << setw(12) << rel_diff << setw(13) << times[0]
+           << setw(13) << times[1] << setw(14) << times[2]
+           << setw(15) << cache_mem << endl;
+
+      for (int k = 0; k < 3; k++)
+      {
+         delete mats[k];
+      }
+   }
+
+   cout << "\nThe matrices assembled with cached geometric factors "
+        << (ok ? "match" : "do not match") << " the uncached ones." << endl;
+
+   delete rt_coll;
+   delete h1_coll;
+   delete mesh;
+
+   return (check && !ok) ? 3 : 0;
+}
@@ -0,0 +1,285 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+//
+//      -------------------------------------------------------------------
+//      Mixed Hybridization Miniapp:  Check the hybridization of RT-L2 systems
+//      -------------------------------------------------------------------
+//
+// This miniapp checks the hybridization of the mixed RT-L2 system
+//
+//                        [ M  B^T ] [ sigma ]   [ g ]
+//                        [ B   0  ] [   u   ] = [ f ]
+//
+// of a Darcy problem, in which the L2 dofs are eliminated element by element
+// together with the RT dofs (see BilinearForm::EnableHybridization with a
+// MixedBilinearForm). The hybridized system for the Lagrange multipliers on the
+// faces is symmetric positive definite and is solved with PCG, while the
+// saddle-point system is solved with MINRES and a block diagonal
+// preconditioner. The fluxes have non-homogeneous essential boundary
+// conditions on the boundary attribute 1, and the mesh must have other boundary
+// attributes, where u is zero. In 4D, the RT0_4D and DG0_Interface_4D
+// spaces are used. With -check the program exits with an error if the two
+// solutions differ.
+//
+// Compile with: make mixed-hybridization
+//
+// Sample runs:  mixed-hybridization
+//               mixed-hybridization -m ../../data/cube4d_24.MFEM -r 1
+//               mixed-hybridization -m ../../data/beam-tet.mesh -o 1
+//               mixed-hybridization -m ../../data/beam-tri.mesh -o 2 -check
+
+#include "mfem.hpp"
+#include <fstream>
+#include <iostream>
+#include <cmath>
+
+using namespace std;
+using namespace mfem;
+
+void g_func(const Vector &x, Vector &g)
+{
+   for (int i = 0; i < x.Size(); i++)
+   {
+      g(i) = sin(x(i) + 0.5*i) + x(0)*x(x.Size()-1);
+   }
+}
+
+double f_func(const Vector &x)
+{
+   double s = 0.0;
+   for (int i = 0; i < x.Size(); i++) { s += (i+1)*x(i); }
+   return cos(s);
+}
+
+int main(int argc, char *argv[])
+{
+   // 1. Parse command-line options.
+   const char *mesh_file = "../../data/cube4d_24.MFEM";
+   int ref_levels = 0;
+   int order = 0;
+   double tol = 1e-8;
+   bool check = false;
+
+   OptionsParser args(argc, argv);
+   args.AddOption(&mesh_file, "-m", "--mesh",
+                  "Mesh file to use.");
+   args.AddOption(&ref_levels, "-r", "--refine",
+                  "Number of uniform refinements of the mesh.");
+   args.AddOption(&order, "-o", "--order",
+                  "Finite element order (polynomial degree), 0 in 4D.");
+   args.AddOption(&tol, "-t", "--tolerance",
+                  "Tolerance of the relative difference of the solutions.");
+   args.AddOption(&check, "-check", "--check", "-no-check", "--no-check",
+                  "Exit with an error if the solutions differ.");
+   args.Parse();
+   if (!args.Good())
+   {
+      args.PrintUsage(cout);
+      return 1;
+   }
+   args.PrintOptions(cout);
+
+   // 2. Read and refine the mesh.
+   ifstream imesh(mesh_file);
+   if (!imesh)
+   {
+      cerr << "\nCan not open mesh file: " << mesh_file << '\n' << endl;
+      return 2;
+   }
+   Mesh *mesh = new Mesh(imesh, 1, 1);
+   imesh.close();
+   const int dim = mesh->Dimension();
+   MFEM_VERIFY(dim > 1, "a 2D, 3D or 4D mesh is required");
+   MFEM_VERIFY(dim < 4 || order == 0, "only RT0 is available in 4D");
+   for (int l = 0; l < ref_levels; l++)
+   {
+      mesh->UniformRefinement();
+   }
+
+   // 3. The RT, L2 and interface spaces.
+   FiniteElementCollection *hdiv_coll, *trace_coll;
+   if (dim == 4)
+   {
+      hdiv_coll = new RT0_4DFECollection;
+      trace_coll = new DG0_Interface_4DFECollection(0, dim);
+   }
+   else
+   {
+      hdiv_coll = new RT_FECollection(order, dim);
+      trace_coll = new DG_Interface_FECollection(order, dim);
+   }
+   L2_FECollection l2_coll(order, dim);
+
+   FiniteElementSpace R_space(mesh, hdiv_coll);
+   FiniteElementSpace W_space(mesh, &l2_coll);
+   FiniteElementSpace T_space(mesh, trace_coll);
+
+   Array<int> block_offsets(3);
+   block_offsets[0] = 0;
+   block_offsets[1] = R_space.GetVSize();
+   block_offsets[2] = W_space.GetVSize();
+   block_offsets.PartialSum();
+
+   cout << "\ndim(R) = " << R_space.GetVSize()
+        << ", dim(W) = " << W_space.GetVSize()
+        << ", dim(T) = " << T_space.GetVSize() << endl;
+
+   // u is determined by the natural boundary conditions on the other
+   // attributes, otherwise the system is singular
+   MFEM_VERIFY(mesh->bdr_attributes.Max() > 1,
+               "the mesh needs boundary attributes other than 1");
+   Array<int> ess_bdr(mesh->bdr_attributes.Max()), ess_dofs;
+   ess_bdr = 0;
+   ess_bdr[0] = 1;
+   R_space.GetEssentialTrueDofs(ess_bdr, ess_dofs);
+
+   // 4. The right-hand side and the boundary values of the flux.
+   VectorFunctionCoefficient g_coeff(dim, g_func);
+   FunctionCoefficient f_coeff(f_func);
+
+   BlockVector rhs(block_offsets), x_bc(block_offsets);
+   {
+      LinearForm g_form, f_form;
+      g_form.Update(&R_space, rhs.GetBlock(0), 0);
+      g_form.AddDomainIntegrator(new VectorFEDomainLFIntegrator(g_coeff));
+      g_form.Assemble();
+      f_form.Update(&W_space, rhs.GetBlock(1), 0);
+      f_form.AddDomainIntegrator(new DomainLFIntegrator(f_coeff));
+      f_form.Assemble();
+
+      GridFunction sigma_bc;
+      sigma_bc.MakeRef(&R_space, x_bc.GetBlock(0), 0);
+      sigma_bc = 0.0;
+      sigma_bc.ProjectBdrCoefficientNormal(g_coeff, ess_bdr);
+      x_bc.GetBlock(1) = 0.0;
+   }
+
+   // 5. Solve the saddle-point system with MINRES.
+   BlockVector x_mixed(x_bc);
+   {
+      BlockVector b(rhs);
+      BilinearForm m(&R_space);
+      m.AddDomainIntegrator(new VectorFEMassIntegrator);
+      m.Assemble();
+      m.EliminateEssentialBC(ess_bdr, x_mixed.GetBlock(0), b.GetBlock(0));
+      m.Finalize();
+
+      MixedBilinearForm bform(&R_space, &W_space);
+      bform.AddDomainIntegrator(new VectorFEDivergenceIntegrator);
+      bform.Assemble();
+      bform.EliminateTrialDofs(ess_bdr, x_mixed.GetBlock(0), b.GetBlock(1));
+      bform.Finalize();
+
+      SparseMatrix &M = m.SpMat();
+      SparseMatrix &B = bform.SpMat();
+      SparseMatrix *Bt = Transpose(B);
+
+      BlockOperator op(block_offsets);
+      op.SetBlock(0, 0, &M);
+      op.SetBlock(0, 1, Bt);
+      op.SetBlock(1, 0, &B);
+
+      // M and the approximate Schur complement B diag(M)^{-1} B^T
+      Vector Md;
+      M.GetDiag(Md);
+      SparseMatrix MinvBt(*Bt);
+      for (int i = 0; i < Md.Size(); i++)
+      {
+         MinvBt.ScaleRow(i, 1.0/Md(i));
+      }
+      SparseMatrix *S = Mult(B, MinvBt);
+      DSmoother invM(M);
+      GSSmoother invS(*S);
+      invM.iterative_mode = false;
+      invS.iterative_mode = false;
+      BlockDiagonalPreconditioner prec(block_offsets);
+      prec.SetDiagonalBlock(0, &invM);
+      prec.SetDiagonalBlock(1, &invS);
+
+      MINRESSolver minres;
+      minres.SetOperator(op);
+      minres.SetPreconditioner(prec);
+      minres.SetRelTol(1e-14);
+      minres.SetAbsTol(0.0);
+      minres.SetMaxIter(20000);
+      minres.SetPrintLevel(0);
+      minres.Mult(b, x_mixed);
+      cout << "\nMINRES on the saddle-point system: "
+           << minres.GetNumIterations() << " iterations"
+           << (minres.GetConverged() ? "" : " (not converged)") << endl;
+
+      delete S;
+      delete Bt;
+   }
+
+   // 6. Solve the hybridized system with PCG.
+   BlockVector x_hyb(x_bc);
+   {
+      BlockVector b(rhs);
+      BilinearForm a(&R_space);
+      a.AddDomainIntegrator(new VectorFEMassIntegrator);
+      MixedBilinearForm bform(&R_space, &W_space);
+      bform.AddDomainIntegrator(new VectorFEDivergenceIntegrator);
+      a.EnableHybridization(&T_space, new NormalTraceJumpIntegrator(),
+                            ess_dofs, &bform);
+      a.Assemble();
+
+      SparseMatrix H;
+      Vector X, B;
+      a.FormLinearSystem(ess_dofs, x_hyb, b, H, X, B);
+
+      // H must be exactly symmetric for PCG
+      SparseMatrix *Ht = Transpose(H);
+      Ht->Add(-1.0, H);
+      const double asym = Ht->MaxNorm();
+      delete Ht;
+
+      GSSmoother prec(H);
+      CGSolver pcg;
+      pcg.SetOperator(H);
+      pcg.SetPreconditioner(prec);
+      pcg.SetRelTol(1e-14);
+      pcg.SetAbsTol(0.0);
+      pcg.SetMaxIter(20000);
+      pcg.SetPrintLevel(0);
+      pcg.Mult(B, X);
+      cout << "PCG on the hybridized system:      "
+           << pcg.GetNumIterations() << " iterations"
+           << (pcg.GetConverged() ? "" : " (not converged)")
+           << ", size " << H.Height()
+           << ", max |H - H^T| = " << asym << endl;
+
+      a.RecoverFEMSolution(X, b, x_hyb);
+   }
+
+   // 7. Compare.
+   bool ok = true;
+   const char *names[2] = { "sigma", "u" };
+   for (int k = 0; k < 2; k++)
+   {
+      Vector diff(x_hyb.GetBlock(k));
+      diff -= x_mixed.GetBlock(k);
+      const double rel_diff = diff.Normlinf() /
+                              x_mixed.GetBlock(k).Normlinf();
+      cout << "relative difference of " << names[k] << " : " << rel_diff
+           << endl;
+      if (!(rel_diff < tol)) { ok = false; }
+   }
+   cout << "\nThe hybridized solution "
+        << (ok ? "matches" : "does not match") << " the mixed solution."
+        << endl;
+
+   delete trace_coll;
+   delete hdiv_coll;
+   delete mesh;
+
+   return (check && !ok) ? 3 : 0;
+}
@@ -0,0 +1,543 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+//
+//      -------------------------------------------------------------------
+//      Pentatope Quadrature Miniapp:  Verify and generate symmetric rules
+//      -------------------------------------------------------------------
+//
+// This miniapp verifies the integration rules for the reference pentatope
+// {[0,0,0,0],[1,0,0,0],[0,1,0,0],[0,0,1,0],[0,0,0,1]} returned by IntRules
+// and can be used to generate new fully symmetric rules.
+//
+// In the verification mode (default), every rule up to the given order is
+// applied to all monomials x^a y^b z^c t^d with a+b+c+d <= order and compared
+// with the exact integral a! b! c! d! / (a+b+c+d+4)!. The number of points,
+// the smallest weight and the smallest barycentric coordinate of the points
+// are also reported.
+//
+// In the generation mode (-g), the points are sought as a union of orbits of
+// the symmetry group of the pentatope (permutations of the five barycentric
+// coordinates), e.g. the orbit "20" consists of the permutations of
+// (a,a,a,b,c). The unknown orbit parameters and weights are computed with a
+// Levenberg-Marquardt iteration from random initial guesses, so that the rule
+// integrates exactly all symmetric polynomials of the given degree. Orbit
+// structures are tried in the order of increasing number of points, and the
+// first rule with positive weights and interior points is printed in the form
+// used in fem/intrules.cpp.
+//
+// Compile with: make pentatope-quadrature
+//
+// Sample runs:  pentatope-quadrature
+//               pentatope-quadrature -o 12
+//               pentatope-quadrature -g 6
+//               pentatope-quadrature -g 8 -s 200 -seed 3
+
+#include "mfem.hpp"
+#include <vector>
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <cstdlib>
+#include <cmath>
+#include <limits>
+
+using namespace std;
+using namespace mfem;
+
+// Orbit types: number of points, number of free parameters and the name of
+// the IntegrationRule method that adds the orbit.
+const int num_orbit_types = 7;
+const int orbit_npts[num_orbit_types] = { 1, 5, 10, 20, 30, 60, 120 };
+const int orbit_nparams[num_orbit_types] = { 0, 1, 1, 2, 2, 3, 4 };
+const char *orbit_method[num_orbit_types] =
+{
+   "AddPentMidPoint", "AddPentPoints5", "AddPentPoints10", "AddPentPoints20",
+   "AddPentPoints30", "AddPentPoints60", "AddPentPoints120"
+};
+
+// Barycentric coordinates of a representative point of the orbit.
+void OrbitTuple(int type, const double *p, double l[5])
+{
+   switch (type)
+   {
+      case 0: l[0] = l[1] = l[2] = l[3] = l[4] = 0.2; break;
+      case 1: l[0] = l[1] = l[2] = l[3] = p[0]; l[4] = 1. - 4*p[0]; break;
+      case 2:
+         l[0] = l[1] = l[2] = p[0]; l[3] = l[4] = (1. - 3*p[0])/2; break;
+      case 3:
+         l[0] = l[1] = l[2] = p[0]; l[3] = p[1]; l[4] = 1. - 3*p[0] - p[1];
+         break;
+      case 4:
+         l[0] = l[1] = p[0]; l[2] = l[3] = p[1]; l[4] = 1. - 2*(p[0] + p[1]);
+         break;
+      case 5:
+         l[0] = l[1] = p[0]; l[2] = p[1]; l[3] = p[2];
+         l[4] = 1. - 2*p[0] - p[1] - p[2];
+         break;
+      case 6:
+         l[0] = p[0]; l[1] = p[1]; l[2] = p[2]; l[3] = p[3];
+         l[4] = 1. - p[0] - p[1] - p[2] - p[3];
+         break;
+   }
+}
+
+// Sum over the points of the orbit of l of the monomial lambda^alpha; the
+// entries of l that are equal by the definition of the orbit type are given
+// by orbit_pattern.
+const int orbit_pattern[num_orbit_types][5] =
+{
+   {0,0,0,0,0}, {0,0,0,0,1}, {0,0,0,1,1}, {0,0,0,1,2}, {0,0,1,1,2},
+   {0,0,1,2,3}, {0,1,2,3,4}
+};
+
+double OrbitMonomialSum(int type, const double l[5], const vector<int> &alpha)
+{
+   const int *pat = orbit_pattern[type];
+   // value of each pattern index
+   double val[5];
+   for (int i = 0; i < 5; i++) { val[pat[i]] = l[i]; }
+   int perm[5];
+   for (int i = 0; i < 5; i++) { perm[i] = pat[i]; }
+   sort(perm, perm + 5);
+   double sum = 0.0;
+   do
+   {
+      double v = 1.0;
+      for (int i = 0; i < 5; i++)
+      {
+         for (int k = 0; k < alpha[i]; k++) { v *= val[perm[i]]; }
+      }
+      sum += v;
+   }
+   while (next_permutation(perm, perm + 5));
+   return sum;
+}
+
+// The partitions of d into at most 5 parts: the homogeneous monomials of
+// degree d in the barycentric coordinates, up to symmetry. Since the
+// barycentric coordinates sum to one, exactness for these implies exactness
+// for all polynomials of degree <= d.
+void GetPartitions(int d, int max_part, vector<int> &cur,
+                   vector<vector<int> > &parts)
+{
+   if (d == 0)
+   {
+      vector<int> alpha(5, 0);
+      for (size_t i = 0; i < cur.size(); i++) { alpha[i] = cur[i]; }
+      parts.push_back(alpha);
+      return;
+   }
+   if (cur.size() == 5) { return; }
+   for (int k = min(d, max_part); k >= 1; k--)
+   {
+      cur.push_back(k);
+      GetPartitions(d - k, k, cur, parts);
+      cur.pop_back();
+   }
+}
+
+double Factorial(int n)
+{
+   double f = 1.0;
+   for (int i = 2; i <= n; i++) { f *= i; }
+   return f;
+}
+
+// A symmetric rule: orbit types plus the unknowns, ordered as the parameters
+// of all orbits followed by the weights of all orbits.
+struct SymmetricRule
+{
+   vector<int> types;
+   Vector x;
+
+   int NumPoints() const
+   {
+      int np = 0;
+      for (int i = 0; i < (int) types.size(); i++) { np += orbit_npts[types[i]]; }
+      return np;
+   }
+   int NumParams() const
+   {
+      int n = 0;
+      for (int i = 0; i < (int) types.size(); i++) { n += orbit_nparams[types[i]]; }
+      return n;
+   }
+   int NumUnknowns() const { return NumParams() + (int) types.size(); }
+};
+
+class RuleResidual
+{
+protected:
+   vector<vector<int> > parts;
+   Vector exact;
+
+public:
+   RuleResidual(int degree)
+   {
+      vector<int> cur;
+      GetPartitions(degree, degree, cur, parts);
+      exact.SetSize(parts.size());
+      for (int k = 0; k < exact.Size(); k++)
+      {
+         double num = 1.0;
+         for (int i = 0; i < 5; i++) { num *= Factorial(parts[k][i]); }
+         exact(k) = num/Factorial(degree + 4);
+      }
+   }
+
+   int NumEquations() const { return exact.Size(); }
+
+   // relative errors of the rule
+   void Eval(const SymmetricRule &rule, const Vector &x, Vector &r) const
+   {
+      r.SetSize(exact.Size());
+      r = 0.0;
+      const int nparams = rule.NumParams();
+      for (int o = 0, p = 0; o < (int) rule.types.size(); o++)
+      {
+         const int t = rule.types[o];
+         double l[5];
+         OrbitTuple(t, x.GetData() + p, l);
+         const double w = x(nparams + o);
+         for (int k = 0; k < r.Size(); k++)
+         {
+            r(k) += w*OrbitMonomialSum(t, l, parts[k]);
+         }
+         p += orbit_nparams[t];
+      }
+      for (int k = 0; k < r.Size(); k++)
+      {
+         r(k) = r(k)/exact(k) - 1.0;
+      }
+   }
+};
+
+// Check positivity of the weights and of all barycentric coordinates.
+bool IsAdmissible(const SymmetricRule &rule, const Vector &x, double tol)
+{
+   const int nparams = rule.NumParams();
+   for (int o = 0, p = 0; o < (int) rule.types.size(); o++)
+   {
+      double l[5];
+      OrbitTuple(rule.types[o], x.GetData() + p, l);
+      for (int i = 0; i < 5; i++)
+      {
+         if (!(l[i] > tol)) { return false; }
+      }
+      if (!(x(nparams + o) > 0.0)) { return false; }
+      p += orbit_nparams[rule.types[o]];
+   }
+   return true;
+}
+
+// Levenberg-Marquardt iteration with a finite difference Jacobian. Returns
+// the norm of the final residual.
+double SolveRule(const RuleResidual &res, SymmetricRule &rule, int max_iter)
+{
+   const int n = rule.NumUnknowns(), m = res.NumEquations();
+   Vector r, r_new, rp, x_new, g(n), dx(n);
+   DenseMatrix J(m, n), JtJ(n, n);
+   res.Eval(rule, rule.x, r);
+   double nrm = r.Norml2(), mu = 1e-3;
+   for (int it = 0; it < max_iter && nrm > 1e-15; it++)
+   {
+      for (int j = 0; j < n; j++)
+      {
+         const double h = 1e-7*max(1.0, fabs(rule.x(j)));
+         x_new = rule.x;
+         x_new(j) += h;
+         res.Eval(rule, x_new, rp);
+         for (int i = 0; i < m; i++) { J(i,j) = (rp(i) - r(i))/h; }
+      }
+      MultAtB(J, J, JtJ);
+      J.MultTranspose(r, g);
+      bool accepted = false;
+      for (int k = 0; k < 20 && !accepted; k++)
+      {
+         DenseMatrix A(JtJ);
+         for (int j = 0; j < n; j++) { A(j,j) += mu*(JtJ(j,j) + 1e-12); }
+         DenseMatrixInverse inv(A);
+         inv.Mult(g, dx);
+         x_new = rule.x;
+         x_new -= dx;
+         res.Eval(rule, x_new, r_new);
+         const double nrm_new = r_new.Norml2();
+         if (nrm_new < nrm)
+         {
+            rule.x = x_new;
+            r = r_new;
+            nrm = nrm_new;
+            mu = max(mu/5, 1e-14);
+            accepted = true;
+         }
+         else
+         {
+            mu *= 10;
+         }
+      }
+      // give up on initial guesses that do not converge
+      if (!accepted || (it == max_iter/2 && nrm > 1e-4)) { break; }
+   }
+   return nrm;
+}
+
+double Random() { return double(rand())/RAND_MAX; }
+
+// Random initial guess: random interior orbits with equal weights.
+void RandomGuess(SymmetricRule &rule)
+{
+   const int nparams = rule.NumParams();
+   rule.x.SetSize(rule.NumUnknowns());
+   const double w = 1./24./rule.NumPoints();
+   for (int o = 0, p = 0; o < (int) rule.types.size(); o++)
+   {
+      const int t = rule.types[o];
+      // random barycentric coordinates, then keep the ones that are free
+      double e[5], s = 0.0;
+      for (int i = 0; i < 5; i++) { e[i] = -log(1e-3 + Random()); s += e[i]; }
+      switch (t)
+      {
+         case 1: rule.x(p) = 0.25*Random(); break;
+         case 2: rule.x(p) = Random()/3; break;
+         case 3:
+            rule.x(p) = e[0]/(3*e[0] + e[1] + e[2]);
+            rule.x(p+1) = e[1]/(3*e[0] + e[1] + e[2]);
+            break;
+         case 4:
+            rule.x(p) = e[0]/(2*e[0] + 2*e[1] + e[2]);
+            rule.x(p+1) = e[1]/(2*e[0] + 2*e[1] + e[2]);
+            break;
+         case 5:
+            s = 2*e[0] + e[1] + e[2] + e[3];
+            for (int i = 0; i < 3; i++) { rule.x(p+i) = e[i]/s; }
+            break;
+         case 6:
+            for (int i = 0; i < 4; i++) { rule.x(p+i) = e[i]/s; }
+            break;
+      }
+      rule.x(nparams + o) = w;
+      p += orbit_nparams[t];
+   }
+}
+
+// Enumerate the orbit structures (number of orbits of each type) with a
+// number of unknowns between num_eq and num_eq + extra. The one-parameter
+// orbits "5" and "10" lie on lines through the centroid, so many of them
+// cannot be independent; their number is limited by max_line.
+void GetStructures(int type, int min_unknowns, int max_unknowns,
+                   int max_line, vector<int> &types,
+                   vector<vector<int> > &structs)
+{
+   if (type == num_orbit_types)
+   {
+      if (min_unknowns <= 0) { structs.push_back(types); }
+      return;
+   }
+   const int nu = orbit_nparams[type] + 1;
+   int max_cnt = max_unknowns/nu;
+   if (type == 0) { max_cnt = min(max_cnt, 1); }
+   if (type == 1 || type == 2) { max_cnt = min(max_cnt, max_line); }
+   for (int k = 0; k <= max_cnt; k++)
+   {
+      GetStructures(type + 1, min_unknowns - k*nu, max_unknowns - k*nu,
+                    max_line, types, structs);
+      types.push_back(type);
+   }
+   types.resize(types.size() - max_cnt - 1);
+}
+
+int StructurePoints(const vector<int> &types)
+{
+   int np = 0;
+   for (int i = 0; i < (int) types.size(); i++) { np += orbit_npts[types[i]]; }
+   return np;
+}
+
+bool FewerPoints(const vector<int> &a, const vector<int> &b)
+{
+   return StructurePoints(a) < StructurePoints(b);
+}
+
+void PrintRule(const SymmetricRule &rule, int degree, ostream &out)
+{
+   const int nparams = rule.NumParams();
+   out << "      case " << degree << ":  // " << rule.NumPoints()
+       << " points - degree " << degree << "\n"
+       << "         ir = new IntegrationRule(" << rule.NumPoints() << ");\n"
+       << setprecision(17);
+   int off = 0;
+   for (int o = 0, p = 0; o < (int) rule.types.size(); o++)
+   {
+      const int t = rule.types[o];
+      out << "         ir->" << orbit_method[t] << "(" << off;
+      for (int i = 0; i < orbit_nparams[t]; i++)
+      {
+         out << ", " << rule.x(p + i);
+      }
+      out << ", " << rule.x(nparams + o) << ");\n";
+      off += orbit_npts[t];
+      p += orbit_nparams[t];
+   }
+   out << setprecision(6);
+}
+
+int Generate(int degree, int num_starts, int extra, int max_line,
+             int max_points)
+{
+   RuleResidual res(degree);
+   const int num_eq = res.NumEquations();
+   vector<vector<int> > structs;
+   vector<int> types;
+   GetStructures(0, num_eq, num_eq + extra, max_line, types, structs);
+   stable_sort(structs.begin(), structs.end(), FewerPoints);
+   cout << "degree " << degree << ": " << num_eq << " moment equations, "
+        << structs.size() << " orbit structures" << endl;
+
+   // A rule with positive weights that is exact for degree 2k needs at least
+   // as many points as the dimension of the polynomials of degree k.
+   const int k = degree/2;
+   const int min_points = (k+1)*(k+2)*(k+3)*(k+4)/24;
+
+   for (size_t s = 0; s < structs.size(); s++)
+   {
+      SymmetricRule rule;
+      rule.types = structs[s];
+      if (rule.NumPoints() < min_points) { continue; }
+      if (max_points > 0 && rule.NumPoints() > max_points) { break; }
+      double best = 1e30;
+      for (int k = 0; k < num_starts; k++)
+      {
+         RandomGuess(rule);
+         const double nrm = SolveRule(res, rule, 200);
+         best = min(best, nrm);
+         if (nrm < 1e-14 && IsAdmissible(rule, rule.x, 1e-12))
+         {
+            cout << "found rule with " << rule.NumPoints() << " points,"
+                 << " residual " << nrm << ":\n";
+            PrintRule(rule, degree, cout);
+            return 0;
+         }
+      }
+      cout << "  " << rule.NumPoints() << " points, orbits";
+      for (int i = 0; i < (int) rule.types.size(); i++)
+      {
+         cout << ' ' << orbit_npts[rule.types[i]];
+      }
+      cout << ": no admissible rule, best residual " << best << endl;
+   }
+   cout << "no rule found" << endl;
+   return 1;
+}
+
+// Exactness test with the monomials x^a y^b z^c t^d, a+b+c+d <= order.
+double CheckRule(const IntegrationRule &ir, int order, double &min_weight,
+                 double &min_bary)
+{
+   min_weight = numeric_limits<double>::infinity();
+   min_bary = numeric_limits<double>::infinity();
+   for (int j = 0; j < ir.GetNPoints(); j++)
+   {
+      const IntegrationPoint &ip = ir.IntPoint(j);
+      min_weight = min(min_weight, ip.weight);
+      min_bary = min(min_bary, min(min(ip.x, ip.y), min(ip.z, ip.t)));
+      min_bary = min(min_bary, 1. - ip.x - ip.y - ip.z - ip.t);
+   }
+   double max_err = 0.0;
+   for (int a = 0; a <= order; a++)
+      for (int b = 0; a + b <= order; b++)
+         for (int c = 0; a + b + c <= order; c++)
+            for (int d = 0; a + b + c + d <= order; d++)
+            {
+               double q = 0.0;
+               for (int j = 0; j < ir.GetNPoints(); j++)
+               {
+                  const IntegrationPoint &ip = ir.IntPoint(j);
+                  q += ip.weight*pow(ip.x, a)*pow(ip.y, b)*pow(ip.z, c)*
+                       pow(ip.t, d);
+               }
+               const double exact = Factorial(a)*Factorial(b)*Factorial(c)*
+                                    Factorial(d)/Factorial(a + b + c + d + 4);
+               max_err = max(max_err, fabs(q - exact)/exact);
+            }
+   return max_err;
+}
+
+int main(int argc, char *argv[])
+{
+   // 1. Parse command-line options.
+   int max_order = 9;
+   int gen_degree = -1;
+   int num_starts = 50;
+   int extra = 1;
+   int max_line = 3;
+   int max_points = 0;
+   int seed = 1;
+   bool check = false;
+
+   OptionsParser args(argc, argv);
+   args.AddOption(&max_order, "-o", "--order",
+                  "Verify the pentatope rules of orders 0 to this order. The"
+                  " higher-order conical product rules may have negative"
+                  " weights.");
+   args.AddOption(&gen_degree, "-g", "--generate",
+                  "Generate a symmetric rule of the given degree instead.");
+   args.AddOption(&num_starts, "-s", "--starts",
+                  "Number of random initial guesses per orbit structure.");
+   args.AddOption(&extra, "-e", "--extra",
+                  "Allowed excess of unknowns over the moment equations.");
+   args.AddOption(&max_line, "-l", "--max-line-orbits",
+                  "Largest number of orbits of each of the types 5 and 10.");
+   args.AddOption(&max_points, "-m", "--max-points",
+                  "Largest number of points to try (0 = no limit).");
+   args.AddOption(&seed, "-seed", "--seed", "Random seed.");
+   args.AddOption(&check, "-check", "--check", "-no-check", "--no-check",
+                  "Exit with an error if a rule is not exact, has negative"
+                  " weights or points outside of the pentatope.");
+   args.Parse();
+   if (!args.Good())
+   {
+      args.PrintUsage(cout);
+      return 1;
+   }
+   args.PrintOptions(cout);
+
+   // 2. Generation mode.
+   if (gen_degree >= 0)
+   {
+      srand(seed);
+      return Generate(gen_degree, num_starts, extra, max_line, max_points);
+   }
+
+   // 3. Verification mode: check the rules in IntRules.
+   cout << "\n" << setw(6) << "order" << setw(8) << "points"
+        << setw(14) << "max rel. err" << setw(14) << "min weight"
+        << setw(14) << "min bary" << endl;
+   bool ok = true;
+   for (int order = 0; order <= max_order; order++)
+   {
+      const IntegrationRule &ir = IntRules.Get(Geometry::PENTATOPE, order);
+      double min_weight, min_bary;
+      const double err = CheckRule(ir, order, min_weight, min_bary);
+      cout << setw(6) << order << setw(8) << ir.GetNPoints()
+           << setw(14) << err << setw(14) << min_weight
+           << setw(14) << min_bary << endl;
+      if (err > 1e-12 || min_weight <= 0.0 || min_bary < 0.0) { ok = false; }
+   }
+
+   if (check && !ok)
+   {
+      cout << "Error: not all pentatope rules are exact, positive and"
+           " interior!" << endl;
+      return 2;
+   }
+
+   return 0;
+}